@@ -28,12 +28,17 @@ class GlobalMethodHandler implements MethodChannel.MethodCallHandler {
   @NonNull private final BinaryMessenger messenger;
   @Nullable private FlutterPlugin.FlutterAssets flutterAssets;
   @Nullable private OfflineChannelHandlerImpl downloadOfflineRegionChannelHandler;
+  @NonNull private final OfflineDownloads offlineDownloads;
+  @NonNull private final OfflineMerges offlineMerges;
 
 
   GlobalMethodHandler(@NonNull FlutterPlugin.FlutterPluginBinding binding) {
     this.context = binding.getApplicationContext();
     this.flutterAssets = binding.getFlutterAssets();
     this.messenger = binding.getBinaryMessenger();
+    this.offlineDownloads = new OfflineDownloads(context, messenger);
+    this.offlineMerges = new OfflineMerges(context, messenger);
+    MapLibreHttpRequestUtil.ensureClient();
   }
 
   private static void copy(InputStream input, OutputStream output) throws IOException {
@@ -80,14 +85,40 @@ class GlobalMethodHandler implements MethodChannel.MethodCallHandler {
       case "mergeOfflineRegions":
         OfflineManagerUtils.mergeRegions(result, context, methodCall.argument("path"));
         break;
+      case "offlineMerge#start":
+        offlineMerges.start(result, methodCall.argument("path"));
+        break;
+      case "offlineMerge#cancel":
+        offlineMerges.cancel(result, methodCall.<Number>argument("id").intValue());
+        break;
       case "setOfflineTileCountLimit":
         OfflineManagerUtils.setOfflineTileCountLimit(
             result, context, methodCall.<Number>argument("limit").longValue());
         break;
+      case "setMaximumAmbientCacheSize":
+        OfflineManagerUtils.setMaximumAmbientCacheSize(
+            result, context, methodCall.<Number>argument("size").longValue());
+        break;
+      case "getAmbientCacheStatistics":
+        OfflineManagerUtils.ambientCacheStatistics(result, context);
+        break;
       case "setHttpHeaders":
         Map<String, String> headers = (Map<String, String>) methodCall.argument("headers");
         MapLibreHttpRequestUtil.setHttpHeaders(headers, result);
         break;
+      case "setNetworkConfiguration":
+        MapLibreHttpRequestUtil.setNetworkConfiguration(
+            context, methodCall.argument("configuration"), result);
+        break;
+      case "getTileStatistics":
+        result.success(
+            TileRequestStatistics.toMap(Boolean.TRUE.equals(methodCall.argument("reset"))));
+        break;
+      case "getNetworkStatistics":
+        result.success(
+            MapLibreHttpRequestUtil.getNetworkStatistics(
+                Boolean.TRUE.equals(methodCall.argument("reset"))));
+        break;
       case "downloadOfflineRegion#setup":
         String channelName = methodCall.argument("channelName");
         // Prepare args
@@ -112,6 +143,27 @@ class GlobalMethodHandler implements MethodChannel.MethodCallHandler {
             result, context, definitionMap, metadataMap, downloadOfflineRegionChannelHandler);
         downloadOfflineRegionChannelHandler = null;
         break;
+      case "offlineDownload#create":
+        offlineDownloads.create(
+            result,
+            (Map<String, Object>) methodCall.argument("definition"),
+            (Map<String, Object>) methodCall.argument("metadata"));
+        break;
+      case "offlineDownload#resume":
+        offlineDownloads.resume(result, methodCall.<Number>argument("id").longValue());
+        break;
+      case "offlineDownload#pause":
+        offlineDownloads.pause(result, methodCall.<Number>argument("id").longValue());
+        break;
+      case "offlineDownload#invalidate":
+        offlineDownloads.invalidate(result, methodCall.<Number>argument("id").longValue());
+        break;
+      case "offlineDownload#saveQueue":
+        offlineDownloads.saveQueue(result, methodCall.argument("queue"));
+        break;
+      case "offlineDownload#loadQueue":
+        offlineDownloads.loadQueue(result);
+        break;
       case "getListOfRegions":
         OfflineManagerUtils.regionsList(result, context);
         break;
@@ -121,10 +173,17 @@ class GlobalMethodHandler implements MethodChannel.MethodCallHandler {
         OfflineManagerUtils.updateRegionMetadata(
             result, context, methodCall.<Number>argument("id").longValue(), metadata);
         break;
+      case "updateOfflineRegionMetadataBatch":
+        OfflineManagerUtils.updateRegionMetadataBatch(
+            result, context, methodCall.argument("updates"));
+        break;
       case "deleteOfflineRegion":
         OfflineManagerUtils.deleteRegion(
             result, context, methodCall.<Number>argument("id").longValue());
         break;
+      case "deleteOfflineRegions":
+        OfflineManagerUtils.deleteRegions(result, context, methodCall.argument("ids"));
+        break;
       default:
         result.notImplemented();
         break;
@@ -136,6 +195,8 @@ class GlobalMethodHandler implements MethodChannel.MethodCallHandler {
     try (InputStream input = openTilesDbFile(tilesDb);
         OutputStream output = new FileOutputStream(dest)) {
       copy(input, output);
+      // the regions of the replaced database are gone
+      OfflineRegionIndex.instance(context).invalidate();
     } catch (IOException e) {
       e.printStackTrace();
     }
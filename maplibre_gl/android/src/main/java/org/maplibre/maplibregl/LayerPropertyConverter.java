@@ -7,243 +7,217 @@ import org.maplibre.android.style.expressions.Expression;
 import org.maplibre.android.style.layers.PropertyFactory;
 import org.maplibre.android.style.layers.PropertyValue;
 
-import java.util.LinkedList;
+import java.util.ArrayList;
 import java.util.List;
 import java.util.Map;
 
 import com.google.gson.JsonArray;
 import com.google.gson.JsonElement;
-import com.google.gson.JsonParser;
+import com.google.gson.JsonNull;
+import com.google.gson.JsonObject;
 import com.google.gson.JsonPrimitive;
 
 import static org.maplibre.maplibregl.Convert.toMap;
 
 class LayerPropertyConverter {
   static PropertyValue[] interpretSymbolLayerProperties(Object o) {
-    final Map<String, String> data = (Map<String, String>) toMap(o);
-    final List<PropertyValue> properties = new LinkedList();
-    final JsonParser parser = new JsonParser();
+    final Map<String, Object> data = (Map<String, Object>) toMap(o);
+    final List<PropertyValue> properties = new ArrayList<>(data.size());
 
-    for (Map.Entry<String, String> entry : data.entrySet()) {
-      final JsonElement jsonElement = parser.parse(entry.getValue());
-      Expression expression = Expression.Converter.convert(jsonElement);
+    for (Map.Entry<String, Object> entry : data.entrySet()) {
+      final Object value = entry.getValue();
       switch (entry.getKey()) {
         case "icon-opacity":
-          properties.add(PropertyFactory.iconOpacity(expression));
+          properties.add(PropertyFactory.iconOpacity(toExpression(value)));
           break;
         case "icon-color":
-          properties.add(PropertyFactory.iconColor(expression));
+          properties.add(PropertyFactory.iconColor(toExpression(value)));
           break;
         case "icon-halo-color":
-          properties.add(PropertyFactory.iconHaloColor(expression));
+          properties.add(PropertyFactory.iconHaloColor(toExpression(value)));
           break;
         case "icon-halo-width":
-          properties.add(PropertyFactory.iconHaloWidth(expression));
+          properties.add(PropertyFactory.iconHaloWidth(toExpression(value)));
           break;
         case "icon-halo-blur":
-          properties.add(PropertyFactory.iconHaloBlur(expression));
+          properties.add(PropertyFactory.iconHaloBlur(toExpression(value)));
           break;
         case "icon-translate":
-          if (jsonElement.isJsonArray()) {
-            final Float[] floatArray = convertJsonToFloatArray(jsonElement);
-            if (floatArray != null) {
-              properties.add(PropertyFactory.iconTranslate(floatArray));
-            } else {
-              properties.add(PropertyFactory.iconTranslate(expression));
-            }
+          if (value instanceof double[]) {
+            properties.add(PropertyFactory.iconTranslate(toFloatArray((double[]) value)));
           } else {
-            properties.add(PropertyFactory.iconTranslate(expression));
+            properties.add(PropertyFactory.iconTranslate(toExpression(value)));
           }
           break;
         case "icon-translate-anchor":
-          properties.add(PropertyFactory.iconTranslateAnchor(expression));
+          properties.add(PropertyFactory.iconTranslateAnchor(toExpression(value)));
           break;
         case "text-opacity":
-          properties.add(PropertyFactory.textOpacity(expression));
+          properties.add(PropertyFactory.textOpacity(toExpression(value)));
           break;
         case "text-color":
-          properties.add(PropertyFactory.textColor(expression));
+          properties.add(PropertyFactory.textColor(toExpression(value)));
           break;
         case "text-halo-color":
-          properties.add(PropertyFactory.textHaloColor(expression));
+          properties.add(PropertyFactory.textHaloColor(toExpression(value)));
           break;
         case "text-halo-width":
-          properties.add(PropertyFactory.textHaloWidth(expression));
+          properties.add(PropertyFactory.textHaloWidth(toExpression(value)));
           break;
         case "text-halo-blur":
-          properties.add(PropertyFactory.textHaloBlur(expression));
+          properties.add(PropertyFactory.textHaloBlur(toExpression(value)));
           break;
         case "text-translate":
-          if (jsonElement.isJsonArray()) {
-            final Float[] floatArray = convertJsonToFloatArray(jsonElement);
-            if (floatArray != null) {
-              properties.add(PropertyFactory.textTranslate(floatArray));
-            } else {
-              properties.add(PropertyFactory.textTranslate(expression));
-            }
+          if (value instanceof double[]) {
+            properties.add(PropertyFactory.textTranslate(toFloatArray((double[]) value)));
           } else {
-            properties.add(PropertyFactory.textTranslate(expression));
+            properties.add(PropertyFactory.textTranslate(toExpression(value)));
           }
           break;
         case "text-translate-anchor":
-          properties.add(PropertyFactory.textTranslateAnchor(expression));
+          properties.add(PropertyFactory.textTranslateAnchor(toExpression(value)));
           break;
         case "symbol-placement":
-          properties.add(PropertyFactory.symbolPlacement(expression));
+          properties.add(PropertyFactory.symbolPlacement(toExpression(value)));
           break;
         case "symbol-spacing":
-          properties.add(PropertyFactory.symbolSpacing(expression));
+          properties.add(PropertyFactory.symbolSpacing(toExpression(value)));
           break;
         case "symbol-avoid-edges":
-          properties.add(PropertyFactory.symbolAvoidEdges(expression));
+          properties.add(PropertyFactory.symbolAvoidEdges(toExpression(value)));
           break;
         case "symbol-sort-key":
-          properties.add(PropertyFactory.symbolSortKey(expression));
+          properties.add(PropertyFactory.symbolSortKey(toExpression(value)));
           break;
         case "symbol-z-order":
-          properties.add(PropertyFactory.symbolZOrder(expression));
+          properties.add(PropertyFactory.symbolZOrder(toExpression(value)));
           break;
         case "icon-allow-overlap":
-          properties.add(PropertyFactory.iconAllowOverlap(expression));
+          properties.add(PropertyFactory.iconAllowOverlap(toExpression(value)));
           break;
         case "icon-ignore-placement":
-          properties.add(PropertyFactory.iconIgnorePlacement(expression));
+          properties.add(PropertyFactory.iconIgnorePlacement(toExpression(value)));
           break;
         case "icon-optional":
-          properties.add(PropertyFactory.iconOptional(expression));
+          properties.add(PropertyFactory.iconOptional(toExpression(value)));
           break;
         case "icon-rotation-alignment":
-          properties.add(PropertyFactory.iconRotationAlignment(expression));
+          properties.add(PropertyFactory.iconRotationAlignment(toExpression(value)));
           break;
         case "icon-size":
-          properties.add(PropertyFactory.iconSize(expression));
+          properties.add(PropertyFactory.iconSize(toExpression(value)));
           break;
         case "icon-text-fit":
-          properties.add(PropertyFactory.iconTextFit(expression));
+          properties.add(PropertyFactory.iconTextFit(toExpression(value)));
           break;
         case "icon-text-fit-padding":
-          if (jsonElement.isJsonArray()) {
-            final Float[] floatArray = convertJsonToFloatArray(jsonElement);
-            if (floatArray != null) {
-              properties.add(PropertyFactory.iconTextFitPadding(floatArray));
-            } else {
-              properties.add(PropertyFactory.iconTextFitPadding(expression));
-            }
+          if (value instanceof double[]) {
+            properties.add(PropertyFactory.iconTextFitPadding(toFloatArray((double[]) value)));
           } else {
-            properties.add(PropertyFactory.iconTextFitPadding(expression));
+            properties.add(PropertyFactory.iconTextFitPadding(toExpression(value)));
           }
           break;
         case "icon-image":
-          if (jsonElement.isJsonPrimitive() && jsonElement.getAsJsonPrimitive().isString()) {
-            properties.add(PropertyFactory.iconImage(jsonElement.getAsString()));
+          if (value instanceof String) {
+            properties.add(PropertyFactory.iconImage((String) value));
           } else {
-            properties.add(PropertyFactory.iconImage(expression));
+            properties.add(PropertyFactory.iconImage(toExpression(value)));
           }
           break;
         case "icon-rotate":
-          properties.add(PropertyFactory.iconRotate(expression));
+          properties.add(PropertyFactory.iconRotate(toExpression(value)));
           break;
         case "icon-padding":
-          properties.add(PropertyFactory.iconPadding(expression));
+          properties.add(PropertyFactory.iconPadding(toExpression(value)));
           break;
         case "icon-keep-upright":
-          properties.add(PropertyFactory.iconKeepUpright(expression));
+          properties.add(PropertyFactory.iconKeepUpright(toExpression(value)));
           break;
         case "icon-offset":
-          if (jsonElement.isJsonArray()) {
-            final Float[] floatArray = convertJsonToFloatArray(jsonElement);
-            if (floatArray != null) {
-              properties.add(PropertyFactory.iconOffset(floatArray));
-            } else {
-              properties.add(PropertyFactory.iconOffset(expression));
-            }
+          if (value instanceof double[]) {
+            properties.add(PropertyFactory.iconOffset(toFloatArray((double[]) value)));
           } else {
-            properties.add(PropertyFactory.iconOffset(expression));
+            properties.add(PropertyFactory.iconOffset(toExpression(value)));
           }
           break;
         case "icon-anchor":
-          properties.add(PropertyFactory.iconAnchor(expression));
+          properties.add(PropertyFactory.iconAnchor(toExpression(value)));
           break;
         case "icon-pitch-alignment":
-          properties.add(PropertyFactory.iconPitchAlignment(expression));
+          properties.add(PropertyFactory.iconPitchAlignment(toExpression(value)));
           break;
         case "text-pitch-alignment":
-          properties.add(PropertyFactory.textPitchAlignment(expression));
+          properties.add(PropertyFactory.textPitchAlignment(toExpression(value)));
           break;
         case "text-rotation-alignment":
-          properties.add(PropertyFactory.textRotationAlignment(expression));
+          properties.add(PropertyFactory.textRotationAlignment(toExpression(value)));
           break;
         case "text-field":
-          properties.add(PropertyFactory.textField(expression));
+          properties.add(PropertyFactory.textField(toExpression(value)));
           break;
         case "text-font":
-          properties.add(PropertyFactory.textFont(expression));
+          properties.add(PropertyFactory.textFont(toExpression(value)));
           break;
         case "text-size":
-          properties.add(PropertyFactory.textSize(expression));
+          properties.add(PropertyFactory.textSize(toExpression(value)));
           break;
         case "text-max-width":
-          properties.add(PropertyFactory.textMaxWidth(expression));
+          properties.add(PropertyFactory.textMaxWidth(toExpression(value)));
           break;
         case "text-line-height":
-          properties.add(PropertyFactory.textLineHeight(expression));
+          properties.add(PropertyFactory.textLineHeight(toExpression(value)));
           break;
         case "text-letter-spacing":
-          properties.add(PropertyFactory.textLetterSpacing(expression));
+          properties.add(PropertyFactory.textLetterSpacing(toExpression(value)));
           break;
         case "text-justify":
-          properties.add(PropertyFactory.textJustify(expression));
+          properties.add(PropertyFactory.textJustify(toExpression(value)));
           break;
         case "text-radial-offset":
-          properties.add(PropertyFactory.textRadialOffset(expression));
+          properties.add(PropertyFactory.textRadialOffset(toExpression(value)));
           break;
         case "text-variable-anchor":
-          properties.add(PropertyFactory.textVariableAnchor(expression));
+          properties.add(PropertyFactory.textVariableAnchor(toExpression(value)));
           break;
         case "text-anchor":
-          properties.add(PropertyFactory.textAnchor(expression));
+          properties.add(PropertyFactory.textAnchor(toExpression(value)));
           break;
         case "text-max-angle":
-          properties.add(PropertyFactory.textMaxAngle(expression));
+          properties.add(PropertyFactory.textMaxAngle(toExpression(value)));
           break;
         case "text-writing-mode":
-          properties.add(PropertyFactory.textWritingMode(expression));
+          properties.add(PropertyFactory.textWritingMode(toExpression(value)));
           break;
         case "text-rotate":
-          properties.add(PropertyFactory.textRotate(expression));
+          properties.add(PropertyFactory.textRotate(toExpression(value)));
           break;
         case "text-padding":
-          properties.add(PropertyFactory.textPadding(expression));
+          properties.add(PropertyFactory.textPadding(toExpression(value)));
           break;
         case "text-keep-upright":
-          properties.add(PropertyFactory.textKeepUpright(expression));
+          properties.add(PropertyFactory.textKeepUpright(toExpression(value)));
           break;
         case "text-transform":
-          properties.add(PropertyFactory.textTransform(expression));
+          properties.add(PropertyFactory.textTransform(toExpression(value)));
           break;
         case "text-offset":
-          if (jsonElement.isJsonArray()) {
-            final Float[] floatArray = convertJsonToFloatArray(jsonElement);
-            if (floatArray != null) {
-              properties.add(PropertyFactory.textOffset(floatArray));
-            } else {
-              properties.add(PropertyFactory.textOffset(expression));
-            }
+          if (value instanceof double[]) {
+            properties.add(PropertyFactory.textOffset(toFloatArray((double[]) value)));
           } else {
-            properties.add(PropertyFactory.textOffset(expression));
+            properties.add(PropertyFactory.textOffset(toExpression(value)));
           }
           break;
         case "text-allow-overlap":
-          properties.add(PropertyFactory.textAllowOverlap(expression));
+          properties.add(PropertyFactory.textAllowOverlap(toExpression(value)));
           break;
         case "text-ignore-placement":
-          properties.add(PropertyFactory.textIgnorePlacement(expression));
+          properties.add(PropertyFactory.textIgnorePlacement(toExpression(value)));
           break;
         case "text-optional":
-          properties.add(PropertyFactory.textOptional(expression));
+          properties.add(PropertyFactory.textOptional(toExpression(value)));
           break;
         case "visibility":
-          properties.add(PropertyFactory.visibility(entry.getValue().substring(1, entry.getValue().length() - 1)));
+          properties.add(PropertyFactory.visibility((String) value));
           break;
         default:
           break;
@@ -254,61 +228,54 @@ class LayerPropertyConverter {
   }
 
   static PropertyValue[] interpretCircleLayerProperties(Object o) {
-    final Map<String, String> data = (Map<String, String>) toMap(o);
-    final List<PropertyValue> properties = new LinkedList();
-    final JsonParser parser = new JsonParser();
+    final Map<String, Object> data = (Map<String, Object>) toMap(o);
+    final List<PropertyValue> properties = new ArrayList<>(data.size());
 
-    for (Map.Entry<String, String> entry : data.entrySet()) {
-      final JsonElement jsonElement = parser.parse(entry.getValue());
-      Expression expression = Expression.Converter.convert(jsonElement);
+    for (Map.Entry<String, Object> entry : data.entrySet()) {
+      final Object value = entry.getValue();
       switch (entry.getKey()) {
         case "circle-radius":
-          properties.add(PropertyFactory.circleRadius(expression));
+          properties.add(PropertyFactory.circleRadius(toExpression(value)));
           break;
         case "circle-color":
-          properties.add(PropertyFactory.circleColor(expression));
+          properties.add(PropertyFactory.circleColor(toExpression(value)));
           break;
         case "circle-blur":
-          properties.add(PropertyFactory.circleBlur(expression));
+          properties.add(PropertyFactory.circleBlur(toExpression(value)));
           break;
         case "circle-opacity":
-          properties.add(PropertyFactory.circleOpacity(expression));
+          properties.add(PropertyFactory.circleOpacity(toExpression(value)));
           break;
         case "circle-translate":
-          if (jsonElement.isJsonArray()) {
-            final Float[] floatArray = convertJsonToFloatArray(jsonElement);
-            if (floatArray != null) {
-              properties.add(PropertyFactory.circleTranslate(floatArray));
-            } else {
-              properties.add(PropertyFactory.circleTranslate(expression));
-            }
+          if (value instanceof double[]) {
+            properties.add(PropertyFactory.circleTranslate(toFloatArray((double[]) value)));
           } else {
-            properties.add(PropertyFactory.circleTranslate(expression));
+            properties.add(PropertyFactory.circleTranslate(toExpression(value)));
           }
           break;
         case "circle-translate-anchor":
-          properties.add(PropertyFactory.circleTranslateAnchor(expression));
+          properties.add(PropertyFactory.circleTranslateAnchor(toExpression(value)));
           break;
         case "circle-pitch-scale":
-          properties.add(PropertyFactory.circlePitchScale(expression));
+          properties.add(PropertyFactory.circlePitchScale(toExpression(value)));
           break;
         case "circle-pitch-alignment":
-          properties.add(PropertyFactory.circlePitchAlignment(expression));
+          properties.add(PropertyFactory.circlePitchAlignment(toExpression(value)));
           break;
         case "circle-stroke-width":
-          properties.add(PropertyFactory.circleStrokeWidth(expression));
+          properties.add(PropertyFactory.circleStrokeWidth(toExpression(value)));
           break;
         case "circle-stroke-color":
-          properties.add(PropertyFactory.circleStrokeColor(expression));
+          properties.add(PropertyFactory.circleStrokeColor(toExpression(value)));
           break;
         case "circle-stroke-opacity":
-          properties.add(PropertyFactory.circleStrokeOpacity(expression));
+          properties.add(PropertyFactory.circleStrokeOpacity(toExpression(value)));
           break;
         case "circle-sort-key":
-          properties.add(PropertyFactory.circleSortKey(expression));
+          properties.add(PropertyFactory.circleSortKey(toExpression(value)));
           break;
         case "visibility":
-          properties.add(PropertyFactory.visibility(entry.getValue().substring(1, entry.getValue().length() - 1)));
+          properties.add(PropertyFactory.visibility((String) value));
           break;
         default:
           break;
@@ -319,82 +286,70 @@ class LayerPropertyConverter {
   }
 
   static PropertyValue[] interpretLineLayerProperties(Object o) {
-    final Map<String, String> data = (Map<String, String>) toMap(o);
-    final List<PropertyValue> properties = new LinkedList();
-    final JsonParser parser = new JsonParser();
+    final Map<String, Object> data = (Map<String, Object>) toMap(o);
+    final List<PropertyValue> properties = new ArrayList<>(data.size());
 
-    for (Map.Entry<String, String> entry : data.entrySet()) {
-      final JsonElement jsonElement = parser.parse(entry.getValue());
-      Expression expression = Expression.Converter.convert(jsonElement);
+    for (Map.Entry<String, Object> entry : data.entrySet()) {
+      final Object value = entry.getValue();
       switch (entry.getKey()) {
         case "line-opacity":
-          properties.add(PropertyFactory.lineOpacity(expression));
+          properties.add(PropertyFactory.lineOpacity(toExpression(value)));
           break;
         case "line-color":
-          properties.add(PropertyFactory.lineColor(expression));
+          properties.add(PropertyFactory.lineColor(toExpression(value)));
           break;
         case "line-translate":
-          if (jsonElement.isJsonArray()) {
-            final Float[] floatArray = convertJsonToFloatArray(jsonElement);
-            if (floatArray != null) {
-              properties.add(PropertyFactory.lineTranslate(floatArray));
-            } else {
-              properties.add(PropertyFactory.lineTranslate(expression));
-            }
+          if (value instanceof double[]) {
+            properties.add(PropertyFactory.lineTranslate(toFloatArray((double[]) value)));
           } else {
-            properties.add(PropertyFactory.lineTranslate(expression));
+            properties.add(PropertyFactory.lineTranslate(toExpression(value)));
           }
           break;
         case "line-translate-anchor":
-          properties.add(PropertyFactory.lineTranslateAnchor(expression));
+          properties.add(PropertyFactory.lineTranslateAnchor(toExpression(value)));
           break;
         case "line-width":
-          properties.add(PropertyFactory.lineWidth(expression));
+          properties.add(PropertyFactory.lineWidth(toExpression(value)));
           break;
         case "line-gap-width":
-          properties.add(PropertyFactory.lineGapWidth(expression));
+          properties.add(PropertyFactory.lineGapWidth(toExpression(value)));
           break;
         case "line-offset":
-          properties.add(PropertyFactory.lineOffset(expression));
+          properties.add(PropertyFactory.lineOffset(toExpression(value)));
           break;
         case "line-blur":
-          properties.add(PropertyFactory.lineBlur(expression));
+          properties.add(PropertyFactory.lineBlur(toExpression(value)));
           break;
         case "line-dasharray":
-          if (jsonElement.isJsonArray()) {
-            final Float[] floatArray = convertJsonToFloatArray(jsonElement);
-            if (floatArray != null) {
-              properties.add(PropertyFactory.lineDasharray(floatArray));
-            } else {
-              properties.add(PropertyFactory.lineDasharray(expression));
-            }
+          if (value instanceof double[]) {
+            properties.add(PropertyFactory.lineDasharray(toFloatArray((double[]) value)));
           } else {
-            properties.add(PropertyFactory.lineDasharray(expression));
+            properties.add(PropertyFactory.lineDasharray(toExpression(value)));
           }
           break;
         case "line-pattern":
-          properties.add(PropertyFactory.linePattern(expression));
+          properties.add(PropertyFactory.linePattern(toExpression(value)));
           break;
         case "line-gradient":
-          properties.add(PropertyFactory.lineGradient(expression));
+          properties.add(PropertyFactory.lineGradient(toExpression(value)));
           break;
         case "line-cap":
-          properties.add(PropertyFactory.lineCap(expression));
+          properties.add(PropertyFactory.lineCap(toExpression(value)));
           break;
         case "line-join":
-          properties.add(PropertyFactory.lineJoin(expression));
+          properties.add(PropertyFactory.lineJoin(toExpression(value)));
           break;
         case "line-miter-limit":
-          properties.add(PropertyFactory.lineMiterLimit(expression));
+          properties.add(PropertyFactory.lineMiterLimit(toExpression(value)));
           break;
         case "line-round-limit":
-          properties.add(PropertyFactory.lineRoundLimit(expression));
+          properties.add(PropertyFactory.lineRoundLimit(toExpression(value)));
           break;
         case "line-sort-key":
-          properties.add(PropertyFactory.lineSortKey(expression));
+          properties.add(PropertyFactory.lineSortKey(toExpression(value)));
           break;
         case "visibility":
-          properties.add(PropertyFactory.visibility(entry.getValue().substring(1, entry.getValue().length() - 1)));
+          properties.add(PropertyFactory.visibility((String) value));
           break;
         default:
           break;
@@ -405,49 +360,42 @@ class LayerPropertyConverter {
   }
 
   static PropertyValue[] interpretFillLayerProperties(Object o) {
-    final Map<String, String> data = (Map<String, String>) toMap(o);
-    final List<PropertyValue> properties = new LinkedList();
-    final JsonParser parser = new JsonParser();
+    final Map<String, Object> data = (Map<String, Object>) toMap(o);
+    final List<PropertyValue> properties = new ArrayList<>(data.size());
 
-    for (Map.Entry<String, String> entry : data.entrySet()) {
-      final JsonElement jsonElement = parser.parse(entry.getValue());
-      Expression expression = Expression.Converter.convert(jsonElement);
+    for (Map.Entry<String, Object> entry : data.entrySet()) {
+      final Object value = entry.getValue();
       switch (entry.getKey()) {
         case "fill-antialias":
-          properties.add(PropertyFactory.fillAntialias(expression));
+          properties.add(PropertyFactory.fillAntialias(toExpression(value)));
           break;
         case "fill-opacity":
-          properties.add(PropertyFactory.fillOpacity(expression));
+          properties.add(PropertyFactory.fillOpacity(toExpression(value)));
           break;
         case "fill-color":
-          properties.add(PropertyFactory.fillColor(expression));
+          properties.add(PropertyFactory.fillColor(toExpression(value)));
           break;
         case "fill-outline-color":
-          properties.add(PropertyFactory.fillOutlineColor(expression));
+          properties.add(PropertyFactory.fillOutlineColor(toExpression(value)));
           break;
         case "fill-translate":
-          if (jsonElement.isJsonArray()) {
-            final Float[] floatArray = convertJsonToFloatArray(jsonElement);
-            if (floatArray != null) {
-              properties.add(PropertyFactory.fillTranslate(floatArray));
-            } else {
-              properties.add(PropertyFactory.fillTranslate(expression));
-            }
+          if (value instanceof double[]) {
+            properties.add(PropertyFactory.fillTranslate(toFloatArray((double[]) value)));
           } else {
-            properties.add(PropertyFactory.fillTranslate(expression));
+            properties.add(PropertyFactory.fillTranslate(toExpression(value)));
           }
           break;
         case "fill-translate-anchor":
-          properties.add(PropertyFactory.fillTranslateAnchor(expression));
+          properties.add(PropertyFactory.fillTranslateAnchor(toExpression(value)));
           break;
         case "fill-pattern":
-          properties.add(PropertyFactory.fillPattern(expression));
+          properties.add(PropertyFactory.fillPattern(toExpression(value)));
           break;
         case "fill-sort-key":
-          properties.add(PropertyFactory.fillSortKey(expression));
+          properties.add(PropertyFactory.fillSortKey(toExpression(value)));
           break;
         case "visibility":
-          properties.add(PropertyFactory.visibility(entry.getValue().substring(1, entry.getValue().length() - 1)));
+          properties.add(PropertyFactory.visibility((String) value));
           break;
         default:
           break;
@@ -458,49 +406,42 @@ class LayerPropertyConverter {
   }
 
   static PropertyValue[] interpretFillExtrusionLayerProperties(Object o) {
-    final Map<String, String> data = (Map<String, String>) toMap(o);
-    final List<PropertyValue> properties = new LinkedList();
-    final JsonParser parser = new JsonParser();
+    final Map<String, Object> data = (Map<String, Object>) toMap(o);
+    final List<PropertyValue> properties = new ArrayList<>(data.size());
 
-    for (Map.Entry<String, String> entry : data.entrySet()) {
-      final JsonElement jsonElement = parser.parse(entry.getValue());
-      Expression expression = Expression.Converter.convert(jsonElement);
+    for (Map.Entry<String, Object> entry : data.entrySet()) {
+      final Object value = entry.getValue();
       switch (entry.getKey()) {
         case "fill-extrusion-opacity":
-          properties.add(PropertyFactory.fillExtrusionOpacity(expression));
+          properties.add(PropertyFactory.fillExtrusionOpacity(toExpression(value)));
           break;
         case "fill-extrusion-color":
-          properties.add(PropertyFactory.fillExtrusionColor(expression));
+          properties.add(PropertyFactory.fillExtrusionColor(toExpression(value)));
           break;
         case "fill-extrusion-translate":
-          if (jsonElement.isJsonArray()) {
-            final Float[] floatArray = convertJsonToFloatArray(jsonElement);
-            if (floatArray != null) {
-              properties.add(PropertyFactory.fillExtrusionTranslate(floatArray));
-            } else {
-              properties.add(PropertyFactory.fillExtrusionTranslate(expression));
-            }
+          if (value instanceof double[]) {
+            properties.add(PropertyFactory.fillExtrusionTranslate(toFloatArray((double[]) value)));
           } else {
-            properties.add(PropertyFactory.fillExtrusionTranslate(expression));
+            properties.add(PropertyFactory.fillExtrusionTranslate(toExpression(value)));
           }
           break;
         case "fill-extrusion-translate-anchor":
-          properties.add(PropertyFactory.fillExtrusionTranslateAnchor(expression));
+          properties.add(PropertyFactory.fillExtrusionTranslateAnchor(toExpression(value)));
           break;
         case "fill-extrusion-pattern":
-          properties.add(PropertyFactory.fillExtrusionPattern(expression));
+          properties.add(PropertyFactory.fillExtrusionPattern(toExpression(value)));
           break;
         case "fill-extrusion-height":
-          properties.add(PropertyFactory.fillExtrusionHeight(expression));
+          properties.add(PropertyFactory.fillExtrusionHeight(toExpression(value)));
           break;
         case "fill-extrusion-base":
-          properties.add(PropertyFactory.fillExtrusionBase(expression));
+          properties.add(PropertyFactory.fillExtrusionBase(toExpression(value)));
           break;
         case "fill-extrusion-vertical-gradient":
-          properties.add(PropertyFactory.fillExtrusionVerticalGradient(expression));
+          properties.add(PropertyFactory.fillExtrusionVerticalGradient(toExpression(value)));
           break;
         case "visibility":
-          properties.add(PropertyFactory.visibility(entry.getValue().substring(1, entry.getValue().length() - 1)));
+          properties.add(PropertyFactory.visibility((String) value));
           break;
         default:
           break;
@@ -511,40 +452,38 @@ class LayerPropertyConverter {
   }
 
   static PropertyValue[] interpretRasterLayerProperties(Object o) {
-    final Map<String, String> data = (Map<String, String>) toMap(o);
-    final List<PropertyValue> properties = new LinkedList();
-    final JsonParser parser = new JsonParser();
+    final Map<String, Object> data = (Map<String, Object>) toMap(o);
+    final List<PropertyValue> properties = new ArrayList<>(data.size());
 
-    for (Map.Entry<String, String> entry : data.entrySet()) {
-      final JsonElement jsonElement = parser.parse(entry.getValue());
-      Expression expression = Expression.Converter.convert(jsonElement);
+    for (Map.Entry<String, Object> entry : data.entrySet()) {
+      final Object value = entry.getValue();
       switch (entry.getKey()) {
         case "raster-opacity":
-          properties.add(PropertyFactory.rasterOpacity(expression));
+          properties.add(PropertyFactory.rasterOpacity(toExpression(value)));
           break;
         case "raster-hue-rotate":
-          properties.add(PropertyFactory.rasterHueRotate(expression));
+          properties.add(PropertyFactory.rasterHueRotate(toExpression(value)));
           break;
         case "raster-brightness-min":
-          properties.add(PropertyFactory.rasterBrightnessMin(expression));
+          properties.add(PropertyFactory.rasterBrightnessMin(toExpression(value)));
           break;
         case "raster-brightness-max":
-          properties.add(PropertyFactory.rasterBrightnessMax(expression));
+          properties.add(PropertyFactory.rasterBrightnessMax(toExpression(value)));
           break;
         case "raster-saturation":
-          properties.add(PropertyFactory.rasterSaturation(expression));
+          properties.add(PropertyFactory.rasterSaturation(toExpression(value)));
           break;
         case "raster-contrast":
-          properties.add(PropertyFactory.rasterContrast(expression));
+          properties.add(PropertyFactory.rasterContrast(toExpression(value)));
           break;
         case "raster-resampling":
-          properties.add(PropertyFactory.rasterResampling(expression));
+          properties.add(PropertyFactory.rasterResampling(toExpression(value)));
           break;
         case "raster-fade-duration":
-          properties.add(PropertyFactory.rasterFadeDuration(expression));
+          properties.add(PropertyFactory.rasterFadeDuration(toExpression(value)));
           break;
         case "visibility":
-          properties.add(PropertyFactory.visibility(entry.getValue().substring(1, entry.getValue().length() - 1)));
+          properties.add(PropertyFactory.visibility((String) value));
           break;
         default:
           break;
@@ -555,34 +494,32 @@ class LayerPropertyConverter {
   }
 
   static PropertyValue[] interpretHillshadeLayerProperties(Object o) {
-    final Map<String, String> data = (Map<String, String>) toMap(o);
-    final List<PropertyValue> properties = new LinkedList();
-    final JsonParser parser = new JsonParser();
+    final Map<String, Object> data = (Map<String, Object>) toMap(o);
+    final List<PropertyValue> properties = new ArrayList<>(data.size());
 
-    for (Map.Entry<String, String> entry : data.entrySet()) {
-      final JsonElement jsonElement = parser.parse(entry.getValue());
-      Expression expression = Expression.Converter.convert(jsonElement);
+    for (Map.Entry<String, Object> entry : data.entrySet()) {
+      final Object value = entry.getValue();
       switch (entry.getKey()) {
         case "hillshade-illumination-direction":
-          properties.add(PropertyFactory.hillshadeIlluminationDirection(expression));
+          properties.add(PropertyFactory.hillshadeIlluminationDirection(toExpression(value)));
           break;
         case "hillshade-illumination-anchor":
-          properties.add(PropertyFactory.hillshadeIlluminationAnchor(expression));
+          properties.add(PropertyFactory.hillshadeIlluminationAnchor(toExpression(value)));
           break;
         case "hillshade-exaggeration":
-          properties.add(PropertyFactory.hillshadeExaggeration(expression));
+          properties.add(PropertyFactory.hillshadeExaggeration(toExpression(value)));
           break;
         case "hillshade-shadow-color":
-          properties.add(PropertyFactory.hillshadeShadowColor(expression));
+          properties.add(PropertyFactory.hillshadeShadowColor(toExpression(value)));
           break;
         case "hillshade-highlight-color":
-          properties.add(PropertyFactory.hillshadeHighlightColor(expression));
+          properties.add(PropertyFactory.hillshadeHighlightColor(toExpression(value)));
           break;
         case "hillshade-accent-color":
-          properties.add(PropertyFactory.hillshadeAccentColor(expression));
+          properties.add(PropertyFactory.hillshadeAccentColor(toExpression(value)));
           break;
         case "visibility":
-          properties.add(PropertyFactory.visibility(entry.getValue().substring(1, entry.getValue().length() - 1)));
+          properties.add(PropertyFactory.visibility((String) value));
           break;
         default:
           break;
@@ -593,31 +530,29 @@ class LayerPropertyConverter {
   }
 
   static PropertyValue[] interpretHeatmapLayerProperties(Object o) {
-    final Map<String, String> data = (Map<String, String>) toMap(o);
-    final List<PropertyValue> properties = new LinkedList();
-    final JsonParser parser = new JsonParser();
+    final Map<String, Object> data = (Map<String, Object>) toMap(o);
+    final List<PropertyValue> properties = new ArrayList<>(data.size());
 
-    for (Map.Entry<String, String> entry : data.entrySet()) {
-      final JsonElement jsonElement = parser.parse(entry.getValue());
-      Expression expression = Expression.Converter.convert(jsonElement);
+    for (Map.Entry<String, Object> entry : data.entrySet()) {
+      final Object value = entry.getValue();
       switch (entry.getKey()) {
         case "heatmap-radius":
-          properties.add(PropertyFactory.heatmapRadius(expression));
+          properties.add(PropertyFactory.heatmapRadius(toExpression(value)));
           break;
         case "heatmap-weight":
-          properties.add(PropertyFactory.heatmapWeight(expression));
+          properties.add(PropertyFactory.heatmapWeight(toExpression(value)));
           break;
         case "heatmap-intensity":
-          properties.add(PropertyFactory.heatmapIntensity(expression));
+          properties.add(PropertyFactory.heatmapIntensity(toExpression(value)));
           break;
         case "heatmap-color":
-          properties.add(PropertyFactory.heatmapColor(expression));
+          properties.add(PropertyFactory.heatmapColor(toExpression(value)));
           break;
         case "heatmap-opacity":
-          properties.add(PropertyFactory.heatmapOpacity(expression));
+          properties.add(PropertyFactory.heatmapOpacity(toExpression(value)));
           break;
         case "visibility":
-          properties.add(PropertyFactory.visibility(entry.getValue().substring(1, entry.getValue().length() - 1)));
+          properties.add(PropertyFactory.visibility((String) value));
           break;
         default:
           break;
@@ -627,21 +562,57 @@ class LayerPropertyConverter {
     return properties.toArray(new PropertyValue[properties.size()]);
   }
 
-  private static boolean isNumber(JsonElement element) {
-    return element.isJsonPrimitive() && element.getAsJsonPrimitive().isNumber();
+  /**
+   * Literal numbers, booleans, strings and number arrays are wrapped without any json
+   * round trip, only nested lists and maps are converted as expressions.
+   */
+  private static Expression toExpression(Object value) {
+    if (value instanceof Number) {
+      return Expression.literal((Number) value);
+    } else if (value instanceof Boolean) {
+      return Expression.literal((boolean) value);
+    } else if (value instanceof String) {
+      return Expression.literal((String) value);
+    } else if (value instanceof double[]) {
+      return Expression.literal(toFloatArray((double[]) value));
+    }
+    return Expression.Converter.convert(toJsonElement(value));
   }
 
-  private static Float[] convertJsonToFloatArray(JsonElement jsonElement) {
-    final JsonArray jsonArray = jsonElement.getAsJsonArray();
-    Float[] floatArray = new Float[jsonArray.size()];
-
-    for (int i = 0; i < jsonArray.size(); i++) {
-      if (jsonArray.get(i).isJsonPrimitive() && jsonArray.get(i).getAsJsonPrimitive().isNumber()) {
-        floatArray[i] = jsonArray.get(i).getAsFloat();
-      } else {
-        return null;
+  private static JsonElement toJsonElement(Object value) {
+    if (value instanceof List) {
+      final JsonArray jsonArray = new JsonArray();
+      for (Object item : (List<?>) value) {
+        jsonArray.add(toJsonElement(item));
+      }
+      return jsonArray;
+    } else if (value instanceof Map) {
+      final JsonObject jsonObject = new JsonObject();
+      for (Map.Entry<?, ?> entry : ((Map<?, ?>) value).entrySet()) {
+        jsonObject.add(String.valueOf(entry.getKey()), toJsonElement(entry.getValue()));
+      }
+      return jsonObject;
+    } else if (value instanceof double[]) {
+      final JsonArray jsonArray = new JsonArray();
+      for (double item : (double[]) value) {
+        jsonArray.add(item);
       }
+      return jsonArray;
+    } else if (value instanceof Number) {
+      return new JsonPrimitive((Number) value);
+    } else if (value instanceof Boolean) {
+      return new JsonPrimitive((Boolean) value);
+    } else if (value instanceof String) {
+      return new JsonPrimitive((String) value);
+    }
+    return JsonNull.INSTANCE;
+  }
+
+  private static Float[] toFloatArray(double[] values) {
+    final Float[] floatArray = new Float[values.length];
+    for (int i = 0; i < values.length; i++) {
+      floatArray[i] = (float) values[i];
     }
     return floatArray;
   }
-}
\ No newline at end of file
+}
@@ -1,43 +1,220 @@
 package org.maplibre.maplibregl;
 
+import android.content.Context;
+import android.util.Log;
 import org.maplibre.android.module.http.HttpRequestUtil;
 import io.flutter.plugin.common.MethodChannel;
+import java.io.File;
+import java.io.IOException;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.HashMap;
 import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.TimeUnit;
+import okhttp3.Cache;
+import okhttp3.ConnectionPool;
+import okhttp3.Dispatcher;
+import okhttp3.Interceptor;
 import okhttp3.OkHttpClient;
+import okhttp3.Protocol;
 import okhttp3.Request;
+import okhttp3.Response;
 
+/**
+ * The OkHttp client MapLibre fetches styles, tiles, glyphs and sprites with.
+ *
+ * <p>The client is only rebuilt when the network configuration changes. It reads the headers on
+ * each request, so setting headers, e.g. after a token refresh, keeps the connection pool and its
+ * open connections. The client also records the requests, cache hits and latency per host, and
+ * per source with {@link TileRequestStatistics}.
+ */
 abstract class MapLibreHttpRequestUtil {
+  private static final String TAG = MapLibreHttpRequestUtil.class.getSimpleName();
+  private static final String CACHE_DIRECTORY = "maplibre_http_cache";
 
-  public static void setHttpHeaders(Map<String, String> headers, MethodChannel.Result result) {
-    HttpRequestUtil.setOkHttpClient(getOkHttpClient(headers, result).build());
-    result.success(null);
+  private static volatile Map<String, String> headers = Collections.emptyMap();
+  private static final Map<String, HostStatistics> statistics = new ConcurrentHashMap<>();
+  private static OkHttpClient client;
+  private static Cache cache;
+
+  /** Installs the client with the default configuration, unless a client is installed. */
+  static synchronized void ensureClient() {
+    if (client == null) {
+      Dispatcher dispatcher = new Dispatcher();
+      // the default of MapLibre, OkHttp allows only 5 requests per host
+      dispatcher.setMaxRequestsPerHost(20);
+      install(defaultClient().dispatcher(dispatcher).build());
+    }
   }
 
-  private static OkHttpClient.Builder getOkHttpClient(
-      Map<String, String> headers, MethodChannel.Result result) {
+  public static void setHttpHeaders(Map<String, String> headers, MethodChannel.Result result) {
+    MapLibreHttpRequestUtil.headers = new HashMap<>(headers);
     try {
-      return new OkHttpClient.Builder()
-          .addNetworkInterceptor(
-              chain -> {
-                Request.Builder builder = chain.request().newBuilder();
-                for (Map.Entry<String, String> header : headers.entrySet()) {
-                  if (header.getKey() == null || header.getKey().trim().isEmpty()) {
-                    continue;
-                  }
-                  if (header.getValue() == null || header.getValue().trim().isEmpty()) {
-                    builder.removeHeader(header.getKey());
-                  } else {
-                    builder.header(header.getKey(), header.getValue());
-                  }
-                }
-                return chain.proceed(builder.build());
-              });
+      ensureClient();
+      result.success(null);
     } catch (Exception e) {
       result.error(
           "OK_HTTP_CLIENT_ERROR",
-          "An unexcepted error happened during creating http " + "client" + e.getMessage(),
+          "An unexcepted error happened during creating http client" + e.getMessage(),
           null);
-      throw new RuntimeException(e);
+    }
+  }
+
+  /** Rebuilds the client from the configuration sent by {@code setNetworkConfiguration}. */
+  static synchronized void setNetworkConfiguration(
+      Context context, Map<String, Object> configuration, MethodChannel.Result result) {
+    try {
+      Dispatcher dispatcher = new Dispatcher();
+      dispatcher.setMaxRequests(intOf(configuration, "maxRequests"));
+      dispatcher.setMaxRequestsPerHost(intOf(configuration, "maxRequestsPerHost"));
+
+      OkHttpClient.Builder builder =
+          defaultClient()
+              .dispatcher(dispatcher)
+              .connectionPool(
+                  new ConnectionPool(
+                      intOf(configuration, "maxIdleConnections"),
+                      longOf(configuration, "keepAlive"),
+                      TimeUnit.MILLISECONDS))
+              .connectTimeout(longOf(configuration, "connectTimeout"), TimeUnit.MILLISECONDS)
+              .readTimeout(longOf(configuration, "readTimeout"), TimeUnit.MILLISECONDS)
+              .protocols(
+                  Boolean.TRUE.equals(configuration.get("preferHttp2"))
+                      ? Arrays.asList(Protocol.HTTP_2, Protocol.HTTP_1_1)
+                      : Collections.singletonList(Protocol.HTTP_1_1));
+
+      long diskCacheSize = longOf(configuration, "diskCacheSize");
+      if (cache != null && cache.maxSize() != diskCacheSize) {
+        closeCache();
+      }
+      if (diskCacheSize > 0) {
+        if (cache == null) {
+          cache = new Cache(new File(context.getCacheDir(), CACHE_DIRECTORY), diskCacheSize);
+        }
+        builder.cache(cache);
+      }
+
+      OkHttpClient previous = client;
+      install(builder.build());
+      if (previous != null) {
+        // let running requests finish, but close the idle connections of the old pool
+        previous.connectionPool().evictAll();
+      }
+      result.success(null);
+    } catch (Exception e) {
+      result.error("OK_HTTP_CLIENT_ERROR", "Could not configure the http client: " + e, null);
+    }
+  }
+
+  /** The statistics per host since the last reset, see {@link HostStatistics#toMap()}. */
+  static Map<String, Object> getNetworkStatistics(boolean reset) {
+    Map<String, Object> result = new HashMap<>();
+    for (Map.Entry<String, HostStatistics> entry : statistics.entrySet()) {
+      result.put(entry.getKey(), entry.getValue().toMap());
+    }
+    if (reset) {
+      statistics.clear();
+    }
+    return result;
+  }
+
+  private static synchronized void install(OkHttpClient client) {
+    MapLibreHttpRequestUtil.client = client;
+    HttpRequestUtil.setOkHttpClient(client);
+  }
+
+  private static OkHttpClient.Builder defaultClient() {
+    return new OkHttpClient.Builder()
+        .eventListenerFactory(TileRequestStatistics.FACTORY)
+        .addInterceptor(MapLibreHttpRequestUtil::recordStatistics)
+        .addNetworkInterceptor(MapLibreHttpRequestUtil::addHeaders);
+  }
+
+  private static Response addHeaders(Interceptor.Chain chain) throws IOException {
+    Request.Builder builder = chain.request().newBuilder();
+    for (Map.Entry<String, String> header : headers.entrySet()) {
+      if (header.getKey() == null || header.getKey().trim().isEmpty()) {
+        continue;
+      }
+      if (header.getValue() == null || header.getValue().trim().isEmpty()) {
+        builder.removeHeader(header.getKey());
+      } else {
+        builder.header(header.getKey(), header.getValue());
+      }
+    }
+    return chain.proceed(builder.build());
+  }
+
+  private static Response recordStatistics(Interceptor.Chain chain) throws IOException {
+    String hostName = chain.request().url().host();
+    HostStatistics host = statistics.get(hostName);
+    if (host == null) {
+      // a reset may clear the map in between, so the entry is not looked up again
+      HostStatistics created = new HostStatistics();
+      HostStatistics existing = statistics.putIfAbsent(hostName, created);
+      host = existing != null ? existing : created;
+    }
+    long start = System.nanoTime();
+    try {
+      Response response = chain.proceed(chain.request());
+      host.record(
+          TimeUnit.NANOSECONDS.toMillis(System.nanoTime() - start),
+          response.isSuccessful() || response.code() == 304,
+          response.cacheResponse() != null && response.networkResponse() == null,
+          response.networkResponse() != null && response.networkResponse().code() == 304);
+      return response;
+    } catch (IOException e) {
+      host.record(TimeUnit.NANOSECONDS.toMillis(System.nanoTime() - start), false, false, false);
+      throw e;
+    }
+  }
+
+  private static void closeCache() {
+    try {
+      cache.close();
+    } catch (IOException e) {
+      Log.e(TAG, "Could not close the http cache", e);
+    }
+    cache = null;
+  }
+
+  private static int intOf(Map<String, Object> configuration, String key) {
+    return ((Number) configuration.get(key)).intValue();
+  }
+
+  private static long longOf(Map<String, Object> configuration, String key) {
+    return ((Number) configuration.get(key)).longValue();
+  }
+
+  /** The requests to a host, with their latency until the response headers arrived. */
+  private static final class HostStatistics {
+    private long requests;
+    private long failures;
+    private long cacheHits;
+    private long conditionalHits;
+    private long totalLatency;
+    private long maxLatency;
+
+    synchronized void record(
+        long latency, boolean isSuccessful, boolean isCacheHit, boolean isConditionalHit) {
+      requests++;
+      if (!isSuccessful) failures++;
+      if (isCacheHit) cacheHits++;
+      if (isConditionalHit) conditionalHits++;
+      totalLatency += latency;
+      maxLatency = Math.max(maxLatency, latency);
+    }
+
+    synchronized Map<String, Object> toMap() {
+      Map<String, Object> map = new HashMap<>();
+      map.put("requests", requests);
+      map.put("failures", failures);
+      map.put("cacheHits", cacheHits);
+      map.put("conditionalHits", conditionalHits);
+      map.put("totalLatency", totalLatency);
+      map.put("maxLatency", maxLatency);
+      return map;
     }
   }
 }
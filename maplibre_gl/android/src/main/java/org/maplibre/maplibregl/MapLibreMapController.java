@@ -31,6 +31,7 @@ import androidx.lifecycle.LifecycleOwner;
 import com.google.gson.Gson;
 import com.google.gson.JsonArray;
 import com.google.gson.JsonElement;
+import com.google.gson.JsonObject;
 import com.google.gson.JsonParser;
 
 import org.maplibre.android.gestures.AndroidGesturesManager;
@@ -88,11 +89,13 @@ import io.flutter.plugin.common.MethodChannel;
 import io.flutter.plugin.platform.PlatformView;
 import java.io.IOException;
 import java.io.InputStream;
+import java.nio.charset.StandardCharsets;
 import java.util.ArrayList;
 import java.util.Arrays;
 import java.util.Collections;
 import java.util.HashMap;
 import java.util.HashSet;
+import java.util.LinkedHashMap;
 import java.util.List;
 import java.util.Locale;
 import java.util.Map;
@@ -147,12 +150,24 @@ final class MapLibreMapController
   private Set<String> interactiveFeatureLayerIds;
   private Map<String, FeatureCollection> addedFeaturesByLayer;
 
+  /**
+   * Feature state by feature id by source id. MapLibre Android has no feature state support, the
+   * state is merged into the feature properties with the prefix {@link #FEATURE_STATE_PREFIX}.
+   */
+  private Map<String, Map<String, JsonObject>> featureStateBySource;
+
+  private static final String FEATURE_STATE_PREFIX = "feature-state:";
+
+  /** Sources of moving points by source id, see {@link MotionSource}. */
+  private final Map<String, MotionSource> motionSources = new HashMap<>();
+
   private LatLngBounds bounds = null;
   Style.OnStyleLoaded onStyleLoadedCallback =
       new Style.OnStyleLoaded() {
         @Override
         public void onStyleLoaded(@NonNull Style style) {
           MapLibreMapController.this.style = style;
+          stopMotionSources();
 
           // commented out while cherry-picking upstream956
           // if (myLocationEnabled) {
@@ -190,6 +205,7 @@ final class MapLibreMapController
     this.mapView = new MapView(context, options);
     this.interactiveFeatureLayerIds = new HashSet<>();
     this.addedFeaturesByLayer = new HashMap<String, FeatureCollection>();
+    this.featureStateBySource = new HashMap<String, Map<String, JsonObject>>();
     this.density = context.getResources().getDisplayMetrics().density;
     this.lifecycleProvider = lifecycleProvider;
     if (dragEnabled) {
@@ -381,6 +397,7 @@ final class MapLibreMapController
 
   private void addGeoJsonSource(String sourceName, String source) {
     FeatureCollection featureCollection = FeatureCollection.fromJson(source);
+    applyFeatureState(sourceName, featureCollection.features());
     GeoJsonSource geoJsonSource = new GeoJsonSource(sourceName, featureCollection);
     addedFeaturesByLayer.put(sourceName, featureCollection);
 
@@ -389,14 +406,42 @@ final class MapLibreMapController
 
   private void setGeoJsonSource(String sourceName, String geojson) {
     FeatureCollection featureCollection = FeatureCollection.fromJson(geojson);
+    applyFeatureState(sourceName, featureCollection.features());
     GeoJsonSource geoJsonSource = style.getSourceAs(sourceName);
     addedFeaturesByLayer.put(sourceName, featureCollection);
 
     geoJsonSource.setGeoJson(featureCollection);
   }
 
+  private void stopMotionSource(String sourceId) {
+    final MotionSource motionSource = motionSources.remove(sourceId);
+    if (motionSource != null) {
+      motionSource.stop();
+    }
+  }
+
+  /** Stops all motion sources, e.g. because their style was replaced. */
+  private void stopMotionSources() {
+    for (MotionSource motionSource : motionSources.values()) {
+      motionSource.stop();
+    }
+    motionSources.clear();
+  }
+
+  /**
+   * Reads a geojson argument. Large sources are encoded in a background isolate on the Dart side
+   * and sent as UTF-8 bytes instead of a string.
+   */
+  private static String geojsonArgument(Object argument) {
+    if (argument instanceof byte[]) {
+      return new String((byte[]) argument, StandardCharsets.UTF_8);
+    }
+    return (String) argument;
+  }
+
   private void setGeoJsonFeature(String sourceName, String geojsonFeature) {
     Feature feature = Feature.fromJson(geojsonFeature);
+    applyFeatureState(sourceName, Collections.singletonList(feature));
     FeatureCollection featureCollection = addedFeaturesByLayer.get(sourceName);
     GeoJsonSource geoJsonSource = style.getSourceAs(sourceName);
     if (featureCollection != null && geoJsonSource != null) {
@@ -413,6 +458,151 @@ final class MapLibreMapController
     }
   }
 
+  /**
+   * Replaces the features with the ids of the features in {@code geojson}, appends the others and
+   * removes the features with an id in {@code removeIds}, then sets the data of the source once.
+   */
+  private void updateGeoJsonSource(String sourceName, String geojson, List<Object> removeIds) {
+    final FeatureCollection featureCollection = addedFeaturesByLayer.get(sourceName);
+    final GeoJsonSource geoJsonSource = style.getSourceAs(sourceName);
+    if (featureCollection == null || geoJsonSource == null) {
+      throw new StyleOperationException(
+          "SOURCE_NOT_FOUND_ERROR", "Geojson source " + sourceName + " not found");
+    }
+    final List<Feature> added = FeatureCollection.fromJson(geojson).features();
+    applyFeatureState(sourceName, added);
+
+    final Set<String> removed = new HashSet<>();
+    if (removeIds != null) {
+      for (Object id : removeIds) {
+        removed.add(String.valueOf(id));
+      }
+    }
+    final Map<String, Feature> addedById = new LinkedHashMap<>();
+    final List<Feature> addedWithoutId = new ArrayList<>();
+    if (added != null) {
+      for (Feature feature : added) {
+        if (feature.id() != null) {
+          addedById.put(feature.id(), feature);
+        } else {
+          addedWithoutId.add(feature);
+        }
+      }
+    }
+
+    final List<Feature> features = new ArrayList<>();
+    for (Feature feature : featureCollection.features()) {
+      final String id = feature.id();
+      if (id == null) {
+        features.add(feature);
+      } else if (!removed.contains(id)) {
+        final Feature replacement = addedById.remove(id);
+        features.add(replacement != null ? replacement : feature);
+      }
+    }
+    features.addAll(addedById.values());
+    features.addAll(addedWithoutId);
+
+    final FeatureCollection updated = FeatureCollection.fromFeatures(features);
+    addedFeaturesByLayer.put(sourceName, updated);
+    geoJsonSource.setGeoJson(updated);
+  }
+
+  /**
+   * Merges the state into the feature with the given id, or removes the key (or the whole state if
+   * key is null) when state is null. A null featureId removes the state of all features. Returns
+   * false if the source is not a geojson source added by this controller.
+   */
+  private boolean updateFeatureState(
+      String sourceName, String featureId, Map<String, Object> state, String key) {
+    final FeatureCollection featureCollection = addedFeaturesByLayer.get(sourceName);
+    final GeoJsonSource geoJsonSource = style.getSourceAs(sourceName);
+    if (featureCollection == null || geoJsonSource == null) {
+      return false;
+    }
+
+    Map<String, JsonObject> states = featureStateBySource.get(sourceName);
+    if (states == null) {
+      states = new HashMap<>();
+      featureStateBySource.put(sourceName, states);
+    }
+    if (featureId == null) {
+      states.clear();
+    } else if (state != null) {
+      JsonObject featureState = states.get(featureId);
+      if (featureState == null) {
+        featureState = new JsonObject();
+        states.put(featureId, featureState);
+      }
+      for (Map.Entry<String, JsonElement> entry :
+          new Gson().toJsonTree(state).getAsJsonObject().entrySet()) {
+        featureState.add(entry.getKey(), entry.getValue());
+      }
+    } else if (key != null && states.containsKey(featureId)) {
+      states.get(featureId).remove(key);
+    } else {
+      states.remove(featureId);
+    }
+
+    final List<Feature> features = featureCollection.features();
+    if (featureId == null) {
+      for (Feature feature : features) {
+        applyFeatureState(feature, null);
+      }
+    } else {
+      for (Feature feature : features) {
+        if (featureId.equals(feature.id())) {
+          applyFeatureState(feature, states.get(featureId));
+        }
+      }
+    }
+    geoJsonSource.setGeoJson(featureCollection);
+    return true;
+  }
+
+  private void applyFeatureState(String sourceName, List<Feature> features) {
+    final Map<String, JsonObject> states = featureStateBySource.get(sourceName);
+    if (states == null || states.isEmpty() || features == null) {
+      return;
+    }
+    for (Feature feature : features) {
+      final JsonObject state = feature.id() != null ? states.get(feature.id()) : null;
+      if (state != null) {
+        applyFeatureState(feature, state);
+      }
+    }
+  }
+
+  /** A feature that identifies a cluster of a clustered geojson source by its id. */
+  private static Feature clusterFeature(long clusterId) {
+    final JsonObject properties = new JsonObject();
+    properties.addProperty("cluster", true);
+    properties.addProperty("cluster_id", clusterId);
+    return Feature.fromGeometry(null, properties);
+  }
+
+  /** Replaces the feature state properties of the feature with the given state. */
+  private static void applyFeatureState(Feature feature, JsonObject state) {
+    final JsonObject properties = feature.properties();
+    if (properties == null) {
+      return;
+    }
+    final List<String> staleKeys = new ArrayList<>();
+    for (String key : properties.keySet()) {
+      if (key.startsWith(FEATURE_STATE_PREFIX)) {
+        staleKeys.add(key);
+      }
+    }
+    for (String key : staleKeys) {
+      properties.remove(key);
+    }
+    if (state != null) {
+      for (Map.Entry<String, JsonElement> entry : state.entrySet()) {
+        properties.add(FEATURE_STATE_PREFIX + entry.getKey(), entry.getValue());
+      }
+    }
+  }
+
   private void addSymbolLayer(
       String layerName,
       String sourceName,
@@ -678,6 +868,245 @@ final class MapLibreMapController
     return null;
   }
 
+  /** Converts the properties for the given layer, returns null for unsupported layer types. */
+  private static PropertyValue[] interpretLayerProperties(
+      Layer layer, Map<String, Object> properties) {
+    if (layer instanceof LineLayer) {
+      return LayerPropertyConverter.interpretLineLayerProperties(properties);
+    } else if (layer instanceof FillLayer) {
+      return LayerPropertyConverter.interpretFillLayerProperties(properties);
+    } else if (layer instanceof CircleLayer) {
+      return LayerPropertyConverter.interpretCircleLayerProperties(properties);
+    } else if (layer instanceof SymbolLayer) {
+      return LayerPropertyConverter.interpretSymbolLayerProperties(properties);
+    } else if (layer instanceof RasterLayer) {
+      return LayerPropertyConverter.interpretRasterLayerProperties(properties);
+    } else if (layer instanceof HillshadeLayer) {
+      return LayerPropertyConverter.interpretHillshadeLayerProperties(properties);
+    }
+    return null;
+  }
+
+  /** Sets the filter of the given layer, returns false if the layer does not support filtering. */
+  private static boolean setLayerFilter(Layer layer, Expression expression) {
+    if (layer instanceof CircleLayer) {
+      ((CircleLayer) layer).setFilter(expression);
+    } else if (layer instanceof FillExtrusionLayer) {
+      ((FillExtrusionLayer) layer).setFilter(expression);
+    } else if (layer instanceof FillLayer) {
+      ((FillLayer) layer).setFilter(expression);
+    } else if (layer instanceof HeatmapLayer) {
+      ((HeatmapLayer) layer).setFilter(expression);
+    } else if (layer instanceof LineLayer) {
+      ((LineLayer) layer).setFilter(expression);
+    } else if (layer instanceof SymbolLayer) {
+      ((SymbolLayer) layer).setFilter(expression);
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+  private Layer requireLayer(String layerId) {
+    Layer layer = style.getLayer(layerId);
+    if (layer == null) {
+      throw new StyleOperationException(
+          "LAYER_NOT_FOUND_ERROR", "Layer " + layerId + " not found");
+    }
+    return layer;
+  }
+
+  /**
+   * Applies a single operation of a style transaction. All operations of a transaction are applied
+   * within the same main thread message, so the renderer picks them up with a single repaint.
+   */
+  @SuppressWarnings("unchecked")
+  private void applyStyleOperation(Map<String, Object> operation) {
+    final String type = (String) operation.get("type");
+    switch (type) {
+      case "addSource":
+        SourcePropertyConverter.addSource(
+            (String) operation.get("sourceId"),
+            (Map<String, Object>) operation.get("properties"),
+            style);
+        break;
+      case "addGeoJsonSource":
+        addGeoJsonSource((String) operation.get("sourceId"), (String) operation.get("geojson"));
+        break;
+      case "setGeoJsonSource":
+        setGeoJsonSource((String) operation.get("sourceId"), (String) operation.get("geojson"));
+        break;
+      case "updateGeoJsonSource":
+        updateGeoJsonSource(
+            (String) operation.get("sourceId"),
+            (String) operation.get("geojson"),
+            (List<Object>) operation.get("removeIds"));
+        break;
+      case "addLayer":
+        addStyleLayer(operation);
+        break;
+      case "setLayerProperties":
+        {
+          final Layer layer = requireLayer((String) operation.get("layerId"));
+          final PropertyValue[] properties =
+              interpretLayerProperties(layer, (Map<String, Object>) operation.get("properties"));
+          if (properties == null) {
+            throw new StyleOperationException(
+                "UNSUPPORTED_LAYER_TYPE", "Layer type not supported");
+          }
+          layer.setProperties(properties);
+          break;
+        }
+      case "setFilter":
+        {
+          final Layer layer = requireLayer((String) operation.get("layerId"));
+          JsonElement jsonElement = new JsonParser().parse((String) operation.get("filter"));
+          if (!setLayerFilter(layer, Expression.Converter.convert(jsonElement))) {
+            throw new StyleOperationException(
+                "INVALID LAYER TYPE",
+                String.format("Layer '%s' does not support filtering.", layer.getId()));
+          }
+          break;
+        }
+      case "setLayerVisibility":
+        {
+          final Layer layer = requireLayer((String) operation.get("layerId"));
+          final boolean visible = (Boolean) operation.get("visible");
+          layer.setProperties(
+              PropertyFactory.visibility(visible ? Property.VISIBLE : Property.NONE));
+          break;
+        }
+      case "removeLayer":
+        {
+          final String layerId = (String) operation.get("layerId");
+          style.removeLayer(layerId);
+          interactiveFeatureLayerIds.remove(layerId);
+          break;
+        }
+      case "removeSource":
+        style.removeSource((String) operation.get("sourceId"));
+        featureStateBySource.remove((String) operation.get("sourceId"));
+        stopMotionSource((String) operation.get("sourceId"));
+        break;
+      default:
+        throw new StyleOperationException(
+            "UNKNOWN_OPERATION", "Unknown style operation " + type);
+    }
+  }
+
+  @SuppressWarnings("unchecked")
+  private void addStyleLayer(Map<String, Object> operation) {
+    final String layerType = (String) operation.get("layerType");
+    final String sourceId = (String) operation.get("sourceId");
+    final String layerId = (String) operation.get("layerId");
+    final String belowLayerId = (String) operation.get("belowLayerId");
+    final String sourceLayer = (String) operation.get("sourceLayer");
+    final Double minzoom = (Double) operation.get("minzoom");
+    final Double maxzoom = (Double) operation.get("maxzoom");
+    final Float minZoom = minzoom != null ? minzoom.floatValue() : null;
+    final Float maxZoom = maxzoom != null ? maxzoom.floatValue() : null;
+    final Boolean enableInteraction = (Boolean) operation.get("enableInteraction");
+    final boolean interactive = enableInteraction != null && enableInteraction;
+    final Map<String, Object> properties = (Map<String, Object>) operation.get("properties");
+    final Expression filter = parseFilter((String) operation.get("filter"));
+
+    switch (layerType) {
+      case "symbol":
+        addSymbolLayer(
+            layerId,
+            sourceId,
+            belowLayerId,
+            sourceLayer,
+            minZoom,
+            maxZoom,
+            LayerPropertyConverter.interpretSymbolLayerProperties(properties),
+            interactive,
+            filter);
+        break;
+      case "line":
+        addLineLayer(
+            layerId,
+            sourceId,
+            belowLayerId,
+            sourceLayer,
+            minZoom,
+            maxZoom,
+            LayerPropertyConverter.interpretLineLayerProperties(properties),
+            interactive,
+            filter);
+        break;
+      case "fill":
+        addFillLayer(
+            layerId,
+            sourceId,
+            belowLayerId,
+            sourceLayer,
+            minZoom,
+            maxZoom,
+            LayerPropertyConverter.interpretFillLayerProperties(properties),
+            interactive,
+            filter);
+        break;
+      case "fill-extrusion":
+        addFillExtrusionLayer(
+            layerId,
+            sourceId,
+            belowLayerId,
+            sourceLayer,
+            minZoom,
+            maxZoom,
+            LayerPropertyConverter.interpretFillExtrusionLayerProperties(properties),
+            interactive,
+            filter);
+        break;
+      case "circle":
+        addCircleLayer(
+            layerId,
+            sourceId,
+            belowLayerId,
+            sourceLayer,
+            minZoom,
+            maxZoom,
+            LayerPropertyConverter.interpretCircleLayerProperties(properties),
+            interactive,
+            filter);
+        break;
+      case "raster":
+        addRasterLayer(
+            layerId,
+            sourceId,
+            minZoom,
+            maxZoom,
+            belowLayerId,
+            LayerPropertyConverter.interpretRasterLayerProperties(properties),
+            null);
+        break;
+      case "hillshade":
+        addHillshadeLayer(
+            layerId,
+            sourceId,
+            minZoom,
+            maxZoom,
+            belowLayerId,
+            LayerPropertyConverter.interpretHillshadeLayerProperties(properties),
+            null);
+        break;
+      case "heatmap":
+        addHeatmapLayer(
+            layerId,
+            sourceId,
+            minZoom,
+            maxZoom,
+            belowLayerId,
+            LayerPropertyConverter.interpretHeatmapLayerProperties(properties),
+            null);
+        break;
+      default:
+        throw new StyleOperationException(
+            "UNSUPPORTED_LAYER_TYPE", "Layer type " + layerType + " not supported");
+    }
+  }
+
   @Override
   public void onMethodCall(MethodCall call, MethodChannel.Result result) {
 
@@ -940,6 +1369,12 @@ final class MapLibreMapController
               });
           break;
         }
+      case "map#setPrefetchZoomDelta":
+        {
+          mapLibreMap.setPrefetchZoomDelta(call.<Number>argument("delta").intValue());
+          result.success(null);
+          break;
+        }
       case "map#clearAmbientCache":
       {
         OfflineManager fileSource = OfflineManager.Companion.getInstance(context);
@@ -961,7 +1396,7 @@ final class MapLibreMapController
       case "source#addGeoJson":
         {
           final String sourceId = call.argument("sourceId");
-          final String geojson = call.argument("geojson");
+          final String geojson = geojsonArgument(call.argument("geojson"));
           addGeoJsonSource(sourceId, geojson);
           result.success(null);
           break;
@@ -969,7 +1404,7 @@ final class MapLibreMapController
       case "source#setGeoJson":
         {
           final String sourceId = call.argument("sourceId");
-          final String geojson = call.argument("geojson");
+          final String geojson = geojsonArgument(call.argument("geojson"));
           setGeoJsonSource(sourceId, geojson);
           result.success(null);
           break;
@@ -982,6 +1417,78 @@ final class MapLibreMapController
           result.success(null);
           break;
         }
+      case "source#getClusterExpansionZoom":
+      case "source#getClusterChildren":
+      case "source#getClusterLeaves":
+        {
+          if (style == null) {
+            result.error(
+                "STYLE IS NULL",
+                "The style is null. Has onStyleLoaded() already been invoked?",
+                null);
+            break;
+          }
+          final String sourceId = call.argument("sourceId");
+          final Source source = style.getSource(sourceId);
+          if (!(source instanceof GeoJsonSource)) {
+            result.error(
+                "SOURCE_NOT_FOUND", "No geojson source found with id " + sourceId, null);
+            break;
+          }
+          final GeoJsonSource geoJsonSource = (GeoJsonSource) source;
+          final Feature cluster = clusterFeature(((Number) call.argument("clusterId")).longValue());
+          if (call.method.equals("source#getClusterExpansionZoom")) {
+            result.success(geoJsonSource.getClusterExpansionZoom(cluster));
+            break;
+          }
+          final FeatureCollection featureCollection;
+          if (call.method.equals("source#getClusterChildren")) {
+            featureCollection = geoJsonSource.getClusterChildren(cluster);
+          } else {
+            featureCollection =
+                geoJsonSource.getClusterLeaves(
+                    cluster,
+                    ((Number) call.argument("limit")).longValue(),
+                    ((Number) call.argument("offset")).longValue());
+          }
+          List<String> featuresJson = new ArrayList<>();
+          if (featureCollection.features() != null) {
+            for (Feature feature : featureCollection.features()) {
+              featuresJson.add(feature.toJson());
+            }
+          }
+          Map<String, Object> reply = new HashMap<>();
+          reply.put("features", featuresJson);
+          result.success(reply);
+          break;
+        }
+      case "featureState#set":
+      case "featureState#remove":
+        {
+          if (style == null) {
+            result.error(
+                "STYLE IS NULL",
+                "The style is null. Has onStyleLoaded() already been invoked?",
+                null);
+            break;
+          }
+          final String sourceId = call.argument("sourceId");
+          final boolean updated =
+              updateFeatureState(
+                  sourceId,
+                  call.argument("featureId"),
+                  call.method.equals("featureState#set") ? call.argument("state") : null,
+                  call.argument("key"));
+          if (updated) {
+            result.success(null);
+          } else {
+            result.error(
+                "UNSUPPORTED_SOURCE",
+                "Feature state is only supported for geojson sources, got " + sourceId,
+                null);
+          }
+          break;
+        }
       case "symbolLayer#add":
         {
           final String sourceId = call.argument("sourceId");
@@ -1055,27 +1562,9 @@ final class MapLibreMapController
           Layer layer = style.getLayer(layerId);
 
           if (layer != null) {
-            final PropertyValue[] properties;
-
-            if (layer instanceof LineLayer) {
-              properties = LayerPropertyConverter
-                  .interpretLineLayerProperties(call.argument("properties"));
-            } else if (layer instanceof FillLayer) {
-              properties = LayerPropertyConverter
-                  .interpretFillLayerProperties(call.argument("properties"));
-            } else if (layer instanceof CircleLayer) {
-              properties = LayerPropertyConverter
-                  .interpretCircleLayerProperties(call.argument("properties"));
-            } else if (layer instanceof SymbolLayer) {
-              properties = LayerPropertyConverter
-                  .interpretSymbolLayerProperties(call.argument("properties"));
-            } else if (layer instanceof RasterLayer) {
-              properties = LayerPropertyConverter
-                  .interpretRasterLayerProperties(call.argument("properties"));
-            } else if (layer instanceof HillshadeLayer) {
-              properties = LayerPropertyConverter
-                  .interpretHillshadeLayerProperties(call.argument("properties"));
-            } else {
+            final PropertyValue[] properties =
+                interpretLayerProperties(layer, call.argument("properties"));
+            if (properties == null) {
               result.error("UNSUPPORTED_LAYER_TYPE", "Layer type not supported", null);
               return;
             }
@@ -1361,6 +1850,47 @@ final class MapLibreMapController
                 null);
           }
           style.removeSource((String) call.argument("sourceId"));
+          featureStateBySource.remove((String) call.argument("sourceId"));
+          stopMotionSource((String) call.argument("sourceId"));
+          result.success(null);
+          break;
+        }
+      case "motionSource#add":
+        {
+          if (style == null) {
+            result.error(
+                "STYLE IS NULL",
+                "The style is null. Has onStyleLoaded() already been invoked?",
+                null);
+            break;
+          }
+          final String sourceId = call.argument("sourceId");
+          if (style.getSource(sourceId) != null) {
+            result.error(
+                "SOURCE_ALREADY_EXISTS", "A source with id " + sourceId + " already exists", null);
+            break;
+          }
+          final long maxExtrapolation = ((Number) call.argument("maxExtrapolation")).longValue();
+          final long blendDuration = ((Number) call.argument("blendDuration")).longValue();
+          motionSources.put(
+              sourceId, new MotionSource(sourceId, style, maxExtrapolation, blendDuration));
+          result.success(null);
+          break;
+        }
+      case "motionSource#update":
+        {
+          final String sourceId = call.argument("sourceId");
+          final MotionSource motionSource = motionSources.get(sourceId);
+          if (motionSource == null) {
+            result.error(
+                "SOURCE_NOT_FOUND", "No motion source found with id " + sourceId, null);
+            break;
+          }
+          motionSource.update(
+              call.argument("ids"),
+              call.argument("fixes"),
+              call.argument("properties"),
+              call.argument("removeIds"));
           result.success(null);
           break;
         }
@@ -1462,19 +1992,7 @@ final class MapLibreMapController
           JsonElement jsonElement = parser.parse(filter);
           Expression expression = Expression.Converter.convert(jsonElement);
 
-          if (layer instanceof CircleLayer) {
-            ((CircleLayer) layer).setFilter(expression);
-          } else if (layer instanceof FillExtrusionLayer) {
-            ((FillExtrusionLayer) layer).setFilter(expression);
-          } else if (layer instanceof FillLayer) {
-            ((FillLayer) layer).setFilter(expression);
-          } else if (layer instanceof HeatmapLayer) {
-            ((HeatmapLayer) layer).setFilter(expression);
-          } else if (layer instanceof LineLayer) {
-            ((LineLayer) layer).setFilter(expression);
-          } else if (layer instanceof SymbolLayer) {
-            ((SymbolLayer) layer).setFilter(expression);
-          } else {
+          if (!setLayerFilter(layer, expression)) {
             result.error(
                 "INVALID LAYER TYPE",
                 String.format("Layer '%s' does not support filtering.", layerId),
@@ -1601,6 +2119,39 @@ final class MapLibreMapController
           result.success(reply);
           break;
         }
+      case "style#applyTransaction":
+        {
+          if (style == null) {
+            result.error(
+                "STYLE IS NULL",
+                "The style is null. Has onStyleLoaded() already been invoked?",
+                null);
+            break;
+          }
+          final List<Map<String, Object>> operations = call.argument("operations");
+          final List<Map<String, Object>> errors = new ArrayList<>();
+          for (int i = 0; i < operations.size(); i++) {
+            try {
+              applyStyleOperation(operations.get(i));
+            } catch (Exception e) {
+              final Map<String, Object> error = new HashMap<>(3);
+              error.put("index", i);
+              error.put(
+                  "code",
+                  e instanceof StyleOperationException
+                      ? ((StyleOperationException) e).code
+                      : "STYLE_OPERATION_ERROR");
+              error.put("message", e.getMessage());
+              errors.add(error);
+            }
+          }
+          updateLocationComponentLayer();
+
+          Map<String, Object> reply = new HashMap<>();
+          reply.put("errors", errors);
+          result.success(reply);
+          break;
+        }
       case "style#getSourceIds":
       {
         if (style == null) {
@@ -1808,6 +2359,7 @@ final class MapLibreMapController
       locationComponent.setLocationComponentEnabled(false);
     }
     stopListeningForLocationUpdates();
+    stopMotionSources();
 
     mapViewContainer.removeView(mapView);
 
@@ -2252,6 +2804,16 @@ final class MapLibreMapController
     dragPrevious = null;
   }
 
+  /** Failure of a single operation of a style transaction. */
+  private static class StyleOperationException extends RuntimeException {
+    final String code;
+
+    StyleOperationException(String code, String message) {
+      super(message);
+      this.code = code;
+    }
+  }
+
   /** Simple Listener to listen for the status of camera movements. */
   public class OnCameraMoveFinishedListener implements MapLibreMap.CancelableCallback {
     @Override
@@ -0,0 +1,198 @@
+package org.maplibre.maplibregl;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+
+/**
+ * Extrapolates the positions of moving points from their last fix by dead reckoning. This is the
+ * same algorithm as the Dart {@code MotionInterpolator}, see there for details. The state of all
+ * points is kept in a single array, so computing the positions of a frame allocates nothing.
+ *
+ * <p>Times are milliseconds since the epoch.
+ */
+final class MotionInterpolator {
+  private static final double EARTH_RADIUS = 6371008.8;
+
+  // latitude, longitude, track, speed, fix time, latitude and longitude error of the fix and the
+  // start of its correction
+  private static final int STRIDE = 8;
+
+  private final long maxExtrapolation;
+  private final long blendDuration;
+
+  private final List<String> ids = new ArrayList<>();
+  private final Map<String, Integer> indexById = new HashMap<>();
+  private double[] state = new double[STRIDE * 16];
+  private final double[] scratch = new double[4];
+
+  MotionInterpolator(long maxExtrapolation, long blendDuration) {
+    this.maxExtrapolation = maxExtrapolation;
+    this.blendDuration = blendDuration;
+  }
+
+  int size() {
+    return ids.size();
+  }
+
+  /** The ids of the points in the order of {@link #positionsAt}. */
+  List<String> ids() {
+    return ids;
+  }
+
+  /** Returns the index of the point, which changes when other points are removed. */
+  int indexOf(String id) {
+    final Integer index = indexById.get(id);
+    return index == null ? -1 : index;
+  }
+
+  /**
+   * Sets the latest fix of the point {@code id} at {@code now} and returns its index, adding the
+   * point if it is new.
+   */
+  int update(
+      String id,
+      double latitude,
+      double longitude,
+      double track,
+      double speed,
+      long timestamp,
+      long now) {
+    Integer index = indexById.get(id);
+    double errorLatitude = 0;
+    double errorLongitude = 0;
+    if (index != null) {
+      positionAt(index, now, scratch, 0);
+      setFix(index, latitude, longitude, track, speed, timestamp);
+      positionAt(index, now, scratch, 2);
+      errorLatitude = scratch[0] - scratch[2];
+      errorLongitude = wrap(scratch[1] - scratch[3]);
+    } else {
+      index = ids.size();
+      ids.add(id);
+      indexById.put(id, index);
+      if (state.length < ids.size() * STRIDE) {
+        state = Arrays.copyOf(state, state.length * 2);
+      }
+      setFix(index, latitude, longitude, track, speed, timestamp);
+    }
+    final int offset = index * STRIDE;
+    state[offset + 5] = errorLatitude;
+    state[offset + 6] = errorLongitude;
+    state[offset + 7] = now;
+    return index;
+  }
+
+  private void setFix(
+      int index, double latitude, double longitude, double track, double speed, long timestamp) {
+    final int offset = index * STRIDE;
+    state[offset] = latitude;
+    state[offset + 1] = longitude;
+    state[offset + 2] = track;
+    state[offset + 3] = speed;
+    state[offset + 4] = timestamp;
+    state[offset + 5] = 0;
+    state[offset + 6] = 0;
+  }
+
+  /**
+   * Removes the point {@code id} and returns its former index, or -1. The last point takes its
+   * place.
+   */
+  int remove(String id) {
+    final Integer index = indexById.remove(id);
+    if (index == null) {
+      return -1;
+    }
+    final int last = ids.size() - 1;
+    final String lastId = ids.remove(last);
+    if (index != last) {
+      ids.set(index, lastId);
+      indexById.put(lastId, index);
+      System.arraycopy(state, last * STRIDE, state, index * STRIDE, STRIDE);
+    }
+    return index;
+  }
+
+  void clear() {
+    ids.clear();
+    indexById.clear();
+  }
+
+  /**
+   * Writes the positions of all points at {@code now} as latitude and longitude pairs in the order
+   * of {@link #ids} to {@code out}, which is reused if it is large enough.
+   */
+  double[] positionsAt(long now, double[] out) {
+    final double[] positions =
+        out != null && out.length >= ids.size() * 2 ? out : new double[state.length / STRIDE * 2];
+    for (int i = 0; i < ids.size(); i++) {
+      positionAt(i, now, positions, i * 2);
+    }
+    return positions;
+  }
+
+  /**
+   * Whether any point moves at {@code now}, i.e. is extrapolated or has an error being corrected.
+   */
+  boolean isMovingAt(long now) {
+    for (int i = 0; i < ids.size(); i++) {
+      final int offset = i * STRIDE;
+      if (state[offset + 3] > 0 && now - state[offset + 4] < maxExtrapolation) {
+        return true;
+      }
+      if ((state[offset + 5] != 0 || state[offset + 6] != 0) && blendAt(offset, now) > 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /** The remaining fraction of the fix error at {@code now}. */
+  private double blendAt(int offset, long now) {
+    if (blendDuration <= 0) {
+      return 0;
+    }
+    final double elapsed = now - state[offset + 7];
+    return elapsed >= blendDuration ? 0 : 1 - Math.max(elapsed, 0) / blendDuration;
+  }
+
+  /**
+   * Moves the fix of the point at {@code index} along its great circle by the distance travelled
+   * until {@code now}, adds the remaining error of the fix and writes the position to {@code out}.
+   */
+  private void positionAt(int index, long now, double[] out, int outOffset) {
+    final int offset = index * STRIDE;
+    double latitude = state[offset];
+    double longitude = state[offset + 1];
+    final double seconds =
+        Math.min(Math.max(now - state[offset + 4], 0), maxExtrapolation) / 1000.0;
+    final double distance = state[offset + 3] * seconds / EARTH_RADIUS;
+    if (distance > 0) {
+      final double track = Math.toRadians(state[offset + 2]);
+      final double latitude1 = Math.toRadians(latitude);
+      final double latitude2 =
+          Math.asin(
+              Math.sin(latitude1) * Math.cos(distance)
+                  + Math.cos(latitude1) * Math.sin(distance) * Math.cos(track));
+      final double deltaLongitude =
+          Math.atan2(
+              Math.sin(track) * Math.sin(distance) * Math.cos(latitude1),
+              Math.cos(distance) - Math.sin(latitude1) * Math.sin(latitude2));
+      latitude = Math.toDegrees(latitude2);
+      longitude += Math.toDegrees(deltaLongitude);
+    }
+    final double blend = blendAt(offset, now);
+    out[outOffset] = latitude + state[offset + 5] * blend;
+    out[outOffset + 1] = wrap(longitude + state[offset + 6] * blend);
+  }
+
+  private static double wrap(double longitude) {
+    if (longitude > 180 || longitude < -180) {
+      return ((longitude + 540) % 360 + 360) % 360 - 180;
+    }
+    return longitude;
+  }
+}
@@ -0,0 +1,140 @@
+package org.maplibre.maplibregl;
+
+import android.view.Choreographer;
+import com.google.gson.Gson;
+import com.google.gson.JsonObject;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Map;
+import org.maplibre.android.maps.Style;
+import org.maplibre.android.style.sources.GeoJsonSource;
+import org.maplibre.geojson.Feature;
+import org.maplibre.geojson.FeatureCollection;
+import org.maplibre.geojson.Point;
+
+/**
+ * A geojson source of moving points. Dart sends the fixes of the points at the rate of its feed,
+ * the positions in between are extrapolated with a {@link MotionInterpolator} and set on the
+ * source once per display frame while any point moves.
+ */
+final class MotionSource implements Choreographer.FrameCallback {
+  private static final Gson gson = new Gson();
+
+  private final String sourceId;
+  private final Style style;
+  private final MotionInterpolator interpolator;
+
+  /** The properties of the points in the order of the ids of the interpolator. */
+  private final List<JsonObject> properties = new ArrayList<>();
+
+  private double[] positions;
+  private boolean isFrameScheduled = false;
+  private boolean stopped = false;
+
+  MotionSource(String sourceId, Style style, long maxExtrapolation, long blendDuration) {
+    this.sourceId = sourceId;
+    this.style = style;
+    this.interpolator = new MotionInterpolator(maxExtrapolation, blendDuration);
+    style.addSource(new GeoJsonSource(sourceId, FeatureCollection.fromFeatures(new Feature[0])));
+  }
+
+  /**
+   * Sets the fixes of the points with {@code ids}, given as latitude, longitude, track, speed and
+   * timestamp per point in {@code fixes}, and removes the points with {@code removeIds}.
+   */
+  void update(
+      List<Object> ids,
+      double[] fixes,
+      List<Map<String, Object>> pointProperties,
+      List<Object> removeIds) {
+    final long now = System.currentTimeMillis();
+    if (removeIds != null) {
+      for (Object id : removeIds) {
+        final int index = interpolator.remove(String.valueOf(id));
+        if (index >= 0) {
+          final JsonObject last = properties.remove(properties.size() - 1);
+          if (index < properties.size()) {
+            properties.set(index, last);
+          }
+        }
+      }
+    }
+    for (int i = 0; i < ids.size(); i++) {
+      final String id = String.valueOf(ids.get(i));
+      final int index =
+          interpolator.update(
+              id,
+              fixes[i * 5],
+              fixes[i * 5 + 1],
+              fixes[i * 5 + 2],
+              fixes[i * 5 + 3],
+              (long) fixes[i * 5 + 4],
+              now);
+      final JsonObject featureProperties =
+          pointProperties != null && pointProperties.get(i) != null
+              ? gson.toJsonTree(pointProperties.get(i)).getAsJsonObject()
+              : new JsonObject();
+      featureProperties.add("id", gson.toJsonTree(ids.get(i)));
+      if (index == properties.size()) {
+        properties.add(featureProperties);
+      } else {
+        properties.set(index, featureProperties);
+      }
+    }
+    render(now);
+    scheduleFrame();
+  }
+
+  /** Stops the frame updates, e.g. once the source was removed. */
+  void stop() {
+    stopped = true;
+    if (isFrameScheduled) {
+      Choreographer.getInstance().removeFrameCallback(this);
+      isFrameScheduled = false;
+    }
+  }
+
+  @Override
+  public void doFrame(long frameTimeNanos) {
+    isFrameScheduled = false;
+    final long now = System.currentTimeMillis();
+    if (!render(now)) {
+      stop();
+      return;
+    }
+    if (interpolator.isMovingAt(now)) {
+      scheduleFrame();
+    }
+  }
+
+  private void scheduleFrame() {
+    if (isFrameScheduled || stopped) {
+      return;
+    }
+    isFrameScheduled = true;
+    Choreographer.getInstance().postFrameCallback(this);
+  }
+
+  /** Sets the positions at {@code now} on the source, false if the source no longer exists. */
+  private boolean render(long now) {
+    if (stopped) {
+      return false;
+    }
+    final GeoJsonSource source = style.isFullyLoaded() ? style.getSourceAs(sourceId) : null;
+    if (source == null) {
+      return false;
+    }
+    positions = interpolator.positionsAt(now, positions);
+    final List<String> ids = interpolator.ids();
+    final List<Feature> features = new ArrayList<>(ids.size());
+    for (int i = 0; i < ids.size(); i++) {
+      features.add(
+          Feature.fromGeometry(
+              Point.fromLngLat(positions[i * 2 + 1], positions[i * 2]),
+              properties.get(i),
+              ids.get(i)));
+    }
+    source.setGeoJson(FeatureCollection.fromFeatures(features));
+    return true;
+  }
+}
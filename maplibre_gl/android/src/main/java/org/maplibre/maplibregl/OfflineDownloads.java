@@ -0,0 +1,247 @@
+package org.maplibre.maplibregl;
+
+import android.content.Context;
+import android.content.SharedPreferences;
+import android.os.SystemClock;
+import android.util.Log;
+import androidx.annotation.NonNull;
+import com.google.gson.Gson;
+import io.flutter.plugin.common.BinaryMessenger;
+import io.flutter.plugin.common.EventChannel;
+import io.flutter.plugin.common.MethodChannel;
+import java.util.HashMap;
+import java.util.HashSet;
+import java.util.Map;
+import java.util.Set;
+import org.maplibre.android.offline.OfflineManager;
+import org.maplibre.android.offline.OfflineRegion;
+import org.maplibre.android.offline.OfflineRegionDefinition;
+import org.maplibre.android.offline.OfflineRegionError;
+import org.maplibre.android.offline.OfflineRegionStatus;
+
+/**
+ * Primitives of the Dart {@code OfflineDownloadQueue}: offline regions are created without being
+ * downloaded, and downloads are resumed and paused by region id. The status of all downloads is
+ * reported on one shared event channel, progress at most every {@link #PROGRESS_INTERVAL_MS} per
+ * region. The queue itself is scheduled in Dart and persisted here as an opaque string.
+ */
+class OfflineDownloads implements EventChannel.StreamHandler {
+  private static final String TAG = "OfflineDownloads";
+  private static final String CHANNEL_NAME = "plugins.flutter.io/maplibre_gl/offline_downloads";
+  private static final String PREFERENCES_NAME = "org.maplibre.maplibregl.offline_downloads";
+  private static final String QUEUE_KEY = "queue";
+  private static final long PROGRESS_INTERVAL_MS = 250;
+
+  private final Context context;
+  private final Gson gson = new Gson();
+  private final Map<Long, OfflineRegion> activeRegions = new HashMap<>();
+  private final Map<Long, Long> lastProgressTimes = new HashMap<>();
+
+  /** Regions being looked up to resume, removed if they are paused meanwhile. */
+  private final Set<Long> pendingResumes = new HashSet<>();
+  private EventChannel.EventSink sink;
+
+  OfflineDownloads(Context context, BinaryMessenger messenger) {
+    this.context = context;
+    new EventChannel(messenger, CHANNEL_NAME).setStreamHandler(this);
+  }
+
+  @Override
+  public void onListen(Object arguments, EventChannel.EventSink events) {
+    sink = events;
+  }
+
+  @Override
+  public void onCancel(Object arguments) {
+    sink = null;
+  }
+
+  /** Creates an offline region without starting its download. */
+  void create(
+      MethodChannel.Result result,
+      Map<String, Object> definitionMap,
+      Map<String, Object> metadataMap) {
+    final float pixelDensity = context.getResources().getDisplayMetrics().density;
+    final OfflineRegionDefinition definition =
+        OfflineManagerUtils.mapToRegionDefinition(definitionMap, pixelDensity);
+    final String metadata = metadataMap != null ? gson.toJson(metadataMap) : "{}";
+    OfflineManager.Companion.getInstance(context)
+        .createOfflineRegion(
+            definition,
+            metadata.getBytes(),
+            new OfflineManager.CreateOfflineRegionCallback() {
+              @Override
+              public void onCreate(@NonNull OfflineRegion offlineRegion) {
+                OfflineRegionIndex.instance(context).put(offlineRegion);
+                result.success(OfflineManagerUtils.offlineRegionToMap(offlineRegion));
+              }
+
+              @Override
+              public void onError(@NonNull String error) {
+                result.error("mapboxInvalidRegionDefinition", error, null);
+              }
+            });
+  }
+
+  /** Starts or resumes the download of the region {@code id}. Tiles already stored are kept. */
+  void resume(MethodChannel.Result result, long id) {
+    if (activeRegions.containsKey(id) || !pendingResumes.add(id)) {
+      result.success(null);
+      return;
+    }
+    OfflineRegionIndex.instance(context)
+        .withRegion(
+            id,
+            new OfflineRegionIndex.RegionCallback() {
+              @Override
+              public void onRegion(OfflineRegion region) {
+                // paused meanwhile
+                if (!pendingResumes.remove(id)) {
+                  result.success(null);
+                  return;
+                }
+                if (region == null) {
+                  result.error("RegionNotFound", "There is no region with id " + id, null);
+                  return;
+                }
+                activeRegions.put(id, region);
+                region.setObserver(observerFor(region));
+                region.setDownloadState(OfflineRegion.STATE_ACTIVE);
+                result.success(null);
+              }
+
+              @Override
+              public void onError(String error) {
+                pendingResumes.remove(id);
+                result.error("RegionListError", error, null);
+              }
+            });
+  }
+
+  /**
+   * Pauses the download of the region {@code id}, it can be resumed later. A resume that is still
+   * looking up the region doesn't start the download.
+   */
+  void pause(MethodChannel.Result result, long id) {
+    pendingResumes.remove(id);
+    final OfflineRegion region = activeRegions.remove(id);
+    if (region != null) {
+      region.setDownloadState(OfflineRegion.STATE_INACTIVE);
+      region.setObserver(null);
+    }
+    lastProgressTimes.remove(id);
+    result.success(null);
+  }
+
+  /**
+   * Marks the tiles of the region {@code id} as expired, so that its next download revalidates them
+   * with conditional requests and only rewrites the tiles that changed.
+   */
+  void invalidate(MethodChannel.Result result, long id) {
+    OfflineRegionIndex.instance(context)
+        .withRegion(
+            id,
+            new OfflineRegionIndex.RegionCallback() {
+              @Override
+              public void onRegion(OfflineRegion region) {
+                if (region == null) {
+                  result.error("RegionNotFound", "There is no region with id " + id, null);
+                  return;
+                }
+                region.invalidate(
+                    new OfflineRegion.OfflineRegionInvalidateCallback() {
+                      @Override
+                      public void onInvalidate() {
+                        result.success(null);
+                      }
+
+                      @Override
+                      public void onError(@NonNull String error) {
+                        result.error("InvalidateRegionError", error, null);
+                      }
+                    });
+              }
+
+              @Override
+              public void onError(String error) {
+                result.error("RegionListError", error, null);
+              }
+            });
+  }
+
+  void saveQueue(MethodChannel.Result result, String queue) {
+    preferences().edit().putString(QUEUE_KEY, queue).apply();
+    result.success(null);
+  }
+
+  void loadQueue(MethodChannel.Result result) {
+    result.success(preferences().getString(QUEUE_KEY, null));
+  }
+
+  private SharedPreferences preferences() {
+    return context.getSharedPreferences(PREFERENCES_NAME, Context.MODE_PRIVATE);
+  }
+
+  private OfflineRegion.OfflineRegionObserver observerFor(OfflineRegion region) {
+    final long id = region.getId();
+    return new OfflineRegion.OfflineRegionObserver() {
+      @Override
+      public void onStatusChanged(@NonNull OfflineRegionStatus status) {
+        if (status.isComplete()) {
+          finish(region);
+          send(id, "complete", status, null, null);
+          return;
+        }
+        final long now = SystemClock.elapsedRealtime();
+        final Long last = lastProgressTimes.get(id);
+        if (last != null && now - last < PROGRESS_INTERVAL_MS) return;
+        lastProgressTimes.put(id, now);
+        send(id, "progress", status, null, null);
+      }
+
+      @Override
+      public void onError(@NonNull OfflineRegionError error) {
+        Log.e(TAG, "Download of region " + id + " failed: " + error.getMessage());
+        finish(region);
+        send(id, "error", null, error.getReason(), error.getMessage());
+      }
+
+      @Override
+      public void mapboxTileCountLimitExceeded(long limit) {
+        finish(region);
+        send(
+            id,
+            "error",
+            null,
+            "mapboxTileCountLimitExceeded",
+            "MapLibre tile count limit exceeded: " + limit);
+      }
+    };
+  }
+
+  private void finish(OfflineRegion region) {
+    region.setDownloadState(OfflineRegion.STATE_INACTIVE);
+    region.setObserver(null);
+    activeRegions.remove(region.getId());
+    lastProgressTimes.remove(region.getId());
+  }
+
+  private void send(
+      long id, String status, OfflineRegionStatus regionStatus, String errorCode, String message) {
+    if (sink == null) return;
+    final Map<String, Object> event = new HashMap<>();
+    event.put("id", id);
+    event.put("status", status);
+    if (regionStatus != null) {
+      event.put("completedResources", regionStatus.getCompletedResourceCount());
+      event.put("requiredResources", regionStatus.getRequiredResourceCount());
+      event.put("completedTiles", regionStatus.getCompletedTileCount());
+      event.put("completedBytes", regionStatus.getCompletedResourceSize());
+    }
+    if (errorCode != null) {
+      event.put("errorCode", errorCode);
+      event.put("errorMessage", message);
+    }
+    sink.success(event);
+  }
+}
@@ -1,19 +1,28 @@
 package org.maplibre.maplibregl;
 
 import android.content.Context;
+import android.os.StatFs;
 import android.util.Log;
 import com.google.gson.Gson;
 import org.maplibre.android.geometry.LatLng;
 import org.maplibre.android.geometry.LatLngBounds;
+import org.maplibre.android.offline.OfflineGeometryRegionDefinition;
 import org.maplibre.android.offline.OfflineManager;
 import org.maplibre.android.offline.OfflineRegion;
 import org.maplibre.android.offline.OfflineRegionDefinition;
 import org.maplibre.android.offline.OfflineRegionError;
 import org.maplibre.android.offline.OfflineRegionStatus;
 import org.maplibre.android.offline.OfflineTilePyramidRegionDefinition;
+import org.maplibre.android.storage.FileSource;
+import org.maplibre.geojson.Geometry;
+import org.maplibre.geojson.MultiPolygon;
+import org.maplibre.geojson.Point;
+import org.maplibre.geojson.Polygon;
 import io.flutter.plugin.common.MethodChannel;
+import java.io.File;
 import java.util.ArrayList;
 import java.util.Arrays;
+import java.util.Collections;
 import java.util.HashMap;
 import java.util.List;
 import java.util.Map;
@@ -21,6 +30,10 @@ import java.util.concurrent.atomic.AtomicBoolean;
 
 abstract class OfflineManagerUtils {
   private static final String TAG = "OfflineManagerUtils";
+  private static final String DATABASE_NAME = "mbgl-offline.db";
+
+  /** The default of MapLibre until the size is set. */
+  private static long maximumAmbientCacheSize = 50 * 1024 * 1024;
 
   static void mergeRegions(MethodChannel.Result result, Context context, String path) {
     OfflineManager.Companion.getInstance(context)
@@ -28,13 +41,14 @@ abstract class OfflineManagerUtils {
             path,
             new OfflineManager.MergeOfflineRegionsCallback() {
               public void onMerge(OfflineRegion[] offlineRegions) {
-                if (result == null) return;
+                final OfflineRegionIndex index = OfflineRegionIndex.instance(context);
                 List<Map<String, Object>> regionsArgs = new ArrayList<>();
                 for (OfflineRegion offlineRegion : offlineRegions) {
+                  index.put(offlineRegion);
                   regionsArgs.add(offlineRegionToMap(offlineRegion));
                 }
-                String json = new Gson().toJson(regionsArgs);
-                result.success(json);
+                if (result == null) return;
+                result.success(regionsArgs);
               }
 
               public void onError(String error) {
@@ -49,6 +63,41 @@ abstract class OfflineManagerUtils {
     result.success(null);
   }
 
+  static void setMaximumAmbientCacheSize(MethodChannel.Result result, Context context, long size) {
+    OfflineManager.Companion.getInstance(context)
+        .setMaximumAmbientCacheSize(
+            size,
+            new OfflineManager.FileSourceCallback() {
+              @Override
+              public void onSuccess() {
+                maximumAmbientCacheSize = size;
+                result.success(null);
+              }
+
+              @Override
+              public void onError(String message) {
+                result.error("AmbientCacheSizeError", message, null);
+              }
+            });
+  }
+
+  /** The database of the ambient cache and the offline regions. */
+  static File databaseFile(Context context) {
+    return new File(FileSource.getResourcesCachePath(context), DATABASE_NAME);
+  }
+
+  /** The size of the database and the free and total space of its storage. */
+  static void ambientCacheStatistics(MethodChannel.Result result, Context context) {
+    String path = FileSource.getResourcesCachePath(context);
+    StatFs storage = new StatFs(path);
+    Map<String, Object> statistics = new HashMap<>();
+    statistics.put("databaseSize", databaseFile(context).length());
+    statistics.put("maximumAmbientCacheSize", maximumAmbientCacheSize);
+    statistics.put("freeSpace", storage.getAvailableBytes());
+    statistics.put("totalSpace", storage.getTotalBytes());
+    result.success(statistics);
+  }
+
   static void downloadRegion(
       MethodChannel.Result result,
       Context context,
@@ -72,8 +121,8 @@ abstract class OfflineManagerUtils {
 
               @Override
               public void onCreate(OfflineRegion offlineRegion) {
-                Map<String, Object> regionData = offlineRegionToMap(offlineRegion);
-                result.success(new Gson().toJson(regionData));
+                OfflineRegionIndex.instance(context).put(offlineRegion);
+                result.success(offlineRegionToMap(offlineRegion));
 
                 _offlineRegion = offlineRegion;
                 // Observe downloading state
@@ -162,16 +211,16 @@ abstract class OfflineManagerUtils {
   }
 
   static void regionsList(MethodChannel.Result result, Context context) {
-    OfflineManager.Companion.getInstance(context)
-        .listOfflineRegions(
-            new OfflineManager.ListOfflineRegionsCallback() {
+    OfflineRegionIndex.instance(context)
+        .withRegions(
+            new OfflineRegionIndex.Callback() {
               @Override
-              public void onList(OfflineRegion[] offlineRegions) {
+              public void onRegions(Map<Long, OfflineRegion> regions) {
                 List<Map<String, Object>> regionsArgs = new ArrayList<>();
-                for (OfflineRegion offlineRegion : offlineRegions) {
+                for (OfflineRegion offlineRegion : regions.values()) {
                   regionsArgs.add(offlineRegionToMap(offlineRegion));
                 }
-                result.success(new Gson().toJson(regionsArgs));
+                result.success(regionsArgs);
               }
 
               @Override
@@ -183,93 +232,239 @@ abstract class OfflineManagerUtils {
 
   static void updateRegionMetadata(
       MethodChannel.Result result, Context context, long id, Map<String, Object> metadataMap) {
-    OfflineManager.Companion.getInstance(context)
-        .listOfflineRegions(
-            new OfflineManager.ListOfflineRegionsCallback() {
+    OfflineRegionIndex.instance(context)
+        .withRegion(
+            id,
+            new OfflineRegionIndex.RegionCallback() {
               @Override
-              public void onList(OfflineRegion[] offlineRegions) {
-                for (OfflineRegion offlineRegion : offlineRegions) {
-                  if (offlineRegion.getId() != id) continue;
+              public void onRegion(OfflineRegion offlineRegion) {
+                if (offlineRegion == null) {
+                  if (result == null) return;
+                  result.error(
+                      "UpdateMetadataError",
+                      "There is no " + "region with given id to " + "update.",
+                      null);
+                  return;
+                }
+                updateMetadata(
+                    offlineRegion,
+                    metadataMap,
+                    new OfflineRegion.OfflineRegionUpdateMetadataCallback() {
+                      @Override
+                      public void onUpdate(byte[] metadataBytes) {
+                        if (result == null) return;
+                        result.success(offlineRegionToMap(offlineRegion, metadataBytes));
+                      }
 
-                  String metadata = "{}";
-                  if (metadataMap != null) {
-                    metadata = new Gson().toJson(metadataMap);
+                      @Override
+                      public void onError(String error) {
+                        if (result == null) return;
+                        result.error("UpdateMetadataError", error, null);
+                      }
+                    });
+              }
+
+              @Override
+              public void onError(String error) {
+                if (result == null) return;
+                result.error("RegionListError", error, null);
+              }
+            });
+  }
+
+  /**
+   * Updates the metadata of several regions, {@code updates} holds the {@code id} and the {@code
+   * metadata} of each region. Responds with the updated regions once all updates are done, or with
+   * the ids of the regions that could not be updated.
+   */
+  static void updateRegionMetadataBatch(
+      MethodChannel.Result result, Context context, List<Map<String, Object>> updates) {
+    OfflineRegionIndex.instance(context)
+        .withRegions(
+            new OfflineRegionIndex.Callback() {
+              @Override
+              public void onRegions(Map<Long, OfflineRegion> regions) {
+                final BatchResult batch =
+                    new BatchResult(result, "UpdateMetadataError", updates.size());
+                for (Map<String, Object> update : updates) {
+                  final long id = ((Number) update.get("id")).longValue();
+                  final OfflineRegion offlineRegion = regions.get(id);
+                  if (offlineRegion == null) {
+                    batch.onFailure(id);
+                    continue;
                   }
-                  offlineRegion.updateMetadata(
-                      metadata.getBytes(),
+                  updateMetadata(
+                      offlineRegion,
+                      (Map<String, Object>) update.get("metadata"),
                       new OfflineRegion.OfflineRegionUpdateMetadataCallback() {
                         @Override
                         public void onUpdate(byte[] metadataBytes) {
-                          Map<String, Object> regionData = offlineRegionToMap(offlineRegion);
-                          regionData.put("metadata", metadataBytesToMap(metadataBytes));
-
-                          if (result == null) return;
-                          result.success(new Gson().toJson(regionData));
+                          batch.onSuccess(offlineRegionToMap(offlineRegion, metadataBytes));
                         }
 
                         @Override
                         public void onError(String error) {
-                          if (result == null) return;
-                          result.error("UpdateMetadataError", error, null);
+                          batch.onFailure(id);
                         }
                       });
-                  return;
                 }
-                if (result == null) return;
-                result.error(
-                    "UpdateMetadataError",
-                    "There is no " + "region with given id to " + "update.",
-                    null);
               }
 
               @Override
               public void onError(String error) {
-                if (result == null) return;
                 result.error("RegionListError", error, null);
               }
             });
   }
 
+  private static void updateMetadata(
+      OfflineRegion offlineRegion,
+      Map<String, Object> metadataMap,
+      OfflineRegion.OfflineRegionUpdateMetadataCallback callback) {
+    String metadata = "{}";
+    if (metadataMap != null) {
+      metadata = new Gson().toJson(metadataMap);
+    }
+    offlineRegion.updateMetadata(metadata.getBytes(), callback);
+  }
+
   static void deleteRegion(MethodChannel.Result result, Context context, long id) {
-    OfflineManager.Companion.getInstance(context)
-        .listOfflineRegions(
-            new OfflineManager.ListOfflineRegionsCallback() {
+    OfflineRegionIndex.instance(context)
+        .withRegion(
+            id,
+            new OfflineRegionIndex.RegionCallback() {
               @Override
-              public void onList(OfflineRegion[] offlineRegions) {
-                for (OfflineRegion offlineRegion : offlineRegions) {
-                  if (offlineRegion.getId() != id) continue;
+              public void onRegion(OfflineRegion offlineRegion) {
+                if (offlineRegion == null) {
+                  if (result == null) return;
+                  result.error(
+                      "DeleteRegionError",
+                      "There is no " + "region with given id to " + "delete.",
+                      null);
+                  return;
+                }
+                delete(
+                    context,
+                    offlineRegion,
+                    new OfflineRegion.OfflineRegionDeleteCallback() {
+                      @Override
+                      public void onDelete() {
+                        if (result == null) return;
+                        result.success(null);
+                      }
+
+                      @Override
+                      public void onError(String error) {
+                        if (result == null) return;
+                        result.error("DeleteRegionError", error, null);
+                      }
+                    });
+              }
+
+              @Override
+              public void onError(String error) {
+                if (result == null) return;
+                result.error("RegionListError", error, null);
+              }
+            });
+  }
 
-                  offlineRegion.delete(
+  /**
+   * Deletes several regions. Responds once all deletions are done, or with the ids of the regions
+   * that could not be deleted.
+   */
+  static void deleteRegions(MethodChannel.Result result, Context context, List<Number> ids) {
+    OfflineRegionIndex.instance(context)
+        .withRegions(
+            new OfflineRegionIndex.Callback() {
+              @Override
+              public void onRegions(Map<Long, OfflineRegion> regions) {
+                final BatchResult batch = new BatchResult(result, "DeleteRegionError", ids.size());
+                for (Number number : ids) {
+                  final long id = number.longValue();
+                  final OfflineRegion offlineRegion = regions.get(id);
+                  if (offlineRegion == null) {
+                    batch.onFailure(id);
+                    continue;
+                  }
+                  delete(
+                      context,
+                      offlineRegion,
                       new OfflineRegion.OfflineRegionDeleteCallback() {
                         @Override
                         public void onDelete() {
-                          if (result == null) return;
-                          result.success(null);
+                          batch.onSuccess(null);
                         }
 
                         @Override
                         public void onError(String error) {
-                          if (result == null) return;
-                          result.error("DeleteRegionError", error, null);
+                          batch.onFailure(id);
                         }
                       });
-                  return;
                 }
-                if (result == null) return;
-                result.error(
-                    "DeleteRegionError",
-                    "There is no " + "region with given id to " + "delete.",
-                    null);
               }
 
               @Override
               public void onError(String error) {
-                if (result == null) return;
                 result.error("RegionListError", error, null);
               }
             });
   }
 
+  private static void delete(
+      Context context,
+      OfflineRegion offlineRegion,
+      OfflineRegion.OfflineRegionDeleteCallback callback) {
+    offlineRegion.delete(
+        new OfflineRegion.OfflineRegionDeleteCallback() {
+          @Override
+          public void onDelete() {
+            OfflineRegionIndex.instance(context).remove(offlineRegion.getId());
+            callback.onDelete();
+          }
+
+          @Override
+          public void onError(String error) {
+            callback.onError(error);
+          }
+        });
+  }
+
+  /** Responds to a batch operation once all of its {@code count} operations are done. */
+  private static final class BatchResult {
+    private final MethodChannel.Result result;
+    private final String errorCode;
+    private final List<Map<String, Object>> regions = new ArrayList<>();
+    private final List<Long> failedIds = new ArrayList<>();
+    private int remaining;
+
+    BatchResult(MethodChannel.Result result, String errorCode, int count) {
+      this.result = result;
+      this.errorCode = errorCode;
+      this.remaining = count;
+      if (count == 0) result.success(regions);
+    }
+
+    void onSuccess(Map<String, Object> region) {
+      if (region != null) regions.add(region);
+      complete();
+    }
+
+    void onFailure(long id) {
+      failedIds.add(id);
+      complete();
+    }
+
+    private void complete() {
+      if (--remaining > 0) return;
+      if (failedIds.isEmpty()) {
+        result.success(regions);
+      } else {
+        result.error(errorCode, "Failed for the regions " + failedIds, failedIds);
+      }
+    }
+  }
+
   private static double calculateDownloadingProgress(
       long requiredResourceCount, long completedResourceCount) {
     return requiredResourceCount > 0
@@ -277,12 +472,28 @@ abstract class OfflineManagerUtils {
         : 0.0;
   }
 
-  private static OfflineRegionDefinition mapToRegionDefinition(
+  static OfflineRegionDefinition mapToRegionDefinition(
       Map<String, Object> map, float pixelDensity) {
     for (Map.Entry<String, Object> entry : map.entrySet()) {
       Log.d(TAG, entry.getKey());
+      // the coordinates of a corridor along a long route would flood the log
+      if (entry.getKey().equals("geometry") && entry.getValue() instanceof List) {
+        Log.d(TAG, ((List<?>) entry.getValue()).size() + " polygons");
+        continue;
+      }
       Log.d(TAG, entry.getValue().toString());
     }
+    final List<List<List<List<Double>>>> geometry =
+        (List<List<List<List<Double>>>>) map.get("geometry");
+    if (geometry != null) {
+      return new OfflineGeometryRegionDefinition(
+          (String) map.get("mapStyleUrl"),
+          listToMultiPolygon(geometry),
+          ((Number) map.get("minZoom")).doubleValue(),
+          ((Number) map.get("maxZoom")).doubleValue(),
+          pixelDensity,
+          (Boolean) map.get("includeIdeographs"));
+    }
     // Create a bounding box for the offline region
     return new OfflineTilePyramidRegionDefinition(
         (String) map.get("mapStyleUrl"),
@@ -300,11 +511,61 @@ abstract class OfflineManagerUtils {
         .build();
   }
 
-  private static Map<String, Object> offlineRegionToMap(OfflineRegion region) {
+  /** Converts polygons of rings of latitude and longitude pairs to a multi polygon. */
+  private static MultiPolygon listToMultiPolygon(List<List<List<List<Double>>>> polygons) {
+    final List<List<List<Point>>> points = new ArrayList<>();
+    for (List<List<List<Double>>> rings : polygons) {
+      final List<List<Point>> polygon = new ArrayList<>();
+      for (List<List<Double>> ring : rings) {
+        final List<Point> ringPoints = new ArrayList<>();
+        for (List<Double> latLng : ring) {
+          ringPoints.add(Point.fromLngLat(latLng.get(1), latLng.get(0)));
+        }
+        // geojson rings are closed
+        if (!ringPoints.isEmpty()
+            && !ringPoints.get(0).equals(ringPoints.get(ringPoints.size() - 1))) {
+          ringPoints.add(ringPoints.get(0));
+        }
+        polygon.add(ringPoints);
+      }
+      points.add(polygon);
+    }
+    return MultiPolygon.fromLngLats(points);
+  }
+
+  private static List<List<List<List<Double>>>> geometryToList(Geometry geometry) {
+    final List<List<List<Point>>> polygons;
+    if (geometry instanceof MultiPolygon) {
+      polygons = ((MultiPolygon) geometry).coordinates();
+    } else if (geometry instanceof Polygon) {
+      polygons = Collections.singletonList(((Polygon) geometry).coordinates());
+    } else {
+      return null;
+    }
+    final List<List<List<List<Double>>>> result = new ArrayList<>();
+    for (List<List<Point>> polygon : polygons) {
+      final List<List<List<Double>>> rings = new ArrayList<>();
+      for (List<Point> ring : polygon) {
+        final List<List<Double>> latLngs = new ArrayList<>();
+        for (Point point : ring) {
+          latLngs.add(Arrays.asList(point.latitude(), point.longitude()));
+        }
+        rings.add(latLngs);
+      }
+      result.add(rings);
+    }
+    return result;
+  }
+
+  static Map<String, Object> offlineRegionToMap(OfflineRegion region) {
+    return offlineRegionToMap(region, region.getMetadata());
+  }
+
+  private static Map<String, Object> offlineRegionToMap(OfflineRegion region, byte[] metadata) {
     Map<String, Object> result = new HashMap();
     result.put("id", region.getId());
     result.put("definition", offlineRegionDefinitionToMap(region.getDefinition()));
-    result.put("metadata", metadataBytesToMap(region.getMetadata()));
+    result.put("metadata", metadataBytesToMap(metadata));
     return result;
   }
 
@@ -316,6 +577,11 @@ abstract class OfflineManagerUtils {
     result.put("minZoom", definition.getMinZoom());
     result.put("maxZoom", definition.getMaxZoom());
     result.put("includeIdeographs", definition.getIncludeIdeographs());
+    if (definition instanceof OfflineGeometryRegionDefinition) {
+      result.put(
+          "geometry",
+          geometryToList(((OfflineGeometryRegionDefinition) definition).getGeometry()));
+    }
     return result;
   }
 
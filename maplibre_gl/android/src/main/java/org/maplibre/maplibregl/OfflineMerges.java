@@ -0,0 +1,295 @@
+package org.maplibre.maplibregl;
+
+import android.content.Context;
+import android.database.Cursor;
+import android.database.sqlite.SQLiteDatabase;
+import android.os.Handler;
+import android.os.Looper;
+import android.os.SystemClock;
+import android.util.Log;
+import androidx.annotation.NonNull;
+import io.flutter.plugin.common.BinaryMessenger;
+import io.flutter.plugin.common.EventChannel;
+import io.flutter.plugin.common.MethodChannel;
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.OutputStream;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.atomic.AtomicBoolean;
+import org.maplibre.android.offline.OfflineManager;
+import org.maplibre.android.offline.OfflineRegion;
+
+/**
+ * Merges side loaded offline databases in the background, with progress and cancellation.
+ *
+ * <p>A merge copies the database to the cache directory, which MapLibre needs writable anyway, and
+ * compares its tiles byte by byte with the tiles already stored. MapLibre replaces stored tiles
+ * by merged tiles that were modified later, so identical tiles are marked as modified at the
+ * time of the stored ones and are not written again. The copy is then merged by MapLibre, which
+ * can't be canceled or report progress. The status of all merges is reported on one shared event
+ * channel, progress at most every {@link #PROGRESS_INTERVAL_MS}.
+ */
+class OfflineMerges implements EventChannel.StreamHandler {
+  private static final String TAG = "OfflineMerges";
+  private static final String CHANNEL_NAME = "plugins.flutter.io/maplibre_gl/offline_merges";
+  private static final long PROGRESS_INTERVAL_MS = 250;
+  private static final int BUFFER_SIZE = 1024 * 1024;
+  private static final int BATCH_SIZE = 256;
+
+  private final Context context;
+  private final ExecutorService executor = Executors.newSingleThreadExecutor();
+  private final Handler mainHandler = new Handler(Looper.getMainLooper());
+  private final Map<Integer, AtomicBoolean> cancellations = new ConcurrentHashMap<>();
+  private int nextId = 0;
+  private EventChannel.EventSink sink;
+
+  OfflineMerges(Context context, BinaryMessenger messenger) {
+    this.context = context;
+    new EventChannel(messenger, CHANNEL_NAME).setStreamHandler(this);
+  }
+
+  @Override
+  public void onListen(Object arguments, EventChannel.EventSink events) {
+    sink = events;
+  }
+
+  @Override
+  public void onCancel(Object arguments) {
+    sink = null;
+  }
+
+  /** Starts merging the database at {@code path} and returns the id of the merge. */
+  void start(MethodChannel.Result result, String path) {
+    final int id = nextId++;
+    final AtomicBoolean isCanceled = new AtomicBoolean();
+    cancellations.put(id, isCanceled);
+    result.success(id);
+    executor.execute(() -> prepare(id, new File(path), isCanceled));
+  }
+
+  /** Cancels the merge {@code id}, unless MapLibre already merges it. */
+  void cancel(MethodChannel.Result result, int id) {
+    final AtomicBoolean isCanceled = cancellations.get(id);
+    if (isCanceled != null) isCanceled.set(true);
+    result.success(null);
+  }
+
+  private static class CanceledException extends Exception {}
+
+  /** The progress of a merge, updated on the background thread. */
+  private static class Progress {
+    final int id;
+    String phase = "copying";
+    long completedBytes;
+    long totalBytes;
+    long completedTiles;
+    long totalTiles;
+    long skippedTiles;
+    long skippedBytes;
+    long lastSent;
+
+    Progress(int id) {
+      this.id = id;
+    }
+
+    Map<String, Object> toMap(String status) {
+      final Map<String, Object> event = new HashMap<>();
+      event.put("id", id);
+      event.put("status", status);
+      event.put("phase", phase);
+      event.put("completedBytes", completedBytes);
+      event.put("totalBytes", totalBytes);
+      event.put("completedTiles", completedTiles);
+      event.put("totalTiles", totalTiles);
+      event.put("skippedTiles", skippedTiles);
+      event.put("skippedBytes", skippedBytes);
+      return event;
+    }
+  }
+
+  private void prepare(int id, File source, AtomicBoolean isCanceled) {
+    final File copy = new File(context.getCacheDir(), "offline_merge_" + id + ".db");
+    final Progress progress = new Progress(id);
+    try {
+      copy(source, copy, progress, isCanceled);
+      progress.phase = "deduplicating";
+      deduplicate(copy, progress, isCanceled);
+      progress.phase = "merging";
+      sendProgress(progress, true);
+      mainHandler.post(() -> merge(copy, progress));
+    } catch (CanceledException e) {
+      finish(copy, id);
+      send(progress.toMap("canceled"));
+    } catch (Exception e) {
+      Log.e(TAG, "Merge of " + source + " failed", e);
+      finish(copy, id);
+      final Map<String, Object> event = progress.toMap("error");
+      event.put("errorMessage", String.valueOf(e.getMessage()));
+      send(event);
+    }
+  }
+
+  private void copy(File source, File destination, Progress progress, AtomicBoolean isCanceled)
+      throws IOException, CanceledException {
+    progress.totalBytes = source.length();
+    final byte[] buffer = new byte[BUFFER_SIZE];
+    try (InputStream input = new FileInputStream(source);
+        OutputStream output = new FileOutputStream(destination)) {
+      int n;
+      while ((n = input.read(buffer)) != -1) {
+        if (isCanceled.get()) throw new CanceledException();
+        output.write(buffer, 0, n);
+        progress.completedBytes += n;
+        sendProgress(progress, false);
+      }
+    }
+  }
+
+  private void deduplicate(File copy, Progress progress, AtomicBoolean isCanceled)
+      throws CanceledException {
+    final File database = OfflineManagerUtils.databaseFile(context);
+    try (SQLiteDatabase side =
+        SQLiteDatabase.openDatabase(copy.getPath(), null, SQLiteDatabase.OPEN_READWRITE)) {
+      try (Cursor totals = side.rawQuery("SELECT COUNT(*), TOTAL(LENGTH(data)) FROM tiles", null)) {
+        totals.moveToFirst();
+        progress.totalTiles = totals.getLong(0);
+        progress.totalBytes = totals.getLong(1);
+        progress.completedBytes = 0;
+      }
+      if (!database.exists()) {
+        progress.completedTiles = progress.totalTiles;
+        progress.completedBytes = progress.totalBytes;
+        return;
+      }
+      try (SQLiteDatabase main =
+          SQLiteDatabase.openDatabase(database.getPath(), null, SQLiteDatabase.OPEN_READONLY)) {
+        long lastId = -1;
+        while (true) {
+          if (isCanceled.get()) throw new CanceledException();
+          final List<long[]> updates = new ArrayList<>();
+          int rows = 0;
+          try (Cursor tiles =
+              side.rawQuery(
+                  "SELECT id, url_template, pixel_ratio, z, x, y, modified, data FROM tiles"
+                      + " WHERE id > ? ORDER BY id LIMIT " + BATCH_SIZE,
+                  new String[] {String.valueOf(lastId)})) {
+            while (tiles.moveToNext()) {
+              rows++;
+              lastId = tiles.getLong(0);
+              final byte[] data = tiles.getBlob(7) != null ? tiles.getBlob(7) : new byte[0];
+              final long size = data.length;
+              final long storedModified = storedModifiedIfIdentical(main, tiles, data);
+              if (storedModified != Long.MIN_VALUE) {
+                progress.skippedTiles++;
+                progress.skippedBytes += size;
+                if (tiles.isNull(6) || tiles.getLong(6) > storedModified) {
+                  updates.add(new long[] {lastId, storedModified});
+                }
+              }
+              progress.completedTiles++;
+              progress.completedBytes += size;
+            }
+          }
+          if (!updates.isEmpty()) {
+            side.beginTransaction();
+            try {
+              for (long[] update : updates) {
+                side.execSQL(
+                    "UPDATE tiles SET modified = ? WHERE id = ?",
+                    new Object[] {update[1], update[0]});
+              }
+              side.setTransactionSuccessful();
+            } finally {
+              side.endTransaction();
+            }
+          }
+          sendProgress(progress, false);
+          if (rows < BATCH_SIZE) break;
+        }
+      }
+    }
+  }
+
+  /**
+   * The modification time of the stored tile with the key of the current row of {@code tiles}, if
+   * its data equals {@code data}, otherwise {@link Long#MIN_VALUE}.
+   */
+  private static long storedModifiedIfIdentical(SQLiteDatabase main, Cursor tiles, byte[] data) {
+    try (Cursor stored =
+        main.rawQuery(
+            "SELECT modified, data FROM tiles WHERE url_template = ? AND pixel_ratio = ?"
+                + " AND z = ? AND x = ? AND y = ?",
+            new String[] {
+              tiles.getString(1),
+              tiles.getString(2),
+              tiles.getString(3),
+              tiles.getString(4),
+              tiles.getString(5)
+            })) {
+      if (!stored.moveToFirst() || stored.isNull(0)) return Long.MIN_VALUE;
+      final byte[] storedData = stored.getBlob(1) != null ? stored.getBlob(1) : new byte[0];
+      return Arrays.equals(data, storedData) ? stored.getLong(0) : Long.MIN_VALUE;
+    }
+  }
+
+  private void merge(File copy, Progress progress) {
+    OfflineManager.Companion.getInstance(context)
+        .mergeOfflineRegions(
+            copy.getPath(),
+            new OfflineManager.MergeOfflineRegionsCallback() {
+              @Override
+              public void onMerge(@NonNull OfflineRegion[] offlineRegions) {
+                finish(copy, progress.id);
+                final OfflineRegionIndex index = OfflineRegionIndex.instance(context);
+                final List<Map<String, Object>> regions = new ArrayList<>();
+                for (OfflineRegion region : offlineRegions) {
+                  index.put(region);
+                  regions.add(OfflineManagerUtils.offlineRegionToMap(region));
+                }
+                final Map<String, Object> event = progress.toMap("complete");
+                event.put("regions", regions);
+                send(event);
+              }
+
+              @Override
+              public void onError(@NonNull String error) {
+                finish(copy, progress.id);
+                final Map<String, Object> event = progress.toMap("error");
+                event.put("errorMessage", error);
+                send(event);
+              }
+            });
+  }
+
+  private void finish(File copy, int id) {
+    cancellations.remove(id);
+    if (copy.exists() && !copy.delete()) {
+      Log.w(TAG, "Could not delete " + copy);
+    }
+  }
+
+  private void sendProgress(Progress progress, boolean force) {
+    final long now = SystemClock.elapsedRealtime();
+    if (!force && now - progress.lastSent < PROGRESS_INTERVAL_MS) return;
+    progress.lastSent = now;
+    send(progress.toMap("progress"));
+  }
+
+  /** Sends {@code event} on the main thread, from which event sinks must be called. */
+  private void send(Map<String, Object> event) {
+    mainHandler.post(
+        () -> {
+          if (sink != null) sink.success(event);
+        });
+  }
+}
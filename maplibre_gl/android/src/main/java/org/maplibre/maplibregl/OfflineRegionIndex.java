@@ -0,0 +1,121 @@
+package org.maplibre.maplibregl;
+
+import android.content.Context;
+import androidx.annotation.NonNull;
+import java.util.ArrayList;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import org.maplibre.android.offline.OfflineManager;
+import org.maplibre.android.offline.OfflineRegion;
+
+/**
+ * The offline regions by id. They are listed from the database once and kept up to date as the
+ * plugin creates, merges and deletes regions, so operations on a single region don't list and scan
+ * all regions. All methods are called on the main thread, like the callbacks of the {@link
+ * OfflineManager}.
+ */
+final class OfflineRegionIndex {
+  interface Callback {
+    void onRegions(Map<Long, OfflineRegion> regions);
+
+    void onError(String error);
+  }
+
+  interface RegionCallback {
+    void onRegion(OfflineRegion region);
+
+    void onError(String error);
+  }
+
+  private static OfflineRegionIndex instance;
+
+  private final Context context;
+  private final Map<Long, OfflineRegion> regions = new LinkedHashMap<>();
+  private boolean isLoaded;
+  private List<Callback> pendingCallbacks;
+
+  private OfflineRegionIndex(Context context) {
+    this.context = context.getApplicationContext();
+  }
+
+  static OfflineRegionIndex instance(Context context) {
+    if (instance == null) {
+      instance = new OfflineRegionIndex(context);
+    }
+    return instance;
+  }
+
+  /** Calls {@code callback} with the regions, listing them from the database on first use. */
+  void withRegions(Callback callback) {
+    if (isLoaded) {
+      callback.onRegions(regions);
+      return;
+    }
+    if (pendingCallbacks != null) {
+      pendingCallbacks.add(callback);
+      return;
+    }
+    pendingCallbacks = new ArrayList<>();
+    pendingCallbacks.add(callback);
+    OfflineManager.Companion.getInstance(context)
+        .listOfflineRegions(
+            new OfflineManager.ListOfflineRegionsCallback() {
+              @Override
+              public void onList(OfflineRegion[] offlineRegions) {
+                for (OfflineRegion region : offlineRegions) {
+                  // keeps regions created while listing
+                  if (!regions.containsKey(region.getId())) {
+                    regions.put(region.getId(), region);
+                  }
+                }
+                isLoaded = true;
+                final List<Callback> callbacks = pendingCallbacks;
+                pendingCallbacks = null;
+                for (Callback pending : callbacks) {
+                  pending.onRegions(regions);
+                }
+              }
+
+              @Override
+              public void onError(@NonNull String error) {
+                final List<Callback> callbacks = pendingCallbacks;
+                pendingCallbacks = null;
+                for (Callback pending : callbacks) {
+                  pending.onError(error);
+                }
+              }
+            });
+  }
+
+  /** Calls {@code callback} with the region {@code id}, or with null if there is none. */
+  void withRegion(long id, RegionCallback callback) {
+    withRegions(
+        new Callback() {
+          @Override
+          public void onRegions(Map<Long, OfflineRegion> regions) {
+            callback.onRegion(regions.get(id));
+          }
+
+          @Override
+          public void onError(String error) {
+            callback.onError(error);
+          }
+        });
+  }
+
+  /** Adds a region created or merged by the plugin. */
+  void put(OfflineRegion region) {
+    regions.put(region.getId(), region);
+  }
+
+  void remove(long id) {
+    regions.remove(id);
+  }
+
+  /** Lists the regions again on next use, e.g. after the database was replaced. */
+  void invalidate() {
+    regions.clear();
+    isLoaded = false;
+  }
+}
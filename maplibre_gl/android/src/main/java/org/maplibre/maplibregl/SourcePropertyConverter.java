@@ -6,6 +6,7 @@ import org.maplibre.geojson.FeatureCollection;
 import org.maplibre.android.geometry.LatLng;
 import org.maplibre.android.geometry.LatLngQuad;
 import org.maplibre.android.maps.Style;
+import org.maplibre.android.style.expressions.Expression;
 import org.maplibre.android.style.sources.GeoJsonOptions;
 import org.maplibre.android.style.sources.GeoJsonSource;
 import org.maplibre.android.style.sources.ImageSource;
@@ -88,6 +89,28 @@ class SourcePropertyConverter {
       options = options.withClusterRadius(Convert.toInt(clusterRadius));
     }
 
+    final Object clusterProperties = data.get("clusterProperties");
+    if (clusterProperties instanceof Map) {
+      final Gson gson = new Gson();
+      for (Map.Entry<?, ?> entry : ((Map<?, ?>) clusterProperties).entrySet()) {
+        if (!(entry.getValue() instanceof List) || ((List<?>) entry.getValue()).size() != 2) {
+          continue;
+        }
+        final List<?> property = (List<?>) entry.getValue();
+        // the operator is either the name of an expression like "+" or a
+        // custom reduce expression using ["accumulated"]
+        final Expression operator =
+            property.get(0) instanceof String
+                ? Expression.literal((String) property.get(0))
+                : Expression.Converter.convert(gson.toJsonTree(property.get(0)));
+        options =
+            options.withClusterProperty(
+                (String) entry.getKey(),
+                operator,
+                Expression.Converter.convert(gson.toJsonTree(property.get(1))));
+      }
+    }
+
     final Object lineMetrics = data.get("lineMetrics");
     if (lineMetrics != null) {
       options = options.withLineMetrics(Convert.toBoolean(lineMetrics));
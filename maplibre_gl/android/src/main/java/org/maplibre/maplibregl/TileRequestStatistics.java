@@ -0,0 +1,146 @@
+package org.maplibre.maplibregl;
+
+import androidx.annotation.NonNull;
+import java.io.IOException;
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.TimeUnit;
+import java.util.regex.Pattern;
+import okhttp3.Call;
+import okhttp3.EventListener;
+import okhttp3.HttpUrl;
+import okhttp3.Response;
+
+/**
+ * Records the requests of the OkHttp client per source, with an {@link EventListener} per call.
+ *
+ * <p>A source is identified by its url template, the url without query and with the tile
+ * coordinates replaced by {@code {z}/{x}/{y}}. The latencies of the last {@link #MAX_LATENCIES}
+ * requests of each source are kept for percentiles.
+ */
+final class TileRequestStatistics extends EventListener {
+  static final EventListener.Factory FACTORY = call -> new TileRequestStatistics();
+
+  private static final int MAX_LATENCIES = 1000;
+  private static final Pattern TILE_COORDINATES =
+      Pattern.compile("/\\d+/\\d+/\\d+(?=[./@]|$)");
+  private static final Map<String, SourceStatistics> sources = new ConcurrentHashMap<>();
+
+  private long start;
+  private long latency;
+  private long bytes;
+  private int code;
+  private boolean isHttpCacheHit;
+
+  /** The statistics per source since the last reset, see {@link SourceStatistics#toMap()}. */
+  static Map<String, Object> toMap(boolean reset) {
+    Map<String, Object> result = new HashMap<>();
+    for (Map.Entry<String, SourceStatistics> entry : sources.entrySet()) {
+      result.put(entry.getKey(), entry.getValue().toMap());
+    }
+    if (reset) {
+      sources.clear();
+    }
+    return result;
+  }
+
+  static String sourceOf(HttpUrl url) {
+    String path = TILE_COORDINATES.matcher(url.encodedPath()).replaceFirst("/{z}/{x}/{y}");
+    return url.scheme() + "://" + url.host() + path;
+  }
+
+  @Override
+  public void callStart(@NonNull Call call) {
+    start = System.nanoTime();
+  }
+
+  @Override
+  public void responseHeadersEnd(@NonNull Call call, @NonNull Response response) {
+    latency = TimeUnit.NANOSECONDS.toMillis(System.nanoTime() - start);
+    code = response.code();
+  }
+
+  @Override
+  public void responseBodyEnd(@NonNull Call call, long byteCount) {
+    bytes = byteCount;
+  }
+
+  @Override
+  public void cacheHit(@NonNull Call call, @NonNull Response response) {
+    isHttpCacheHit = true;
+    code = response.code();
+    latency = TimeUnit.NANOSECONDS.toMillis(System.nanoTime() - start);
+  }
+
+  @Override
+  public void callEnd(@NonNull Call call) {
+    sourceStatistics(call).record(latency, bytes, code, isHttpCacheHit);
+  }
+
+  @Override
+  public void callFailed(@NonNull Call call, @NonNull IOException ioe) {
+    if (call.isCanceled()) {
+      // MapLibre cancels the requests of tiles that left the viewport
+      return;
+    }
+    sourceStatistics(call).record(
+        TimeUnit.NANOSECONDS.toMillis(System.nanoTime() - start), bytes, 0, false);
+  }
+
+  private static SourceStatistics sourceStatistics(Call call) {
+    String source = sourceOf(call.request().url());
+    SourceStatistics statistics = sources.get(source);
+    if (statistics == null) {
+      // a reset may clear the map in between, so the entry is not looked up again
+      SourceStatistics created = new SourceStatistics();
+      SourceStatistics existing = sources.putIfAbsent(source, created);
+      statistics = existing != null ? existing : created;
+    }
+    return statistics;
+  }
+
+  private static final class SourceStatistics {
+    private long requests;
+    private long failures;
+    private long networkResponses;
+    private long ambientCacheHits;
+    private long httpCacheHits;
+    private long bytes;
+    private final long[] latencies = new long[MAX_LATENCIES];
+
+    synchronized void record(long latency, long bytes, int code, boolean isHttpCacheHit) {
+      latencies[(int) (requests % MAX_LATENCIES)] = latency;
+      requests++;
+      this.bytes += bytes;
+      if (isHttpCacheHit) {
+        httpCacheHits++;
+      } else if (code == 304) {
+        // MapLibre revalidates the tiles of its ambient cache with conditional requests
+        ambientCacheHits++;
+      } else if (code >= 200 && code < 300) {
+        networkResponses++;
+      } else {
+        failures++;
+      }
+    }
+
+    synchronized Map<String, Object> toMap() {
+      List<Long> latencies = new ArrayList<>();
+      for (int i = 0; i < Math.min(requests, MAX_LATENCIES); i++) {
+        latencies.add(this.latencies[i]);
+      }
+      Map<String, Object> map = new HashMap<>();
+      map.put("requests", requests);
+      map.put("failures", failures);
+      map.put("networkResponses", networkResponses);
+      map.put("ambientCacheHits", ambientCacheHits);
+      map.put("httpCacheHits", httpCacheHits);
+      map.put("bytes", bytes);
+      map.put("latencies", latencies);
+      return map;
+    }
+  }
+}
@@ -1,12 +1,13 @@
 // This file is generated by
 // ./scripts/lib/generate.dart
 
+import Flutter
 import MapLibre
 
 class LayerPropertyConverter {
-    class func addSymbolProperties(symbolLayer: MLNSymbolStyleLayer, properties: [String: String]) {
+    class func addSymbolProperties(symbolLayer: MLNSymbolStyleLayer, properties: [String: Any]) {
         for (propertyName, propertyValue) in properties {
-            let expression = interpretExpression(propertyName: propertyName, expression: propertyValue)
+            let expression = interpretExpression(propertyName: propertyName, value: propertyValue)
             switch propertyName {
                 case "icon-opacity":
                     symbolLayer.iconOpacity = expression
@@ -119,8 +120,7 @@ class LayerPropertyConverter {
                 case "text-optional":
                     symbolLayer.textOptional = expression
                 case "visibility":
-                    let trimmedPropertyValue = propertyValue.trimmingCharacters(in: .init(charactersIn: "\""))
-                    symbolLayer.isVisible = trimmedPropertyValue == "visible"
+                    symbolLayer.isVisible = propertyValue as? String == "visible"
              
                 default:
                     break
@@ -128,9 +128,9 @@ class LayerPropertyConverter {
         }
     }
 
-    class func addCircleProperties(circleLayer: MLNCircleStyleLayer, properties: [String: String]) {
+    class func addCircleProperties(circleLayer: MLNCircleStyleLayer, properties: [String: Any]) {
         for (propertyName, propertyValue) in properties {
-            let expression = interpretExpression(propertyName: propertyName, expression: propertyValue)
+            let expression = interpretExpression(propertyName: propertyName, value: propertyValue)
             switch propertyName {
                 case "circle-radius":
                     circleLayer.circleRadius = expression
@@ -157,8 +157,7 @@ class LayerPropertyConverter {
                 case "circle-sort-key":
                     circleLayer.circleSortKey = expression
                 case "visibility":
-                    let trimmedPropertyValue = propertyValue.trimmingCharacters(in: .init(charactersIn: "\""))
-                    circleLayer.isVisible = trimmedPropertyValue == "visible"
+                    circleLayer.isVisible = propertyValue as? String == "visible"
              
                 default:
                     break
@@ -166,9 +165,9 @@ class LayerPropertyConverter {
         }
     }
 
-    class func addLineProperties(lineLayer: MLNLineStyleLayer, properties: [String: String]) {
+    class func addLineProperties(lineLayer: MLNLineStyleLayer, properties: [String: Any]) {
         for (propertyName, propertyValue) in properties {
-            let expression = interpretExpression(propertyName: propertyName, expression: propertyValue)
+            let expression = interpretExpression(propertyName: propertyName, value: propertyValue)
             switch propertyName {
                 case "line-opacity":
                     lineLayer.lineOpacity = expression
@@ -203,8 +202,7 @@ class LayerPropertyConverter {
                 case "line-sort-key":
                     lineLayer.lineSortKey = expression
                 case "visibility":
-                    let trimmedPropertyValue = propertyValue.trimmingCharacters(in: .init(charactersIn: "\""))
-                    lineLayer.isVisible = trimmedPropertyValue == "visible"
+                    lineLayer.isVisible = propertyValue as? String == "visible"
              
                 default:
                     break
@@ -212,9 +210,9 @@ class LayerPropertyConverter {
         }
     }
 
-    class func addFillProperties(fillLayer: MLNFillStyleLayer, properties: [String: String]) {
+    class func addFillProperties(fillLayer: MLNFillStyleLayer, properties: [String: Any]) {
         for (propertyName, propertyValue) in properties {
-            let expression = interpretExpression(propertyName: propertyName, expression: propertyValue)
+            let expression = interpretExpression(propertyName: propertyName, value: propertyValue)
             switch propertyName {
                 case "fill-antialias":
                     fillLayer.fillAntialiased = expression
@@ -233,8 +231,7 @@ class LayerPropertyConverter {
                 case "fill-sort-key":
                     fillLayer.fillSortKey = expression
                 case "visibility":
-                    let trimmedPropertyValue = propertyValue.trimmingCharacters(in: .init(charactersIn: "\""))
-                    fillLayer.isVisible = trimmedPropertyValue == "visible"
+                    fillLayer.isVisible = propertyValue as? String == "visible"
              
                 default:
                     break
@@ -242,9 +239,9 @@ class LayerPropertyConverter {
         }
     }
 
-    class func addFillExtrusionProperties(fillExtrusionLayer: MLNFillExtrusionStyleLayer, properties: [String: String]) {
+    class func addFillExtrusionProperties(fillExtrusionLayer: MLNFillExtrusionStyleLayer, properties: [String: Any]) {
         for (propertyName, propertyValue) in properties {
-            let expression = interpretExpression(propertyName: propertyName, expression: propertyValue)
+            let expression = interpretExpression(propertyName: propertyName, value: propertyValue)
             switch propertyName {
                 case "fill-extrusion-opacity":
                     fillExtrusionLayer.fillExtrusionOpacity = expression
@@ -263,8 +260,7 @@ class LayerPropertyConverter {
                 case "fill-extrusion-vertical-gradient":
                     fillExtrusionLayer.fillExtrusionHasVerticalGradient = expression
                 case "visibility":
-                    let trimmedPropertyValue = propertyValue.trimmingCharacters(in: .init(charactersIn: "\""))
-                    fillExtrusionLayer.isVisible = trimmedPropertyValue == "visible"
+                    fillExtrusionLayer.isVisible = propertyValue as? String == "visible"
              
                 default:
                     break
@@ -272,9 +268,9 @@ class LayerPropertyConverter {
         }
     }
 
-    class func addRasterProperties(rasterLayer: MLNRasterStyleLayer, properties: [String: String]) {
+    class func addRasterProperties(rasterLayer: MLNRasterStyleLayer, properties: [String: Any]) {
         for (propertyName, propertyValue) in properties {
-            let expression = interpretExpression(propertyName: propertyName, expression: propertyValue)
+            let expression = interpretExpression(propertyName: propertyName, value: propertyValue)
             switch propertyName {
                 case "raster-opacity":
                     rasterLayer.rasterOpacity = expression
@@ -293,8 +289,7 @@ class LayerPropertyConverter {
                 case "raster-fade-duration":
                     rasterLayer.rasterFadeDuration = expression
                 case "visibility":
-                    let trimmedPropertyValue = propertyValue.trimmingCharacters(in: .init(charactersIn: "\""))
-                    rasterLayer.isVisible = trimmedPropertyValue == "visible"
+                    rasterLayer.isVisible = propertyValue as? String == "visible"
              
                 default:
                     break
@@ -302,9 +297,9 @@ class LayerPropertyConverter {
         }
     }
 
-    class func addHillshadeProperties(hillshadeLayer: MLNHillshadeStyleLayer, properties: [String: String]) {
+    class func addHillshadeProperties(hillshadeLayer: MLNHillshadeStyleLayer, properties: [String: Any]) {
         for (propertyName, propertyValue) in properties {
-            let expression = interpretExpression(propertyName: propertyName, expression: propertyValue)
+            let expression = interpretExpression(propertyName: propertyName, value: propertyValue)
             switch propertyName {
                 case "hillshade-illumination-direction":
                     hillshadeLayer.hillshadeIlluminationDirection = expression
@@ -319,8 +314,7 @@ class LayerPropertyConverter {
                 case "hillshade-accent-color":
                     hillshadeLayer.hillshadeAccentColor = expression
                 case "visibility":
-                    let trimmedPropertyValue = propertyValue.trimmingCharacters(in: .init(charactersIn: "\""))
-                    hillshadeLayer.isVisible = trimmedPropertyValue == "visible"
+                    hillshadeLayer.isVisible = propertyValue as? String == "visible"
              
                 default:
                     break
@@ -328,9 +322,9 @@ class LayerPropertyConverter {
         }
     }
 
-    class func addHeatmapProperties(heatmapLayer: MLNHeatmapStyleLayer, properties: [String: String]) {
+    class func addHeatmapProperties(heatmapLayer: MLNHeatmapStyleLayer, properties: [String: Any]) {
         for (propertyName, propertyValue) in properties {
-            let expression = interpretExpression(propertyName: propertyName, expression: propertyValue)
+            let expression = interpretExpression(propertyName: propertyName, value: propertyValue)
             switch propertyName {
                 case "heatmap-radius":
                     heatmapLayer.heatmapRadius = expression
@@ -343,8 +337,7 @@ class LayerPropertyConverter {
                 case "heatmap-opacity":
                     heatmapLayer.heatmapOpacity = expression
                 case "visibility":
-                    let trimmedPropertyValue = propertyValue.trimmingCharacters(in: .init(charactersIn: "\""))
-                    heatmapLayer.isVisible = trimmedPropertyValue == "visible"
+                    heatmapLayer.isVisible = propertyValue as? String == "visible"
              
                 default:
                     break
@@ -352,52 +345,45 @@ class LayerPropertyConverter {
         }
     }
 
-    private class func interpretExpression(propertyName: String, expression: String) -> NSExpression? {
+    /// Literal values arrive in their message codec representation and are
+    /// turned into constant expressions directly, only nested arrays and
+    /// dictionaries are interpreted as expressions.
+    private class func interpretExpression(propertyName: String, value: Any) -> NSExpression? {
         let isColor = propertyName.contains("color");
         let isOffset = propertyName.contains("offset");
         let isTranslate = propertyName.contains("translate");
 
-        do {
-            let json = try JSONSerialization.jsonObject(with: expression.data(using: .utf8)!, options: .fragmentsAllowed)
+        switch value {
+        case let string as String:
             // this is required because NSExpression.init(mglJSONObject: json) fails to create
             // a proper Expression if the data of is a hexString
             if isColor {
-                if let color = json as? String {
-                    return NSExpression(forConstantValue: UIColor(hexString: color))
-                }
+                return NSExpression(forConstantValue: UIColor(hexString: string))
             }
-
-            if let offset = json as? [Any]{
-                // checks on the value of property that are literal expressions
-                if offset.count == 2 && offset.first is String && offset.first as? String == "literal" {
-                    if let vector = offset.last as? [Any]{
-                        if(vector.count == 2) {
-                            if isOffset || isTranslate {
-                                // this is required because NSExpression.init(mglJSONObject: json) fails to create
-                                // a proper Expression if the data of a literal is an array destined for a CGVector
-                                if let x = vector.first as? Double, let y = vector.last as? Double {
-                                    return NSExpression(forConstantValue: NSValue(cgVector: CGVector(dx: x, dy: y)))
-                                }
-                            }
-                            return NSExpression.init(mglJSONObject: json)
-                        }
-                    }
-                // checks on the value of properties that are arrays
-                } else if offset.count == 2, let x = offset.first as? Double, let y = offset.last as? Double {
-                    if isOffset || isTranslate {
-                        // this is required because NSExpression.init(mglJSONObject: json) fails to create
-                        // a proper Expression if the data of an array is destined for a CGVector
-                        return NSExpression(forConstantValue: NSValue(cgVector: CGVector(dx: x, dy: y)))
-                    }
-                    // this is required because NSExpression.init(mglJSONObject: json) fails to create
-                    // a proper Expression if the data is an array of double
-                    return NSExpression(forConstantValue: [NSNumber(value: x), NSNumber(value: y)])
-                }
+            return NSExpression(forConstantValue: string)
+        case let number as NSNumber:
+            return NSExpression(forConstantValue: number)
+        case let typedData as FlutterStandardTypedData:
+            let values = typedData.data.withUnsafeBytes { Array($0.bindMemory(to: Double.self)) }
+            if values.count == 2 && (isOffset || isTranslate) {
+                return NSExpression(forConstantValue: NSValue(cgVector: CGVector(dx: values[0], dy: values[1])))
+            }
+            return NSExpression(forConstantValue: values.map { NSNumber(value: $0) })
+        case let array as [Any]:
+            // checks on the value of property that are literal expressions
+            if array.count == 2 && array.first as? String == "literal",
+               let vector = array.last as? [Any], vector.count == 2,
+               isOffset || isTranslate,
+               let x = vector.first as? Double, let y = vector.last as? Double {
+                // this is required because NSExpression.init(mglJSONObject: json) fails to create
+                // a proper Expression if the data of a literal is an array destined for a CGVector
+                return NSExpression(forConstantValue: NSValue(cgVector: CGVector(dx: x, dy: y)))
             }
-            
-            return NSExpression.init(mglJSONObject: json)
-        } catch {
+            return NSExpression(mglJSONObject: array)
+        case let dictionary as [String: Any]:
+            return NSExpression(mglJSONObject: dictionary)
+        default:
+            return nil
         }
-        return nil
     }
 }
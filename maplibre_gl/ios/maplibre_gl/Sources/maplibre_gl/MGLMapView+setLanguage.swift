@@ -25,7 +25,9 @@ extension MLNMapView {
                     continue
                 }
                 
-                let properties = ["text-field": "[\"coalesce\",[\"get\",\"name:\(language)\"],[\"get\",\"name:latin\"],[\"get\",\"name\"]]"]
+                let properties: [String: Any] = [
+                    "text-field": ["coalesce", ["get", "name:\(language)"], ["get", "name:latin"], ["get", "name"]]
+                ]
                     
                 LayerPropertyConverter.addSymbolProperties(
                     symbolLayer: symbolLayer,
@@ -25,11 +25,21 @@ class MapLibreMapController: NSObject, FlutterPlatformView, MLNMapViewDelegate,
 
     private var interactiveFeatureLayerIds = Set<String>()
     private var addedShapesByLayer = [String: MLNShape]()
+    /// Feature state by feature id by source id. MapLibre iOS has no feature state support, the
+    /// state is merged into the feature attributes with the prefix `featureStatePrefix`.
+    private var featureStateBySource = [String: [String: [String: Any]]]()
+    private let featureStatePrefix = "feature-state:"
+    /// Sources of moving points by source id, see `MotionSource`.
+    private var motionSources = [String: MotionSource]()
 
     func view() -> UIView {
         return mapView
     }
 
+    deinit {
+        stopMotionSources()
+    }
+
     init(
         withFrame frame: CGRect,
         viewIdentifier viewId: Int64,
@@ -158,6 +168,13 @@ class MapLibreMapController: NSObject, FlutterPlatformView, MLNMapViewDelegate,
                     result(nil)
                 }
             }
+        case "map#setPrefetchZoomDelta":
+            guard let arguments = methodCall.arguments as? [String: Any],
+                  let delta = arguments["delta"] as? Int
+            else { return }
+            // the zoom delta is not exposed on iOS, only whether tiles are prefetched
+            mapView.prefetchesTiles = delta > 0
+            result(nil)
         case "map#clearAmbientCache":
             MLNOfflineStorage.shared.clearAmbientCache {
                 error in
@@ -354,7 +371,7 @@ class MapLibreMapController: NSObject, FlutterPlatformView, MLNMapViewDelegate,
             guard let arguments = methodCall.arguments as? [String: Any] else { return }
             guard let sourceId = arguments["sourceId"] as? String else { return }
             guard let layerId = arguments["layerId"] as? String else { return }
-            guard let properties = arguments["properties"] as? [String: String] else { return }
+            guard let properties = arguments["properties"] as? [String: Any] else { return }
             guard let enableInteraction = arguments["enableInteraction"] as? Bool else { return }
             let belowLayerId = arguments["belowLayerId"] as? String
             let sourceLayer = arguments["sourceLayer"] as? String
@@ -382,7 +399,7 @@ class MapLibreMapController: NSObject, FlutterPlatformView, MLNMapViewDelegate,
             guard let arguments = methodCall.arguments as? [String: Any] else { return }
             guard let sourceId = arguments["sourceId"] as? String else { return }
             guard let layerId = arguments["layerId"] as? String else { return }
-            guard let properties = arguments["properties"] as? [String: String] else { return }
+            guard let properties = arguments["properties"] as? [String: Any] else { return }
             guard let enableInteraction = arguments["enableInteraction"] as? Bool else { return }
             let belowLayerId = arguments["belowLayerId"] as? String
             let sourceLayer = arguments["sourceLayer"] as? String
@@ -409,7 +426,7 @@ class MapLibreMapController: NSObject, FlutterPlatformView, MLNMapViewDelegate,
         case "layer#setProperties":
             guard let arguments = methodCall.arguments as? [String: Any] else { return }
             guard let layerId = arguments["layerId"] as? String else { return }
-            guard let properties = arguments["properties"] as? [String: String] else { return }
+            guard let properties = arguments["properties"] as? [String: Any] else { return }
 
             guard let layer = mapView.style?.layer(withIdentifier: layerId) else {
                 result(FlutterError(
@@ -420,21 +437,7 @@ class MapLibreMapController: NSObject, FlutterPlatformView, MLNMapViewDelegate,
                 return
             }
 
-            //switch depending on the runtime type of layer
-            switch layer {
-            case let lineLayer as MLNLineStyleLayer:
-                LayerPropertyConverter.addLineProperties(lineLayer: lineLayer, properties: properties)
-            case let fillLayer as MLNFillStyleLayer:
-                LayerPropertyConverter.addFillProperties(fillLayer: fillLayer, properties: properties)
-            case let circleLayer as MLNCircleStyleLayer:
-                LayerPropertyConverter.addCircleProperties(circleLayer: circleLayer, properties: properties)
-             case let symbolLayer as MLNSymbolStyleLayer:
-                LayerPropertyConverter.addSymbolProperties(symbolLayer: symbolLayer, properties: properties)
-            case let rasterLayer as MLNRasterStyleLayer:
-                LayerPropertyConverter.addRasterProperties(rasterLayer: rasterLayer, properties: properties)
-            case let hillshadeLayer as MLNHillshadeStyleLayer:
-                LayerPropertyConverter.addHillshadeProperties(hillshadeLayer: hillshadeLayer, properties: properties)
-            default:
+            if !setLayerProperties(layer, properties) {
                 result(FlutterError(
                     code: "UNSUPPORTED_LAYER_TYPE",
                     message: "Layer type not supported",
@@ -449,7 +452,7 @@ class MapLibreMapController: NSObject, FlutterPlatformView, MLNMapViewDelegate,
             guard let arguments = methodCall.arguments as? [String: Any] else { return }
             guard let sourceId = arguments["sourceId"] as? String else { return }
             guard let layerId = arguments["layerId"] as? String else { return }
-            guard let properties = arguments["properties"] as? [String: String] else { return }
+            guard let properties = arguments["properties"] as? [String: Any] else { return }
             guard let enableInteraction = arguments["enableInteraction"] as? Bool else { return }
             let belowLayerId = arguments["belowLayerId"] as? String
             let sourceLayer = arguments["sourceLayer"] as? String
@@ -477,7 +480,7 @@ class MapLibreMapController: NSObject, FlutterPlatformView, MLNMapViewDelegate,
             guard let arguments = methodCall.arguments as? [String: Any] else { return }
             guard let sourceId = arguments["sourceId"] as? String else { return }
             guard let layerId = arguments["layerId"] as? String else { return }
-            guard let properties = arguments["properties"] as? [String: String] else { return }
+            guard let properties = arguments["properties"] as? [String: Any] else { return }
             guard let enableInteraction = arguments["enableInteraction"] as? Bool else { return }
             let belowLayerId = arguments["belowLayerId"] as? String
             let sourceLayer = arguments["sourceLayer"] as? String
@@ -505,7 +508,7 @@ class MapLibreMapController: NSObject, FlutterPlatformView, MLNMapViewDelegate,
             guard let arguments = methodCall.arguments as? [String: Any] else { return }
             guard let sourceId = arguments["sourceId"] as? String else { return }
             guard let layerId = arguments["layerId"] as? String else { return }
-            guard let properties = arguments["properties"] as? [String: String] else { return }
+            guard let properties = arguments["properties"] as? [String: Any] else { return }
             guard let enableInteraction = arguments["enableInteraction"] as? Bool else { return }
             let belowLayerId = arguments["belowLayerId"] as? String
             let sourceLayer = arguments["sourceLayer"] as? String
@@ -533,7 +536,7 @@ class MapLibreMapController: NSObject, FlutterPlatformView, MLNMapViewDelegate,
             guard let arguments = methodCall.arguments as? [String: Any] else { return }
             guard let sourceId = arguments["sourceId"] as? String else { return }
             guard let layerId = arguments["layerId"] as? String else { return }
-            guard let properties = arguments["properties"] as? [String: String] else { return }
+            guard let properties = arguments["properties"] as? [String: Any] else { return }
             let belowLayerId = arguments["belowLayerId"] as? String
             let minzoom = arguments["minzoom"] as? Double
             let maxzoom = arguments["maxzoom"] as? Double
@@ -556,7 +559,7 @@ class MapLibreMapController: NSObject, FlutterPlatformView, MLNMapViewDelegate,
             guard let arguments = methodCall.arguments as? [String: Any] else { return }
             guard let sourceId = arguments["sourceId"] as? String else { return }
             guard let layerId = arguments["layerId"] as? String else { return }
-            guard let properties = arguments["properties"] as? [String: String] else { return }
+            guard let properties = arguments["properties"] as? [String: Any] else { return }
             let belowLayerId = arguments["belowLayerId"] as? String
             let minzoom = arguments["minzoom"] as? Double
             let maxzoom = arguments["maxzoom"] as? Double
@@ -577,7 +580,7 @@ class MapLibreMapController: NSObject, FlutterPlatformView, MLNMapViewDelegate,
             guard let arguments = methodCall.arguments as? [String: Any] else { return }
             guard let sourceId = arguments["sourceId"] as? String else { return }
             guard let layerId = arguments["layerId"] as? String else { return }
-            guard let properties = arguments["properties"] as? [String: String] else { return }
+            guard let properties = arguments["properties"] as? [String: Any] else { return }
             let belowLayerId = arguments["belowLayerId"] as? String
             let minzoom = arguments["minzoom"] as? Double
             let maxzoom = arguments["maxzoom"] as? Double
@@ -696,6 +699,45 @@ class MapLibreMapController: NSObject, FlutterPlatformView, MLNMapViewDelegate,
                 return
             }
             mapView.style?.removeSource(source)
+            featureStateBySource[sourceId] = nil
+            motionSources.removeValue(forKey: sourceId)?.stop()
+            result(nil)
+        case "motionSource#add":
+            guard let arguments = methodCall.arguments as? [String: Any] else { return }
+            guard let sourceId = arguments["sourceId"] as? String else { return }
+            guard let style = mapView.style else {
+                result(MethodCallError.styleNotFound.flutterError)
+                return
+            }
+            guard style.source(withIdentifier: sourceId) == nil else {
+                result(MethodCallError.sourceAlreadyExists(sourceId: sourceId).flutterError)
+                return
+            }
+            let motionSource = MotionSource(
+                sourceId: sourceId,
+                maxExtrapolation: arguments["maxExtrapolation"] as? Double ?? 5000,
+                blendDuration: arguments["blendDuration"] as? Double ?? 1000
+            )
+            style.addSource(motionSource.source)
+            motionSources[sourceId] = motionSource
+            result(nil)
+        case "motionSource#update":
+            guard let arguments = methodCall.arguments as? [String: Any] else { return }
+            guard let sourceId = arguments["sourceId"] as? String else { return }
+            guard let motionSource = motionSources[sourceId] else {
+                result(MethodCallError.sourceNotFound(sourceId: sourceId).flutterError)
+                return
+            }
+            guard let data = arguments["fixes"] as? FlutterStandardTypedData else { return }
+            let fixes = data.data.withUnsafeBytes {
+                Array($0.bindMemory(to: Double.self).prefix(Int(data.elementCount)))
+            }
+            motionSource.update(
+                ids: arguments["ids"] as? [Any] ?? [],
+                fixes: fixes,
+                properties: arguments["properties"] as? [Any] ?? [],
+                removeIds: arguments["removeIds"] as? [Any] ?? []
+            )
             result(nil)
         case "style#addLayer":
             guard let arguments = methodCall.arguments as? [String: Any] else { return }
@@ -828,7 +870,7 @@ class MapLibreMapController: NSObject, FlutterPlatformView, MLNMapViewDelegate,
         case "source#addGeoJson":
             guard let arguments = methodCall.arguments as? [String: Any] else { return }
             guard let sourceId = arguments["sourceId"] as? String else { return }
-            guard let geojson = arguments["geojson"] as? String else { return }
+            guard let geojson = geojsonData(arguments["geojson"]) else { return }
             let addResult = addSourceGeojson(sourceId: sourceId, geojson: geojson)
 
             switch addResult {
@@ -850,7 +892,7 @@ class MapLibreMapController: NSObject, FlutterPlatformView, MLNMapViewDelegate,
         case "source#setGeoJson":
             guard let arguments = methodCall.arguments as? [String: Any] else { return }
             guard let sourceId = arguments["sourceId"] as? String else { return }
-            guard let geojson = arguments["geojson"] as? String else { return }
+            guard let geojson = geojsonData(arguments["geojson"]) else { return }
             let setResult = setSource(sourceId: sourceId, geojson: geojson)
 
             switch setResult {
@@ -869,6 +911,88 @@ class MapLibreMapController: NSObject, FlutterPlatformView, MLNMapViewDelegate,
             case let .failure(error): result(error.flutterError)
             }
 
+        case "source#getClusterExpansionZoom",
+             "source#getClusterChildren",
+             "source#getClusterLeaves":
+            guard let arguments = methodCall.arguments as? [String: Any] else { return }
+            guard let sourceId = arguments["sourceId"] as? String else { return }
+            guard let clusterId = arguments["clusterId"] as? Int else { return }
+            guard let source = mapView.style?.source(withIdentifier: sourceId) as? MLNShapeSource
+            else {
+                result(MethodCallError.sourceNotFound(sourceId: sourceId).flutterError)
+                return
+            }
+            // clusters can only be looked up in the tiles that are loaded
+            guard let cluster = source
+                .features(matching: NSPredicate(format: "cluster_id == %d", clusterId))
+                .compactMap({ $0 as? MLNPointFeatureCluster })
+                .first
+            else {
+                result(MethodCallError.genericError(
+                    details: "No cluster \(clusterId) loaded in source \(sourceId)."
+                ).flutterError)
+                return
+            }
+
+            if methodCall.method == "source#getClusterExpansionZoom" {
+                result(Int(source.zoomLevel(forExpanding: cluster)))
+                return
+            }
+            let features: [MLNFeature]
+            if methodCall.method == "source#getClusterChildren" {
+                features = source.children(of: cluster)
+            } else {
+                features = source.leaves(
+                    of: cluster,
+                    offset: UInt(arguments["offset"] as? Int ?? 0),
+                    limit: UInt(arguments["limit"] as? Int ?? 10)
+                )
+            }
+            var featuresJson = [String]()
+            for feature in features {
+                if let data = try? JSONSerialization.data(
+                    withJSONObject: feature.geoJSONDictionary(),
+                    options: []
+                ),
+                    let text = String(data: data, encoding: .utf8)
+                {
+                    featuresJson.append(text)
+                }
+            }
+            result(["features": featuresJson])
+
+        case "featureState#set":
+            guard let arguments = methodCall.arguments as? [String: Any] else { return }
+            guard let sourceId = arguments["sourceId"] as? String else { return }
+            guard let featureId = arguments["featureId"] as? String else { return }
+            guard let state = arguments["state"] as? [String: Any] else { return }
+            let setResult = updateFeatureState(sourceId: sourceId, featureId: featureId) {
+                $0.merge(state) { _, new in new }
+            }
+
+            switch setResult {
+            case .success: result(nil)
+            case let .failure(error): result(error.flutterError)
+            }
+
+        case "featureState#remove":
+            guard let arguments = methodCall.arguments as? [String: Any] else { return }
+            guard let sourceId = arguments["sourceId"] as? String else { return }
+            let featureId = arguments["featureId"] as? String
+            let key = arguments["key"] as? String
+            let removeResult = updateFeatureState(sourceId: sourceId, featureId: featureId) {
+                if let key = key {
+                    $0[key] = nil
+                } else {
+                    $0.removeAll()
+                }
+            }
+
+            switch removeResult {
+            case .success: result(nil)
+            case let .failure(error): result(error.flutterError)
+            }
+
         case "layer#setVisibility":
             guard let arguments = methodCall.arguments as? [String: Any] else { return }
             guard let layerId = arguments["layerId"] as? String else { return }
@@ -944,6 +1068,22 @@ class MapLibreMapController: NSObject, FlutterPlatformView, MLNMapViewDelegate,
             reply["sources"] = sourceIds as NSObject
             result(reply)
 
+        case "style#applyTransaction":
+            guard let arguments = methodCall.arguments as? [String: Any] else { return }
+            guard let operations = arguments["operations"] as? [[String: Any]] else { return }
+
+            var errors = [[String: Any]]()
+            for (index, operation) in operations.enumerated() {
+                if case let .failure(error) = applyStyleOperation(operation) {
+                    errors.append([
+                        "index": index,
+                        "code": error.code,
+                        "message": error.details,
+                    ])
+                }
+            }
+            result(["errors": errors])
+
         case "style#getFilter":
             guard let arguments = methodCall.arguments as? [String: Any] else { return }
             guard let layerId = arguments["layerId"] as? String else { return }
@@ -1190,6 +1330,8 @@ class MapLibreMapController: NSObject, FlutterPlatformView, MLNMapViewDelegate,
         }
 
         addedShapesByLayer.removeAll()
+        featureStateBySource.removeAll()
+        stopMotionSources()
         interactiveFeatureLayerIds.removeAll()
 
         mapReadyResult?(nil)
@@ -1257,7 +1399,7 @@ class MapLibreMapController: NSObject, FlutterPlatformView, MLNMapViewDelegate,
         maximumZoomLevel: Double?,
         filter: String?,
         enableInteraction: Bool,
-        properties: [String: String]
+        properties: [String: Any]
     ) -> Result<Void, MethodCallError> {
         switch validateBeforeLayerAdd(sourceId: sourceId, layerId: layerId) {
         case .failure(let error):
@@ -1303,7 +1445,7 @@ class MapLibreMapController: NSObject, FlutterPlatformView, MLNMapViewDelegate,
         maximumZoomLevel: Double?,
         filter: String?,
         enableInteraction: Bool,
-        properties: [String: String]
+        properties: [String: Any]
     ) -> Result<Void, MethodCallError> {
         switch validateBeforeLayerAdd(sourceId: sourceId, layerId: layerId) {
         case .failure(let error):
@@ -1346,7 +1488,7 @@ class MapLibreMapController: NSObject, FlutterPlatformView, MLNMapViewDelegate,
         maximumZoomLevel: Double?,
         filter: String?,
         enableInteraction: Bool,
-        properties: [String: String]
+        properties: [String: Any]
     ) -> Result<Void, MethodCallError> {
         switch validateBeforeLayerAdd(sourceId: sourceId, layerId: layerId) {
         case .failure(let error):
@@ -1389,7 +1531,7 @@ class MapLibreMapController: NSObject, FlutterPlatformView, MLNMapViewDelegate,
         maximumZoomLevel: Double?,
         filter: String?,
         enableInteraction: Bool,
-        properties: [String: String]
+        properties: [String: Any]
     ) -> Result<Void, MethodCallError> {
         switch validateBeforeLayerAdd(sourceId: sourceId, layerId: layerId) {
         case .failure(let error):
@@ -1437,7 +1579,7 @@ class MapLibreMapController: NSObject, FlutterPlatformView, MLNMapViewDelegate,
         maximumZoomLevel: Double?,
         filter: String?,
         enableInteraction: Bool,
-        properties: [String: String]
+        properties: [String: Any]
     ) -> Result<Void, MethodCallError> {
         switch validateBeforeLayerAdd(sourceId: sourceId, layerId: layerId) {
         case .failure(let error):
@@ -1474,6 +1616,187 @@ class MapLibreMapController: NSObject, FlutterPlatformView, MLNMapViewDelegate,
         }
     }
 
+    /// Sets the properties depending on the runtime type of layer, returns false if the type is not supported.
+    func setLayerProperties(_ layer: MLNStyleLayer, _ properties: [String: Any]) -> Bool {
+        switch layer {
+        case let lineLayer as MLNLineStyleLayer:
+            LayerPropertyConverter.addLineProperties(lineLayer: lineLayer, properties: properties)
+        case let fillLayer as MLNFillStyleLayer:
+            LayerPropertyConverter.addFillProperties(fillLayer: fillLayer, properties: properties)
+        case let circleLayer as MLNCircleStyleLayer:
+            LayerPropertyConverter.addCircleProperties(circleLayer: circleLayer, properties: properties)
+        case let symbolLayer as MLNSymbolStyleLayer:
+            LayerPropertyConverter.addSymbolProperties(symbolLayer: symbolLayer, properties: properties)
+        case let rasterLayer as MLNRasterStyleLayer:
+            LayerPropertyConverter.addRasterProperties(rasterLayer: rasterLayer, properties: properties)
+        case let hillshadeLayer as MLNHillshadeStyleLayer:
+            LayerPropertyConverter.addHillshadeProperties(hillshadeLayer: hillshadeLayer, properties: properties)
+        default:
+            return false
+        }
+        return true
+    }
+
+    /// Applies a single operation of a style transaction. All operations of a transaction run
+    /// within the same run loop pass, so the map view repaints only once for the whole batch.
+    func applyStyleOperation(_ operation: [String: Any]) -> Result<Void, MethodCallError> {
+        guard let style = mapView.style else {
+            return .failure(.styleNotFound)
+        }
+        guard let type = operation["type"] as? String else {
+            return .failure(.genericError(details: "Style operation without type."))
+        }
+
+        switch type {
+        case "addSource":
+            guard let sourceId = operation["sourceId"] as? String,
+                  let properties = operation["properties"] as? [String: Any]
+            else { break }
+            return addSource(sourceId: sourceId, properties: properties)
+        case "addGeoJsonSource":
+            guard let sourceId = operation["sourceId"] as? String,
+                  let geojson = operation["geojson"] as? String
+            else { break }
+            return addSourceGeojson(sourceId: sourceId, geojson: Data(geojson.utf8))
+        case "setGeoJsonSource":
+            guard let sourceId = operation["sourceId"] as? String,
+                  let geojson = operation["geojson"] as? String
+            else { break }
+            return setSource(sourceId: sourceId, geojson: Data(geojson.utf8))
+        case "updateGeoJsonSource":
+            guard let sourceId = operation["sourceId"] as? String,
+                  let geojson = operation["geojson"] as? String
+            else { break }
+            return updateSource(
+                sourceId: sourceId,
+                geojson: geojson,
+                removeIds: operation["removeIds"] as? [Any] ?? []
+            )
+        case "addLayer":
+            return addStyleLayer(operation)
+        case "setLayerProperties":
+            guard let layerId = operation["layerId"] as? String,
+                  let properties = operation["properties"] as? [String: Any]
+            else { break }
+            guard let layer = style.layer(withIdentifier: layerId) else {
+                return .failure(.layerNotFound(layerId: layerId))
+            }
+            if !setLayerProperties(layer, properties) {
+                return .failure(.invalidLayerType(
+                    details: "Layer '\(layerId)' does not support setting properties."
+                ))
+            }
+            return .success(())
+        case "setFilter":
+            guard let layerId = operation["layerId"] as? String,
+                  let filter = operation["filter"] as? String
+            else { break }
+            guard let layer = style.layer(withIdentifier: layerId) else {
+                return .failure(.layerNotFound(layerId: layerId))
+            }
+            return setFilter(layer, filter)
+        case "setLayerVisibility":
+            guard let layerId = operation["layerId"] as? String,
+                  let visible = operation["visible"] as? Bool
+            else { break }
+            guard let layer = style.layer(withIdentifier: layerId) else {
+                return .failure(.layerNotFound(layerId: layerId))
+            }
+            layer.isVisible = visible
+            return .success(())
+        case "removeLayer":
+            guard let layerId = operation["layerId"] as? String else { break }
+            guard let layer = style.layer(withIdentifier: layerId) else {
+                return .failure(.layerNotFound(layerId: layerId))
+            }
+            interactiveFeatureLayerIds.remove(layerId)
+            style.removeLayer(layer)
+            return .success(())
+        case "removeSource":
+            guard let sourceId = operation["sourceId"] as? String else { break }
+            if let source = style.source(withIdentifier: sourceId) {
+                style.removeSource(source)
+            }
+            featureStateBySource[sourceId] = nil
+            motionSources.removeValue(forKey: sourceId)?.stop()
+            return .success(())
+        default:
+            return .failure(.genericError(details: "Unknown style operation '\(type)'."))
+        }
+        return .failure(.genericError(details: "Invalid arguments for style operation '\(type)'."))
+    }
+
+    private func addStyleLayer(_ operation: [String: Any]) -> Result<Void, MethodCallError> {
+        guard let layerType = operation["layerType"] as? String,
+              let sourceId = operation["sourceId"] as? String,
+              let layerId = operation["layerId"] as? String,
+              let properties = operation["properties"] as? [String: Any]
+        else {
+            return .failure(.genericError(details: "Invalid arguments for style operation 'addLayer'."))
+        }
+        let belowLayerId = operation["belowLayerId"] as? String
+        let sourceLayer = operation["sourceLayer"] as? String
+        let minzoom = operation["minzoom"] as? Double
+        let maxzoom = operation["maxzoom"] as? Double
+        let filter = operation["filter"] as? String
+        let enableInteraction = operation["enableInteraction"] as? Bool ?? false
+
+        switch layerType {
+        case "symbol":
+            return addSymbolLayer(
+                sourceId: sourceId, layerId: layerId, belowLayerId: belowLayerId,
+                sourceLayerIdentifier: sourceLayer, minimumZoomLevel: minzoom,
+                maximumZoomLevel: maxzoom, filter: filter,
+                enableInteraction: enableInteraction, properties: properties
+            )
+        case "line":
+            return addLineLayer(
+                sourceId: sourceId, layerId: layerId, belowLayerId: belowLayerId,
+                sourceLayerIdentifier: sourceLayer, minimumZoomLevel: minzoom,
+                maximumZoomLevel: maxzoom, filter: filter,
+                enableInteraction: enableInteraction, properties: properties
+            )
+        case "fill":
+            return addFillLayer(
+                sourceId: sourceId, layerId: layerId, belowLayerId: belowLayerId,
+                sourceLayerIdentifier: sourceLayer, minimumZoomLevel: minzoom,
+                maximumZoomLevel: maxzoom, filter: filter,
+                enableInteraction: enableInteraction, properties: properties
+            )
+        case "fill-extrusion":
+            return addFillExtrusionLayer(
+                sourceId: sourceId, layerId: layerId, belowLayerId: belowLayerId,
+                sourceLayerIdentifier: sourceLayer, minimumZoomLevel: minzoom,
+                maximumZoomLevel: maxzoom, filter: filter,
+                enableInteraction: enableInteraction, properties: properties
+            )
+        case "circle":
+            return addCircleLayer(
+                sourceId: sourceId, layerId: layerId, belowLayerId: belowLayerId,
+                sourceLayerIdentifier: sourceLayer, minimumZoomLevel: minzoom,
+                maximumZoomLevel: maxzoom, filter: filter,
+                enableInteraction: enableInteraction, properties: properties
+            )
+        case "hillshade":
+            return addHillshadeLayer(
+                sourceId: sourceId, layerId: layerId, belowLayerId: belowLayerId,
+                minimumZoomLevel: minzoom, maximumZoomLevel: maxzoom, properties: properties
+            )
+        case "heatmap":
+            return addHeatmapLayer(
+                sourceId: sourceId, layerId: layerId, belowLayerId: belowLayerId,
+                minimumZoomLevel: minzoom, maximumZoomLevel: maxzoom, properties: properties
+            )
+        case "raster":
+            return addRasterLayer(
+                sourceId: sourceId, layerId: layerId, belowLayerId: belowLayerId,
+                minimumZoomLevel: minzoom, maximumZoomLevel: maxzoom, properties: properties
+            )
+        default:
+            return .failure(.invalidLayerType(details: "Layer type '\(layerType)' is not supported."))
+        }
+    }
+
     func setFilter(_ layer: MLNStyleLayer, _ filter: String) -> Result<Void, MethodCallError> {
         do {
             let filter = try JSONSerialization.jsonObject(
@@ -1503,7 +1826,7 @@ class MapLibreMapController: NSObject, FlutterPlatformView, MLNMapViewDelegate,
         belowLayerId: String?,
         minimumZoomLevel: Double?,
         maximumZoomLevel: Double?,
-        properties: [String: String]
+        properties: [String: Any]
     ) -> Result<Void, MethodCallError> {
         switch validateBeforeLayerAdd(sourceId: sourceId, layerId: layerId) {
         case .failure(let error):
@@ -1535,7 +1858,7 @@ class MapLibreMapController: NSObject, FlutterPlatformView, MLNMapViewDelegate,
         belowLayerId: String?,
         minimumZoomLevel: Double?,
         maximumZoomLevel: Double?,
-        properties: [String: String]
+        properties: [String: Any]
     ) -> Result<Void, MethodCallError> {
         switch validateBeforeLayerAdd(sourceId: sourceId, layerId: layerId) {
         case .failure(let error):
@@ -1567,7 +1890,7 @@ class MapLibreMapController: NSObject, FlutterPlatformView, MLNMapViewDelegate,
         belowLayerId: String?,
         minimumZoomLevel: Double?,
         maximumZoomLevel: Double?,
-        properties: [String: String]
+        properties: [String: Any]
     )  -> Result<Void, MethodCallError>  {
         switch validateBeforeLayerAdd(sourceId: sourceId, layerId: layerId) {
         case .failure(let error):
@@ -1677,7 +2000,27 @@ class MapLibreMapController: NSObject, FlutterPlatformView, MLNMapViewDelegate,
         }
     }
 
-    func addSourceGeojson(sourceId: String, geojson: String) -> Result<Void, MethodCallError> {
+    /// Reads a geojson argument. Large sources are encoded in a background isolate on the Dart
+    /// side and sent as UTF-8 bytes instead of a string.
+    func geojsonData(_ argument: Any?) -> Data? {
+        if let bytes = argument as? FlutterStandardTypedData {
+            return bytes.data
+        }
+        if let string = argument as? String {
+            return Data(string.utf8)
+        }
+        return nil
+    }
+
+    /// Stops all motion sources, e.g. because their style was replaced.
+    private func stopMotionSources() {
+        for motionSource in motionSources.values {
+            motionSource.stop()
+        }
+        motionSources.removeAll()
+    }
+
+    func addSourceGeojson(sourceId: String, geojson: Data) -> Result<Void, MethodCallError> {
         do{
             guard let style = mapView.style else { 
                 return .failure(.styleNotFound)
@@ -1686,9 +2029,12 @@ class MapLibreMapController: NSObject, FlutterPlatformView, MLNMapViewDelegate,
                 return .failure(.sourceAlreadyExists(sourceId: sourceId))
             }
 
-            let parsed = try MLNShape(
-                data: geojson.data(using: .utf8)!,
-                encoding: String.Encoding.utf8.rawValue
+            let parsed = applyFeatureState(
+                sourceId: sourceId,
+                shape: try MLNShape(
+                    data: geojson,
+                    encoding: String.Encoding.utf8.rawValue
+                )
             )
             let source = MLNShapeSource(identifier: sourceId, shape: parsed, options: [:])
             addedShapesByLayer[sourceId] = parsed
@@ -1699,15 +2045,18 @@ class MapLibreMapController: NSObject, FlutterPlatformView, MLNMapViewDelegate,
         }
     }
 
-    func setSource(sourceId: String, geojson: String) -> Result<Void, MethodCallError> {
+    func setSource(sourceId: String, geojson: Data) -> Result<Void, MethodCallError> {
         guard let style = mapView.style else { 
             return .failure(.styleNotFound)
         }
 
         do{
-            let parsed = try MLNShape(
-                data: geojson.data(using: .utf8)!,
-                encoding: String.Encoding.utf8.rawValue
+            let parsed = applyFeatureState(
+                sourceId: sourceId,
+                shape: try MLNShape(
+                    data: geojson,
+                    encoding: String.Encoding.utf8.rawValue
+                )
             )
             guard let source = style.source(withIdentifier: sourceId) as? MLNShapeSource else {
                 return .failure(.sourceNotFound(sourceId: sourceId))
@@ -1727,9 +2076,12 @@ class MapLibreMapController: NSObject, FlutterPlatformView, MLNMapViewDelegate,
             return .failure(.styleNotFound)
         }
         do {
-            let newShape = try MLNShape(
-                data: geojsonFeature.data(using: .utf8)!,
-                encoding: String.Encoding.utf8.rawValue
+            let newShape = applyFeatureState(
+                sourceId: sourceId,
+                shape: try MLNShape(
+                    data: geojsonFeature.data(using: .utf8)!,
+                    encoding: String.Encoding.utf8.rawValue
+                )
             )
             guard let source = style.source(withIdentifier: sourceId) as? MLNShapeSource else {
                 return .failure(.sourceNotFound(sourceId: sourceId))
@@ -1765,6 +2117,149 @@ class MapLibreMapController: NSObject, FlutterPlatformView, MLNMapViewDelegate,
         }
     }
 
+    /// Replaces the features with the ids of the features in `geojson`, appends the others and
+    /// removes the features with an id in `removeIds`, then sets the shape of the source once.
+    func updateSource(
+        sourceId: String,
+        geojson: String,
+        removeIds: [Any]
+    ) -> Result<Void, MethodCallError> {
+        guard let style = mapView.style else {
+            return .failure(.styleNotFound)
+        }
+        guard let source = style.source(withIdentifier: sourceId) as? MLNShapeSource,
+              let collection = addedShapesByLayer[sourceId] as? MLNShapeCollectionFeature
+        else {
+            return .failure(.sourceNotFound(sourceId: sourceId))
+        }
+
+        let added: MLNShape
+        do {
+            added = applyFeatureState(
+                sourceId: sourceId,
+                shape: try MLNShape(
+                    data: geojson.data(using: .utf8)!,
+                    encoding: String.Encoding.utf8.rawValue
+                )
+            )
+        } catch {
+            return .failure(.geojsonParseError(sourceId: sourceId))
+        }
+        let addedFeatures: [MLNShape & MLNFeature]
+        if let addedCollection = added as? MLNShapeCollectionFeature {
+            addedFeatures = addedCollection.shapes
+        } else if let feature = added as? MLNShape & MLNFeature {
+            addedFeatures = [feature]
+        } else {
+            addedFeatures = []
+        }
+
+        let removed = Set(removeIds.map { "\($0)" })
+        var addedById = [String: MLNShape & MLNFeature]()
+        var addedOrder = [String]()
+        var addedWithoutId = [MLNShape & MLNFeature]()
+        for feature in addedFeatures {
+            guard let identifier = feature.identifier else {
+                addedWithoutId.append(feature)
+                continue
+            }
+            let id = "\(identifier)"
+            if addedById[id] == nil {
+                addedOrder.append(id)
+            }
+            addedById[id] = feature
+        }
+
+        var shapes = [MLNShape & MLNFeature]()
+        shapes.reserveCapacity(collection.shapes.count + addedFeatures.count)
+        for feature in collection.shapes {
+            guard let identifier = feature.identifier else {
+                shapes.append(feature)
+                continue
+            }
+            let id = "\(identifier)"
+            if removed.contains(id) {
+                continue
+            }
+            shapes.append(addedById.removeValue(forKey: id) ?? feature)
+        }
+        for id in addedOrder {
+            if let feature = addedById[id] {
+                shapes.append(feature)
+            }
+        }
+        shapes.append(contentsOf: addedWithoutId)
+
+        let shape = MLNShapeCollectionFeature(shapes: shapes)
+        addedShapesByLayer[sourceId] = shape
+        source.shape = shape
+        return .success(())
+    }
+
+    /// Updates the feature state of a feature, or of all features of the source if `featureId`
+    /// is nil, and re-sets the shape of the source.
+    func updateFeatureState(
+        sourceId: String,
+        featureId: String?,
+        update: (inout [String: Any]) -> Void
+    ) -> Result<Void, MethodCallError> {
+        guard let style = mapView.style else {
+            return .failure(.styleNotFound)
+        }
+        guard let source = style.source(withIdentifier: sourceId) as? MLNShapeSource,
+              let collection = addedShapesByLayer[sourceId] as? MLNShapeCollectionFeature
+        else {
+            return .failure(.sourceNotFound(sourceId: sourceId))
+        }
+
+        var states = featureStateBySource[sourceId] ?? [:]
+        if let featureId = featureId {
+            var state = states[featureId] ?? [:]
+            update(&state)
+            states[featureId] = state.isEmpty ? nil : state
+        } else {
+            states.removeAll()
+        }
+        featureStateBySource[sourceId] = states
+
+        let shape = applyFeatureState(sourceId: sourceId, shape: collection)
+        addedShapesByLayer[sourceId] = shape
+        source.shape = shape
+        return .success(())
+    }
+
+    /// Replaces the feature state attributes of the features in `shape` with the stored state.
+    func applyFeatureState(sourceId: String, shape: MLNShape) -> MLNShape {
+        guard let states = featureStateBySource[sourceId] else {
+            return shape
+        }
+        let features: [MLNShape & MLNFeature]
+        if let collection = shape as? MLNShapeCollectionFeature {
+            features = collection.shapes
+        } else if let feature = shape as? MLNShape & MLNFeature {
+            features = [feature]
+        } else {
+            return shape
+        }
+
+        for feature in features {
+            var attributes = feature.attributes.filter { !$0.key.hasPrefix(featureStatePrefix) }
+            if let identifier = feature.identifier,
+               let state = states["\(identifier)"]
+            {
+                for (key, value) in state {
+                    attributes[featureStatePrefix + key] = value
+                }
+            }
+            feature.attributes = attributes
+        }
+
+        if let collection = shape as? MLNShapeCollectionFeature {
+            return MLNShapeCollectionFeature(shapes: collection.shapes)
+        }
+        return shape
+    }
+
     /*
      *  MapLibreMapOptionsSink
      */
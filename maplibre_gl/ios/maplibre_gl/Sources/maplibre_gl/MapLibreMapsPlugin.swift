@@ -5,6 +5,8 @@ import UIKit
 
 public class MapLibreMapsPlugin: NSObject, FlutterPlugin {
     static var downloadOfflineRegionChannelHandler: OfflineChannelHandler? = nil
+    static var offlineDownloads: OfflineDownloads? = nil
+    static var offlineMerges: OfflineMerges? = nil
 
     public static func register(with registrar: FlutterPluginRegistrar) {
         let instance = MapLibreMapFactory(withRegistrar: registrar)
@@ -14,6 +16,11 @@ public class MapLibreMapsPlugin: NSObject, FlutterPlugin {
             name: "plugins.flutter.io/maplibre_gl",
             binaryMessenger: registrar.messenger()
         )
+        let offlineDownloads = OfflineDownloads(messenger: registrar.messenger())
+        self.offlineDownloads = offlineDownloads
+        let offlineMerges = OfflineMerges(messenger: registrar.messenger())
+        self.offlineMerges = offlineMerges
+        NetworkConfiguration.shared.ensureSession()
 
         channel.setMethodCallHandler { methodCall, result in
             switch methodCall.method {
@@ -29,10 +36,29 @@ public class MapLibreMapsPlugin: NSObject, FlutterPlugin {
                     result(nil)
                     return
                 }
-                let sessionConfig = URLSessionConfiguration.default
-                sessionConfig.httpAdditionalHeaders = headers // your headers here
-                MLNNetworkConfiguration.sharedManager.sessionConfiguration = sessionConfig
+                NetworkConfiguration.shared.setHeaders(headers)
                 result(nil)
+            case "setNetworkConfiguration":
+                guard let arguments = methodCall.arguments as? [String: Any],
+                      let configuration = arguments["configuration"] as? [String: Any]
+                else {
+                    result(FlutterError(
+                        code: "setNetworkConfigurationError",
+                        message: "could not decode arguments",
+                        details: nil
+                    ))
+                    return
+                }
+                NetworkConfiguration.shared.configure(configuration)
+                result(nil)
+            case "getTileStatistics":
+                let arguments = methodCall.arguments as? [String: Any]
+                let reset = arguments?["reset"] as? Bool ?? false
+                result(TileRequestStatistics.shared.statistics(reset: reset))
+            case "getNetworkStatistics":
+                let arguments = methodCall.arguments as? [String: Any]
+                let reset = arguments?["reset"] as? Bool ?? false
+                result(NetworkConfiguration.shared.statistics(reset: reset))
             case "installOfflineMapTiles":
                 guard let arguments = methodCall.arguments as? [String: String] else { return }
                 let tilesdb = arguments["tilesdb"]
@@ -86,6 +112,90 @@ public class MapLibreMapsPlugin: NSObject, FlutterPlugin {
                     channelHandler: downloadOfflineRegionChannelHandler!
                 )
                 downloadOfflineRegionChannelHandler = nil;
+            case "offlineDownload#create":
+                guard let args = methodCall.arguments as? [String: Any],
+                      let definitionDictionary = args["definition"] as? [String: Any],
+                      let definition = OfflineRegionDefinition.fromDictionary(definitionDictionary)
+                else {
+                    result(FlutterError(
+                        code: "OfflineDownloadError",
+                        message: "could not decode arguments",
+                        details: nil
+                    ))
+                    return
+                }
+                offlineDownloads.create(
+                    definition: definition,
+                    metadata: args["metadata"] as? [String: Any] ?? [:],
+                    result: result
+                )
+            case "offlineDownload#resume", "offlineDownload#pause", "offlineDownload#invalidate":
+                guard let args = methodCall.arguments as? [String: Any],
+                      let id = args["id"] as? Int
+                else {
+                    result(FlutterError(
+                        code: "OfflineDownloadError",
+                        message: "could not decode arguments",
+                        details: nil
+                    ))
+                    return
+                }
+                switch methodCall.method {
+                case "offlineDownload#resume":
+                    offlineDownloads.resume(id: id, result: result)
+                case "offlineDownload#pause":
+                    offlineDownloads.pause(id: id, result: result)
+                default:
+                    offlineDownloads.invalidate(id: id, result: result)
+                }
+            case "offlineDownload#saveQueue":
+                guard let args = methodCall.arguments as? [String: Any],
+                      let queue = args["queue"] as? String
+                else {
+                    result(nil)
+                    return
+                }
+                offlineDownloads.saveQueue(queue, result: result)
+            case "offlineDownload#loadQueue":
+                offlineDownloads.loadQueue(result: result)
+            case "offlineMerge#start":
+                guard let args = methodCall.arguments as? [String: Any],
+                      let path = args["path"] as? String
+                else {
+                    result(FlutterError(
+                        code: "OfflineMergeError",
+                        message: "could not decode arguments",
+                        details: nil
+                    ))
+                    return
+                }
+                offlineMerges.start(path: path, result: result)
+            case "offlineMerge#cancel":
+                guard let args = methodCall.arguments as? [String: Any],
+                      let id = args["id"] as? Int
+                else {
+                    result(FlutterError(
+                        code: "OfflineMergeError",
+                        message: "could not decode arguments",
+                        details: nil
+                    ))
+                    return
+                }
+                offlineMerges.cancel(id: id, result: result)
+            case "setMaximumAmbientCacheSize":
+                guard let arguments = methodCall.arguments as? [String: Any],
+                      let size = arguments["size"] as? UInt64
+                else {
+                    result(FlutterError(
+                        code: "SetMaximumAmbientCacheSizeError",
+                        message: "could not decode arguments",
+                        details: nil
+                    ))
+                    return
+                }
+                OfflineManagerUtils.setMaximumAmbientCacheSize(result: result, size: size)
+            case "getAmbientCacheStatistics":
+                OfflineManagerUtils.ambientCacheStatistics(result: result)
             case "setOfflineTileCountLimit":
                 guard let arguments = methodCall.arguments as? [String: Any],
                       let limit = arguments["limit"] as? UInt64
@@ -109,13 +219,49 @@ public class MapLibreMapsPlugin: NSObject, FlutterPlugin {
                     return
                 }
                 OfflineManagerUtils.deleteRegion(result: result, id: id)
+            case "deleteOfflineRegions":
+                guard let args = methodCall.arguments as? [String: Any],
+                      let ids = args["ids"] as? [Int]
+                else {
+                    result(nil)
+                    return
+                }
+                OfflineManagerUtils.deleteRegions(result: result, ids: ids)
+            case "updateOfflineRegionMetadata":
+                guard let args = methodCall.arguments as? [String: Any],
+                      let id = args["id"] as? Int
+                else {
+                    result(FlutterError(
+                        code: "UpdateMetadataError",
+                        message: "could not decode arguments",
+                        details: nil
+                    ))
+                    return
+                }
+                OfflineManagerUtils.updateRegionMetadata(
+                    result: result,
+                    id: id,
+                    metadata: args["metadata"] as? [String: Any] ?? [:]
+                )
+            case "updateOfflineRegionMetadataBatch":
+                guard let args = methodCall.arguments as? [String: Any],
+                      let updates = args["updates"] as? [[String: Any]]
+                else {
+                    result(FlutterError(
+                        code: "UpdateMetadataError",
+                        message: "could not decode arguments",
+                        details: nil
+                    ))
+                    return
+                }
+                OfflineManagerUtils.updateRegionMetadataBatch(result: result, updates: updates)
             default:
                 result(FlutterMethodNotImplemented)
             }
         }
     }
 
-    private static func getTilesUrl() -> URL {
+    static func getTilesUrl() -> URL {
         guard var cachesUrl = FileManager.default.urls(
             for: .applicationSupportDirectory,
             in: .userDomainMask
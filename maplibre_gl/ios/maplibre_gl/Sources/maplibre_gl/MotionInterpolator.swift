@@ -0,0 +1,174 @@
+import Foundation
+
+/// Extrapolates the positions of moving points from their last fix by dead reckoning. This is the
+/// same algorithm as the Dart `MotionInterpolator`, see there for details. The state of all points
+/// is kept in a single array, so computing the positions of a frame allocates nothing.
+///
+/// Times are milliseconds since the epoch.
+final class MotionInterpolator {
+    private static let earthRadius = 6_371_008.8
+
+    // latitude, longitude, track, speed, fix time, latitude and longitude error of the fix and
+    // the start of its correction
+    private static let stride = 8
+
+    private let maxExtrapolation: Double
+    private let blendDuration: Double
+
+    /// The ids of the points in the order of `positions(at:into:)`.
+    private(set) var ids = [String]()
+    private var indexById = [String: Int]()
+    private var state = [Double]()
+    private var scratch = [Double](repeating: 0, count: 4)
+
+    init(maxExtrapolation: Double, blendDuration: Double) {
+        self.maxExtrapolation = maxExtrapolation
+        self.blendDuration = blendDuration
+    }
+
+    var count: Int { ids.count }
+
+    /// Sets the latest fix of the point `id` at `now` and returns its index, adding the point if
+    /// it is new.
+    @discardableResult
+    func update(
+        id: String,
+        latitude: Double,
+        longitude: Double,
+        track: Double,
+        speed: Double,
+        timestamp: Double,
+        now: Double
+    ) -> Int {
+        var errorLatitude = 0.0
+        var errorLongitude = 0.0
+        let index: Int
+        if let existing = indexById[id] {
+            index = existing
+            position(of: index, at: now, into: &scratch, offset: 0)
+            setFix(index, latitude, longitude, track, speed, timestamp)
+            position(of: index, at: now, into: &scratch, offset: 2)
+            errorLatitude = scratch[0] - scratch[2]
+            errorLongitude = MotionInterpolator.wrap(scratch[1] - scratch[3])
+        } else {
+            index = ids.count
+            ids.append(id)
+            indexById[id] = index
+            state.append(contentsOf: repeatElement(0, count: MotionInterpolator.stride))
+            setFix(index, latitude, longitude, track, speed, timestamp)
+        }
+        let offset = index * MotionInterpolator.stride
+        state[offset + 5] = errorLatitude
+        state[offset + 6] = errorLongitude
+        state[offset + 7] = now
+        return index
+    }
+
+    private func setFix(
+        _ index: Int,
+        _ latitude: Double,
+        _ longitude: Double,
+        _ track: Double,
+        _ speed: Double,
+        _ timestamp: Double
+    ) {
+        let offset = index * MotionInterpolator.stride
+        state[offset] = latitude
+        state[offset + 1] = longitude
+        state[offset + 2] = track
+        state[offset + 3] = speed
+        state[offset + 4] = timestamp
+        state[offset + 5] = 0
+        state[offset + 6] = 0
+    }
+
+    /// Removes the point `id` and returns its former index. The last point takes its place.
+    @discardableResult
+    func remove(id: String) -> Int? {
+        guard let index = indexById.removeValue(forKey: id) else { return nil }
+        let stride = MotionInterpolator.stride
+        let last = ids.count - 1
+        let lastId = ids.removeLast()
+        if index != last {
+            ids[index] = lastId
+            indexById[lastId] = index
+            for i in 0 ..< stride {
+                state[index * stride + i] = state[last * stride + i]
+            }
+        }
+        state.removeLast(stride)
+        return index
+    }
+
+    func removeAll() {
+        ids.removeAll()
+        indexById.removeAll()
+        state.removeAll()
+    }
+
+    /// Writes the positions of all points at `now` as latitude and longitude pairs in the order
+    /// of `ids` to `out`, growing it if needed.
+    func positions(at now: Double, into out: inout [Double]) {
+        if out.count < ids.count * 2 {
+            out = [Double](repeating: 0, count: ids.count * 2)
+        }
+        for i in 0 ..< ids.count {
+            position(of: i, at: now, into: &out, offset: i * 2)
+        }
+    }
+
+    /// Whether any point moves at `now`, i.e. is extrapolated or has an error being corrected.
+    func isMoving(at now: Double) -> Bool {
+        for i in 0 ..< ids.count {
+            let offset = i * MotionInterpolator.stride
+            if state[offset + 3] > 0, now - state[offset + 4] < maxExtrapolation {
+                return true
+            }
+            if state[offset + 5] != 0 || state[offset + 6] != 0, blend(offset, at: now) > 0 {
+                return true
+            }
+        }
+        return false
+    }
+
+    /// The remaining fraction of the fix error at `now`.
+    private func blend(_ offset: Int, at now: Double) -> Double {
+        if blendDuration <= 0 { return 0 }
+        let elapsed = now - state[offset + 7]
+        return elapsed >= blendDuration ? 0 : 1 - max(elapsed, 0) / blendDuration
+    }
+
+    /// Moves the fix of the point at `index` along its great circle by the distance travelled
+    /// until `now`, adds the remaining error of the fix and writes the position to `out`.
+    private func position(of index: Int, at now: Double, into out: inout [Double], offset outOffset: Int) {
+        let offset = index * MotionInterpolator.stride
+        var latitude = state[offset]
+        var longitude = state[offset + 1]
+        let seconds = min(max(now - state[offset + 4], 0), maxExtrapolation) / 1000
+        let distance = state[offset + 3] * seconds / MotionInterpolator.earthRadius
+        if distance > 0 {
+            let track = state[offset + 2] * .pi / 180
+            let latitude1 = latitude * .pi / 180
+            let latitude2 = asin(
+                sin(latitude1) * cos(distance) + cos(latitude1) * sin(distance) * cos(track)
+            )
+            let deltaLongitude = atan2(
+                sin(track) * sin(distance) * cos(latitude1),
+                cos(distance) - sin(latitude1) * sin(latitude2)
+            )
+            latitude = latitude2 * 180 / .pi
+            longitude += deltaLongitude * 180 / .pi
+        }
+        let blend = blend(offset, at: now)
+        out[outOffset] = latitude + state[offset + 5] * blend
+        out[outOffset + 1] = MotionInterpolator.wrap(longitude + state[offset + 6] * blend)
+    }
+
+    private static func wrap(_ longitude: Double) -> Double {
+        if longitude > 180 || longitude < -180 {
+            let wrapped = (longitude + 540).truncatingRemainder(dividingBy: 360)
+            return (wrapped < 0 ? wrapped + 360 : wrapped) - 180
+        }
+        return longitude
+    }
+}
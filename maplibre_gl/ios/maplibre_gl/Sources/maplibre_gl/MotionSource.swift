@@ -0,0 +1,101 @@
+import Foundation
+import MapLibre
+
+/// A geojson source of moving points. Dart sends the fixes of the points at the rate of its feed,
+/// the positions in between are extrapolated with a `MotionInterpolator` and set on the source
+/// once per display frame while any point moves.
+final class MotionSource: NSObject {
+    let source: MLNShapeSource
+    private let interpolator: MotionInterpolator
+
+    /// The attributes of the points in the order of the ids of the interpolator.
+    private var attributes = [[String: Any]]()
+    private var positions = [Double]()
+    private var displayLink: CADisplayLink?
+
+    init(sourceId: String, maxExtrapolation: Double, blendDuration: Double) {
+        source = MLNShapeSource(
+            identifier: sourceId,
+            shape: MLNShapeCollectionFeature(shapes: []),
+            options: [:]
+        )
+        interpolator = MotionInterpolator(
+            maxExtrapolation: maxExtrapolation,
+            blendDuration: blendDuration
+        )
+        super.init()
+    }
+
+    /// Sets the fixes of the points with `ids`, given as latitude, longitude, track, speed and
+    /// timestamp per point in `fixes`, and removes the points with `removeIds`.
+    func update(ids: [Any], fixes: [Double], properties: [Any], removeIds: [Any]) {
+        let now = Date().timeIntervalSince1970 * 1000
+        for id in removeIds {
+            guard let index = interpolator.remove(id: "\(id)") else { continue }
+            let last = attributes.removeLast()
+            if index < attributes.count {
+                attributes[index] = last
+            }
+        }
+        for (i, id) in ids.enumerated() {
+            let index = interpolator.update(
+                id: "\(id)",
+                latitude: fixes[i * 5],
+                longitude: fixes[i * 5 + 1],
+                track: fixes[i * 5 + 2],
+                speed: fixes[i * 5 + 3],
+                timestamp: fixes[i * 5 + 4],
+                now: now
+            )
+            var pointAttributes = i < properties.count
+                ? properties[i] as? [String: Any] ?? [:]
+                : [:]
+            pointAttributes["id"] = id
+            if index == attributes.count {
+                attributes.append(pointAttributes)
+            } else {
+                attributes[index] = pointAttributes
+            }
+        }
+        render(at: now)
+        startDisplayLink()
+    }
+
+    /// Stops the frame updates, e.g. once the source was removed.
+    func stop() {
+        displayLink?.invalidate()
+        displayLink = nil
+    }
+
+    private func startDisplayLink() {
+        guard displayLink == nil else { return }
+        let displayLink = CADisplayLink(target: self, selector: #selector(onFrame))
+        displayLink.add(to: .main, forMode: .common)
+        self.displayLink = displayLink
+    }
+
+    @objc private func onFrame() {
+        let now = Date().timeIntervalSince1970 * 1000
+        render(at: now)
+        if !interpolator.isMoving(at: now) {
+            stop()
+        }
+    }
+
+    private func render(at now: Double) {
+        interpolator.positions(at: now, into: &positions)
+        var features = [MLNPointFeature]()
+        features.reserveCapacity(interpolator.count)
+        for (i, id) in interpolator.ids.enumerated() {
+            let feature = MLNPointFeature()
+            feature.coordinate = CLLocationCoordinate2D(
+                latitude: positions[i * 2],
+                longitude: positions[i * 2 + 1]
+            )
+            feature.identifier = id
+            feature.attributes = attributes[i]
+            features.append(feature)
+        }
+        source.shape = MLNShapeCollectionFeature(shapes: features)
+    }
+}
@@ -0,0 +1,162 @@
+import Foundation
+import MapLibre
+
+/// The URL session MapLibre fetches styles, tiles, glyphs and sprites with.
+///
+/// The session is provided to MapLibre as the delegate of its network configuration, so it can
+/// collect the requests, cache hits and latency per host, and per source with
+/// `TileRequestStatistics`, from the task metrics. A URL session copies its configuration, so
+/// headers and configuration changes create a new session, the previous one finishes its running
+/// tasks. URLSession negotiates HTTP/2 and pools its
+/// connections on its own, only the connections per host are configurable.
+class NetworkConfiguration: NSObject, MLNNetworkConfigurationDelegate, URLSessionTaskDelegate {
+    static let shared = NetworkConfiguration()
+
+    private static let cacheDirectory = "maplibre_http_cache"
+
+    private var configuration = NetworkConfiguration.defaultConfiguration()
+    private var headers = [String: String]()
+    private var currentSession: URLSession?
+    private var statistics = [String: HostStatistics]()
+    private let lock = NSLock()
+
+    /// The configuration MapLibre uses by default, its ambient cache replaces the URL cache.
+    private static func defaultConfiguration() -> URLSessionConfiguration {
+        let configuration = URLSessionConfiguration.default
+        configuration.httpMaximumConnectionsPerHost = 8
+        configuration.requestCachePolicy = .reloadIgnoringLocalCacheData
+        configuration.urlCache = nil
+        return configuration
+    }
+
+    /// Installs the session with the default configuration, unless a session is installed.
+    func ensureSession() {
+        if currentSession == nil {
+            install()
+        }
+    }
+
+    func setHeaders(_ headers: [String: String]) {
+        self.headers = headers
+        install()
+    }
+
+    /// Applies the configuration sent by `setNetworkConfiguration`.
+    func configure(_ arguments: [String: Any]) {
+        let configuration = NetworkConfiguration.defaultConfiguration()
+        if let maxRequestsPerHost = arguments["maxRequestsPerHost"] as? Int {
+            configuration.httpMaximumConnectionsPerHost = maxRequestsPerHost
+        }
+        if let readTimeout = arguments["readTimeout"] as? Int {
+            configuration.timeoutIntervalForRequest = TimeInterval(readTimeout) / 1000
+        }
+        let diskCacheSize = arguments["diskCacheSize"] as? Int ?? 0
+        if diskCacheSize > 0 {
+            configuration.urlCache = URLCache(
+                memoryCapacity: 0,
+                diskCapacity: diskCacheSize,
+                diskPath: NetworkConfiguration.cacheDirectory
+            )
+            configuration.requestCachePolicy = .useProtocolCachePolicy
+        }
+        self.configuration = configuration
+        install()
+    }
+
+    /// The statistics per host since the last reset.
+    func statistics(reset: Bool) -> [String: [String: Int]] {
+        lock.lock()
+        defer { lock.unlock() }
+        let result = statistics.mapValues { $0.toDictionary() }
+        if reset {
+            statistics.removeAll()
+        }
+        return result
+    }
+
+    private func install() {
+        let configuration = self.configuration.copy() as! URLSessionConfiguration
+        configuration.httpAdditionalHeaders = headers
+        currentSession?.finishTasksAndInvalidate()
+        currentSession = URLSession(configuration: configuration, delegate: self, delegateQueue: nil)
+        MLNNetworkConfiguration.sharedManager.delegate = self
+    }
+
+    // MARK: - MLNNetworkConfigurationDelegate
+
+    @objc(sessionForNetworkConfiguration:)
+    func session(for _: MLNNetworkConfiguration) -> URLSession {
+        return currentSession ?? URLSession.shared
+    }
+
+    // MARK: - URLSessionTaskDelegate
+
+    func urlSession(
+        _: URLSession,
+        task: URLSessionTask,
+        didFinishCollecting metrics: URLSessionTaskMetrics
+    ) {
+        guard let url = task.originalRequest?.url,
+              let host = url.host,
+              let transaction = metrics.transactionMetrics.last
+        else { return }
+        if (task.error as? URLError)?.code == .cancelled {
+            // MapLibre cancels the requests of tiles that left the viewport
+            return
+        }
+        let latency = transaction.responseStartDate.map { start in
+            Int(start.timeIntervalSince(metrics.taskInterval.start) * 1000)
+        }
+        let statusCode = (task.response as? HTTPURLResponse)?.statusCode
+        let isCacheHit = transaction.resourceFetchType == .localCache
+        let isConditionalHit = metrics.transactionMetrics.contains {
+            ($0.response as? HTTPURLResponse)?.statusCode == 304
+        }
+        let latencyOrDuration = latency ?? Int(metrics.taskInterval.duration * 1000)
+        TileRequestStatistics.shared.record(
+            url: url,
+            latency: latencyOrDuration,
+            bytes: Int(task.countOfBytesReceived),
+            statusCode: task.error == nil ? statusCode : nil,
+            isHttpCacheHit: isCacheHit
+        )
+        lock.lock()
+        defer { lock.unlock() }
+        statistics[host, default: HostStatistics()].record(
+            latency: latencyOrDuration,
+            isSuccessful: task.error == nil && statusCode.map { $0 < 400 } ?? false,
+            isCacheHit: isCacheHit,
+            isConditionalHit: isConditionalHit
+        )
+    }
+}
+
+/// The requests to a host, with their latency until the response headers arrived.
+private struct HostStatistics {
+    var requests = 0
+    var failures = 0
+    var cacheHits = 0
+    var conditionalHits = 0
+    var totalLatency = 0
+    var maxLatency = 0
+
+    mutating func record(latency: Int, isSuccessful: Bool, isCacheHit: Bool, isConditionalHit: Bool) {
+        requests += 1
+        if !isSuccessful { failures += 1 }
+        if isCacheHit { cacheHits += 1 }
+        if isConditionalHit { conditionalHits += 1 }
+        totalLatency += latency
+        maxLatency = max(maxLatency, latency)
+    }
+
+    func toDictionary() -> [String: Int] {
+        return [
+            "requests": requests,
+            "failures": failures,
+            "cacheHits": cacheHits,
+            "conditionalHits": conditionalHits,
+            "totalLatency": totalLatency,
+            "maxLatency": maxLatency,
+        ]
+    }
+}
@@ -0,0 +1,221 @@
+import Flutter
+import Foundation
+import MapLibre
+
+/// Primitives of the Dart `OfflineDownloadQueue`: offline packs are created without being
+/// downloaded, and downloads are resumed and suspended by region id. The status of all downloads
+/// is reported on one shared event channel, progress at most every `progressInterval` per region.
+/// The queue itself is scheduled in Dart and persisted here as an opaque string.
+class OfflineDownloads: NSObject, FlutterStreamHandler {
+    private static let channelName = "plugins.flutter.io/maplibre_gl/offline_downloads"
+    private static let queueKey = "org.maplibre.maplibregl.offline_downloads.queue"
+    private static let progressInterval: TimeInterval = 0.25
+
+    private var sink: FlutterEventSink?
+    /// The region ids of the packs being downloaded by pack.
+    private var activeIds = [ObjectIdentifier: Int]()
+    private var activePacks = [Int: MLNOfflinePack]()
+    private var lastProgressTimes = [Int: TimeInterval]()
+
+    init(messenger: FlutterBinaryMessenger) {
+        super.init()
+        FlutterEventChannel(name: OfflineDownloads.channelName, binaryMessenger: messenger)
+            .setStreamHandler(self)
+        NotificationCenter.default.addObserver(
+            self,
+            selector: #selector(onProgress(notification:)),
+            name: NSNotification.Name.MLNOfflinePackProgressChanged,
+            object: nil
+        )
+        NotificationCenter.default.addObserver(
+            self,
+            selector: #selector(onError(notification:)),
+            name: NSNotification.Name.MLNOfflinePackError,
+            object: nil
+        )
+        NotificationCenter.default.addObserver(
+            self,
+            selector: #selector(onMaximumAllowedMapboxTiles(notification:)),
+            name: NSNotification.Name.MLNOfflinePackMaximumMapboxTilesReached,
+            object: nil
+        )
+    }
+
+    deinit {
+        NotificationCenter.default.removeObserver(self)
+    }
+
+    // MARK: FlutterStreamHandler protocol compliance
+
+    func onListen(withArguments _: Any?,
+                  eventSink events: @escaping FlutterEventSink) -> FlutterError?
+    {
+        sink = events
+        return nil
+    }
+
+    func onCancel(withArguments _: Any?) -> FlutterError? {
+        sink = nil
+        return nil
+    }
+
+    // MARK: Downloads
+
+    /// Creates an offline pack without starting its download.
+    func create(
+        definition: OfflineRegionDefinition,
+        metadata: [String: Any],
+        result: @escaping FlutterResult
+    ) {
+        // the iOS SDK does not generate region ids, see OfflinePackDownloader
+        let region = OfflineRegion(id: UUID().hashValue, metadata: metadata, definition: definition)
+        MLNOfflineStorage.shared.addPack(
+            for: definition.toMLNOfflineRegion(),
+            withContext: region.prepareContext()
+        ) { pack, error in
+            guard pack != nil else {
+                result(FlutterError(
+                    code: "mapboxInvalidRegionDefinition",
+                    message: error?.localizedDescription,
+                    details: nil
+                ))
+                return
+            }
+            result(region.toDictionary())
+        }
+    }
+
+    /// Starts or resumes the download of the region `id`. Tiles already stored are kept.
+    func resume(id: Int, result: @escaping FlutterResult) {
+        if activePacks[id] == nil {
+            guard let pack = OfflineRegionIndex.shared.pack(id: id) else {
+                result(FlutterError(
+                    code: "RegionNotFound",
+                    message: "There is no region with id \(id)",
+                    details: nil
+                ))
+                return
+            }
+            activePacks[id] = pack
+            activeIds[ObjectIdentifier(pack)] = id
+            pack.resume()
+        }
+        result(nil)
+    }
+
+    /// Suspends the download of the region `id`, it can be resumed later.
+    func pause(id: Int, result: @escaping FlutterResult) {
+        if let pack = activePacks[id] {
+            pack.suspend()
+            finish(id: id, pack: pack)
+        }
+        result(nil)
+    }
+
+    /// Marks the tiles of the region `id` as expired, so that its next download revalidates them
+    /// with conditional requests and only rewrites the tiles that changed.
+    func invalidate(id: Int, result: @escaping FlutterResult) {
+        guard let pack = OfflineRegionIndex.shared.pack(id: id) else {
+            result(FlutterError(
+                code: "RegionNotFound",
+                message: "There is no region with id \(id)",
+                details: nil
+            ))
+            return
+        }
+        MLNOfflineStorage.shared.invalidatePack(pack) { error in
+            if let error = error {
+                result(FlutterError(
+                    code: "InvalidateRegionError",
+                    message: error.localizedDescription,
+                    details: nil
+                ))
+            } else {
+                result(nil)
+            }
+        }
+    }
+
+    func saveQueue(_ queue: String, result: @escaping FlutterResult) {
+        UserDefaults.standard.set(queue, forKey: OfflineDownloads.queueKey)
+        result(nil)
+    }
+
+    func loadQueue(result: @escaping FlutterResult) {
+        result(UserDefaults.standard.string(forKey: OfflineDownloads.queueKey))
+    }
+
+    private func finish(id: Int, pack: MLNOfflinePack) {
+        activePacks.removeValue(forKey: id)
+        activeIds.removeValue(forKey: ObjectIdentifier(pack))
+        lastProgressTimes.removeValue(forKey: id)
+    }
+
+    // MARK: Progress observation
+
+    @objc private func onProgress(notification: NSNotification) {
+        guard let pack = notification.object as? MLNOfflinePack,
+              let id = activeIds[ObjectIdentifier(pack)] else { return }
+        if pack.state == .complete {
+            finish(id: id, pack: pack)
+            send(id: id, status: "complete", progress: pack.progress)
+            return
+        }
+        let now = Date().timeIntervalSince1970
+        if let last = lastProgressTimes[id], now - last < OfflineDownloads.progressInterval {
+            return
+        }
+        lastProgressTimes[id] = now
+        send(id: id, status: "progress", progress: pack.progress)
+    }
+
+    @objc private func onError(notification: NSNotification) {
+        guard let pack = notification.object as? MLNOfflinePack,
+              let id = activeIds[ObjectIdentifier(pack)] else { return }
+        let error = notification.userInfo?[MLNOfflinePackUserInfoKey.error] as? NSError
+        pack.suspend()
+        finish(id: id, pack: pack)
+        send(
+            id: id,
+            status: "error",
+            errorCode: "Downloading error",
+            errorMessage: error?.localizedDescription
+        )
+    }
+
+    @objc private func onMaximumAllowedMapboxTiles(notification: NSNotification) {
+        guard let pack = notification.object as? MLNOfflinePack,
+              let id = activeIds[ObjectIdentifier(pack)] else { return }
+        let maximumCount = (notification.userInfo?[MLNOfflinePackUserInfoKey.maximumCount]
+            as AnyObject).uint64Value ?? 0
+        pack.suspend()
+        finish(id: id, pack: pack)
+        send(
+            id: id,
+            status: "error",
+            errorCode: "mapboxTileCountLimitExceeded",
+            errorMessage: "MapLibre tile count limit exceeded: \(maximumCount)"
+        )
+    }
+
+    private func send(
+        id: Int,
+        status: String,
+        progress: MLNOfflinePackProgress? = nil,
+        errorCode: String? = nil,
+        errorMessage: String? = nil
+    ) {
+        var event: [String: Any] = ["id": id, "status": status]
+        if let progress = progress {
+            event["completedResources"] = progress.countOfResourcesCompleted
+            event["requiredResources"] = progress.countOfResourcesExpected
+            event["completedTiles"] = progress.countOfTilesCompleted
+            event["completedBytes"] = progress.countOfBytesCompleted
+        }
+        if let errorCode = errorCode {
+            event["errorCode"] = errorCode
+            event["errorMessage"] = errorMessage
+        }
+        sink?(event)
+    }
+}
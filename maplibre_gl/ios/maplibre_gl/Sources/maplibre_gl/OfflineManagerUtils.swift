@@ -34,21 +34,10 @@ class OfflineManagerUtils {
     }
 
     static func regionsList(result: @escaping FlutterResult) {
-        let offlineStorage = MLNOfflineStorage.shared
-        guard let packs = offlineStorage.packs else {
-            result("[]")
-            return
-        }
-        let regionsArgs = packs.compactMap { pack in
+        let regionsArgs = (MLNOfflineStorage.shared.packs ?? []).compactMap { pack in
             OfflineRegion.fromOfflinePack(pack)?.toDictionary()
         }
-        guard let regionsArgsJsonData = try? JSONSerialization.data(withJSONObject: regionsArgs),
-              let regionsArgsJsonString = String(data: regionsArgsJsonData, encoding: .utf8)
-        else {
-            result(FlutterError(code: "RegionListError", message: nil, details: nil))
-            return
-        }
-        result(regionsArgsJsonString)
+        result(regionsArgs)
     }
 
     static func setOfflineTileCountLimit(result: @escaping FlutterResult, maximumCount: UInt64) {
@@ -57,39 +46,187 @@ class OfflineManagerUtils {
         result(nil)
     }
 
+    /// The default of MapLibre until the size is set.
+    private static var maximumAmbientCacheSize = 50 * 1024 * 1024
+
+    static func setMaximumAmbientCacheSize(result: @escaping FlutterResult, size: UInt64) {
+        MLNOfflineStorage.shared.setMaximumAmbientCacheSize(UInt(size)) { error in
+            if let error = error {
+                result(FlutterError(
+                    code: "AmbientCacheSizeError",
+                    message: error.localizedDescription,
+                    details: nil
+                ))
+            } else {
+                maximumAmbientCacheSize = Int(size)
+                result(nil)
+            }
+        }
+    }
+
+    /// The size of the database and the free and total space of its storage.
+    static func ambientCacheStatistics(result: @escaping FlutterResult) {
+        let databaseUrl = MapLibreMapsPlugin.getTilesUrl()
+        let databaseSize = (try? FileManager.default
+            .attributesOfItem(atPath: databaseUrl.path)[.size] as? Int) ?? 0
+        // the database is created on first use, the home directory is on the same volume
+        let storage = try? URL(fileURLWithPath: NSHomeDirectory()).resourceValues(forKeys: [
+            .volumeAvailableCapacityForImportantUsageKey,
+            .volumeTotalCapacityKey,
+        ])
+        let statistics: [String: Any] = [
+            "databaseSize": databaseSize,
+            "maximumAmbientCacheSize": maximumAmbientCacheSize,
+            "freeSpace": storage?.volumeAvailableCapacityForImportantUsage ?? 0,
+            "totalSpace": storage?.volumeTotalCapacity ?? 0,
+        ]
+        result(statistics)
+    }
+
     static func deleteRegion(result: @escaping FlutterResult, id: Int) {
-        let offlineStorage = MLNOfflineStorage.shared
-        guard let pacs = offlineStorage.packs else { return }
-        let packToRemove = pacs.first(where: { pack -> Bool in
-            let contextJsonObject = try? JSONSerialization.jsonObject(with: pack.context)
-            let contextJsonDict = contextJsonObject as? [String: Any]
-            if let regionId = contextJsonDict?["id"] as? Int {
-                return regionId == id
+        guard let pack = OfflineRegionIndex.shared.pack(id: id) else {
+            result(FlutterError(
+                code: "DeleteRegionError",
+                message: "There is no region with given id to delete",
+                details: nil
+            ))
+            return
+        }
+        delete(pack: pack, id: id) { error in
+            if let error = error {
+                result(FlutterError(
+                    code: "DeleteRegionError",
+                    message: error.localizedDescription,
+                    details: nil
+                ))
+            } else {
+                result(nil)
+            }
+        }
+    }
+
+    /// Deletes several regions. Responds once all deletions are done, or with the ids of the
+    /// regions that could not be deleted.
+    static func deleteRegions(result: @escaping FlutterResult, ids: [Int]) {
+        let group = DispatchGroup()
+        var failedIds = [Int]()
+        for id in ids {
+            guard let pack = OfflineRegionIndex.shared.pack(id: id) else {
+                failedIds.append(id)
+                continue
+            }
+            group.enter()
+            delete(pack: pack, id: id) { error in
+                if error != nil {
+                    failedIds.append(id)
+                }
+                group.leave()
+            }
+        }
+        group.notify(queue: .main) {
+            respond(result: result, errorCode: "DeleteRegionError", failedIds: failedIds, value: nil)
+        }
+    }
+
+    private static func delete(
+        pack: MLNOfflinePack,
+        id: Int,
+        completion: @escaping (Error?) -> Void
+    ) {
+        // deletion is only safe if the download is suspended
+        pack.suspend()
+        OfflineManagerUtils.releaseDownloader(id: id)
+        MLNOfflineStorage.shared.removePack(pack, withCompletionHandler: completion)
+    }
+
+    static func updateRegionMetadata(
+        result: @escaping FlutterResult,
+        id: Int,
+        metadata: [String: Any]
+    ) {
+        guard let pack = OfflineRegionIndex.shared.pack(id: id) else {
+            result(FlutterError(
+                code: "UpdateMetadataError",
+                message: "There is no region with given id to update.",
+                details: nil
+            ))
+            return
+        }
+        updateMetadata(pack: pack, metadata: metadata) { region, error in
+            if let region = region {
+                result(region.toDictionary())
             } else {
-                return false
+                result(FlutterError(
+                    code: "UpdateMetadataError",
+                    message: error?.localizedDescription,
+                    details: nil
+                ))
+            }
+        }
+    }
+
+    /// Updates the metadata of several regions, `updates` holds the `id` and the `metadata` of
+    /// each region. Responds with the updated regions once all updates are done, or with the ids
+    /// of the regions that could not be updated.
+    static func updateRegionMetadataBatch(result: @escaping FlutterResult, updates: [[String: Any]]) {
+        let group = DispatchGroup()
+        var regions = [[String: Any]]()
+        var failedIds = [Int]()
+        for update in updates {
+            guard let id = update["id"] as? Int else { continue }
+            guard let pack = OfflineRegionIndex.shared.pack(id: id) else {
+                failedIds.append(id)
+                continue
             }
-        })
-        if let packToRemoveUnwrapped = packToRemove {
-            // deletion is only safe if the download is suspended
-            packToRemoveUnwrapped.suspend()
-            OfflineManagerUtils.releaseDownloader(id: id)
-
-            offlineStorage.removePack(packToRemoveUnwrapped) { error in
-                if let error = error {
-                    result(FlutterError(
-                        code: "DeleteRegionError",
-                        message: error.localizedDescription,
-                        details: nil
-                    ))
+            group.enter()
+            updateMetadata(pack: pack, metadata: update["metadata"] as? [String: Any] ?? [:]) {
+                region, _ in
+                if let region = region {
+                    regions.append(region.toDictionary())
                 } else {
-                    result(nil)
+                    failedIds.append(id)
                 }
+                group.leave()
             }
+        }
+        group.notify(queue: .main) {
+            respond(
+                result: result,
+                errorCode: "UpdateMetadataError",
+                failedIds: failedIds,
+                value: regions
+            )
+        }
+    }
+
+    private static func updateMetadata(
+        pack: MLNOfflinePack,
+        metadata: [String: Any],
+        completion: @escaping (OfflineRegion?, Error?) -> Void
+    ) {
+        guard let region = OfflineRegion.fromOfflinePack(pack) else {
+            completion(nil, OfflinePackError.InvalidPackData)
+            return
+        }
+        let updated = OfflineRegion(id: region.id, metadata: metadata, definition: region.definition)
+        pack.setContext(updated.prepareContext()) { error in
+            completion(error == nil ? updated : nil, error)
+        }
+    }
+
+    private static func respond(
+        result: FlutterResult,
+        errorCode: String,
+        failedIds: [Int],
+        value: Any?
+    ) {
+        if failedIds.isEmpty {
+            result(value)
         } else {
             result(FlutterError(
-                code: "DeleteRegionError",
-                message: "There is no region with given id to delete",
-                details: nil
+                code: errorCode,
+                message: "Failed for the regions \(failedIds)",
+                details: failedIds
             ))
         }
     }
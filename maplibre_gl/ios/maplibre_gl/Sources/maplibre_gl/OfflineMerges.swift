@@ -0,0 +1,382 @@
+import Flutter
+import Foundation
+import MapLibre
+import SQLite3
+
+/// Merges side loaded offline databases in the background, with progress and cancellation.
+///
+/// A merge copies the database to the caches directory, which MapLibre needs writable anyway, and
+/// compares its tiles byte by byte with the tiles already stored. MapLibre replaces stored
+/// tiles by merged tiles that were modified later, so identical tiles are marked as modified at the
+/// time of the stored ones and are not written again. The copy is then merged by MapLibre, which
+/// can't be canceled or report progress. The status of all merges is reported on one shared event
+/// channel, progress at most every `progressInterval`.
+class OfflineMerges: NSObject, FlutterStreamHandler {
+    private static let channelName = "plugins.flutter.io/maplibre_gl/offline_merges"
+    private static let progressInterval: TimeInterval = 0.25
+    private static let bufferSize = 1024 * 1024
+    private static let batchSize = 256
+
+    private let queue = DispatchQueue(label: "org.maplibre.maplibregl.offline_merges")
+    private var sink: FlutterEventSink?
+    private var nextId = 0
+    /// The ids of the merges to cancel, guarded by `lock` as merges run on `queue`.
+    private var canceledIds = Set<Int>()
+    private let lock = NSLock()
+
+    private struct Canceled: Error {}
+
+    private struct MergeError: Error {
+        let message: String
+    }
+
+    /// The progress of a merge, updated on `queue`.
+    private class Progress {
+        let id: Int
+        var phase = "copying"
+        var completedBytes = 0
+        var totalBytes = 0
+        var completedTiles = 0
+        var totalTiles = 0
+        var skippedTiles = 0
+        var skippedBytes = 0
+        var lastSent: TimeInterval = 0
+
+        init(id: Int) {
+            self.id = id
+        }
+
+        func toDictionary(status: String) -> [String: Any] {
+            return [
+                "id": id,
+                "status": status,
+                "phase": phase,
+                "completedBytes": completedBytes,
+                "totalBytes": totalBytes,
+                "completedTiles": completedTiles,
+                "totalTiles": totalTiles,
+                "skippedTiles": skippedTiles,
+                "skippedBytes": skippedBytes,
+            ]
+        }
+    }
+
+    init(messenger: FlutterBinaryMessenger) {
+        super.init()
+        FlutterEventChannel(name: OfflineMerges.channelName, binaryMessenger: messenger)
+            .setStreamHandler(self)
+    }
+
+    // MARK: FlutterStreamHandler protocol compliance
+
+    func onListen(withArguments _: Any?,
+                  eventSink events: @escaping FlutterEventSink) -> FlutterError?
+    {
+        sink = events
+        return nil
+    }
+
+    func onCancel(withArguments _: Any?) -> FlutterError? {
+        sink = nil
+        return nil
+    }
+
+    // MARK: Merges
+
+    /// Starts merging the database at `path` and returns the id of the merge.
+    func start(path: String, result: @escaping FlutterResult) {
+        let id = nextId
+        nextId += 1
+        result(id)
+        queue.async {
+            self.prepare(id: id, source: URL(fileURLWithPath: path))
+        }
+    }
+
+    /// Cancels the merge `id`, unless MapLibre already merges it.
+    func cancel(id: Int, result: @escaping FlutterResult) {
+        lock.lock()
+        canceledIds.insert(id)
+        lock.unlock()
+        result(nil)
+    }
+
+    private func prepare(id: Int, source: URL) {
+        let copy = FileManager.default.urls(for: .cachesDirectory, in: .userDomainMask)[0]
+            .appendingPathComponent("offline_merge_\(id).db")
+        let progress = Progress(id: id)
+        do {
+            try self.copy(from: source, to: copy, progress: progress)
+            progress.phase = "deduplicating"
+            try deduplicate(copy, progress: progress)
+            progress.phase = "merging"
+            sendProgress(progress, force: true)
+            DispatchQueue.main.async {
+                self.merge(copy, progress: progress)
+            }
+        } catch is Canceled {
+            finish(copy, id: id)
+            send(progress.toDictionary(status: "canceled"))
+        } catch {
+            finish(copy, id: id)
+            var event = progress.toDictionary(status: "error")
+            event["errorMessage"] = (error as? MergeError)?.message ?? error.localizedDescription
+            send(event)
+        }
+    }
+
+    private func checkCanceled(_ progress: Progress) throws {
+        lock.lock()
+        defer { lock.unlock() }
+        if canceledIds.contains(progress.id) {
+            throw Canceled()
+        }
+    }
+
+    private func copy(from source: URL, to destination: URL, progress: Progress) throws {
+        let attributes = try FileManager.default.attributesOfItem(atPath: source.path)
+        progress.totalBytes = attributes[.size] as? Int ?? 0
+        if #available(iOS 13.4, *) {
+            try copyWithFileHandles(from: source, to: destination, progress: progress)
+        } else {
+            try copyWithStreams(from: source, to: destination, progress: progress)
+        }
+    }
+
+    /// Copies with the throwing file handle API. The legacy API raises Objective-C exceptions on
+    /// I/O errors, e.g. a full disk, which Swift can't catch.
+    @available(iOS 13.4, *)
+    private func copyWithFileHandles(
+        from source: URL,
+        to destination: URL,
+        progress: Progress
+    ) throws {
+        guard FileManager.default.createFile(atPath: destination.path, contents: nil) else {
+            throw MergeError(message: "Could not create \(destination.path)")
+        }
+        let input = try FileHandle(forReadingFrom: source)
+        let output = try FileHandle(forWritingTo: destination)
+        defer {
+            try? input.close()
+            try? output.close()
+        }
+        while true {
+            // the chunks are released after each iteration
+            let isDone = try autoreleasepool { () -> Bool in
+                guard let chunk = try input.read(upToCount: OfflineMerges.bufferSize),
+                      !chunk.isEmpty
+                else { return true }
+                try checkCanceled(progress)
+                try output.write(contentsOf: chunk)
+                progress.completedBytes += chunk.count
+                return false
+            }
+            if isDone { break }
+            sendProgress(progress, force: false)
+        }
+    }
+
+    /// Copies with streams before iOS 13.4, whose errors are reported by their results.
+    private func copyWithStreams(from source: URL, to destination: URL, progress: Progress) throws {
+        guard let input = InputStream(url: source),
+              let output = OutputStream(url: destination, append: false)
+        else {
+            throw MergeError(message: "Could not copy \(source.path)")
+        }
+        input.open()
+        output.open()
+        defer {
+            input.close()
+            output.close()
+        }
+        var buffer = [UInt8](repeating: 0, count: OfflineMerges.bufferSize)
+        while true {
+            let count = input.read(&buffer, maxLength: buffer.count)
+            if count < 0 {
+                throw input.streamError ?? MergeError(message: "Could not read \(source.path)")
+            }
+            if count == 0 { break }
+            try checkCanceled(progress)
+            var written = 0
+            while written < count {
+                let result = buffer.withUnsafeBufferPointer { bytes in
+                    output.write(bytes.baseAddress! + written, maxLength: count - written)
+                }
+                if result <= 0 {
+                    throw output.streamError
+                        ?? MergeError(message: "Could not write \(destination.path)")
+                }
+                written += result
+            }
+            progress.completedBytes += count
+            sendProgress(progress, force: false)
+        }
+    }
+
+    private func deduplicate(_ copy: URL, progress: Progress) throws {
+        var side: OpaquePointer?
+        guard sqlite3_open_v2(copy.path, &side, SQLITE_OPEN_READWRITE, nil) == SQLITE_OK else {
+            sqlite3_close(side)
+            throw MergeError(message: "Could not open \(copy.path)")
+        }
+        defer { sqlite3_close(side) }
+
+        try query(side, "SELECT COUNT(*), TOTAL(LENGTH(data)) FROM tiles") { statement in
+            progress.totalTiles = Int(sqlite3_column_int64(statement, 0))
+            progress.totalBytes = Int(sqlite3_column_double(statement, 1))
+        }
+        progress.completedBytes = 0
+
+        let database = MapLibreMapsPlugin.getTilesUrl()
+        var main: OpaquePointer?
+        guard FileManager.default.fileExists(atPath: database.path),
+              sqlite3_open_v2(database.path, &main, SQLITE_OPEN_READONLY, nil) == SQLITE_OK
+        else {
+            sqlite3_close(main)
+            progress.completedTiles = progress.totalTiles
+            progress.completedBytes = progress.totalBytes
+            return
+        }
+        defer { sqlite3_close(main) }
+
+        // prepared once and reset between tiles
+        var stored: OpaquePointer?
+        let sql = "SELECT modified, data FROM tiles WHERE url_template = ?1 AND pixel_ratio = ?2"
+            + " AND z = ?3 AND x = ?4 AND y = ?5"
+        guard sqlite3_prepare_v2(main, sql, -1, &stored, nil) == SQLITE_OK else {
+            throw MergeError(message: String(cString: sqlite3_errmsg(main)))
+        }
+        defer { sqlite3_finalize(stored) }
+
+        var lastId: Int64 = -1
+        while true {
+            try checkCanceled(progress)
+            var updates = [(id: Int64, modified: Int64)]()
+            var rows = 0
+            try query(
+                side,
+                "SELECT id, url_template, pixel_ratio, z, x, y, modified, data FROM tiles"
+                    + " WHERE id > \(lastId) ORDER BY id LIMIT \(OfflineMerges.batchSize)"
+            ) { tile in
+                rows += 1
+                lastId = sqlite3_column_int64(tile, 0)
+                let size = Int(sqlite3_column_bytes(tile, 7))
+                if let storedModified = storedModifiedIfIdentical(stored, tile: tile) {
+                    progress.skippedTiles += 1
+                    progress.skippedBytes += size
+                    if sqlite3_column_type(tile, 6) == SQLITE_NULL
+                        || sqlite3_column_int64(tile, 6) > storedModified
+                    {
+                        updates.append((lastId, storedModified))
+                    }
+                }
+                progress.completedTiles += 1
+                progress.completedBytes += size
+            }
+            if !updates.isEmpty {
+                sqlite3_exec(side, "BEGIN", nil, nil, nil)
+                for update in updates {
+                    sqlite3_exec(
+                        side,
+                        "UPDATE tiles SET modified = \(update.modified) WHERE id = \(update.id)",
+                        nil,
+                        nil,
+                        nil
+                    )
+                }
+                guard sqlite3_exec(side, "COMMIT", nil, nil, nil) == SQLITE_OK else {
+                    throw MergeError(message: String(cString: sqlite3_errmsg(side)))
+                }
+            }
+            sendProgress(progress, force: false)
+            if rows < OfflineMerges.batchSize { break }
+        }
+    }
+
+    /// The modification time of the stored tile with the key of `tile`, if its data is the same,
+    /// looked up with the prepared statement `stored`.
+    private func storedModifiedIfIdentical(
+        _ stored: OpaquePointer?,
+        tile: OpaquePointer?
+    ) -> Int64? {
+        defer {
+            sqlite3_reset(stored)
+            sqlite3_clear_bindings(stored)
+        }
+        for column in Int32(1) ... 5 {
+            sqlite3_bind_value(stored, column, sqlite3_column_value(tile, column))
+        }
+        guard sqlite3_step(stored) == SQLITE_ROW,
+              sqlite3_column_type(stored, 0) != SQLITE_NULL
+        else { return nil }
+        return OfflineMerges.isSameBlob(tile, 7, stored, 1) ? sqlite3_column_int64(stored, 0) : nil
+    }
+
+    private func query(
+        _ database: OpaquePointer?,
+        _ sql: String,
+        row: (OpaquePointer?) throws -> Void
+    ) throws {
+        var statement: OpaquePointer?
+        guard sqlite3_prepare_v2(database, sql, -1, &statement, nil) == SQLITE_OK else {
+            throw MergeError(message: String(cString: sqlite3_errmsg(database)))
+        }
+        defer { sqlite3_finalize(statement) }
+        while sqlite3_step(statement) == SQLITE_ROW {
+            try row(statement)
+        }
+    }
+
+    /// Whether the blobs in the columns of the current rows of two statements are equal.
+    private static func isSameBlob(
+        _ statement: OpaquePointer?,
+        _ column: Int32,
+        _ other: OpaquePointer?,
+        _ otherColumn: Int32
+    ) -> Bool {
+        // the blobs are read before their sizes, as SQLite recommends
+        let bytes = sqlite3_column_blob(statement, column)
+        let otherBytes = sqlite3_column_blob(other, otherColumn)
+        let count = sqlite3_column_bytes(statement, column)
+        guard count == sqlite3_column_bytes(other, otherColumn) else { return false }
+        return count == 0 || memcmp(bytes, otherBytes, Int(count)) == 0
+    }
+
+    private func merge(_ copy: URL, progress: Progress) {
+        MLNOfflineStorage.shared.addContents(ofFile: copy.path) { _, packs, error in
+            self.finish(copy, id: progress.id)
+            if let error = error {
+                var event = progress.toDictionary(status: "error")
+                event["errorMessage"] = error.localizedDescription
+                self.send(event)
+                return
+            }
+            var event = progress.toDictionary(status: "complete")
+            event["regions"] = (packs ?? []).compactMap { pack in
+                OfflineRegion.fromOfflinePack(pack)?.toDictionary()
+            }
+            self.send(event)
+        }
+    }
+
+    private func finish(_ copy: URL, id: Int) {
+        lock.lock()
+        canceledIds.remove(id)
+        lock.unlock()
+        try? FileManager.default.removeItem(at: copy)
+    }
+
+    private func sendProgress(_ progress: Progress, force: Bool) {
+        let now = Date().timeIntervalSince1970
+        if !force, now - progress.lastSent < OfflineMerges.progressInterval { return }
+        progress.lastSent = now
+        send(progress.toDictionary(status: "progress"))
+    }
+
+    /// Sends `event` on the main thread, from which event sinks must be called.
+    private func send(_ event: [String: Any]) {
+        DispatchQueue.main.async {
+            self.sink?(event)
+        }
+    }
+}
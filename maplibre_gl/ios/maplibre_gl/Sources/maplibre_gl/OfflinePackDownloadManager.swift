@@ -53,9 +53,9 @@ class OfflinePackDownloader {
         // SDK does not have this feature. Therefore, we generate a region ID here.
         let id = UUID().hashValue
         let regionData = OfflineRegion(id: id, metadata: metadata, definition: regionDefinition)
-        let tilePyramidRegion = regionDefinition.toMLNTilePyramidOfflineRegion()
+        let region = regionDefinition.toMLNOfflineRegion()
         storage
-            .addPack(for: tilePyramidRegion,
+            .addPack(for: region,
                      withContext: regionData.prepareContext()) { [weak self] pack, error in
                 if let pack = pack {
                     self?.onPackCreated(pack: pack)
@@ -69,14 +69,12 @@ class OfflinePackDownloader {
     // MARK: Pack management
 
     private func onPackCreated(pack: MLNOfflinePack) {
-        if let region = OfflineRegion.fromOfflinePack(pack),
-           let regionData = try? JSONSerialization.data(withJSONObject: region.toDictionary())
-        {
+        if let region = OfflineRegion.fromOfflinePack(pack) {
             // Start downloading
             self.pack = pack
             pack.resume()
             // Provide region with generated
-            result(String(data: regionData, encoding: .utf8))
+            result(region.toDictionary())
             channelHandler.onStart()
         } else {
             onPackCreationError(error: OfflinePackError.InvalidPackData)
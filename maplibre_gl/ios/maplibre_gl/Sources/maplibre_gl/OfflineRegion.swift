@@ -38,20 +38,37 @@ class OfflineRegion {
     }
 
     static func fromOfflinePack(_ pack: MLNOfflinePack) -> OfflineRegion? {
-        guard let region = pack.region as? MLNTilePyramidOfflineRegion,
+        guard let definition = definition(of: pack.region),
               let dataObject = try? JSONSerialization.jsonObject(with: pack.context, options: []),
               let dict = dataObject as? [String: Any],
               let id = dict["id"] as? Int,
               let metadata = dict["metadata"] as? [String: Any] else { return nil }
-        return OfflineRegion(
-            id: id,
-            metadata: metadata,
-            definition: OfflineRegionDefinition(
-                bounds: [region.bounds.sw, region.bounds.ne].map { [$0.latitude, $0.longitude] },
+        return OfflineRegion(id: id, metadata: metadata, definition: definition)
+    }
+
+    private static func definition(of region: MLNOfflineRegion) -> OfflineRegionDefinition? {
+        func list(_ bounds: MLNCoordinateBounds) -> [[Double]] {
+            return [bounds.sw, bounds.ne].map { [$0.latitude, $0.longitude] }
+        }
+        if let region = region as? MLNTilePyramidOfflineRegion {
+            return OfflineRegionDefinition(
+                bounds: list(region.bounds),
                 mapStyleUrl: region.styleURL,
                 minZoom: region.minimumZoomLevel,
                 maxZoom: region.maximumZoomLevel
             )
-        )
+        }
+        if let region = region as? MLNShapeOfflineRegion,
+           let overlay = region.shape as? MLNOverlay
+        {
+            return OfflineRegionDefinition(
+                bounds: list(overlay.overlayBounds),
+                mapStyleUrl: region.styleURL,
+                minZoom: region.minimumZoomLevel,
+                maxZoom: region.maximumZoomLevel,
+                geometry: OfflineRegionDefinition.geometry(of: region.shape)
+            )
+        }
+        return nil
     }
 }
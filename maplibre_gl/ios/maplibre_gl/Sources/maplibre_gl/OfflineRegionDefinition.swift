@@ -6,12 +6,22 @@ class OfflineRegionDefinition {
     let mapStyleUrl: URL
     let minZoom: Double
     let maxZoom: Double
+    /// The polygons of a region limited to a geometry, each a list of rings of latitude and
+    /// longitude pairs, the first ring the outline and the others holes.
+    let geometry: [[[[Double]]]]?
 
-    init(bounds: [[Double]], mapStyleUrl: URL, minZoom: Double, maxZoom: Double) {
+    init(
+        bounds: [[Double]],
+        mapStyleUrl: URL,
+        minZoom: Double,
+        maxZoom: Double,
+        geometry: [[[[Double]]]]? = nil
+    ) {
         self.bounds = bounds
         self.mapStyleUrl = mapStyleUrl
         self.minZoom = minZoom
         self.maxZoom = maxZoom
+        self.geometry = geometry
     }
 
     func getBounds() -> MLNCoordinateBounds {
@@ -32,17 +42,42 @@ class OfflineRegionDefinition {
             bounds: bounds,
             mapStyleUrl: mapStyleUrl,
             minZoom: minZoom,
-            maxZoom: maxZoom
+            maxZoom: maxZoom,
+            geometry: jsonDict["geometry"] as? [[[[Double]]]]
         )
     }
 
     func toDictionary() -> [String: Any] {
-        return [
+        var dictionary: [String: Any] = [
             "bounds": bounds,
             "mapStyleUrl": mapStyleUrl.absoluteString,
             "minZoom": minZoom,
             "maxZoom": maxZoom,
         ]
+        if let geometry = geometry {
+            dictionary["geometry"] = geometry
+        }
+        return dictionary
+    }
+
+    /// The region of the definition, a shape region if it has a geometry.
+    func toMLNOfflineRegion() -> MLNOfflineRegion {
+        guard let geometry = geometry else {
+            return toMLNTilePyramidOfflineRegion()
+        }
+        let polygons = geometry.compactMap { rings -> MLNPolygon? in
+            guard let outline = rings.first else { return nil }
+            return OfflineRegionDefinition.polygon(
+                outline,
+                interiorPolygons: rings.dropFirst().map { OfflineRegionDefinition.polygon($0) }
+            )
+        }
+        return MLNShapeOfflineRegion(
+            styleURL: mapStyleUrl,
+            shape: MLNMultiPolygon(polygons: polygons),
+            fromZoomLevel: minZoom,
+            toZoomLevel: maxZoom
+        )
     }
 
     func toMLNTilePyramidOfflineRegion() -> MLNTilePyramidOfflineRegion {
@@ -53,4 +88,39 @@ class OfflineRegionDefinition {
             toZoomLevel: maxZoom
         )
     }
+
+    private static func polygon(
+        _ ring: [[Double]],
+        interiorPolygons: [MLNPolygon]? = nil
+    ) -> MLNPolygon {
+        var coordinates = ring.map {
+            CLLocationCoordinate2D(latitude: $0[0], longitude: $0[1])
+        }
+        return MLNPolygon(
+            coordinates: &coordinates,
+            count: UInt(coordinates.count),
+            interiorPolygons: interiorPolygons
+        )
+    }
+
+    /// The polygons of a shape region, see `geometry`.
+    static func geometry(of shape: MLNShape) -> [[[[Double]]]]? {
+        func ring(_ polyline: MLNMultiPoint) -> [[Double]] {
+            let coordinates = UnsafeBufferPointer(
+                start: polyline.coordinates,
+                count: Int(polyline.pointCount)
+            )
+            return coordinates.map { [$0.latitude, $0.longitude] }
+        }
+        func rings(_ polygon: MLNPolygon) -> [[[Double]]] {
+            return [ring(polygon)] + (polygon.interiorPolygons ?? []).map { ring($0) }
+        }
+        if let multiPolygon = shape as? MLNMultiPolygon {
+            return multiPolygon.polygons.map(rings)
+        }
+        if let polygon = shape as? MLNPolygon {
+            return [rings(polygon)]
+        }
+        return nil
+    }
 }
@@ -0,0 +1,45 @@
+import Foundation
+import MapLibre
+
+/// The offline packs by region id. The ids are parsed from the contexts of the packs once and the
+/// index is rebuilt only after the packs of the offline storage changed, so operations on a single
+/// region don't deserialize the context of every pack.
+class OfflineRegionIndex: NSObject {
+    static let shared = OfflineRegionIndex()
+
+    private var packsById: [Int: MLNOfflinePack]?
+    private var observation: NSKeyValueObservation?
+
+    override private init() {
+        super.init()
+        // packs is key-value observing compliant, it changes when packs are added or removed
+        observation = MLNOfflineStorage.shared.observe(\.packs, options: []) { [weak self] _, _ in
+            self?.packsById = nil
+        }
+    }
+
+    /// The packs by region id, empty while the offline storage is still loading its packs.
+    var packs: [Int: MLNOfflinePack] {
+        if let packsById = packsById {
+            return packsById
+        }
+        guard let packs = MLNOfflineStorage.shared.packs else { return [:] }
+        var packsById = [Int: MLNOfflinePack](minimumCapacity: packs.count)
+        for pack in packs {
+            if let id = OfflineRegionIndex.regionId(of: pack) {
+                packsById[id] = pack
+            }
+        }
+        self.packsById = packsById
+        return packsById
+    }
+
+    func pack(id: Int) -> MLNOfflinePack? {
+        return packs[id]
+    }
+
+    private static func regionId(of pack: MLNOfflinePack) -> Int? {
+        let context = try? JSONSerialization.jsonObject(with: pack.context) as? [String: Any]
+        return context?["id"] as? Int
+    }
+}
@@ -99,7 +99,20 @@ class SourcePropertyConverter {
             options[.maximumZoomLevelForClustering] = clusterMaxZoom
         }
 
-        // TODO: clusterProperties not implemneted for IOS
+        if let clusterProperties = properties["clusterProperties"] as? [String: [Any]] {
+            var expressions = [String: [NSExpression]]()
+            for (name, property) in clusterProperties where property.count == 2 {
+                // an operator name like "+" is expanded to the equivalent reduce expression
+                let reduce: Any = property[0] is String
+                    ? [property[0], ["accumulated"], ["get", name]]
+                    : property[0]
+                expressions[name] = [
+                    NSExpression(mglJSONObject: reduce),
+                    NSExpression(mglJSONObject: property[1]),
+                ]
+            }
+            options[.clusterProperties] = expressions
+        }
 
         if let lineMetrics = properties["lineMetrics"] as? Bool {
             options[.lineDistanceMetrics] = lineMetrics
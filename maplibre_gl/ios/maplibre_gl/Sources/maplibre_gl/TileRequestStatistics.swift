@@ -0,0 +1,93 @@
+import Foundation
+
+/// The requests of the URL session of MapLibre per source.
+///
+/// A source is identified by its url template, the url without query and with the tile
+/// coordinates replaced by `{z}/{x}/{y}`. The latencies of the last `maxLatencies` requests of
+/// each source are kept for percentiles.
+class TileRequestStatistics {
+    static let shared = TileRequestStatistics()
+
+    fileprivate static let maxLatencies = 1000
+    private static let tileCoordinates = try! NSRegularExpression(
+        pattern: "/\\d+/\\d+/\\d+(?=[./@]|$)"
+    )
+
+    private var sources = [String: SourceStatistics]()
+    private let lock = NSLock()
+
+    static func source(of url: URL) -> String {
+        let path = url.path
+        let range = NSRange(path.startIndex..., in: path)
+        let template = tileCoordinates.firstMatch(in: path, range: range).map { match in
+            (path as NSString).replacingCharacters(in: match.range, with: "/{z}/{x}/{y}")
+        } ?? path
+        return "\(url.scheme ?? "")://\(url.host ?? "")\(template)"
+    }
+
+    /// Records a request, `statusCode` is nil if it failed.
+    func record(url: URL, latency: Int, bytes: Int, statusCode: Int?, isHttpCacheHit: Bool) {
+        let source = TileRequestStatistics.source(of: url)
+        lock.lock()
+        defer { lock.unlock() }
+        sources[source, default: SourceStatistics()].record(
+            latency: latency,
+            bytes: bytes,
+            statusCode: statusCode,
+            isHttpCacheHit: isHttpCacheHit
+        )
+    }
+
+    /// The statistics per source since the last reset.
+    func statistics(reset: Bool) -> [String: [String: Any]] {
+        lock.lock()
+        defer { lock.unlock() }
+        let result = sources.mapValues { $0.toDictionary() }
+        if reset {
+            sources.removeAll()
+        }
+        return result
+    }
+}
+
+private struct SourceStatistics {
+    var requests = 0
+    var failures = 0
+    var networkResponses = 0
+    var ambientCacheHits = 0
+    var httpCacheHits = 0
+    var bytes = 0
+    var latencies = [Int]()
+
+    mutating func record(latency: Int, bytes: Int, statusCode: Int?, isHttpCacheHit: Bool) {
+        if latencies.count < TileRequestStatistics.maxLatencies {
+            latencies.append(latency)
+        } else {
+            latencies[requests % TileRequestStatistics.maxLatencies] = latency
+        }
+        requests += 1
+        self.bytes += bytes
+        if isHttpCacheHit {
+            httpCacheHits += 1
+        } else if statusCode == 304 {
+            // MapLibre revalidates the tiles of its ambient cache with conditional requests
+            ambientCacheHits += 1
+        } else if let statusCode = statusCode, (200 ..< 300).contains(statusCode) {
+            networkResponses += 1
+        } else {
+            failures += 1
+        }
+    }
+
+    func toDictionary() -> [String: Any] {
+        return [
+            "requests": requests,
+            "failures": failures,
+            "networkResponses": networkResponses,
+            "ambientCacheHits": ambientCacheHits,
+            "httpCacheHits": httpCacheHits,
+            "bytes": bytes,
+            "latencies": latencies,
+        ]
+    }
+}
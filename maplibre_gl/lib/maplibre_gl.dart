@@ -37,26 +37,35 @@ library maplibre_gl;
 
 import 'dart:async';
 import 'dart:convert';
+import 'dart:isolate';
 import 'dart:math';
 
 import 'package:flutter/foundation.dart';
 import 'package:flutter/gestures.dart';
 import 'package:flutter/material.dart';
+import 'package:flutter/scheduler.dart';
 import 'package:flutter/services.dart';
 
 import 'package:maplibre_gl_platform_interface/maplibre_gl_platform_interface.dart';
 
 export 'package:maplibre_gl_platform_interface/maplibre_gl_platform_interface.dart'
     show
+        AmbientCacheStatistics,
         Annotation,
         ArgumentCallbacks,
         AttributionButtonPosition,
+        CameraMoveTolerance,
         CameraPosition,
         CameraTargetBounds,
         CameraUpdate,
         Circle,
         CircleOptions,
+        ClusterIndex,
         CompassViewPosition,
+        ExpressionCompiler,
+        ExpressionValidationError,
+        ExpressionValidationException,
+        featureStatePropertyPrefix,
         Fill,
         FillOptions,
         GeojsonSourceProperties,
@@ -71,15 +80,32 @@ export 'package:maplibre_gl_platform_interface/maplibre_gl_platform_interface.da
         LocationPriority,
         MapLibreMethodChannel,
         MapLibrePlatform,
+        MapPerformanceStats,
         MinMaxZoomPreference,
+        MotionInterpolator,
+        MovingPoint,
         MyLocationRenderMode,
         MyLocationTrackingMode,
+        OfflineRefreshStatistics,
+        OfflineTilePlan,
+        OfflineTilePlanner,
+        OfflineTileRevalidator,
+        OfflineTileSavings,
+        OfflineTileSizeModel,
         OnPlatformViewCreatedCallback,
+        PrefetchPacer,
         RasterDemSourceProperties,
         RasterSourceProperties,
+        RoutePosition,
+        RoutePrefetchPlan,
+        RoutePrefetchPlanner,
         SourceProperties,
+        StyleOperationError,
         Symbol,
         SymbolOptions,
+        TileSizeProbe,
+        TileSourceStatistics,
+        TileValidator,
         UserHeading,
         UserLocation,
         VectorSourceProperties,
@@ -106,3 +132,19 @@ part 'src/annotation_manager.dart';
 part 'src/util.dart';
 
 part 'src/maplibre_styles.dart';
+
+part 'src/style_transaction.dart';
+
+part 'src/expression_compilation.dart';
+
+part 'src/live_feature_feed.dart';
+
+part 'src/offline_download_queue.dart';
+
+part 'src/network_configuration.dart';
+
+part 'src/ambient_cache_prefetcher.dart';
+
+part 'src/offline_merge.dart';
+
+part 'src/route_prefetcher.dart';
@@ -0,0 +1,114 @@
+part of '../maplibre_gl.dart';
+
+/// Warms the ambient cache of MapLibre ahead of the camera, e.g. along a
+/// planned route, so the map loads the tiles from the cache when it gets
+/// there.
+///
+/// Each prefetch downloads a temporary offline region with the
+/// [OfflineDownloadQueue], so at most
+/// [OfflineDownloadQueue.maxConcurrentDownloads] regions are downloaded at a
+/// time, and by default after the other downloads of the queue. Once a region
+/// is downloaded it is deleted and its tiles stay in the database as ambient
+/// cache tiles, which MapLibre evicts least recently used beyond the maximum
+/// size of the cache. Set a maximum size that fits the prefetched tiles with
+/// [setMaximumAmbientCacheSize].
+///
+/// Example:
+/// ```dart
+/// await AmbientCachePrefetcher.removeLeftovers();
+/// await OfflineDownloadQueue.instance.restore();
+/// final prefetcher = AmbientCachePrefetcher(mapStyleUrl: styleUrl);
+/// await prefetcher.prefetchRoute(route,
+///     width: 500, minZoom: 10, maxZoom: 15);
+/// ```
+///
+/// Not supported on web.
+class AmbientCachePrefetcher {
+  AmbientCachePrefetcher({
+    required this.mapStyleUrl,
+    this.priority = -1,
+    OfflineDownloadQueue? queue,
+  }) : _queue = queue ?? OfflineDownloadQueue.instance;
+
+  /// Marks the regions of prefetches in their metadata.
+  static const _metadataKey = 'ambientCachePrefetch';
+
+  final String mapStyleUrl;
+
+  /// The priority of the prefetches in the [OfflineDownloadQueue].
+  final int priority;
+  final OfflineDownloadQueue _queue;
+  final _downloads = <OfflineDownload>{};
+
+  /// The prefetches that are not done yet.
+  List<OfflineDownload> get downloads => _downloads.toList();
+
+  /// Prefetches the tiles of [bounds].
+  Future<OfflineDownload> prefetchBounds(
+    LatLngBounds bounds, {
+    required double minZoom,
+    required double maxZoom,
+  }) =>
+      _prefetch(OfflineRegionDefinition(
+        bounds: bounds,
+        mapStyleUrl: mapStyleUrl,
+        minZoom: minZoom,
+        maxZoom: maxZoom,
+      ));
+
+  /// Prefetches the tiles within [width] meters along [path].
+  ///
+  /// The path is prefetched in parts of [segmentLength] meters, in the order
+  /// of the path, so the tiles at its start are cached first.
+  Future<List<OfflineDownload>> prefetchRoute(
+    List<LatLng> path, {
+    required double width,
+    required double minZoom,
+    required double maxZoom,
+    double segmentLength = 5000,
+  }) async {
+    return [
+      for (final part in OfflineTilePlanner.splitPath(path, segmentLength))
+        await _prefetch(OfflineRegionDefinition.corridor(
+          path: part,
+          width: width,
+          mapStyleUrl: mapStyleUrl,
+          minZoom: minZoom,
+          maxZoom: maxZoom,
+        )),
+    ];
+  }
+
+  /// Cancels the prefetches that are not done yet and deletes their regions.
+  /// Tiles that were already downloaded stay in the ambient cache, like the
+  /// tiles of completed prefetches.
+  Future<void> cancel() =>
+      Future.wait([for (final download in downloads) download.cancel()]);
+
+  /// Deletes the regions of prefetches that did not finish before the app
+  /// was closed. Call it before [OfflineDownloadQueue.restore], which would
+  /// otherwise continue them.
+  static Future<void> removeLeftovers() async {
+    final leftovers = [
+      for (final region in await getListOfRegions())
+        if (region.metadata[_metadataKey] == true) region.id,
+    ];
+    if (leftovers.isNotEmpty) await deleteOfflineRegions(leftovers);
+  }
+
+  Future<OfflineDownload> _prefetch(OfflineRegionDefinition definition) async {
+    final download = await _queue.enqueue(
+      definition,
+      metadata: const {_metadataKey: true},
+      priority: priority,
+    );
+    _downloads.add(download);
+    download.done
+        .then((_) => deleteOfflineRegion(download.id),
+            // a failed download stays in the queue until it is canceled
+            onError: (Object _) => download.cancel())
+        .whenComplete(() => _downloads.remove(download))
+        .ignore();
+    return download;
+  }
+}
@@ -24,19 +24,113 @@ abstract class AnnotationManager<T extends Annotation> {
   /// This can be replaced by layer filters a soon as they are implemented
   final int Function(T)? selectLayer;
 
+  /// Annotation properties (e.g. `circleColor`) that can be overridden per
+  /// annotation with [setFeatureState] instead of rewriting the annotation.
+  /// Only paint properties which support the feature state can be listed.
+  final Set<String> featureStateProperties;
+
+  /// If true, nearby annotations are grouped into clusters by the map, see
+  /// [GeojsonSourceProperties.cluster]. Clusters are drawn with
+  /// [clusterLayerProperties] instead of the annotation layers.
+  final bool cluster;
+
+  /// Radius of each cluster in pixels, see
+  /// [GeojsonSourceProperties.clusterRadius].
+  final double clusterRadius;
+
+  /// Max zoom on which annotations are clustered, see
+  /// [GeojsonSourceProperties.clusterMaxZoom].
+  final double? clusterMaxZoom;
+
+  /// Custom properties aggregated from the annotations of a cluster, see
+  /// [GeojsonSourceProperties.clusterProperties]. The annotation properties
+  /// are available by their option name, e.g. `["get", "iconSize"]`.
+  final Map<String, dynamic>? clusterProperties;
+
+  /// The layers used to draw clusters. Cluster features have the properties
+  /// `point_count` and `point_count_abbreviated` besides the
+  /// [clusterProperties]. Defaults to a circle with the point count.
+  final List<LayerProperties> clusterLayerProperties;
+
+  /// The ids of the layers drawing the clusters if [cluster] is enabled.
+  List<String> get clusterLayerIds => [
+        if (cluster)
+          for (int i = 0; i < clusterLayerProperties.length; i++)
+            _makeClusterLayerId(i)
+      ];
+
+  static const _clusterFilter = [Expressions.has, 'point_count'];
+  static const _annotationFilter = [
+    Expressions.not,
+    [Expressions.has, 'point_count']
+  ];
+
+  static const defaultClusterLayerProperties = <LayerProperties>[
+    CircleLayerProperties(
+      circleColor: '#51bbd6',
+      circleRadius: [
+        Expressions.step,
+        [Expressions.get, 'point_count'],
+        15,
+        10,
+        20,
+        100,
+        25,
+      ],
+      circleStrokeWidth: 1,
+      circleStrokeColor: '#ffffff',
+    ),
+    SymbolLayerProperties(
+      textField: [Expressions.get, 'point_count_abbreviated'],
+      textSize: 12,
+      textAllowOverlap: true,
+      textIgnorePlacement: true,
+    ),
+  ];
+
   /// get the an annotation by its id
   T? byId(String id) => _idToAnnotation[id];
 
   Set<T> get annotations => _idToAnnotation.values.toSet();
 
   AnnotationManager(this.controller,
-      {this.onTap, this.selectLayer, required this.enableInteraction})
+      {this.onTap,
+      this.selectLayer,
+      required this.enableInteraction,
+      this.featureStateProperties = const {},
+      this.cluster = false,
+      this.clusterRadius = 50,
+      this.clusterMaxZoom,
+      this.clusterProperties,
+      this.clusterLayerProperties = defaultClusterLayerProperties})
       : id = getRandomString() {
+    assert(!cluster || allLayerProperties.length == 1,
+        "clustering is only supported for managers with a single layer");
     for (var i = 0; i < allLayerProperties.length; i++) {
       final layerId = _makeLayerId(i);
-      controller.addGeoJsonSource(layerId, buildFeatureCollection([]),
-          promoteId: "id");
-      controller.addLayer(layerId, layerId, allLayerProperties[i]);
+      if (cluster) {
+        controller.addSource(
+            layerId,
+            GeojsonSourceProperties(
+              data: buildFeatureCollection([]),
+              cluster: true,
+              clusterRadius: clusterRadius,
+              clusterMaxZoom: clusterMaxZoom,
+              clusterProperties: clusterProperties,
+              promoteId: "id",
+            ));
+        controller.addLayer(layerId, layerId, _layerProperties(i),
+            filter: _annotationFilter);
+        for (var j = 0; j < clusterLayerProperties.length; j++) {
+          controller.addLayer(
+              layerId, _makeClusterLayerId(j), clusterLayerProperties[j],
+              filter: _clusterFilter, enableInteraction: enableInteraction);
+        }
+      } else {
+        controller.addGeoJsonSource(layerId, buildFeatureCollection([]),
+            promoteId: "id");
+        controller.addLayer(layerId, layerId, _layerProperties(i));
+      }
     }
 
     if (onTap != null) {
@@ -51,8 +145,42 @@ abstract class AnnotationManager<T extends Annotation> {
     for (var i = 0; i < allLayerProperties.length; i++) {
       final layerId = _makeLayerId(i);
       await controller.removeLayer(layerId);
-      await controller.addLayer(layerId, layerId, allLayerProperties[i]);
+      await controller.addLayer(layerId, layerId, _layerProperties(i),
+          filter: cluster ? _annotationFilter : null);
+    }
+  }
+
+  /// The properties of the layer at [layerIndex] where the properties listed
+  /// in [featureStateProperties] prefer the feature state over the value of
+  /// the annotation.
+  LayerProperties _layerProperties(int layerIndex) {
+    final properties = allLayerProperties[layerIndex];
+    if (featureStateProperties.isEmpty) {
+      return properties;
     }
+
+    const compiler = ExpressionCompiler();
+    final layerType = StyleTransaction._layerTypeOf(properties);
+    final json = properties.toJson().map((key, value) {
+      if (value is List &&
+          value.length == 2 &&
+          value.first == Expressions.get &&
+          featureStateProperties.contains(value.last)) {
+        final bound = [
+          Expressions.coalesce,
+          kIsWeb
+              ? [Expressions.featureState, value.last]
+              : [Expressions.get, '$featureStatePropertyPrefix${value.last}'],
+          value,
+        ];
+        // layout properties can not be bound to the feature state
+        if (compiler.validateLayerProperties(layerType, {key: bound}).isEmpty) {
+          return MapEntry(key, bound);
+        }
+      }
+      return MapEntry(key, value);
+    });
+    return _layerPropertiesFromJson(properties, json);
   }
 
   _onFeatureTapped(
@@ -65,6 +193,8 @@ abstract class AnnotationManager<T extends Annotation> {
 
   String _makeLayerId(int layerIndex) => "${id}_$layerIndex";
 
+  String _makeClusterLayerId(int index) => "${id}_cluster_$index";
+
   Future<void> _setAll() async {
     if (selectLayer != null) {
       final featureBuckets = [for (final _ in allLayerProperties) <T>[]];
@@ -130,6 +260,9 @@ abstract class AnnotationManager<T extends Annotation> {
   Future<void> dispose() async {
     _idToAnnotation.clear();
     await _setAll();
+    for (final layerId in clusterLayerIds) {
+      await controller.removeLayer(layerId);
+    }
     for (var i = 0; i < allLayerProperties.length; i++) {
       await controller.removeLayer(_makeLayerId(i));
       await controller.removeSource(_makeLayerId(i));
@@ -166,10 +299,59 @@ abstract class AnnotationManager<T extends Annotation> {
           _makeLayerId(layerIndex), anntotation.toGeoJson());
     }
   }
+
+  /// Overrides properties of [annotation] listed in [featureStateProperties]
+  /// with the values of [state], e.g. to highlight a selected annotation.
+  ///
+  /// This is much cheaper than [set] on web, as the feature data is not
+  /// touched. The state is kept if the annotation is updated afterwards.
+  Future<void> setFeatureState(T annotation, Map<String, dynamic> state) async {
+    assert(state.keys.every(featureStateProperties.contains),
+        "only featureStateProperties can be set as feature state");
+    await controller.setFeatureState(
+        _makeLayerId(_idToLayerIndex[annotation.id] ?? 0),
+        annotation.id,
+        state);
+  }
+
+  /// Removes the state [key] of [annotation] or all of its state if [key] is
+  /// null, see [setFeatureState].
+  Future<void> removeFeatureState(T annotation, [String? key]) async {
+    await controller.removeFeatureState(
+        _makeLayerId(_idToLayerIndex[annotation.id] ?? 0),
+        featureId: annotation.id,
+        key: key);
+  }
+
+  /// Returns the zoom at which the cluster with [clusterId] splits up, see
+  /// [MapLibreMapController.getClusterExpansionZoom]. The id is the
+  /// `cluster_id` property of a feature of the [clusterLayerIds].
+  Future<int> getClusterExpansionZoom(int clusterId) {
+    assert(cluster, "clustering is not enabled");
+    return controller.getClusterExpansionZoom(_makeLayerId(0), clusterId);
+  }
+
+  /// Returns up to [limit] annotations of the cluster with [clusterId],
+  /// skipping the first [offset] annotations.
+  Future<List<T>> getClusterLeaves(int clusterId,
+      {int limit = 10, int offset = 0}) async {
+    assert(cluster, "clustering is not enabled");
+    final leaves = await controller.getClusterLeaves(
+        _makeLayerId(0), clusterId,
+        limit: limit, offset: offset);
+    return [
+      for (final leaf in leaves)
+        if (_idToAnnotation[leaf['properties']?['id']] case final annotation?)
+          annotation
+    ];
+  }
 }
 
 class LineManager extends AnnotationManager<Line> {
-  LineManager(super.controller, {super.onTap, super.enableInteraction = true})
+  LineManager(super.controller,
+      {super.onTap,
+      super.enableInteraction = true,
+      super.featureStateProperties})
       : super(
           selectLayer: (Line line) => line.options.linePattern == null ? 0 : 1,
         );
@@ -197,6 +379,7 @@ class FillManager extends AnnotationManager<Fill> {
     super.controller, {
     super.onTap,
     super.enableInteraction = true,
+    super.featureStateProperties,
   }) : super(
           selectLayer: (Fill fill) => fill.options.fillPattern == null ? 0 : 1,
         );
@@ -222,6 +405,12 @@ class CircleManager extends AnnotationManager<Circle> {
     super.controller, {
     super.onTap,
     super.enableInteraction = true,
+    super.featureStateProperties,
+    super.cluster,
+    super.clusterRadius,
+    super.clusterMaxZoom,
+    super.clusterProperties,
+    super.clusterLayerProperties,
   });
 
   @override
@@ -247,6 +436,12 @@ class SymbolManager extends AnnotationManager<Symbol> {
     bool iconIgnorePlacement = false,
     bool textIgnorePlacement = false,
     super.enableInteraction = true,
+    super.featureStateProperties,
+    super.cluster,
+    super.clusterRadius,
+    super.clusterMaxZoom,
+    super.clusterProperties,
+    super.clusterLayerProperties,
   })  : _iconAllowOverlap = iconAllowOverlap,
         _textAllowOverlap = textAllowOverlap,
         _iconIgnorePlacement = iconIgnorePlacement,
@@ -17,6 +17,9 @@ typedef OnFeatureDragnCallback = void Function(dynamic id,
     required LatLng delta,
     required DragEventType eventType});
 
+typedef OnFeatureHoverCallback = void Function(
+    dynamic id, Point<double> point, LatLng coordinates, String? layerId);
+
 typedef OnMapLongClickCallback = void Function(
     Point<double> point, LatLng coordinates);
 
@@ -111,6 +114,13 @@ class MapLibreMapController extends ChangeNotifier {
       }
     });
 
+    _maplibrePlatform.onFeatureHoverPlatform.add((payload) {
+      for (final fun in List<OnFeatureHoverCallback>.from(onFeatureHover)) {
+        fun(payload["id"], payload["point"], payload["latLng"],
+            payload["layerId"]);
+      }
+    });
+
     _maplibrePlatform.onCameraMoveStartedPlatform.add((_) {
       _isCameraMoving = true;
       notifyListeners();
@@ -123,6 +133,7 @@ class MapLibreMapController extends ChangeNotifier {
 
     _maplibrePlatform.onCameraIdlePlatform.add((cameraPosition) {
       _isCameraMoving = false;
+      _timeToIdle.cameraIdle();
       if (cameraPosition != null) {
         _cameraPosition = cameraPosition;
       }
@@ -171,6 +182,7 @@ class MapLibreMapController extends ChangeNotifier {
     });
 
     _maplibrePlatform.onMapIdlePlatform.add((_) {
+      _timeToIdle.mapIdle();
       onMapIdle?.call();
     });
     _maplibrePlatform.onUserLocationUpdatedPlatform.add((location) {
@@ -210,6 +222,14 @@ class MapLibreMapController extends ChangeNotifier {
 
   final onFeatureDrag = <OnFeatureDragnCallback>[];
 
+  /// Callbacks to receive hover events for features (geojson layer) placed on
+  /// this map. They are called at most once per frame and only when the
+  /// feature under the pointer changes, with a null id when the pointer
+  /// leaves the features.
+  ///
+  /// Only supported on web.
+  final onFeatureHover = <OnFeatureHoverCallback>[];
+
   /// Callbacks to receive tap events for info windows on symbols
   @Deprecated("InfoWindow tapped is no longer supported")
   final ArgumentCallbacks<Symbol> onInfoWindowTapped =
@@ -247,6 +267,8 @@ class MapLibreMapController extends ChangeNotifier {
   CameraPosition? get cameraPosition => _cameraPosition;
   CameraPosition? _cameraPosition;
 
+  final _timeToIdle = TimeToIdleRecorder();
+
   final MapLibrePlatform _maplibrePlatform; //ignore: unused_field
 
   /// Updates configuration options of the map user interface.
@@ -349,6 +371,63 @@ class MapLibreMapController extends ChangeNotifier {
         sourceId, geojsonFeature);
   }
 
+  /// Merges [state] into the state of the feature with [featureId] in the
+  /// source [sourceId]. Use [sourceLayer] for vector sources.
+  ///
+  /// Unlike [setGeoJsonFeature] this does not replace the feature data, which
+  /// makes it the cheap way to change e.g. selection or hover styling. On web
+  /// paint properties read the state with `["feature-state", key]`. Android
+  /// and iOS have no native feature state, there it is only supported for
+  /// geojson sources and stored in the feature properties, readable with
+  /// `["get", "${featureStatePropertyPrefix}key"]`.
+  ///
+  /// The returned [Future] completes after the change has been made on the
+  /// platform side.
+  Future<void> setFeatureState(
+      String sourceId, String featureId, Map<String, dynamic> state,
+      {String? sourceLayer}) async {
+    await _maplibrePlatform.setFeatureState(sourceId, featureId, state,
+        sourceLayer: sourceLayer);
+  }
+
+  /// Removes the [key] of the state of [featureId] set with
+  /// [setFeatureState], all keys of the feature if [key] is null, or the state
+  /// of all features of [sourceId] if [featureId] is null as well.
+  ///
+  /// The returned [Future] completes after the change has been made on the
+  /// platform side.
+  Future<void> removeFeatureState(String sourceId,
+      {String? featureId, String? key, String? sourceLayer}) async {
+    assert(key == null || featureId != null,
+        "a key can only be removed from a single feature");
+    await _maplibrePlatform.removeFeatureState(sourceId,
+        featureId: featureId, key: key, sourceLayer: sourceLayer);
+  }
+
+  /// Returns the zoom level at which the cluster with [clusterId] of the
+  /// clustered geojson source [sourceId] splits into multiple children, e.g.
+  /// to zoom in on a tapped cluster. The id is the `cluster_id` property of
+  /// the cluster feature.
+  ///
+  /// On iOS the cluster has to be part of the loaded tiles.
+  Future<int> getClusterExpansionZoom(String sourceId, int clusterId) {
+    return _maplibrePlatform.getClusterExpansionZoom(sourceId, clusterId);
+  }
+
+  /// Returns the direct children (clusters or points) of the cluster with
+  /// [clusterId] on the next zoom level as geojson features.
+  Future<List> getClusterChildren(String sourceId, int clusterId) {
+    return _maplibrePlatform.getClusterChildren(sourceId, clusterId);
+  }
+
+  /// Returns up to [limit] of the original points of the cluster with
+  /// [clusterId] as geojson features, skipping the first [offset] points.
+  Future<List> getClusterLeaves(String sourceId, int clusterId,
+      {int limit = 10, int offset = 0}) {
+    return _maplibrePlatform.getClusterLeaves(sourceId, clusterId,
+        limit: limit, offset: offset);
+  }
+
   /// Add a symbol layer to the map with the given properties
   ///
   /// Consider using [addLayer] for an unified layer api.
@@ -1116,6 +1195,17 @@ class MapLibreMapController extends ChangeNotifier {
     return _maplibrePlatform.clearAmbientCache();
   }
 
+  /// Loads the tiles of up to [delta] lower zoom levels before the tiles of
+  /// the current zoom level, so zooming out and fast camera moves show
+  /// coarser tiles instead of empty ones. 0 disables prefetching, MapLibre
+  /// prefetches 4 zoom levels by default.
+  ///
+  /// On iOS only whether tiles are prefetched can be set. Not supported on
+  /// web.
+  Future<void> setPrefetchZoomDelta(int delta) {
+    return _maplibrePlatform.setPrefetchZoomDelta(delta);
+  }
+
   /// Get last my location
   ///
   /// Return last latlng, nullable
@@ -1213,6 +1303,34 @@ class MapLibreMapController extends ChangeNotifier {
     return _maplibrePlatform.removeSource(sourceId);
   }
 
+  /// Adds an empty geojson source [sourceId] of moving points, e.g. vehicles
+  /// of a live feed.
+  ///
+  /// Points are set with [updateMotionSource] at the rate of the feed. In
+  /// between, the plugin extrapolates each point from its last fix along its
+  /// track at its speed once per display frame, for at most
+  /// [maxExtrapolation], and blends out the error of a new fix over
+  /// [blendDuration], so the points move smoothly without sending an update
+  /// per frame. On Android and iOS this runs natively.
+  ///
+  /// The features have the id of their point as the `id` property. Remove
+  /// the source with [removeSource].
+  Future<void> addMotionSource(String sourceId,
+      {Duration maxExtrapolation = const Duration(seconds: 5),
+      Duration blendDuration = const Duration(seconds: 1)}) {
+    return _maplibrePlatform.addMotionSource(sourceId,
+        maxExtrapolation: maxExtrapolation, blendDuration: blendDuration);
+  }
+
+  /// Sets the latest fixes of [points], adding new points, and removes the
+  /// points with [removeIds] from the motion source [sourceId] added with
+  /// [addMotionSource].
+  Future<void> updateMotionSource(String sourceId, List<MovingPoint> points,
+      {List<Object> removeIds = const []}) {
+    return _maplibrePlatform.updateMotionSource(sourceId, points,
+        removeIds: removeIds);
+  }
+
   /// Adds an image layer to the map's style at render time.
   Future<void> addImageLayer(String layerId, String imageSourceId,
       {double? minzoom, double? maxzoom}) {
@@ -1398,6 +1516,23 @@ class MapLibreMapController extends ChangeNotifier {
     return _maplibrePlatform.setLayerVisibility(layerId, visible);
   }
 
+  /// Applies all operations recorded in [transaction] with a single platform
+  /// call.
+  ///
+  /// The operations are applied in order. An operation that fails does not
+  /// abort the transaction; instead a [StyleOperationError] pointing at the
+  /// failed operation is added to the returned list, which is empty if all
+  /// operations succeeded.
+  ///
+  /// Attention: This may only be called after onStyleLoaded() has been invoked.
+  Future<List<StyleOperationError>> applyStyleTransaction(
+      StyleTransaction transaction) async {
+    if (transaction.isEmpty) {
+      return const [];
+    }
+    return _maplibrePlatform.applyStyleTransaction(transaction.operations);
+  }
+
   Future<List> getLayerIds() {
     return _maplibrePlatform.getLayerIds();
   }
@@ -1411,6 +1546,28 @@ class MapLibreMapController extends ChangeNotifier {
         .toList();
   }
 
+  /// The tile requests per source and the times until the map was idle after
+  /// camera moves, to find out whether the network, the caches or rendering
+  /// make the map slow. With [reset] the statistics start over.
+  ///
+  /// The tile requests are recorded by the shared HTTP client, so they
+  /// include the requests of all maps.
+  Future<MapPerformanceStats> getPerformanceStats({bool reset = false}) async {
+    final Map<Object?, Object?> sources = await _globalChannel.invokeMethod(
+      'getTileStatistics',
+      <String, dynamic>{
+        'reset': reset,
+      },
+    );
+    final timesToIdle = _timeToIdle.times;
+    if (reset) _timeToIdle.reset();
+    return MapPerformanceStats(
+      sources: sources.map((source, map) => MapEntry(
+          source as String, TileSourceStatistics.fromMap(map as Map))),
+      timesToIdle: timesToIdle,
+    );
+  }
+
   @override
   void dispose() {
     super.dispose();
@@ -0,0 +1,32 @@
+part of '../maplibre_gl.dart';
+
+extension LayerPropertiesCompilation on LayerProperties {
+  /// Returns a copy of these properties with all expressions validated
+  /// against the style specification and constant sub expressions folded,
+  /// see [ExpressionCompiler].
+  ///
+  /// Throws an [ExpressionValidationException] if a property is invalid.
+  LayerProperties compile(
+      [ExpressionCompiler compiler = const ExpressionCompiler()]) {
+    final json = compiler.compileLayerProperties(
+        StyleTransaction._layerTypeOf(this), toJson());
+    return _layerPropertiesFromJson(this, json);
+  }
+}
+
+/// Creates layer properties of the same type as [properties] from [json].
+LayerProperties _layerPropertiesFromJson(
+    LayerProperties properties, Map<String, dynamic> json) {
+  return switch (properties) {
+    FillLayerProperties() => FillLayerProperties.fromJson(json),
+    FillExtrusionLayerProperties() =>
+      FillExtrusionLayerProperties.fromJson(json),
+    LineLayerProperties() => LineLayerProperties.fromJson(json),
+    SymbolLayerProperties() => SymbolLayerProperties.fromJson(json),
+    CircleLayerProperties() => CircleLayerProperties.fromJson(json),
+    RasterLayerProperties() => RasterLayerProperties.fromJson(json),
+    HillshadeLayerProperties() => HillshadeLayerProperties.fromJson(json),
+    HeatmapLayerProperties() => HeatmapLayerProperties.fromJson(json),
+    _ => throw UnimplementedError("Unknown layer type $properties"),
+  };
+}
@@ -26,6 +26,11 @@ Future<dynamic> setOffline(bool offline) => _globalChannel.invokeMethod(
       },
     );
 
+/// Sets the headers of all requests of MapLibre, e.g. an authorization
+/// token.
+///
+/// The headers are read on each request, so updating them keeps the open
+/// connections of the HTTP client on Android.
 Future<void> setHttpHeaders(Map<String, String> headers) {
   return _globalChannel.invokeMethod(
     'setHttpHeaders',
@@ -35,29 +40,52 @@ Future<void> setHttpHeaders(Map<String, String> headers) {
   );
 }
 
+/// Configures the HTTP client MapLibre fetches styles, tiles, glyphs and
+/// sprites with. The headers set with [setHttpHeaders] are kept.
+Future<void> setNetworkConfiguration(NetworkConfiguration configuration) {
+  return _globalChannel.invokeMethod(
+    'setNetworkConfiguration',
+    <String, dynamic>{
+      'configuration': configuration.toMap(),
+    },
+  );
+}
+
+/// The requests, cache hits and latency of MapLibre per host, recorded since
+/// the plugin was registered or since the last [reset].
+Future<Map<String, HostNetworkStatistics>> getNetworkStatistics(
+    {bool reset = false}) async {
+  final Map<Object?, Object?> statistics = await _globalChannel.invokeMethod(
+    'getNetworkStatistics',
+    <String, dynamic>{
+      'reset': reset,
+    },
+  );
+  return statistics.map((host, map) => MapEntry(
+      host as String, HostNetworkStatistics.fromMap(map as Map)));
+}
+
 Future<List<OfflineRegion>> mergeOfflineRegions(String path) async {
-  final String regionsJson = await _globalChannel.invokeMethod(
+  final List<Object?> regions = await _globalChannel.invokeMethod(
     'mergeOfflineRegions',
     <String, dynamic>{
       'path': path,
     },
   );
-  final Iterable regions = json.decode(regionsJson);
-  return regions.map((region) => OfflineRegion.fromMap(region)).toList();
+  return regions.map(OfflineRegion._fromChannel).toList();
 }
 
 Future<List<OfflineRegion>> getListOfRegions() async {
-  final String regionsJson = await _globalChannel.invokeMethod(
+  final List<Object?> regions = await _globalChannel.invokeMethod(
     'getListOfRegions',
     <String, dynamic>{},
   );
-  final Iterable regions = json.decode(regionsJson);
-  return regions.map((region) => OfflineRegion.fromMap(region)).toList();
+  return regions.map(OfflineRegion._fromChannel).toList();
 }
 
 Future<OfflineRegion> updateOfflineRegionMetadata(
     int id, Map<String, dynamic> metadata) async {
-  final regionJson = await _globalChannel.invokeMethod(
+  final region = await _globalChannel.invokeMethod(
     'updateOfflineRegionMetadata',
     <String, dynamic>{
       'id': id,
@@ -65,7 +93,46 @@ Future<OfflineRegion> updateOfflineRegionMetadata(
     },
   );
 
-  return OfflineRegion.fromMap(json.decode(regionJson));
+  return OfflineRegion._fromChannel(region);
+}
+
+/// Replaces the metadata of several regions in one call, [metadata] maps the
+/// region ids to their new metadata.
+///
+/// If a region does not exist or can't be updated, the others are still
+/// updated and a [PlatformException] with the failed ids as details is
+/// thrown.
+Future<List<OfflineRegion>> updateOfflineRegionMetadataBatch(
+    Map<int, Map<String, dynamic>> metadata) async {
+  final List<Object?> regions = await _globalChannel.invokeMethod(
+    'updateOfflineRegionMetadataBatch',
+    <String, dynamic>{
+      'updates': [
+        for (final entry in metadata.entries)
+          {'id': entry.key, 'metadata': entry.value},
+      ],
+    },
+  );
+  return regions.map(OfflineRegion._fromChannel).toList();
+}
+
+/// Limits the ambient cache of MapLibre to [size] bytes, the least recently
+/// used tiles are evicted beyond it. The size is not persisted, set it on
+/// each start of the app, e.g. to [AmbientCacheStatistics.recommendedSize].
+Future<void> setMaximumAmbientCacheSize(int size) =>
+    _globalChannel.invokeMethod(
+      'setMaximumAmbientCacheSize',
+      <String, dynamic>{
+        'size': size,
+      },
+    );
+
+/// The size of the database of the ambient cache and the offline regions,
+/// and the free space of the device.
+Future<AmbientCacheStatistics> getAmbientCacheStatistics() async {
+  final Map<Object?, Object?> statistics =
+      await _globalChannel.invokeMethod('getAmbientCacheStatistics');
+  return AmbientCacheStatistics.fromMap(statistics);
 }
 
 Future<dynamic> setOfflineTileCountLimit(int limit) =>
@@ -83,6 +150,19 @@ Future<dynamic> deleteOfflineRegion(int id) => _globalChannel.invokeMethod(
       },
     );
 
+/// Deletes several regions and their tiles in one call.
+///
+/// If a region does not exist or can't be deleted, the others are still
+/// deleted and a [PlatformException] with the failed ids as details is
+/// thrown.
+Future<void> deleteOfflineRegions(Iterable<int> ids) =>
+    _globalChannel.invokeMethod(
+      'deleteOfflineRegions',
+      <String, dynamic>{
+        'ids': ids.toList(),
+      },
+    );
+
 Future<OfflineRegion> downloadOfflineRegion(
   OfflineRegionDefinition definition, {
   Map<String, dynamic> metadata = const {},
@@ -130,5 +210,5 @@ Future<OfflineRegion> downloadOfflineRegion(
     'metadata': metadata,
   });
 
-  return OfflineRegion.fromMap(json.decode(result));
+  return OfflineRegion._fromChannel(result);
 }
@@ -0,0 +1,412 @@
+part of '../maplibre_gl.dart';
+
+/// A moving point of a [LiveFeatureFeed], e.g. an aircraft or a vehicle.
+@immutable
+class LiveFeature {
+  const LiveFeature({
+    required this.id,
+    required this.position,
+    this.properties = const {},
+    this.track = 0,
+    this.speed = 0,
+    this.timestamp,
+  });
+
+  /// The key of the feature in the feed. A feature replaces the previous
+  /// feature with the same id.
+  final Object id;
+
+  final LatLng position;
+
+  /// The properties of the geojson feature, available to the layers of the
+  /// feed source with `["get", name]`.
+  final Map<String, dynamic> properties;
+
+  /// The direction of travel in degrees clockwise from north, used if the
+  /// feed interpolates the motion.
+  final double track;
+
+  /// The ground speed in meters per second, used if the feed interpolates
+  /// the motion.
+  final double speed;
+
+  /// The time of the [position], defaults to the time the feature is sent to
+  /// the map.
+  final DateTime? timestamp;
+
+  MovingPoint toMovingPoint() => MovingPoint(
+        id: id,
+        position: position,
+        track: track,
+        speed: speed,
+        timestamp: timestamp ?? DateTime.now(),
+        properties: properties,
+      );
+
+  Map<String, dynamic> toGeoJson() => {
+        'type': 'Feature',
+        'id': id,
+        'properties': {...properties, 'id': id},
+        'geometry': {
+          'type': 'Point',
+          'coordinates': [position.longitude, position.latitude],
+        },
+      };
+}
+
+/// Decodes a raw feed message, e.g. a WebSocket text frame, into features.
+///
+/// The decoder runs in a background isolate, so it must be a top-level or
+/// static function.
+typedef LiveFeatureDecoder = List<LiveFeature> Function(Object? message);
+
+/// Called with the error of a message the [LiveFeatureDecoder] failed on.
+/// Errors of the background isolate are passed as a [RemoteError].
+typedef LiveFeatureDecodeErrorCallback = void Function(Object error);
+
+/// Shows a live feed of moving points, like ADS-B traffic or vehicle
+/// positions, in a single geojson source.
+///
+/// Raw messages passed to [add] are decoded by the [decoder] in a background
+/// isolate (synchronously on web). The decoded features are kept in a table
+/// keyed by [LiveFeature.id] and expire [ttl] after their last update. All
+/// changes of one frame are coalesced and sent to the map with a single
+/// [StyleTransaction]: a diff with the changed and removed features, or the
+/// whole collection if most features changed.
+///
+/// With [interpolateMotion], the source is a motion source, see
+/// [MapLibreMapController.addMotionSource]: the features move along their
+/// [LiveFeature.track] at their [LiveFeature.speed] between the messages of
+/// the feed, instead of jumping from fix to fix.
+///
+/// The feed notifies its listeners once per applied frame, e.g. to show the
+/// number of [features]. Messages the [decoder] fails on are skipped and
+/// reported to [onDecodeError].
+///
+/// Example:
+/// ```dart
+/// final feed = LiveFeatureFeed(
+///   controller: controller,
+///   sourceId: 'traffic',
+///   decoder: decodeTraffic,
+/// );
+/// await feed.start();
+/// await controller.addSymbolLayer('traffic', 'traffic-symbols',
+///     const SymbolLayerProperties(iconImage: 'plane'));
+/// feed.listen(channel.stream);
+/// ```
+class LiveFeatureFeed extends ChangeNotifier {
+  LiveFeatureFeed({
+    required this.controller,
+    required this.sourceId,
+    required this.decoder,
+    this.ttl = const Duration(seconds: 60),
+    this.expiryResolution = const Duration(seconds: 1),
+    this.fullUpdateRatio = 0.5,
+    this.decodeInBackground = !kIsWeb,
+    this.interpolateMotion = false,
+    this.maxExtrapolation = const Duration(seconds: 5),
+    this.onDecodeError,
+  }) : _wheel = _TimeWheel(
+            (ttl.inMicroseconds / expiryResolution.inMicroseconds).ceil());
+
+  final MapLibreMapController controller;
+
+  /// The id of the geojson source added by [start].
+  final String sourceId;
+
+  final LiveFeatureDecoder decoder;
+
+  /// The time after its last update after which a feature is removed.
+  final Duration ttl;
+
+  /// The granularity of the expiry, features expire up to this much later
+  /// than [ttl].
+  final Duration expiryResolution;
+
+  /// If more than this fraction of the features changed in a frame, the
+  /// whole collection is sent instead of a diff.
+  final double fullUpdateRatio;
+
+  /// Whether messages are decoded in a background isolate. Isolates are not
+  /// supported on web.
+  final bool decodeInBackground;
+
+  /// Whether the positions of the features are extrapolated between their
+  /// updates, for at most [maxExtrapolation] after an update.
+  final bool interpolateMotion;
+
+  final Duration maxExtrapolation;
+
+  final LiveFeatureDecodeErrorCallback? onDecodeError;
+
+  final _features = <Object, LiveFeature>{};
+  final _changed = <Object, LiveFeature>{};
+  final _removed = <Object>{};
+  final _TimeWheel _wheel;
+  Timer? _expiryTimer;
+
+  Isolate? _isolate;
+  ReceivePort? _receivePort;
+  SendPort? _decoderPort;
+  final _queuedMessages = <Object?>[];
+
+  var _isFrameScheduled = false;
+  var _isUpdating = false;
+  var _needsFullUpdate = false;
+  var _isDisposed = false;
+
+  /// The current features of the feed.
+  Iterable<LiveFeature> get features => _features.values;
+
+  /// Adds an empty geojson source [sourceId] to the map and starts the
+  /// decoder and the expiry of features. Layers showing the feed can be
+  /// added once this completes.
+  Future<void> start() async {
+    if (interpolateMotion) {
+      await controller.addMotionSource(sourceId,
+          maxExtrapolation: maxExtrapolation);
+    } else {
+      await controller.addGeoJsonSource(sourceId, _collection(),
+          promoteId: 'id');
+    }
+    _expiryTimer = Timer.periodic(expiryResolution, (_) => _expire());
+    if (decodeInBackground) {
+      await _startDecoder();
+    }
+  }
+
+  /// Decodes a raw [message] with the [decoder] and applies its features.
+  void add(Object? message) {
+    if (!decodeInBackground) {
+      final List<LiveFeature> features;
+      try {
+        features = decoder(message);
+      } catch (e) {
+        // a malformed message must not stop the feed
+        onDecodeError?.call(e);
+        return;
+      }
+      addFeatures(features);
+    } else if (_decoderPort == null) {
+      _queuedMessages.add(message);
+    } else {
+      _decoderPort!.send(message);
+    }
+  }
+
+  /// Adds all messages of [messages], e.g. the stream of a WebSocket.
+  StreamSubscription<dynamic> listen(Stream<dynamic> messages) =>
+      messages.listen(add);
+
+  /// Adds or replaces already decoded features.
+  void addFeatures(Iterable<LiveFeature> features) {
+    if (_isDisposed) return;
+    for (final feature in features) {
+      _features[feature.id] = feature;
+      _changed[feature.id] = feature;
+      _removed.remove(feature.id);
+      _wheel.schedule(feature.id);
+    }
+    _scheduleFrame();
+  }
+
+  /// Removes the feature with [id] before it expires.
+  void remove(Object id) {
+    if (_features.remove(id) == null) return;
+    _wheel.cancel(id);
+    _changed.remove(id);
+    _removed.add(id);
+    _scheduleFrame();
+  }
+
+  /// Removes all features.
+  void clear() {
+    _removed.addAll(_features.keys);
+    _features.clear();
+    _changed.clear();
+    _wheel.clear();
+    _scheduleFrame();
+  }
+
+  void _expire() {
+    final expired = _wheel.advance();
+    for (final id in expired) {
+      _features.remove(id);
+      _changed.remove(id);
+      _removed.add(id);
+    }
+    // a failed update is retried once per tick, not on every frame while
+    // e.g. the style reloads
+    if (expired.isNotEmpty || _needsFullUpdate) _scheduleFrame();
+  }
+
+  Future<void> _startDecoder() async {
+    final receivePort = ReceivePort();
+    _receivePort = receivePort;
+    final decoderPort = Completer<SendPort>();
+    receivePort.listen((message) {
+      if (message is SendPort) {
+        decoderPort.complete(message);
+      } else if (message is List<LiveFeature>) {
+        addFeatures(message);
+      } else if (message is RemoteError && !_isDisposed) {
+        onDecodeError?.call(message);
+      }
+    });
+    _isolate = await Isolate.spawn(
+        _decodeMessages, (receivePort.sendPort, decoder),
+        debugName: 'LiveFeatureFeed $sourceId');
+    if (_isDisposed) {
+      _isolate!.kill(priority: Isolate.immediate);
+      return;
+    }
+    _decoderPort = await decoderPort.future;
+    _queuedMessages
+      ..forEach(_decoderPort!.send)
+      ..clear();
+  }
+
+  static void _decodeMessages((SendPort, LiveFeatureDecoder) arguments) {
+    final (sendPort, decoder) = arguments;
+    final receivePort = ReceivePort();
+    sendPort.send(receivePort.sendPort);
+    receivePort.listen((message) {
+      try {
+        sendPort.send(decoder(message));
+      } catch (e, stackTrace) {
+        // a malformed message must not stop the feed
+        sendPort.send(RemoteError(e.toString(), stackTrace.toString()));
+      }
+    });
+  }
+
+  void _scheduleFrame() {
+    if (_isFrameScheduled || _isDisposed) return;
+    _isFrameScheduled = true;
+    SchedulerBinding.instance.scheduleFrameCallback((_) {
+      _isFrameScheduled = false;
+      _update();
+    });
+  }
+
+  /// Sends the changes of the last frame. While an update is in flight, the
+  /// changes of the following frames are collected and sent together once
+  /// it completed. A failed update is retried with the whole collection on
+  /// the next tick of the expiry.
+  Future<void> _update() async {
+    if (_isUpdating || _isDisposed) return;
+    if (_changed.isEmpty && _removed.isEmpty && !_needsFullUpdate) return;
+
+    final Future<bool> Function() send;
+    if (interpolateMotion) {
+      // the motion source keeps the points, a full update sends all of them
+      final points = [
+        for (final feature
+            in (_needsFullUpdate ? _features : _changed).values)
+          feature.toMovingPoint()
+      ];
+      final removeIds = _removed.toList();
+      send = () async {
+        await controller.updateMotionSource(sourceId, points,
+            removeIds: removeIds);
+        return true;
+      };
+    } else {
+      final transaction = StyleTransaction();
+      final changeCount = _changed.length + _removed.length;
+      if (_needsFullUpdate ||
+          changeCount > _features.length * fullUpdateRatio) {
+        transaction.setGeoJsonSource(sourceId, _collection());
+      } else {
+        transaction.updateGeoJsonSource(sourceId,
+            add: [for (final feature in _changed.values) feature.toGeoJson()],
+            remove: _removed.toList());
+      }
+      send = () async =>
+          (await controller.applyStyleTransaction(transaction)).isEmpty;
+    }
+    _changed.clear();
+    _removed.clear();
+    _needsFullUpdate = false;
+    notifyListeners();
+
+    _isUpdating = true;
+    try {
+      // the source may be out of sync, e.g. after a style change
+      _needsFullUpdate = !await send();
+    } on PlatformException {
+      _needsFullUpdate = true;
+    } finally {
+      _isUpdating = false;
+    }
+    if (_changed.isNotEmpty || _removed.isNotEmpty) {
+      _scheduleFrame();
+    }
+  }
+
+  Map<String, dynamic> _collection() => {
+        'type': 'FeatureCollection',
+        'features': [
+          for (final feature in _features.values) feature.toGeoJson()
+        ],
+      };
+
+  /// Stops the decoder and the expiry. The source is left on the map.
+  @override
+  void dispose() {
+    _isDisposed = true;
+    _expiryTimer?.cancel();
+    _isolate?.kill(priority: Isolate.immediate);
+    _receivePort?.close();
+    super.dispose();
+  }
+}
+
+/// Schedules the expiry of keys in a ring of [slotCount] slots, one per tick
+/// of the expiry timer, so that refreshing and expiring a key are O(1)
+/// instead of scanning all keys.
+class _TimeWheel {
+  _TimeWheel(int ticks)
+      : _slots = List.generate(max(ticks, 1) + 1, (_) => <Object>{});
+
+  final List<Set<Object>> _slots;
+  final _slotByKey = <Object, int>{};
+  var _tick = 0;
+
+  int get slotCount => _slots.length;
+
+  /// Schedules [key] to expire after the full wheel turned once, replacing
+  /// its previous schedule.
+  void schedule(Object key) {
+    cancel(key);
+    // the current slot is reached again after all other slots
+    _slots[_tick].add(key);
+    _slotByKey[key] = _tick;
+  }
+
+  void cancel(Object key) {
+    final slot = _slotByKey.remove(key);
+    if (slot != null) _slots[slot].remove(key);
+  }
+
+  void clear() {
+    for (final slot in _slots) {
+      slot.clear();
+    }
+    _slotByKey.clear();
+  }
+
+  /// Advances the wheel by one tick and returns the expired keys.
+  List<Object> advance() {
+    _tick = (_tick + 1) % slotCount;
+    final slot = _slots[_tick];
+    if (slot.isEmpty) return const [];
+    final expired = slot.toList();
+    slot.clear();
+    for (final key in expired) {
+      _slotByKey.remove(key);
+    }
+    return expired;
+  }
+}
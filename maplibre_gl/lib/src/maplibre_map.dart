@@ -42,6 +42,8 @@ class MapLibreMap extends StatefulWidget {
     this.attributionButtonMargins,
     this.iosLongClickDuration,
     this.webPreserveDrawingBuffer = false,
+    this.webGeoJsonWorkerThreshold,
+    this.webCameraMoveTolerance,
     this.onMapClick,
     this.onUserLocationUpdated,
     this.onMapLongClick,
@@ -106,6 +108,19 @@ class MapLibreMap extends StatefulWidget {
   /// **Web only** - has no effect on other platforms.
   final bool? webPreserveDrawingBuffer;
 
+  /// Geojson sources with at least this many features are prepared in a web
+  /// worker instead of on the main thread, which keeps the page responsive
+  /// while large sources are set. Disabled if null.
+  /// **Web only** - has no effect on other platforms.
+  final int? webGeoJsonWorkerThreshold;
+
+  /// The camera changes below this tolerance are not reported to
+  /// [MapLibreMapController.cameraPosition] listeners while the camera moves.
+  /// Camera move events are delivered at most once per animation frame.
+  /// Uses the defaults of [CameraMoveTolerance] if null.
+  /// **Web only** - has no effect on other platforms.
+  final CameraMoveTolerance? webCameraMoveTolerance;
+
   /// True if the map should show a compass when rotated.
   final bool compassEnabled;
 
@@ -282,6 +297,10 @@ class _MapLibreMapState extends State<MapLibreMap> {
             widget.iosLongClickDuration!.inMilliseconds,
       if (widget.webPreserveDrawingBuffer != null)
         'webPreserveDrawingBuffer': widget.webPreserveDrawingBuffer,
+      if (widget.webGeoJsonWorkerThreshold != null)
+        'webGeoJsonWorkerThreshold': widget.webGeoJsonWorkerThreshold,
+      if (widget.webCameraMoveTolerance != null)
+        'webCameraMoveTolerance': widget.webCameraMoveTolerance!.toMap(),
     };
     return _maplibrePlatform.buildView(
         creationParams, onPlatformViewCreated, widget.gestureRecognizers);
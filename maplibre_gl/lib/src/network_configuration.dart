@@ -0,0 +1,105 @@
+part of '../maplibre_gl.dart';
+
+/// The configuration of the HTTP client MapLibre fetches styles, tiles,
+/// glyphs and sprites with, see [setNetworkConfiguration].
+///
+/// On iOS the system negotiates HTTP/2 and keeps connections alive on its
+/// own, so only [maxRequestsPerHost], [readTimeout] and [diskCacheSize]
+/// apply.
+@immutable
+class NetworkConfiguration {
+  const NetworkConfiguration({
+    this.maxRequests = 64,
+    this.maxRequestsPerHost = 20,
+    this.maxIdleConnections = 5,
+    this.keepAlive = const Duration(minutes: 5),
+    this.connectTimeout = const Duration(seconds: 10),
+    this.readTimeout = const Duration(seconds: 10),
+    this.preferHttp2 = true,
+    this.diskCacheSize = 0,
+  });
+
+  /// The maximum number of concurrent requests, Android only.
+  final int maxRequests;
+  final int maxRequestsPerHost;
+
+  /// The idle connections kept open for reuse, Android only.
+  final int maxIdleConnections;
+
+  /// How long idle connections are kept open, Android only.
+  final Duration keepAlive;
+  final Duration connectTimeout;
+  final Duration readTimeout;
+
+  /// Whether to use HTTP/2 when the server supports it, otherwise only
+  /// HTTP/1.1 is used. Android only.
+  final bool preferHttp2;
+
+  /// The size in bytes of an HTTP disk cache in front of the ambient cache
+  /// of MapLibre, or 0 for no HTTP cache. It keeps responses MapLibre does
+  /// not store itself and serves conditional requests.
+  final int diskCacheSize;
+
+  Map<String, dynamic> toMap() => <String, dynamic>{
+        'maxRequests': maxRequests,
+        'maxRequestsPerHost': maxRequestsPerHost,
+        'maxIdleConnections': maxIdleConnections,
+        'keepAlive': keepAlive.inMilliseconds,
+        'connectTimeout': connectTimeout.inMilliseconds,
+        'readTimeout': readTimeout.inMilliseconds,
+        'preferHttp2': preferHttp2,
+        'diskCacheSize': diskCacheSize,
+      };
+}
+
+/// The requests to a host since the statistics were last reset, see
+/// [getNetworkStatistics].
+@immutable
+class HostNetworkStatistics {
+  const HostNetworkStatistics({
+    required this.requests,
+    required this.failures,
+    required this.cacheHits,
+    required this.conditionalHits,
+    required this.averageLatency,
+    required this.maxLatency,
+  });
+
+  factory HostNetworkStatistics.fromMap(Map<Object?, Object?> map) {
+    final requests = map['requests'] as int;
+    return HostNetworkStatistics(
+      requests: requests,
+      failures: map['failures'] as int,
+      cacheHits: map['cacheHits'] as int,
+      conditionalHits: map['conditionalHits'] as int,
+      averageLatency: Duration(
+          milliseconds:
+              requests == 0 ? 0 : (map['totalLatency'] as int) ~/ requests),
+      maxLatency: Duration(milliseconds: map['maxLatency'] as int),
+    );
+  }
+
+  final int requests;
+
+  /// The requests that failed or were answered with an error status.
+  final int failures;
+
+  /// The requests served from the HTTP disk cache without a request.
+  final int cacheHits;
+
+  /// The requests the server answered with `304 Not Modified`.
+  final int conditionalHits;
+
+  /// The time until the response headers arrived.
+  final Duration averageLatency;
+  final Duration maxLatency;
+
+  double get cacheHitRate =>
+      requests == 0 ? 0 : (cacheHits + conditionalHits) / requests;
+
+  @override
+  String toString() =>
+      'HostNetworkStatistics, requests = $requests, failures = $failures, '
+      'cacheHits = $cacheHits, conditionalHits = $conditionalHits, '
+      'averageLatency = $averageLatency, maxLatency = $maxLatency';
+}
@@ -0,0 +1,522 @@
+part of '../maplibre_gl.dart';
+
+enum OfflineDownloadState {
+  /// Waiting for a free download slot.
+  queued,
+  downloading,
+
+  /// Paused with [OfflineDownload.pause], not scheduled until resumed.
+  paused,
+  completed,
+  failed,
+  canceled,
+}
+
+/// The aggregate throughput of all running downloads of the
+/// [OfflineDownloadQueue], averaged over the last few seconds.
+@immutable
+class OfflineDownloadThroughput {
+  const OfflineDownloadThroughput({
+    required this.tilesPerSecond,
+    required this.bytesPerSecond,
+    required this.activeDownloads,
+  });
+
+  final double tilesPerSecond;
+  final double bytesPerSecond;
+  final int activeDownloads;
+
+  @override
+  String toString() =>
+      'OfflineDownloadThroughput, tilesPerSecond = $tilesPerSecond, '
+      'bytesPerSecond = $bytesPerSecond, activeDownloads = $activeDownloads';
+}
+
+/// A handle of an offline region download in the [OfflineDownloadQueue].
+///
+/// Listeners are notified when the state or the progress changes.
+class OfflineDownload extends ChangeNotifier {
+  OfflineDownload._(this._queue, this.region, this._priority, this._sequence,
+      this._state) {
+    // an unawaited failure must not be reported as unhandled
+    _done.future.ignore();
+  }
+
+  final OfflineDownloadQueue _queue;
+  final OfflineRegion region;
+  int _priority;
+
+  /// The order in which downloads of the same priority are started.
+  final int _sequence;
+  OfflineDownloadState _state;
+  final _done = Completer<void>();
+
+  int _completedResources = 0;
+  int _requiredResources = 0;
+  int _completedTiles = 0;
+  int _completedBytes = 0;
+  PlatformException? _error;
+
+  int get id => region.id;
+
+  /// Downloads with a higher priority are started first and preempt running
+  /// downloads of a lower priority.
+  int get priority => _priority;
+
+  OfflineDownloadState get state => _state;
+
+  int get completedResources => _completedResources;
+
+  /// The number of resources of the region, an estimate until all tiles of
+  /// the style were requested.
+  int get requiredResources => _requiredResources;
+
+  int get completedTiles => _completedTiles;
+
+  int get completedBytes => _completedBytes;
+
+  /// The progress between 0 and 1.
+  double get progress => _requiredResources > 0
+      ? min(_completedResources / _requiredResources, 1)
+      : 0;
+
+  /// The cause of a failed download.
+  PlatformException? get error => _error;
+
+  /// Completes when the region is downloaded, or with the error of a failed
+  /// or canceled download.
+  Future<void> get done => _done.future;
+
+  Future<void> setPriority(int priority) =>
+      _queue._setPriority(this, priority);
+
+  /// Pauses the download. Tiles downloaded so far are kept.
+  Future<void> pause() => _queue._pause(this);
+
+  /// Queues a paused or failed download again.
+  Future<void> resume() => _queue._resume(this);
+
+  /// Stops the download and removes it from the queue. The region and its
+  /// tiles are deleted unless [deleteRegion] is false.
+  Future<void> cancel({bool deleteRegion = true}) =>
+      _queue._cancel(this, deleteRegion);
+
+  void _setState(OfflineDownloadState state) {
+    _state = state;
+    notifyListeners();
+  }
+
+  @override
+  String toString() => 'OfflineDownload, id = $id, state = $_state, '
+      'priority = $_priority, progress = $progress';
+}
+
+/// Downloads offline regions with a limited number of concurrent downloads,
+/// in the order of their priority.
+///
+/// Each region is created when it is enqueued and downloaded once a slot is
+/// free. Queued and paused downloads are persisted, [restore] resumes them
+/// after an app restart: offline regions keep the tiles downloaded so far, so
+/// a restored download continues where it stopped.
+///
+/// The status of all downloads is reported by the platform on one shared
+/// event channel, from which the aggregate [throughput] is computed. An
+/// error of the channel fails the running downloads.
+///
+/// Example:
+/// ```dart
+/// final queue = OfflineDownloadQueue.instance..maxConcurrentDownloads = 3;
+/// await queue.restore();
+/// for (final corridor in corridors) {
+///   await queue.enqueue(corridor, priority: corridor == next ? 1 : 0);
+/// }
+/// queue.throughput.listen((t) => print('${t.tilesPerSecond} tiles/s'));
+/// ```
+///
+/// Offline regions are not supported on web.
+class OfflineDownloadQueue extends ChangeNotifier {
+  OfflineDownloadQueue._();
+
+  /// The queue of the app. There is a single queue, as all downloads share
+  /// one event channel.
+  static final instance = OfflineDownloadQueue._();
+
+  static const _events =
+      EventChannel('plugins.flutter.io/maplibre_gl/offline_downloads');
+
+  static const _throughputWindow = Duration(seconds: 5);
+
+  final _downloads = <int, OfflineDownload>{};
+  StreamSubscription<dynamic>? _subscription;
+  var _nextSequence = 0;
+  var _maxConcurrentDownloads = 2;
+
+  final _throughput = StreamController<OfflineDownloadThroughput>.broadcast();
+  Timer? _throughputTimer;
+
+  /// Tiles and bytes completed since the previous sample, with the time of
+  /// the sample in milliseconds.
+  final _samples = <(int, int, int)>[];
+
+  /// The number of regions downloaded at the same time.
+  int get maxConcurrentDownloads => _maxConcurrentDownloads;
+
+  set maxConcurrentDownloads(int value) {
+    assert(value > 0);
+    _maxConcurrentDownloads = value;
+    _schedule();
+  }
+
+  /// The downloads that are not completed or canceled, in the order in which
+  /// they are scheduled.
+  List<OfflineDownload> get downloads => _downloads.values.toList()
+    ..sort(_compareSchedule);
+
+  /// Emits the aggregate throughput once per second while downloads are
+  /// running.
+  Stream<OfflineDownloadThroughput> get throughput => _throughput.stream;
+
+  /// Restores the downloads persisted by a previous run of the app and starts
+  /// the queued ones. Regions that were deleted in the meantime are skipped.
+  Future<void> restore() async {
+    _listen();
+    final String? saved =
+        await _globalChannel.invokeMethod('offlineDownload#loadQueue');
+    if (saved == null) return;
+    final regions = {
+      for (final region in await getListOfRegions()) region.id: region
+    };
+    for (final Map<String, dynamic> entry in json.decode(saved)) {
+      final region = regions[entry['id']];
+      if (region == null || _downloads.containsKey(region.id)) continue;
+      final int sequence = entry['sequence'];
+      _nextSequence = max(_nextSequence, sequence + 1);
+      _downloads[region.id] = OfflineDownload._(
+        this,
+        region,
+        entry['priority'],
+        sequence,
+        entry['paused'] == true
+            ? OfflineDownloadState.paused
+            : OfflineDownloadState.queued,
+      );
+    }
+    _schedule();
+    notifyListeners();
+  }
+
+  /// Creates an offline region for [definition] and queues its download.
+  Future<OfflineDownload> enqueue(
+    OfflineRegionDefinition definition, {
+    Map<String, dynamic> metadata = const {},
+    int priority = 0,
+  }) async {
+    _listen();
+    final region = await _globalChannel
+        .invokeMethod('offlineDownload#create', <String, dynamic>{
+      'definition': definition.toMap(),
+      'metadata': metadata,
+    });
+    final download = OfflineDownload._(
+      this,
+      OfflineRegion._fromChannel(region),
+      priority,
+      _nextSequence++,
+      OfflineDownloadState.queued,
+    );
+    _downloads[download.id] = download;
+    _changed();
+    return download;
+  }
+
+  /// Refreshes the tiles of a downloaded [region] and queues its download.
+  ///
+  /// The tiles of the region are marked as expired, so the download
+  /// revalidates them with conditional requests and only downloads and
+  /// rewrites the tiles that changed. [refreshWithStatistics] measures the
+  /// requests and bytes of the refresh.
+  Future<OfflineDownload> refresh(OfflineRegion region,
+      {int priority = 0}) async {
+    _listen();
+    final queued = _downloads[region.id];
+    if (queued != null) return queued;
+    await _globalChannel.invokeMethod(
+        'offlineDownload#invalidate', <String, dynamic>{'id': region.id});
+    final download = OfflineDownload._(
+      this,
+      region,
+      priority,
+      _nextSequence++,
+      OfflineDownloadState.queued,
+    );
+    _downloads[download.id] = download;
+    _changed();
+    return download;
+  }
+
+  /// Refreshes [region] like [refresh] and completes with the tile requests
+  /// of the refresh once it is downloaded.
+  ///
+  /// The requests are measured with the tile statistics of the shared HTTP
+  /// client, see `MapLibreMapController.getPerformanceStats`, so requests of
+  /// maps and downloads running at the same time are counted as well. The
+  /// server answers unchanged tiles with `304 Not Modified`, without their
+  /// size, so [OfflineRefreshStatistics.savedBytes] is estimated with the
+  /// average size of the changed tiles, or of [sizeModel] if none changed.
+  /// Completes with the error of a failed or canceled refresh.
+  Future<OfflineRefreshStatistics> refreshWithStatistics(
+    OfflineRegion region, {
+    int priority = 0,
+    OfflineTileSizeModel sizeModel = const OfflineTileSizeModel(),
+  }) async {
+    final before = await _tileStatistics();
+    final download = await refresh(region, priority: priority);
+    await download.done;
+    final after = await _tileStatistics();
+    int delta(int Function(TileSourceStatistics source) value) {
+      var sum = 0;
+      after.forEach((template, source) {
+        final previous = before[template];
+        sum += value(source) - (previous == null ? 0 : value(previous));
+      });
+      // the statistics were reset meanwhile
+      return max(sum, 0);
+    }
+
+    final unchanged = delta((source) => source.ambientCacheHits);
+    final changed = delta((source) => source.networkResponses);
+    final downloadedBytes = delta((source) => source.bytes);
+    final bytesPerTile = changed > 0
+        ? downloadedBytes ~/ changed
+        : sizeModel.defaultTileBytes;
+    return OfflineRefreshStatistics(
+      unchanged: unchanged,
+      changed: changed,
+      failed: delta((source) => source.failures),
+      downloadedBytes: downloadedBytes,
+      savedBytes: unchanged * bytesPerTile,
+    );
+  }
+
+  static Future<Map<String, TileSourceStatistics>> _tileStatistics() async {
+    final Map<Object?, Object?> sources = await _globalChannel.invokeMethod(
+      'getTileStatistics',
+      <String, dynamic>{
+        'reset': false,
+      },
+    );
+    return sources.map((source, map) => MapEntry(
+        source as String, TileSourceStatistics.fromMap(map as Map)));
+  }
+
+  void _listen() {
+    _subscription ??=
+        _events.receiveBroadcastStream().listen(_onEvent, onError: _onError);
+  }
+
+  static int _compareSchedule(OfflineDownload a, OfflineDownload b) {
+    final priority = b._priority.compareTo(a._priority);
+    return priority != 0 ? priority : a._sequence.compareTo(b._sequence);
+  }
+
+  /// Runs the [maxConcurrentDownloads] queued or running downloads of the
+  /// highest priority and moves the other running downloads back to the
+  /// queue.
+  void _schedule() {
+    final candidates = _downloads.values
+        .where((download) =>
+            download._state == OfflineDownloadState.queued ||
+            download._state == OfflineDownloadState.downloading)
+        .toList()
+      ..sort(_compareSchedule);
+    for (var i = 0; i < candidates.length; i++) {
+      final download = candidates[i];
+      final shouldRun = i < _maxConcurrentDownloads;
+      if (shouldRun && download._state == OfflineDownloadState.queued) {
+        _start(download);
+      } else if (!shouldRun &&
+          download._state == OfflineDownloadState.downloading) {
+        download._setState(OfflineDownloadState.queued);
+        _invoke('offlineDownload#pause', download.id);
+      }
+    }
+    _updateThroughputTimer();
+  }
+
+  void _start(OfflineDownload download) {
+    download._setState(OfflineDownloadState.downloading);
+    _invoke('offlineDownload#resume', download.id).catchError((Object e) {
+      _fail(download, e is PlatformException
+          ? e
+          : PlatformException(code: 'OfflineDownloadError', details: e));
+    });
+  }
+
+  Future<void> _invoke(String method, int id) =>
+      _globalChannel.invokeMethod(method, <String, dynamic>{'id': id});
+
+  void _onEvent(dynamic event) {
+    final Map<dynamic, dynamic> status = event;
+    final download = _downloads[status['id']];
+    if (download == null) return;
+    if (status.containsKey('completedResources')) {
+      _sample(download, status['completedTiles'], status['completedBytes']);
+      download
+        .._completedResources = status['completedResources']
+        .._requiredResources = status['requiredResources']
+        .._completedTiles = status['completedTiles']
+        .._completedBytes = status['completedBytes'];
+    }
+    switch (status['status']) {
+      case 'progress':
+        // a paused download may still report the progress of its last tiles
+        if (download._state == OfflineDownloadState.downloading) {
+          download.notifyListeners();
+        }
+      case 'complete':
+        _downloads.remove(download.id);
+        download._setState(OfflineDownloadState.completed);
+        download._done.complete();
+        _changed();
+      case 'error':
+        _fail(
+            download,
+            PlatformException(
+                code: status['errorCode'] ?? 'OfflineDownloadError',
+                message: status['errorMessage']));
+    }
+  }
+
+  /// Fails the running downloads, as their status can't be reported.
+  void _onError(Object error) {
+    final exception = error is PlatformException
+        ? error
+        : PlatformException(code: 'OfflineDownloadError', details: error);
+    final running = [
+      for (final download in _downloads.values)
+        if (download._state == OfflineDownloadState.downloading) download
+    ];
+    for (final download in running) {
+      _fail(download, exception);
+    }
+  }
+
+  void _fail(OfflineDownload download, PlatformException error) {
+    if (download._state != OfflineDownloadState.downloading) return;
+    download._error = error;
+    download._setState(OfflineDownloadState.failed);
+    if (!download._done.isCompleted) download._done.completeError(error);
+    _changed();
+  }
+
+  Future<void> _setPriority(OfflineDownload download, int priority) async {
+    download._priority = priority;
+    _changed();
+  }
+
+  Future<void> _pause(OfflineDownload download) async {
+    final state = download._state;
+    if (state != OfflineDownloadState.queued &&
+        state != OfflineDownloadState.downloading) {
+      return;
+    }
+    download._setState(OfflineDownloadState.paused);
+    if (state == OfflineDownloadState.downloading) {
+      await _invoke('offlineDownload#pause', download.id);
+    }
+    _changed();
+  }
+
+  Future<void> _resume(OfflineDownload download) async {
+    if (download._state != OfflineDownloadState.paused &&
+        download._state != OfflineDownloadState.failed) {
+      return;
+    }
+    download._error = null;
+    download._setState(OfflineDownloadState.queued);
+    _changed();
+  }
+
+  Future<void> _cancel(OfflineDownload download, bool deleteRegion) async {
+    if (_downloads.remove(download.id) == null) return;
+    final wasRunning = download._state == OfflineDownloadState.downloading;
+    download._setState(OfflineDownloadState.canceled);
+    if (!download._done.isCompleted) {
+      download._done.completeError(PlatformException(
+          code: 'OfflineDownloadCanceled',
+          message: 'The download of region ${download.id} was canceled'));
+    }
+    _changed();
+    if (wasRunning) await _invoke('offlineDownload#pause', download.id);
+    if (deleteRegion) await deleteOfflineRegion(download.id);
+  }
+
+  /// Persists the queue and schedules the downloads after a change.
+  void _changed() {
+    _schedule();
+    _save();
+    notifyListeners();
+  }
+
+  Future<void> _save() {
+    final entries = [
+      for (final download in _downloads.values)
+        if (download._state != OfflineDownloadState.failed)
+          {
+            'id': download.id,
+            'priority': download._priority,
+            'sequence': download._sequence,
+            'paused': download._state == OfflineDownloadState.paused,
+          }
+    ];
+    return _globalChannel.invokeMethod('offlineDownload#saveQueue',
+        <String, dynamic>{'queue': json.encode(entries)});
+  }
+
+  void _sample(OfflineDownload download, int tiles, int bytes) {
+    final deltaTiles = tiles - download._completedTiles;
+    final deltaBytes = bytes - download._completedBytes;
+    if (deltaTiles <= 0 && deltaBytes <= 0) return;
+    _samples.add((
+      DateTime.now().millisecondsSinceEpoch,
+      max(deltaTiles, 0),
+      max(deltaBytes, 0),
+    ));
+  }
+
+  void _updateThroughputTimer() {
+    final isDownloading = _downloads.values
+        .any((download) => download._state == OfflineDownloadState.downloading);
+    if (isDownloading) {
+      _throughputTimer ??=
+          Timer.periodic(const Duration(seconds: 1), (_) => _emitThroughput());
+    } else if (_throughputTimer != null) {
+      _throughputTimer!.cancel();
+      _throughputTimer = null;
+      _samples.clear();
+      _emitThroughput();
+    }
+  }
+
+  void _emitThroughput() {
+    final now = DateTime.now().millisecondsSinceEpoch;
+    final windowStart = now - _throughputWindow.inMilliseconds;
+    _samples.removeWhere((sample) => sample.$1 < windowStart);
+    if (!_throughput.hasListener) return;
+    var tiles = 0;
+    var bytes = 0;
+    for (final (_, sampleTiles, sampleBytes) in _samples) {
+      tiles += sampleTiles;
+      bytes += sampleBytes;
+    }
+    final seconds = _throughputWindow.inMilliseconds / 1000;
+    _throughput.add(OfflineDownloadThroughput(
+      tilesPerSecond: tiles / seconds,
+      bytesPerSecond: bytes / seconds,
+      activeDownloads: _downloads.values
+          .where((download) =>
+              download._state == OfflineDownloadState.downloading)
+          .length,
+    ));
+  }
+}
@@ -0,0 +1,193 @@
+part of '../maplibre_gl.dart';
+
+enum OfflineMergePhase {
+  /// Copying the database to a writable location.
+  copying,
+
+  /// Comparing its tiles with the tiles already stored.
+  deduplicating,
+
+  /// Merging its regions and tiles into the database of MapLibre, which
+  /// can't be canceled and doesn't report progress.
+  merging,
+}
+
+/// The progress of an [OfflineMerge].
+@immutable
+class OfflineMergeProgress {
+  const OfflineMergeProgress({
+    required this.phase,
+    required this.completedBytes,
+    required this.totalBytes,
+    required this.completedTiles,
+    required this.totalTiles,
+    required this.skippedTiles,
+    required this.skippedBytes,
+  });
+
+  factory OfflineMergeProgress._fromMap(Map<dynamic, dynamic> map) =>
+      OfflineMergeProgress(
+        phase: OfflineMergePhase.values.byName(map['phase']),
+        completedBytes: map['completedBytes'],
+        totalBytes: map['totalBytes'],
+        completedTiles: map['completedTiles'],
+        totalTiles: map['totalTiles'],
+        skippedTiles: map['skippedTiles'],
+        skippedBytes: map['skippedBytes'],
+      );
+
+  final OfflineMergePhase phase;
+
+  /// The bytes of the file copied while [OfflineMergePhase.copying], the
+  /// bytes of the tiles compared afterwards.
+  final int completedBytes;
+  final int totalBytes;
+
+  /// The tiles compared so far and the tiles of the merged database.
+  final int completedTiles;
+  final int totalTiles;
+
+  /// The tiles identical to stored tiles, which are not written again.
+  final int skippedTiles;
+  final int skippedBytes;
+
+  /// The progress of the current phase between 0 and 1.
+  double get progress => switch (phase) {
+        OfflineMergePhase.copying =>
+          totalBytes > 0 ? completedBytes / totalBytes : 0,
+        OfflineMergePhase.deduplicating =>
+          totalTiles > 0 ? completedTiles / totalTiles : 0,
+        OfflineMergePhase.merging => 1,
+      };
+
+  @override
+  String toString() => 'OfflineMergeProgress, phase = $phase, '
+      'completedBytes = $completedBytes, totalBytes = $totalBytes, '
+      'completedTiles = $completedTiles, totalTiles = $totalTiles, '
+      'skippedTiles = $skippedTiles, skippedBytes = $skippedBytes';
+}
+
+/// Merges the offline regions of a side loaded database in the background,
+/// like [mergeOfflineRegions], with progress and cancellation.
+///
+/// The database is copied to a writable location and its tiles are compared
+/// with the tiles already stored, so tiles that are identical are not
+/// written again. Merging a database that overlaps the stored regions, e.g.
+/// an update of a region, then takes a fraction of the time. The status of
+/// all merges is reported by the platform on one shared event channel.
+///
+/// Example:
+/// ```dart
+/// final merge = await OfflineMerge.start(path);
+/// merge.progress.listen((p) => print('${p.phase} ${p.progress}'));
+/// final regions = await merge.regions;
+/// ```
+///
+/// Not supported on web.
+class OfflineMerge {
+  OfflineMerge._(this.id) {
+    // an unawaited failure must not be reported as unhandled
+    _regions.future.ignore();
+  }
+
+  static const _events =
+      EventChannel('plugins.flutter.io/maplibre_gl/offline_merges');
+
+  static StreamSubscription<dynamic>? _subscription;
+  static final _merges = <int, OfflineMerge>{};
+
+  /// Events of merges whose id was not returned yet.
+  static final _pending = <int, List<Map<dynamic, dynamic>>>{};
+
+  final int id;
+  final _progress = StreamController<OfflineMergeProgress>.broadcast();
+  final _regions = Completer<List<OfflineRegion>>();
+  OfflineMergeProgress? _lastProgress;
+
+  /// Starts merging the database at [path].
+  static Future<OfflineMerge> start(String path) async {
+    _subscription ??=
+        _events.receiveBroadcastStream().listen(_route, onError: _onError);
+    final int id = await _globalChannel.invokeMethod(
+      'offlineMerge#start',
+      <String, dynamic>{
+        'path': path,
+      },
+    );
+    final merge = OfflineMerge._(id);
+    _merges[id] = merge;
+    _pending.remove(id)?.forEach(merge._onEvent);
+    return merge;
+  }
+
+  /// Emits the progress at most a few times per second.
+  Stream<OfflineMergeProgress> get progress => _progress.stream;
+
+  /// The last progress that was reported.
+  OfflineMergeProgress? get lastProgress => _lastProgress;
+
+  /// Completes with the merged regions, or with a [PlatformException] if the
+  /// merge failed or was canceled, or its status can't be reported.
+  Future<List<OfflineRegion>> get regions => _regions.future;
+
+  /// Cancels the merge and deletes the copy of the database. A merge that
+  /// reached [OfflineMergePhase.merging] completes anyway.
+  Future<void> cancel() => _globalChannel.invokeMethod(
+        'offlineMerge#cancel',
+        <String, dynamic>{
+          'id': id,
+        },
+      );
+
+  /// Passes [event] to the merge it reports on.
+  static void _route(dynamic event) {
+    final Map<dynamic, dynamic> status = event;
+    final int id = status['id'];
+    final merge = _merges[id];
+    if (merge == null) {
+      (_pending[id] ??= []).add(status);
+      return;
+    }
+    merge._onEvent(status);
+  }
+
+  /// Fails the merges in flight, as their status can't be reported.
+  static void _onError(Object error) {
+    final exception = error is PlatformException
+        ? error
+        : PlatformException(code: 'OfflineMergeError', details: error);
+    for (final merge in _merges.values.toList()) {
+      merge._finish();
+      merge._regions.completeError(exception);
+    }
+  }
+
+  void _onEvent(Map<dynamic, dynamic> status) {
+    _lastProgress = OfflineMergeProgress._fromMap(status);
+    switch (status['status']) {
+      case 'progress':
+        _progress.add(_lastProgress!);
+      case 'complete':
+        final List<Object?> regions = status['regions'];
+        _finish();
+        _regions.complete(regions.map(OfflineRegion._fromChannel).toList());
+      case 'error':
+      case 'canceled':
+        _finish();
+        _regions.completeError(PlatformException(
+          code: status['status'] == 'canceled'
+              ? 'OfflineMergeCanceled'
+              : 'OfflineMergeError',
+          message: status['errorMessage'],
+        ));
+    }
+  }
+
+  void _finish() {
+    _merges.remove(id);
+    _progress.close();
+  }
+
+  @override
+  String toString() => 'OfflineMerge, id = $id, progress = $_lastProgress';
+}
@@ -9,14 +9,65 @@ class OfflineRegionDefinition {
     required this.minZoom,
     required this.maxZoom,
     this.includeIdeographs = false,
+    this.geometry,
   });
 
+  /// A region of the tiles intersecting [polygons], each a list of rings of
+  /// which the first is the outline and the others are holes. The polygons
+  /// must not cross the antimeridian.
+  factory OfflineRegionDefinition.polygons({
+    required List<List<List<LatLng>>> polygons,
+    required String mapStyleUrl,
+    required double minZoom,
+    required double maxZoom,
+    bool includeIdeographs = false,
+  }) {
+    final outlines = polygons.expand((rings) => rings.first);
+    return OfflineRegionDefinition(
+      bounds: LatLngBounds(
+        southwest: LatLng(outlines.map((p) => p.latitude).reduce(min),
+            outlines.map((p) => p.longitude).reduce(min)),
+        northeast: LatLng(outlines.map((p) => p.latitude).reduce(max),
+            outlines.map((p) => p.longitude).reduce(max)),
+      ),
+      mapStyleUrl: mapStyleUrl,
+      minZoom: minZoom,
+      maxZoom: maxZoom,
+      includeIdeographs: includeIdeographs,
+      geometry: polygons,
+    );
+  }
+
+  /// A region of the tiles within [width] meters around [path], e.g. along a
+  /// route or a pipeline. Downloads a fraction of the tiles of the bounding
+  /// box of a long path, see [savings].
+  factory OfflineRegionDefinition.corridor({
+    required List<LatLng> path,
+    required double width,
+    required String mapStyleUrl,
+    required double minZoom,
+    required double maxZoom,
+    bool includeIdeographs = false,
+  }) =>
+      OfflineRegionDefinition.polygons(
+        polygons: OfflineTilePlanner.corridorPolygons(path, width),
+        mapStyleUrl: mapStyleUrl,
+        minZoom: minZoom,
+        maxZoom: maxZoom,
+        includeIdeographs: includeIdeographs,
+      );
+
+  /// The bounding box of the region, or of its [geometry].
   final LatLngBounds bounds;
   final String mapStyleUrl;
   final double minZoom;
   final double maxZoom;
   final bool includeIdeographs;
 
+  /// The polygons of a region limited to a geometry, see
+  /// [OfflineRegionDefinition.polygons].
+  final List<List<List<LatLng>>>? geometry;
+
   @override
   String toString() =>
       "OfflineRegionDefinition, bounds = $bounds, mapStyleUrl = $mapStyleUrl, minZoom = $minZoom, maxZoom = $maxZoom";
@@ -28,9 +79,83 @@ class OfflineRegionDefinition {
     data['minZoom'] = minZoom;
     data['maxZoom'] = maxZoom;
     data['includeIdeographs'] = includeIdeographs;
+    if (geometry != null) {
+      data['geometry'] = [
+        for (final rings in geometry!)
+          [
+            for (final ring in rings)
+              [for (final point in ring) point.toJson()],
+          ],
+      ];
+    }
     return data;
   }
 
+  /// The tiles of the region per zoom level, for a source described by
+  /// [planner].
+  OfflineTilePlan planTiles(
+          [OfflineTilePlanner planner = const OfflineTilePlanner()]) =>
+      geometry != null
+          ? planner.planPolygons(geometry!, minZoom, maxZoom)
+          : planner.planBounds(bounds, minZoom, maxZoom);
+
+  /// The tiles and bytes the [geometry] of the region saves compared to
+  /// downloading its bounding box. Use [OfflineTileSavings.timeAt] with the
+  /// throughput of the [OfflineDownloadQueue] for the time saved.
+  OfflineTileSavings savings({
+    OfflineTilePlanner planner = const OfflineTilePlanner(),
+    OfflineTileSizeModel model = const OfflineTileSizeModel(),
+  }) =>
+      planTiles(planner).savingsComparedTo(
+          planner.planBounds(bounds, minZoom, maxZoom), model);
+
+  /// Splits the region into regions of at most [maxTilesPerRegion] tiles.
+  ///
+  /// Bounds are split with [OfflineTilePlanner.splitBounds]. The polygons of
+  /// a [geometry] are grouped in order into regions, a polygon with more
+  /// tiles is a region of its own.
+  List<OfflineRegionDefinition> split({
+    required int maxTilesPerRegion,
+    OfflineTilePlanner planner = const OfflineTilePlanner(),
+  }) {
+    if (geometry == null) {
+      return [
+        for (final chunk in planner.splitBounds(bounds, minZoom, maxZoom,
+            maxTilesPerChunk: maxTilesPerRegion))
+          OfflineRegionDefinition(
+            bounds: chunk,
+            mapStyleUrl: mapStyleUrl,
+            minZoom: minZoom,
+            maxZoom: maxZoom,
+            includeIdeographs: includeIdeographs,
+          ),
+      ];
+    }
+    final chunks = <List<List<List<LatLng>>>>[[]];
+    var chunkTiles = 0;
+    for (final polygon in geometry!) {
+      // the sum of the polygons is at least the tiles of their union
+      final tiles = planner.planPolygon(polygon, minZoom, maxZoom).tileCount;
+      if (chunks.last.isNotEmpty && chunkTiles + tiles > maxTilesPerRegion) {
+        chunks.add([]);
+        chunkTiles = 0;
+      }
+      chunks.last.add(polygon);
+      chunkTiles += tiles;
+    }
+    if (chunks.length == 1) return [this];
+    return [
+      for (final polygons in chunks)
+        OfflineRegionDefinition.polygons(
+          polygons: polygons,
+          mapStyleUrl: mapStyleUrl,
+          minZoom: minZoom,
+          maxZoom: maxZoom,
+          includeIdeographs: includeIdeographs,
+        ),
+    ];
+  }
+
   factory OfflineRegionDefinition.fromMap(Map<String, dynamic> map) {
     return OfflineRegionDefinition(
       bounds: _latLngBoundsFromList(map['bounds']),
@@ -39,9 +164,21 @@ class OfflineRegionDefinition {
       minZoom: map['minZoom'].toDouble(),
       maxZoom: map['maxZoom'].toDouble(),
       includeIdeographs: map['includeIdeographs'] ?? false,
+      geometry: map['geometry'] == null
+          ? null
+          : [
+              for (final List rings in map['geometry'])
+                [
+                  for (final List ring in rings)
+                    [for (final List point in ring) _latLngFromList(point)],
+                ],
+            ],
     );
   }
 
+  static LatLng _latLngFromList(List<dynamic> json) =>
+      LatLng((json[0] as num).toDouble(), (json[1] as num).toDouble());
+
   static LatLngBounds _latLngBoundsFromList(List<dynamic> json) {
     return LatLngBounds(
       southwest: LatLng(json[0][0], json[0][1]),
@@ -70,6 +207,17 @@ class OfflineRegion {
     );
   }
 
+  /// Creates a region from the untyped map sent by the platform channel.
+  factory OfflineRegion._fromChannel(Object? data) =>
+      OfflineRegion.fromMap(_castChannelValue(data));
+
+  static dynamic _castChannelValue(Object? value) => switch (value) {
+        Map() => value.map((key, value) =>
+            MapEntry<String, dynamic>(key as String, _castChannelValue(value))),
+        List() => value.map(_castChannelValue).toList(),
+        _ => value,
+      };
+
   @override
   String toString() =>
       "OfflineRegion, id = $id, definition = $definition, metadata = $metadata";
@@ -0,0 +1,200 @@
+part of '../maplibre_gl.dart';
+
+/// Prefetches the tiles the camera will need along a route into the ambient
+/// cache, ahead of the user, so the map does not show blank tiles at speed
+/// on a poor network.
+///
+/// Feed it the locations of [MapLibreMap.onUserLocationUpdated] with the
+/// zoom and tilt of the camera. The [RoutePrefetchPlanner] matches each
+/// location to the route and plans the part the user covers within
+/// [horizon] at the current speed, which is prefetched in parts of
+/// [segmentLength] meters with an [AmbientCachePrefetcher], one part at a
+/// time and in the order of the route. The [PrefetchPacer] measures the
+/// throughput of the [OfflineDownloadQueue] and waits between parts so
+/// prefetches stay within their share of the bandwidth.
+///
+/// A change of the zoom level restarts the prefetch at the position of the
+/// user, as the tiles of the new zoom level were not prefetched. A part that
+/// fails, e.g. as it exceeds the tile limit, is reported to [onError] and
+/// the prefetch continues with the next part.
+///
+/// Example:
+/// ```dart
+/// final prefetcher = RoutePrefetcher(route: route, mapStyleUrl: styleUrl);
+/// MapLibreMap(
+///   onUserLocationUpdated: (location) {
+///     final camera = controller.cameraPosition!;
+///     prefetcher.update(location, zoom: camera.zoom, tilt: camera.tilt);
+///   },
+///   ...
+/// );
+/// ```
+///
+/// Not supported on web.
+class RoutePrefetcher {
+  RoutePrefetcher({
+    required List<LatLng> route,
+    required String mapStyleUrl,
+    this.horizon = const Duration(minutes: 3),
+    this.segmentLength = 2000,
+    this.sizeModel = const OfflineTileSizeModel(),
+    RoutePrefetchPlanner? planner,
+    PrefetchPacer? pacer,
+    OfflineDownloadQueue? queue,
+    this.onError,
+  })  : planner = planner ?? RoutePrefetchPlanner(route),
+        pacer = pacer ?? PrefetchPacer(),
+        _prefetcher = AmbientCachePrefetcher(
+          mapStyleUrl: mapStyleUrl,
+          queue: queue,
+        ) {
+    _throughput = (queue ?? OfflineDownloadQueue.instance)
+        .throughput
+        .where((throughput) => throughput.activeDownloads > 0)
+        .listen((throughput) =>
+            this.pacer.addThroughput(throughput.bytesPerSecond));
+  }
+
+  /// How far ahead in time the route is prefetched.
+  final Duration horizon;
+
+  /// The length in meters of the parts the route is prefetched in.
+  final double segmentLength;
+
+  /// Estimates the bytes of a part for the [pacer].
+  final OfflineTileSizeModel sizeModel;
+
+  final RoutePrefetchPlanner planner;
+  final PrefetchPacer pacer;
+
+  /// Called with the error of a part that failed to prefetch.
+  final void Function(Object error)? onError;
+
+  final AmbientCachePrefetcher _prefetcher;
+  late final StreamSubscription<OfflineDownloadThroughput> _throughput;
+
+  RoutePosition? _position;
+  double _speed = 0;
+  double _zoom = 0;
+  double _tilt = 0;
+  int? _tileZoom;
+  double _prefetchedUntil = 0;
+  bool _isBusy = false;
+  Timer? _delay;
+  bool _isDisposed = false;
+
+  /// The last location matched to the route, null while off the route.
+  RoutePosition? get position => _position;
+
+  /// The distance along the route in meters up to which the tiles were
+  /// prefetched.
+  double get prefetchedUntil => _prefetchedUntil;
+
+  /// Updates the location of the user and the camera and prefetches the
+  /// next part of the route, unless a part is still being prefetched.
+  void update(UserLocation location, {required double zoom, double tilt = 0}) {
+    if (_isDisposed) return;
+    final bearing = location.bearing;
+    final position = planner.locate(
+      location.position,
+      bearing: bearing != null && bearing >= 0 ? bearing : null,
+      notBefore: _position?.distanceAlong ?? 0,
+    );
+    _position = position;
+    if (position == null) return;
+    _speed = location.speed ?? 0;
+    _zoom = zoom;
+    _tilt = tilt;
+    final tileZoom = zoom.floor();
+    if (tileZoom != _tileZoom || _prefetchedUntil < position.distanceAlong) {
+      _tileZoom = tileZoom;
+      _prefetchedUntil = position.distanceAlong;
+    }
+    _next();
+  }
+
+  /// The next part of the route that can be prefetched before the camera
+  /// reaches it. Parts that can't are skipped, the map loads their tiles
+  /// anyway, and the bandwidth is left to the parts further ahead.
+  RoutePrefetchPlan? _nextPlan(RoutePosition position) {
+    final viewAhead =
+        planner.viewAhead(_zoom, _tilt, position.point.latitude);
+    final speed = max(_speed, planner.minSpeed);
+    while (true) {
+      final plan = planner.plan(
+        position: position,
+        speed: _speed,
+        horizon: horizon,
+        zoom: _zoom,
+        tilt: _tilt,
+        prefetchedUntil: _prefetchedUntil,
+        maxLength: segmentLength,
+      );
+      if (plan == null) return null;
+      final arrival =
+          max(plan.fromDistance - position.distanceAlong - viewAhead, 0) /
+              speed;
+      if (pacer.canDownloadWithin(plan.tiles.estimateBytes(sizeModel),
+          Duration(milliseconds: (arrival * 1000).round()))) {
+        return plan;
+      }
+      _prefetchedUntil = plan.toDistance;
+    }
+  }
+
+  /// Prefetches the next part of the route, and the part after it once the
+  /// [pacer] allows.
+  Future<void> _next() async {
+    final position = _position;
+    if (_isBusy || _delay != null || position == null) return;
+    final plan = _nextPlan(position);
+    if (plan == null) return;
+    _isBusy = true;
+    final tileZoom = _tileZoom;
+    final stopwatch = Stopwatch()..start();
+    try {
+      final downloads = await _prefetcher.prefetchRoute(
+        plan.path,
+        width: plan.width,
+        minZoom: plan.minZoom,
+        maxZoom: plan.maxZoom,
+        segmentLength: double.infinity,
+      );
+      // a change of the zoom level restarted the prefetch meanwhile
+      if (tileZoom == _tileZoom) _prefetchedUntil = plan.toDistance;
+      await Future.wait([for (final download in downloads) download.done]);
+    } on PlatformException catch (e) {
+      // canceled parts did not fail
+      if (e.code != 'OfflineDownloadCanceled') onError?.call(e);
+    } catch (e) {
+      onError?.call(e);
+    } finally {
+      _isBusy = false;
+    }
+    // canceled or disposed meanwhile
+    if (_position == null) return;
+    final delay = pacer.delayAfter(
+        plan.tiles.estimateBytes(sizeModel), stopwatch.elapsed);
+    _delay = Timer(delay, () {
+      _delay = null;
+      _next();
+    });
+  }
+
+  /// Cancels the running prefetch and stops prefetching until the next
+  /// [update].
+  Future<void> cancel() {
+    _delay?.cancel();
+    _delay = null;
+    _position = null;
+    // the canceled parts are deleted, the next update starts over
+    _tileZoom = null;
+    return _prefetcher.cancel();
+  }
+
+  Future<void> dispose() {
+    _isDisposed = true;
+    _throughput.cancel();
+    return cancel();
+  }
+}
@@ -0,0 +1,162 @@
+part of '../maplibre_gl.dart';
+
+/// Collects style mutations so that they can be applied with a single
+/// platform call using [MapLibreMapController.applyStyleTransaction].
+///
+/// Building a style with many sources and layers one call at a time costs one
+/// platform round trip per call. A [StyleTransaction] records the operations
+/// in Dart instead and ships them as one message. The platform applies them
+/// in the order they were added, within the same frame, so the style is only
+/// repainted once.
+///
+/// Example:
+/// ```dart
+/// final transaction = StyleTransaction()
+///   ..addGeoJsonSource('points', geojson)
+///   ..addLayer('points', 'points-circle',
+///       const CircleLayerProperties(circleColor: '#ff0000'))
+///   ..setLayerVisibility('buildings', false);
+/// final errors = await controller.applyStyleTransaction(transaction);
+/// ```
+class StyleTransaction {
+  final _operations = <Map<String, dynamic>>[];
+
+  /// The recorded operations in the order they will be applied.
+  List<Map<String, dynamic>> get operations => List.unmodifiable(_operations);
+
+  /// The number of recorded operations.
+  int get length => _operations.length;
+
+  /// Whether no operation has been recorded yet.
+  bool get isEmpty => _operations.isEmpty;
+
+  /// Adds a new source, see [MapLibreMapController.addSource].
+  void addSource(String sourceId, SourceProperties properties) {
+    _operations.add({
+      'type': 'addSource',
+      'sourceId': sourceId,
+      'properties': properties.toJson(),
+    });
+  }
+
+  /// Adds a new geojson source, see [MapLibreMapController.addGeoJsonSource].
+  void addGeoJsonSource(String sourceId, Map<String, dynamic> geojson,
+      {String? promoteId}) {
+    _operations.add({
+      'type': 'addGeoJsonSource',
+      'sourceId': sourceId,
+      'geojson': geojson,
+      'promoteId': promoteId,
+    });
+  }
+
+  /// Sets new data to an existing geojson source, see
+  /// [MapLibreMapController.setGeoJsonSource].
+  void setGeoJsonSource(String sourceId, Map<String, dynamic> geojson) {
+    _operations.add({
+      'type': 'setGeoJsonSource',
+      'sourceId': sourceId,
+      'geojson': geojson,
+    });
+  }
+
+  /// Updates an existing geojson source with a diff instead of setting all
+  /// of its data: the features of [add] replace the features with the same
+  /// id or are appended, and the features with an id in [remove] are
+  /// removed.
+  void updateGeoJsonSource(String sourceId,
+      {List<Map<String, dynamic>> add = const [],
+      List<Object> remove = const []}) {
+    _operations.add({
+      'type': 'updateGeoJsonSource',
+      'sourceId': sourceId,
+      'geojson': {'type': 'FeatureCollection', 'features': add},
+      'removeIds': remove,
+    });
+  }
+
+  /// Adds a layer, see [MapLibreMapController.addLayer].
+  void addLayer(String sourceId, String layerId, LayerProperties properties,
+      {String? belowLayerId,
+      bool enableInteraction = true,
+      String? sourceLayer,
+      double? minzoom,
+      double? maxzoom,
+      dynamic filter}) {
+    final layerType = _layerTypeOf(properties);
+    if (filter != null &&
+        (layerType == 'raster' || layerType == 'hillshade')) {
+      throw UnimplementedError("$layerType layer does not support filter");
+    }
+    // raster, hillshade and heatmap layers never take part in interaction
+    final interactive = enableInteraction &&
+        layerType != 'raster' &&
+        layerType != 'hillshade' &&
+        layerType != 'heatmap';
+    _operations.add({
+      'type': 'addLayer',
+      'layerType': layerType,
+      'sourceId': sourceId,
+      'layerId': layerId,
+      'properties': properties.toJson(),
+      'belowLayerId': belowLayerId,
+      'sourceLayer': sourceLayer,
+      'minzoom': minzoom,
+      'maxzoom': maxzoom,
+      'filter': filter,
+      'enableInteraction': interactive,
+    });
+  }
+
+  /// Sets one or multiple properties of a layer, see
+  /// [MapLibreMapController.setLayerProperties].
+  void setLayerProperties(String layerId, LayerProperties properties) {
+    _operations.add({
+      'type': 'setLayerProperties',
+      'layerId': layerId,
+      'properties': properties.toJson(),
+    });
+  }
+
+  /// Sets the filter of a layer, see [MapLibreMapController.setFilter].
+  void setFilter(String layerId, dynamic filter) {
+    _operations.add({
+      'type': 'setFilter',
+      'layerId': layerId,
+      'filter': filter,
+    });
+  }
+
+  /// Shows or hides a layer, see [MapLibreMapController.setLayerVisibility].
+  void setLayerVisibility(String layerId, bool visible) {
+    _operations.add({
+      'type': 'setLayerVisibility',
+      'layerId': layerId,
+      'visible': visible,
+    });
+  }
+
+  /// Removes a layer, see [MapLibreMapController.removeLayer].
+  void removeLayer(String layerId) {
+    _operations.add({'type': 'removeLayer', 'layerId': layerId});
+  }
+
+  /// Removes a source, see [MapLibreMapController.removeSource].
+  void removeSource(String sourceId) {
+    _operations.add({'type': 'removeSource', 'sourceId': sourceId});
+  }
+
+  static String _layerTypeOf(LayerProperties properties) {
+    return switch (properties) {
+      FillLayerProperties() => 'fill',
+      FillExtrusionLayerProperties() => 'fill-extrusion',
+      LineLayerProperties() => 'line',
+      SymbolLayerProperties() => 'symbol',
+      CircleLayerProperties() => 'circle',
+      RasterLayerProperties() => 'raster',
+      HillshadeLayerProperties() => 'hillshade',
+      HeatmapLayerProperties() => 'heatmap',
+      _ => throw UnimplementedError("Unknown layer type $properties"),
+    };
+  }
+}
@@ -0,0 +1,198 @@
+import 'dart:async';
+import 'dart:convert';
+
+import 'package:flutter/services.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:maplibre_gl/maplibre_gl.dart';
+
+const _map = MethodChannel('plugins.flutter.io/maplibre_gl_1');
+
+List<LiveFeature> _decode(Object? message) {
+  if (message is! String) throw const FormatException('not a feature id');
+  return [LiveFeature(id: message, position: const LatLng(0, 0))];
+}
+
+List<LiveFeature> _features(Iterable<int> ids) => [
+      for (final id in ids)
+        LiveFeature(id: 'f$id', position: LatLng(0, id / 1000)),
+    ];
+
+void main() {
+  TestWidgetsFlutterBinding.ensureInitialized();
+  final messenger =
+      TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger;
+
+  /// The operations of the applied style transactions.
+  late List<Map<dynamic, dynamic>> updates;
+
+  /// Holds the replies of style transactions while set.
+  Completer<void>? hold;
+
+  /// The errors of the next style transaction.
+  late List<Map<String, Object>> errors;
+
+  setUp(() {
+    updates = [];
+    hold = null;
+    errors = [];
+    messenger.setMockMethodCallHandler(_map, (call) async {
+      if (call.method != 'style#applyTransaction') return null;
+      updates.add((call.arguments['operations'] as List).single);
+      await hold?.future;
+      final reply = {'errors': errors};
+      errors = [];
+      return reply;
+    });
+  });
+
+  tearDown(() => messenger.setMockMethodCallHandler(_map, null));
+
+  Future<LiveFeatureFeed> start({
+    Duration ttl = const Duration(seconds: 60),
+    LiveFeatureDecodeErrorCallback? onDecodeError,
+  }) async {
+    final platform = MapLibreMethodChannel();
+    await platform.initPlatform(1);
+    final feed = LiveFeatureFeed(
+      controller: MapLibreMapController(
+        maplibrePlatform: platform,
+        initialCameraPosition: const CameraPosition(target: LatLng(0, 0)),
+        annotationOrder: const [],
+        annotationConsumeTapEvents: const [],
+      ),
+      sourceId: 'traffic',
+      decoder: _decode,
+      ttl: ttl,
+      decodeInBackground: false,
+      onDecodeError: onDecodeError,
+    );
+    await feed.start();
+    return feed;
+  }
+
+  /// The type of [update] and the ids of the features it adds or sets.
+  Map<String, Object?> describe(Map<dynamic, dynamic> update) {
+    final Map<String, dynamic> geojson = jsonDecode(update['geojson']);
+    return {
+      'type': update['type'],
+      'ids': [for (final feature in geojson['features']) feature['id']],
+    };
+  }
+
+  group('expiry', () {
+    testWidgets('removes features after the ttl', (tester) async {
+      final feed = await start(ttl: const Duration(seconds: 3));
+      feed.addFeatures(_features([1]));
+      await tester.pump();
+      expect(updates, hasLength(1));
+
+      await tester.pump(const Duration(seconds: 3));
+      expect(feed.features, hasLength(1));
+      await tester.pump(const Duration(seconds: 1));
+      expect(feed.features, isEmpty);
+      expect(describe(updates.last), {'type': 'setGeoJsonSource', 'ids': []});
+      feed.dispose();
+    });
+
+    testWidgets('reschedules the expiry of updated features', (tester) async {
+      final feed = await start(ttl: const Duration(seconds: 3));
+      feed.addFeatures(_features([1]));
+      await tester.pump(const Duration(seconds: 2));
+      feed.addFeatures(_features([1]));
+      await tester.pump(const Duration(seconds: 3));
+      expect(feed.features, hasLength(1));
+      await tester.pump(const Duration(seconds: 1));
+      expect(feed.features, isEmpty);
+      feed.dispose();
+    });
+  });
+
+  testWidgets('sends the whole collection if most features changed',
+      (tester) async {
+    final feed = await start();
+    feed.addFeatures(_features(List.generate(10, (i) => i)));
+    await tester.pump();
+    expect(describe(updates.last)['type'], 'setGeoJsonSource');
+
+    feed.addFeatures(_features([0, 1, 2, 3, 4]));
+    await tester.pump();
+    expect(describe(updates.last), {
+      'type': 'updateGeoJsonSource',
+      'ids': ['f0', 'f1', 'f2', 'f3', 'f4'],
+    });
+
+    feed.remove('f9');
+    await tester.pump();
+    expect(describe(updates.last), {'type': 'updateGeoJsonSource', 'ids': []});
+    expect(updates.last['removeIds'], ['f9']);
+
+    feed.addFeatures(_features([0, 1, 2, 3, 4]));
+    await tester.pump();
+    expect(describe(updates.last)['type'], 'setGeoJsonSource');
+    expect(describe(updates.last)['ids'], hasLength(9));
+    feed.dispose();
+  });
+
+  testWidgets('coalesces the changes while an update is in flight',
+      (tester) async {
+    final feed = await start();
+    feed.addFeatures(_features(List.generate(10, (i) => i)));
+    await tester.pump();
+
+    hold = Completer();
+    feed.addFeatures(_features([0]));
+    await tester.pump();
+    feed.addFeatures(_features([1]));
+    await tester.pump();
+    feed.addFeatures(_features([2]));
+    await tester.pump();
+    expect(updates, hasLength(2));
+
+    hold!.complete();
+    await tester.pump();
+    await tester.pump();
+    expect(updates, hasLength(3));
+    expect(describe(updates.last), {
+      'type': 'updateGeoJsonSource',
+      'ids': ['f1', 'f2'],
+    });
+    feed.dispose();
+  });
+
+  testWidgets('resyncs a quiet feed after a failed update on the next tick',
+      (tester) async {
+    final feed = await start();
+    errors = [
+      {'index': 0, 'code': 'sourceNotFound', 'message': 'style reloading'},
+    ];
+    feed.addFeatures(_features([1, 2]));
+    await tester.pump();
+    expect(updates, hasLength(1));
+
+    await tester.pump(const Duration(milliseconds: 100));
+    await tester.pump(const Duration(milliseconds: 100));
+    expect(updates, hasLength(1));
+
+    await tester.pump(const Duration(seconds: 1));
+    expect(updates, hasLength(2));
+    expect(describe(updates.last), {
+      'type': 'setGeoJsonSource',
+      'ids': ['f1', 'f2'],
+    });
+
+    await tester.pump(const Duration(seconds: 1));
+    expect(updates, hasLength(2));
+    feed.dispose();
+  });
+
+  testWidgets('reports messages that fail to decode', (tester) async {
+    final decodeErrors = <Object>[];
+    final feed = await start(onDecodeError: decodeErrors.add);
+    feed.add(42);
+    feed.add('a');
+    expect(decodeErrors.single, isA<FormatException>());
+    expect(feed.features.single.id, 'a');
+    await tester.pump();
+    feed.dispose();
+  });
+}
@@ -0,0 +1,188 @@
+import 'dart:convert';
+
+import 'package:flutter/services.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:maplibre_gl/maplibre_gl.dart';
+
+const _methods = MethodChannel('plugins.flutter.io/maplibre_gl');
+const _events =
+    MethodChannel('plugins.flutter.io/maplibre_gl/offline_downloads');
+
+final _definition = OfflineRegionDefinition(
+  bounds: LatLngBounds(
+    southwest: const LatLng(45, 5),
+    northeast: const LatLng(46, 6),
+  ),
+  mapStyleUrl: 'https://example.com/style.json',
+  minZoom: 0,
+  maxZoom: 10,
+);
+
+Map<String, Object?> _region(int id) => {
+      'id': id,
+      'definition': _definition.toMap(),
+      'metadata': <String, Object?>{},
+    };
+
+void main() {
+  TestWidgetsFlutterBinding.ensureInitialized();
+  final messenger =
+      TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger;
+  final queue = OfflineDownloadQueue.instance;
+
+  // region ids are unique across tests, as the queue is shared
+  var nextRegionId = 1;
+  late List<MethodCall> calls;
+  String? savedQueue;
+  var storedRegions = <Map<String, Object?>>[];
+
+  /// Sends [event] on the shared event channel, like the platform.
+  Future<void> emit(Map<String, Object?> event) =>
+      messenger.handlePlatformMessage(_events.name,
+          const StandardMethodCodec().encodeSuccessEnvelope(event), (_) {});
+
+  /// The pauses and resumes sent to the platform.
+  List<String> commands() => [
+        for (final call in calls)
+          if (call.method == 'offlineDownload#pause' ||
+              call.method == 'offlineDownload#resume')
+            '${call.method} ${call.arguments['id']}',
+      ];
+
+  /// The entries of the last saved queue.
+  List<dynamic> saved() => json.decode(calls
+      .lastWhere((call) => call.method == 'offlineDownload#saveQueue')
+      .arguments['queue']);
+
+  setUp(() {
+    calls = [];
+    savedQueue = null;
+    storedRegions = [];
+    messenger.setMockMethodCallHandler(_methods, (call) async {
+      calls.add(call);
+      switch (call.method) {
+        case 'offlineDownload#create':
+          return _region(nextRegionId++);
+        case 'offlineDownload#loadQueue':
+          return savedQueue;
+        case 'getListOfRegions':
+          return storedRegions;
+      }
+      return null;
+    });
+    messenger.setMockMethodCallHandler(_events, (call) async => null);
+  });
+
+  tearDown(() async {
+    for (final download in queue.downloads) {
+      await download.cancel(deleteRegion: false);
+    }
+    queue.maxConcurrentDownloads = 2;
+    messenger.setMockMethodCallHandler(_methods, null);
+    messenger.setMockMethodCallHandler(_events, null);
+  });
+
+  test('preempts running downloads of a lower priority', () async {
+    queue.maxConcurrentDownloads = 1;
+    final low = await queue.enqueue(_definition);
+    expect(commands(), ['offlineDownload#resume ${low.id}']);
+    calls.clear();
+
+    final high = await queue.enqueue(_definition, priority: 1);
+    expect(commands(), [
+      'offlineDownload#resume ${high.id}',
+      'offlineDownload#pause ${low.id}',
+    ]);
+    expect(high.state, OfflineDownloadState.downloading);
+    expect(low.state, OfflineDownloadState.queued);
+    expect(queue.downloads, [high, low]);
+  });
+
+  test('runs at most maxConcurrentDownloads at a time', () async {
+    final first = await queue.enqueue(_definition);
+    final second = await queue.enqueue(_definition);
+    final third = await queue.enqueue(_definition);
+    expect(commands(), [
+      'offlineDownload#resume ${first.id}',
+      'offlineDownload#resume ${second.id}',
+    ]);
+    expect(third.state, OfflineDownloadState.queued);
+
+    await emit({'id': first.id, 'status': 'complete'});
+    await pumpEventQueue();
+    await first.done;
+    expect(first.state, OfflineDownloadState.completed);
+    expect(third.state, OfflineDownloadState.downloading);
+    expect(commands().last, 'offlineDownload#resume ${third.id}');
+  });
+
+  test('persists paused downloads and skips failed ones', () async {
+    final paused = await queue.enqueue(_definition);
+    final failed = await queue.enqueue(_definition);
+    await paused.pause();
+    expect(commands().last, 'offlineDownload#pause ${paused.id}');
+    expect(paused.state, OfflineDownloadState.paused);
+
+    await emit({
+      'id': failed.id,
+      'status': 'error',
+      'errorCode': 'RegionError',
+      'errorMessage': 'tile limit exceeded',
+    });
+    await pumpEventQueue();
+    expect(failed.state, OfflineDownloadState.failed);
+    expect(failed.error!.code, 'RegionError');
+    await expectLater(failed.done, throwsA(isA<PlatformException>()));
+    expect(saved(), [
+      {'id': paused.id, 'priority': 0, 'sequence': anything, 'paused': true},
+    ]);
+
+    calls.clear();
+    await paused.resume();
+    expect(paused.state, OfflineDownloadState.downloading);
+    expect(commands(), ['offlineDownload#resume ${paused.id}']);
+    expect(saved().single['paused'], isFalse);
+  });
+
+  test('restores paused and queued downloads', () async {
+    final pausedId = nextRegionId++;
+    final queuedId = nextRegionId++;
+    final deletedId = nextRegionId++;
+    storedRegions = [_region(pausedId), _region(queuedId)];
+    savedQueue = json.encode([
+      {'id': queuedId, 'priority': 1, 'sequence': 1001, 'paused': false},
+      {'id': pausedId, 'priority': 0, 'sequence': 1000, 'paused': true},
+      {'id': deletedId, 'priority': 0, 'sequence': 1002, 'paused': false},
+    ]);
+    await queue.restore();
+
+    final downloads = queue.downloads;
+    expect(downloads.map((download) => download.id), [queuedId, pausedId]);
+    expect(downloads.first.state, OfflineDownloadState.downloading);
+    expect(downloads.last.state, OfflineDownloadState.paused);
+    expect(commands(), ['offlineDownload#resume $queuedId']);
+
+    // new downloads are scheduled after the restored ones
+    final added = await queue.enqueue(_definition, priority: 1);
+    expect(queue.downloads.map((download) => download.id),
+        [queuedId, added.id, pausedId]);
+  });
+
+  test('fails the running downloads on event channel errors', () async {
+    queue.maxConcurrentDownloads = 1;
+    final running = await queue.enqueue(_definition);
+    final queued = await queue.enqueue(_definition);
+    await messenger.handlePlatformMessage(
+        _events.name,
+        const StandardMethodCodec()
+            .encodeErrorEnvelope(code: 'StreamError', message: 'closed'),
+        (_) {});
+    await pumpEventQueue();
+    await expectLater(
+        running.done,
+        throwsA(isA<PlatformException>()
+            .having((e) => e.code, 'code', 'StreamError')));
+    expect(running.state, OfflineDownloadState.failed);
+    expect(queued.state, OfflineDownloadState.downloading);
+  });
+}
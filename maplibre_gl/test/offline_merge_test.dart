@@ -0,0 +1,170 @@
+import 'package:flutter/services.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:maplibre_gl/maplibre_gl.dart';
+
+const _methods = MethodChannel('plugins.flutter.io/maplibre_gl');
+const _events = MethodChannel('plugins.flutter.io/maplibre_gl/offline_merges');
+
+Map<String, Object?> _status(
+  int id,
+  String status, {
+  String phase = 'copying',
+  int completedBytes = 0,
+  int totalBytes = 0,
+  int completedTiles = 0,
+  int totalTiles = 0,
+  String? errorMessage,
+  List<Object?>? regions,
+}) =>
+    {
+      'id': id,
+      'status': status,
+      'phase': phase,
+      'completedBytes': completedBytes,
+      'totalBytes': totalBytes,
+      'completedTiles': completedTiles,
+      'totalTiles': totalTiles,
+      'skippedTiles': 0,
+      'skippedBytes': 0,
+      if (errorMessage != null) 'errorMessage': errorMessage,
+      if (regions != null) 'regions': regions,
+    };
+
+void main() {
+  TestWidgetsFlutterBinding.ensureInitialized();
+  final messenger =
+      TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger;
+
+  /// Sends [event] on the shared event channel, like the platform.
+  Future<void> emit(Map<String, Object?> event) =>
+      messenger.handlePlatformMessage(_events.name,
+          const StandardMethodCodec().encodeSuccessEnvelope(event), (_) {});
+
+  /// Starts a merge with [id], sending [before] before the id is returned.
+  Future<OfflineMerge> start(int id,
+      [List<Map<String, Object?>> before = const []]) {
+    messenger.setMockMethodCallHandler(_methods, (call) async {
+      if (call.method != 'offlineMerge#start') return null;
+      expect(call.arguments, {'path': '/side.db'});
+      for (final event in before) {
+        await emit(event);
+      }
+      return id;
+    });
+    return OfflineMerge.start('/side.db');
+  }
+
+  setUp(() {
+    messenger.setMockMethodCallHandler(_events, (call) async => null);
+  });
+
+  tearDown(() {
+    messenger.setMockMethodCallHandler(_methods, null);
+    messenger.setMockMethodCallHandler(_events, null);
+  });
+
+  group('OfflineMergeProgress', () {
+    OfflineMergeProgress progress(OfflineMergePhase phase,
+            {int bytes = 0, int tiles = 0}) =>
+        OfflineMergeProgress(
+          phase: phase,
+          completedBytes: 50,
+          totalBytes: bytes,
+          completedTiles: 10,
+          totalTiles: tiles,
+          skippedTiles: 0,
+          skippedBytes: 0,
+        );
+
+    test('is the progress of the bytes while copying', () {
+      expect(progress(OfflineMergePhase.copying, bytes: 200).progress, 0.25);
+      expect(progress(OfflineMergePhase.copying).progress, 0);
+    });
+
+    test('is the progress of the tiles while deduplicating', () {
+      expect(
+          progress(OfflineMergePhase.deduplicating, bytes: 200, tiles: 40)
+              .progress,
+          0.25);
+      expect(progress(OfflineMergePhase.deduplicating, bytes: 200).progress,
+          0);
+    });
+
+    test('is complete while merging', () {
+      expect(progress(OfflineMergePhase.merging).progress, 1);
+    });
+  });
+
+  test('reports the progress of the events', () async {
+    final merge = await start(1);
+    expect(merge.id, 1);
+    final reported = merge.progress.first;
+    await emit(_status(
+      1,
+      'progress',
+      phase: 'deduplicating',
+      completedBytes: 100,
+      totalBytes: 400,
+      completedTiles: 3,
+      totalTiles: 12,
+    ));
+    final progress = await reported;
+    expect(progress.phase, OfflineMergePhase.deduplicating);
+    expect(progress.completedBytes, 100);
+    expect(progress.totalBytes, 400);
+    expect(progress.completedTiles, 3);
+    expect(progress.totalTiles, 12);
+    expect(progress.progress, 0.25);
+    expect(merge.lastProgress, progress);
+  });
+
+  test('buffers the events that arrive before start returns', () async {
+    final merge = await start(2, [
+      _status(2, 'progress', completedBytes: 10, totalBytes: 40),
+      _status(2, 'complete', phase: 'merging', regions: []),
+    ]);
+    expect(merge.lastProgress!.phase, OfflineMergePhase.merging);
+    expect(await merge.regions, isEmpty);
+  });
+
+  test('fails with OfflineMergeCanceled when canceled', () async {
+    final merge = await start(3);
+    final canceled = <MethodCall>[];
+    messenger.setMockMethodCallHandler(_methods, (call) async {
+      canceled.add(call);
+      return null;
+    });
+    await merge.cancel();
+    expect(canceled.single.method, 'offlineMerge#cancel');
+    expect(canceled.single.arguments, {'id': 3});
+    await emit(_status(3, 'canceled'));
+    await expectLater(
+        merge.regions,
+        throwsA(isA<PlatformException>()
+            .having((e) => e.code, 'code', 'OfflineMergeCanceled')));
+    expect(await merge.progress.isEmpty, isTrue);
+  });
+
+  test('fails with OfflineMergeError on errors', () async {
+    final merge = await start(4);
+    await emit(_status(4, 'error', errorMessage: 'disk full'));
+    await expectLater(
+        merge.regions,
+        throwsA(isA<PlatformException>()
+            .having((e) => e.code, 'code', 'OfflineMergeError')
+            .having((e) => e.message, 'message', 'disk full')));
+  });
+
+  test('fails the merges in flight on event channel errors', () async {
+    final merge = await start(5);
+    await messenger.handlePlatformMessage(
+        _events.name,
+        const StandardMethodCodec()
+            .encodeErrorEnvelope(code: 'StreamError', message: 'closed'),
+        (_) {});
+    await expectLater(
+        merge.regions,
+        throwsA(isA<PlatformException>()
+            .having((e) => e.code, 'code', 'StreamError')));
+  });
+}
@@ -13,6 +13,7 @@ import 'package:maplibre_gl/maplibre_gl.dart';
 import 'package:web_socket_channel/web_socket_channel.dart';
 
 import 'page.dart';
+import 'traffic_replay.dart';
 
 class StratuxTrafficPage extends ExamplePage {
   const StratuxTrafficPage({super.key})
@@ -87,6 +88,40 @@ class TrafficInfo {
       return Colors.blue;
     }
   }
+
+  String get label =>
+      '${tail ?? 'N/A'} ${(altitude / 100).round() * 100}ft';
+
+  LiveFeature toLiveFeature() => LiveFeature(
+        id: icaoAddress,
+        position: position,
+        track: track,
+        // Stratux reports the speed in knots
+        speed: speed * 0.514444,
+        timestamp: lastSeen,
+        properties: {
+          'track': track,
+          'color': _colorToString(color),
+          'label': label,
+        },
+      );
+}
+
+String _colorToString(Color color) {
+  return '#${color.value.toRadixString(16).padLeft(8, '0').substring(2)}';
+}
+
+/// Decodes a Stratux traffic message. Runs in the background isolate of the
+/// [LiveFeatureFeed].
+List<LiveFeature> decodeStratuxTraffic(Object? message) {
+  final data = jsonDecode(message as String);
+  if (data is Map<String, dynamic> &&
+      data.containsKey('Icao_addr') &&
+      data.containsKey('Lat') &&
+      data.containsKey('Lng')) {
+    return [TrafficInfo.fromJson(data).toLiveFeature()];
+  }
+  return const [];
 }
 
 class StratuxTrafficBody extends StatefulWidget {
@@ -102,43 +137,25 @@ class _StratuxTrafficBodyState extends State<StratuxTrafficBody> {
     zoom: 10.0,
   );
 
+  static const _sourceId = 'traffic';
+  static const _layerId = 'traffic-symbols';
+
   MapLibreMapController? _mapController;
-  final Map<int, TrafficInfo> _trafficData = {};
+  LiveFeatureFeed? _feed;
   WebSocketChannel? _channel;
+  TrafficReplay? _replay;
+  StreamSubscription? _subscription;
   bool _isConnected = false;
   String _stratuxIp = '192.168.10.1';
   bool _showTraffic = true;
-  Timer? _cleanupTimer;
-  Timer? _updateMarkersTimer;
-
-  // Map to track symbols by ICAO address
-  final Map<int, Symbol> _trafficSymbols = {};
-
-  // Flag to track if icon has been loaded
-  bool _iconLoaded = false;
 
   final TextEditingController _ipController =
       TextEditingController(text: '192.168.10.1');
 
-  @override
-  void initState() {
-    super.initState();
-    _cleanupTimer = Timer.periodic(const Duration(seconds: 30), (_) {
-      _cleanupStaleTraffic();
-    });
-    _updateMarkersTimer =
-        Timer.periodic(const Duration(milliseconds: 500), (_) {
-      if (_isConnected && _showTraffic && _iconLoaded) {
-        _updateTrafficMarkers();
-      }
-    });
-  }
-
   @override
   void dispose() {
-    _disconnect();
-    _cleanupTimer?.cancel();
-    _updateMarkersTimer?.cancel();
+    _stopFeed();
+    _feed?.dispose();
     _ipController.dispose();
     super.dispose();
   }
@@ -149,32 +166,7 @@ class _StratuxTrafficBodyState extends State<StratuxTrafficBody> {
       _channel = WebSocketChannel.connect(
         Uri.parse('ws://$_stratuxIp/traffic'),
       );
-      _channel!.stream.listen(
-        (message) {
-          try {
-            final data = jsonDecode(message);
-            if (data is Map<String, dynamic>) {
-              _processTrafficData(data);
-            }
-          } catch (e) {
-            debugPrint('Error processing traffic data: $e');
-          }
-        },
-        onDone: () {
-          setState(() {
-            _isConnected = false;
-          });
-        },
-        onError: (error) {
-          debugPrint('WebSocket error: $error');
-          setState(() {
-            _isConnected = false;
-          });
-        },
-      );
-      setState(() {
-        _isConnected = true;
-      });
+      _listen(_channel!.stream);
     } catch (e) {
       debugPrint('Connection error: $e');
       setState(() {
@@ -183,148 +175,90 @@ class _StratuxTrafficBodyState extends State<StratuxTrafficBody> {
     }
   }
 
-  void _disconnect() {
-    _channel?.sink.close();
-    _channel = null;
-    setState(() {
-      _isConnected = false;
-    });
+  /// Replays recorded traffic at 10x speed instead of connecting to Stratux.
+  Future<void> _startReplay() async {
+    _replay = await TrafficReplay.load(speed: 10);
+    _listen(_replay!.stream);
   }
 
-  void _processTrafficData(Map<String, dynamic> data) {
-    try {
-      if (data.containsKey('Icao_addr') &&
-          data.containsKey('Lat') &&
-          data.containsKey('Lng')) {
-        final trafficInfo = TrafficInfo.fromJson(data);
+  void _listen(Stream<dynamic> messages) {
+    final feed = _feed;
+    if (feed == null) return;
+    _subscription = feed.listen(messages)
+      ..onDone(() {
         setState(() {
-          _trafficData[trafficInfo.icaoAddress] = trafficInfo;
+          _isConnected = false;
         });
-      }
-    } catch (e) {
-      debugPrint('Error processing traffic data: $e');
-    }
+      })
+      ..onError((error) {
+        debugPrint('WebSocket error: $error');
+        setState(() {
+          _isConnected = false;
+        });
+      });
+    setState(() {
+      _isConnected = true;
+    });
   }
 
-  Future<void> _onStyleLoaded() async {
-    // Enable icons to overlap one another
-    await _mapController!.setSymbolIconAllowOverlap(true);
-    // Permit other symbols to render even when colliding with icons
-    await _mapController!.setSymbolIconIgnorePlacement(true);
-    // Allow text labels to overlap
-    await _mapController!.setSymbolTextAllowOverlap(true);
-    // Permit other symbols regardless of text collisions
-    await _mapController!.setSymbolTextIgnorePlacement(true);
-    // Now load your custom icon
-    await _loadCustomIcon();
+  void _stopFeed() {
+    _subscription?.cancel();
+    _subscription = null;
+    _channel?.sink.close();
+    _channel = null;
+    _replay?.close();
+    _replay = null;
   }
 
-  void _cleanupStaleTraffic() {
-    final now = DateTime.now();
-    final keysToRemove = <int>[];
+  void _disconnect() {
+    _stopFeed();
+    setState(() {
+      _isConnected = false;
+    });
+  }
 
-    for (final entry in _trafficData.entries) {
-      final diff = now.difference(entry.value.lastSeen);
-      if (diff.inSeconds > 60) {
-        keysToRemove.add(entry.key);
-      }
-    }
+  Future<void> _onStyleLoaded() async {
+    await _loadCustomIcon();
 
-    if (keysToRemove.isNotEmpty) {
-      setState(() {
-        for (final key in keysToRemove) {
-          _trafficData.remove(key);
-          // Also remove the symbol if it exists
-          if (_trafficSymbols.containsKey(key)) {
-            _mapController?.removeSymbol(_trafficSymbols[key]!);
-            _trafficSymbols.remove(key);
-          }
-        }
-      });
-    }
+    final feed = LiveFeatureFeed(
+      controller: _mapController!,
+      sourceId: _sourceId,
+      decoder: decodeStratuxTraffic,
+      // traffic is reported about once per second, the aircraft are moved
+      // along their track in between
+      interpolateMotion: true,
+    );
+    await feed.start();
+    await _mapController!.addSymbolLayer(
+      _sourceId,
+      _layerId,
+      const SymbolLayerProperties(
+        iconImage: 'plane-icon',
+        iconSize: 0.3,
+        iconRotate: [Expressions.get, 'track'],
+        iconColor: [Expressions.get, 'color'],
+        iconAllowOverlap: true,
+        iconIgnorePlacement: true,
+        textField: [Expressions.get, 'label'],
+        textOffset: [Expressions.literal, [0, 1.5]],
+        textSize: 10,
+        textColor: '#FFFFFF',
+        textHaloColor: '#000000',
+        textHaloWidth: 1,
+        textAllowOverlap: true,
+        textIgnorePlacement: true,
+      ),
+    );
+    setState(() {
+      _feed = feed;
+    });
   }
 
   void _toggleTrafficVisibility() {
     setState(() {
       _showTraffic = !_showTraffic;
-      if (!_showTraffic) {
-        _removeAllSymbols();
-      } else {
-        _updateTrafficMarkers();
-      }
     });
-  }
-
-  void _removeAllSymbols() {
-    if (_mapController != null) {
-      for (final symbol in _trafficSymbols.values) {
-        _mapController!.removeSymbol(symbol);
-      }
-      _trafficSymbols.clear();
-    }
-  }
-
-  Future<void> _updateTrafficMarkers() async {
-    if (_mapController == null || !_showTraffic || !_iconLoaded) return;
-
-    try {
-      // Process each traffic item
-      for (final traffic in _trafficData.values) {
-        // Check if we already have a symbol for this traffic
-        if (_trafficSymbols.containsKey(traffic.icaoAddress)) {
-          // Update existing symbol position and properties
-          await _mapController!.updateSymbol(
-            _trafficSymbols[traffic.icaoAddress]!,
-            SymbolOptions(
-              geometry: traffic.position,
-              iconRotate: traffic.track,
-              iconColor: _colorToString(traffic.color),
-              textField:
-                  '${traffic.tail ?? 'N/A'} ${(traffic.altitude / 100).round() * 100}ft',
-            ),
-          );
-        } else {
-          // Create a new symbol for this traffic
-          final symbol = await _mapController!.addSymbol(
-            SymbolOptions(
-              geometry: traffic.position,
-              iconSize: 0.3,
-              iconImage: 'plane-icon',
-              iconRotate: traffic.track,
-              iconColor: _colorToString(traffic.color),
-              textField:
-                  '${traffic.tail ?? 'N/A'} ${(traffic.altitude / 100).round() * 100}ft',
-              textOffset: const Offset(0, 1.5),
-              textSize: 10,
-              textColor: '#FFFFFF',
-              textHaloColor: '#000000',
-              textHaloWidth: 1,
-            ),
-          );
-          _trafficSymbols[traffic.icaoAddress] = symbol;
-        }
-      }
-
-      // Check for symbols that no longer have corresponding traffic data
-      final symbolsToRemove = <int>[];
-      for (final icao in _trafficSymbols.keys) {
-        if (!_trafficData.containsKey(icao)) {
-          symbolsToRemove.add(icao);
-        }
-      }
-
-      // Remove symbols for traffic that no longer exists
-      for (final icao in symbolsToRemove) {
-        await _mapController!.removeSymbol(_trafficSymbols[icao]!);
-        _trafficSymbols.remove(icao);
-      }
-    } catch (e) {
-      debugPrint('Error updating traffic markers: $e');
-    }
-  }
-
-  String _colorToString(Color color) {
-    return '#${color.value.toRadixString(16).padLeft(8, '0').substring(2)}';
+    _mapController?.setLayerVisibility(_layerId, _showTraffic);
   }
 
   Future<void> _loadCustomIcon() async {
@@ -332,7 +266,6 @@ class _StratuxTrafficBodyState extends State<StratuxTrafficBody> {
       final ByteData bytes = await rootBundle.load('assets/plane2.png');
       final Uint8List list = bytes.buffer.asUint8List();
       await _mapController!.addImage('plane-icon', list);
-      _iconLoaded = true;
     } catch (e) {
       debugPrint('Error loading plane icon: $e');
     }
@@ -358,10 +291,20 @@ class _StratuxTrafficBodyState extends State<StratuxTrafficBody> {
                 ),
                 const SizedBox(width: 8),
                 ElevatedButton(
-                  onPressed: _isConnected ? _disconnect : _connect,
+                  onPressed: _feed == null
+                      ? null
+                      : _isConnected
+                          ? _disconnect
+                          : _connect,
                   child: Text(_isConnected ? 'Disconnect' : 'Connect'),
                 ),
                 const SizedBox(width: 8),
+                ElevatedButton(
+                  onPressed:
+                      _feed == null || _isConnected ? null : _startReplay,
+                  child: const Text('Replay'),
+                ),
+                const SizedBox(width: 8),
                 IconButton(
                   icon: Icon(
                       _showTraffic ? Icons.visibility : Icons.visibility_off),
@@ -377,12 +320,9 @@ class _StratuxTrafficBodyState extends State<StratuxTrafficBody> {
                 MapLibreMap(
                   onMapCreated: (controller) {
                     _mapController = controller;
-                    _mapController!.onSymbolTapped.add(_onSymbolTapped);
-                  },
-                  onStyleLoadedCallback: () {
-                    _onStyleLoaded();
-                    // _loadCustomIcon();
+                    _mapController!.onFeatureTapped.add(_onFeatureTapped);
                   },
+                  onStyleLoadedCallback: _onStyleLoaded,
                   initialCameraPosition: _kInitialPosition,
                   styleString: MapLibreStyles.demo,
                 ),
@@ -398,7 +338,14 @@ class _StratuxTrafficBodyState extends State<StratuxTrafficBody> {
                     child: Column(
                       crossAxisAlignment: CrossAxisAlignment.start,
                       children: [
-                        Text('Aircraft Count: ${_trafficData.length}'),
+                        if (_feed != null)
+                          ListenableBuilder(
+                            listenable: _feed!,
+                            builder: (context, _) => Text(
+                                'Aircraft Count: ${_feed!.features.length}'),
+                          )
+                        else
+                          const Text('Aircraft Count: 0'),
                         const SizedBox(height: 4),
                         Row(
                           children: [
@@ -435,12 +382,17 @@ class _StratuxTrafficBodyState extends State<StratuxTrafficBody> {
     );
   }
 
-  void _onSymbolTapped(Symbol symbol) {
+  void _onFeatureTapped(
+      dynamic id, Point<double> point, LatLng coordinates, String layerId) {
+    if (layerId != _layerId) return;
     // You can show more details about the traffic when tapped
-    final properties = symbol.options.toJson();
+    final traffic = _feed?.features
+        .where((feature) => '${feature.id}' == '$id')
+        .firstOrNull;
+    if (traffic == null) return;
     ScaffoldMessenger.of(context).showSnackBar(
       SnackBar(
-        content: Text('Traffic: ${properties['textField']}'),
+        content: Text('Traffic: ${traffic.properties['label']}'),
         duration: const Duration(seconds: 1),
       ),
     );
@@ -0,0 +1,110 @@
+// Copyright 2023 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'dart:async';
+import 'dart:convert';
+
+import 'package:flutter/services.dart';
+
+/// Replays recorded Stratux traffic as a stand-in for the traffic WebSocket.
+///
+/// The recording is a JSON lines file of `{"t": milliseconds, "m": message}`
+/// entries. The messages are emitted on [stream] as JSON text frames, like
+/// the frames of the WebSocket, at [speed] times their recorded pace.
+class TrafficReplay {
+  TrafficReplay(String recording, {this.speed = 10, this.loop = true})
+      : _entries = [
+          for (final line in const LineSplitter().convert(recording))
+            if (line.isNotEmpty) _Entry.parse(line)
+        ];
+
+  /// Loads the recording bundled with the example.
+  static Future<TrafficReplay> load(
+          {double speed = 10, bool loop = true}) async =>
+      TrafficReplay(
+          await rootBundle.loadString('assets/traffic_recording.jsonl'),
+          speed: speed,
+          loop: loop);
+
+  final List<_Entry> _entries;
+
+  /// How much faster than recorded the messages are emitted.
+  final double speed;
+
+  /// Whether the recording starts over once all messages were emitted.
+  final bool loop;
+
+  late final _controller = StreamController<String>(
+    onListen: _start,
+    onPause: _stop,
+    onResume: _start,
+    onCancel: _stop,
+  );
+  final _stopwatch = Stopwatch();
+  var _next = 0;
+  var _loopOffset = Duration.zero;
+  Timer? _timer;
+
+  /// The replayed messages, like the stream of a WebSocket channel.
+  Stream<String> get stream => _controller.stream;
+
+  Duration get _duration =>
+      _entries.isEmpty ? Duration.zero : _entries.last.time;
+
+  void _start() {
+    _stopwatch.start();
+    _scheduleNext();
+  }
+
+  void _stop() {
+    _stopwatch.stop();
+    _timer?.cancel();
+    _timer = null;
+  }
+
+  void _scheduleNext() {
+    if (_next == _entries.length) {
+      if (!loop || _entries.isEmpty) {
+        _controller.close();
+        return;
+      }
+      _next = 0;
+      _loopOffset += _duration + const Duration(seconds: 1);
+    }
+    final due = (_loopOffset + _entries[_next].time) * (1 / speed);
+    _timer = Timer(due - _stopwatch.elapsed, _emitDue);
+  }
+
+  /// Emits all messages that are due, so that a late timer does not make the
+  /// replay drift.
+  void _emitDue() {
+    final elapsed = _stopwatch.elapsed;
+    while (_next < _entries.length &&
+        (_loopOffset + _entries[_next].time) * (1 / speed) <= elapsed) {
+      _controller.add(_entries[_next].message);
+      _next++;
+    }
+    _scheduleNext();
+  }
+
+  /// Stops the replay and closes the [stream].
+  Future<void> close() {
+    _stop();
+    return _controller.close();
+  }
+}
+
+class _Entry {
+  _Entry(this.time, this.message);
+
+  factory _Entry.parse(String line) {
+    final Map<String, dynamic> json = jsonDecode(line);
+    return _Entry(Duration(milliseconds: json['t']), jsonEncode(json['m']));
+  }
+
+  final Duration time;
+
+  /// The message as the JSON text frame sent by Stratux.
+  final String message;
+}
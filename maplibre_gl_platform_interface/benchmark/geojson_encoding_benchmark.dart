@@ -0,0 +1,102 @@
+// Measures the longest stall of the UI isolate while a large geojson source
+// is set, with the JSON encoding on the UI isolate and in a background
+// isolate.
+//
+// A periodic timer stands in for the frames of the UI isolate: the longest
+// gap between two ticks is the longest time a frame could not be produced.
+//
+// Run with:
+//   flutter test benchmark/geojson_encoding_benchmark.dart
+import 'dart:async';
+import 'dart:math';
+
+import 'package:flutter/services.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:maplibre_gl_platform_interface/maplibre_gl_platform_interface.dart';
+
+const _featureCounts = [1000, 10000, 50000];
+const _frame = Duration(milliseconds: 16);
+
+Map<String, dynamic> _collection(int featureCount) {
+  final random = Random(42);
+  return {
+    'type': 'FeatureCollection',
+    'features': [
+      for (var i = 0; i < featureCount; i++)
+        {
+          'type': 'Feature',
+          'id': i,
+          'properties': {'id': i, 'name': 'feature $i', 'speed': i % 300},
+          'geometry': {
+            'type': 'Point',
+            'coordinates': [
+              random.nextDouble() * 360 - 180,
+              random.nextDouble() * 170 - 85,
+            ],
+          },
+        }
+    ],
+  };
+}
+
+/// Sets [geojson] [count] times and returns the longest gap between two
+/// ticks of a frame timer in milliseconds.
+Future<double> _maxStall(MapLibreMethodChannel platform,
+    Map<String, dynamic> geojson, int count) async {
+  final stopwatch = Stopwatch()..start();
+  var lastTick = Duration.zero;
+  var maxGap = Duration.zero;
+  final timer = Timer.periodic(_frame, (_) {
+    final now = stopwatch.elapsed;
+    final gap = now - lastTick;
+    if (gap > maxGap) maxGap = gap;
+    lastTick = now;
+  });
+  for (var i = 0; i < count; i++) {
+    await platform.setGeoJsonSource('source', geojson);
+    // let the timer tick between two updates
+    await Future<void>.delayed(_frame);
+  }
+  timer.cancel();
+  return maxGap.inMicroseconds / 1000;
+}
+
+void main() {
+  TestWidgetsFlutterBinding.ensureInitialized();
+
+  final platform = MapLibreMethodChannel();
+  var receivedBytes = 0;
+
+  setUpAll(() async {
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+        .setMockMethodCallHandler(
+            const MethodChannel('plugins.flutter.io/maplibre_gl_0'),
+            (call) async {
+      final geojson = (call.arguments as Map?)?['geojson'];
+      if (geojson is Uint8List) receivedBytes += geojson.length;
+      if (geojson is String) receivedBytes += geojson.length;
+      return null;
+    });
+    await platform.initPlatform(0);
+  });
+
+  tearDown(() => MapLibreMethodChannel.geoJsonEncodingIsolateThreshold = 5000);
+
+  for (final featureCount in _featureCounts) {
+    test('set $featureCount features', () async {
+      final geojson = _collection(featureCount);
+
+      MapLibreMethodChannel.geoJsonEncodingIsolateThreshold = null;
+      final uiStall = await _maxStall(platform, geojson, 5);
+
+      MapLibreMethodChannel.geoJsonEncodingIsolateThreshold = 0;
+      final backgroundStall = await _maxStall(platform, geojson, 5);
+
+      // ignore: avoid_print
+      print('$featureCount features: longest stall '
+          '${uiStall.toStringAsFixed(1)} ms on the UI isolate, '
+          '${backgroundStall.toStringAsFixed(1)} ms in the background');
+      expect(receivedBytes, greaterThan(0));
+    });
+  }
+}
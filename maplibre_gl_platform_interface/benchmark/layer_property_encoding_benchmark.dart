@@ -0,0 +1,131 @@
+// Compares the previous per-entry JSON encoding of layer properties with the
+// typed encoding of [encodeLayerProperties] for every layer type.
+//
+// Run with:
+//   flutter test benchmark/layer_property_encoding_benchmark.dart
+import 'dart:convert';
+
+import 'package:flutter/services.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:maplibre_gl_platform_interface/maplibre_gl_platform_interface.dart';
+
+const _iterations = 20000;
+
+const _zoomWidth = [
+  'interpolate',
+  ['linear'],
+  ['zoom'],
+  5,
+  1.0,
+  15,
+  4.0,
+];
+
+final _layerProperties = <String, Map<String, dynamic>>{
+  'symbol': {
+    'icon-image': 'airport-15',
+    'icon-size': 1.5,
+    'icon-offset': [0, -8],
+    'icon-allow-overlap': true,
+    'text-field': ['get', 'name'],
+    'text-font': ['literal', ['Open Sans Regular']],
+    'text-size': 12,
+    'text-color': '#333333',
+    'text-halo-color': '#ffffff',
+    'text-halo-width': 1,
+    'text-offset': [0, 1.2],
+    'text-anchor': 'top',
+  },
+  'circle': {
+    'circle-radius': _zoomWidth,
+    'circle-color': '#3bb2d0',
+    'circle-opacity': 0.8,
+    'circle-stroke-width': 1,
+    'circle-stroke-color': '#ffffff',
+    'circle-translate': [0, 0],
+  },
+  'line': {
+    'line-color': '#ff0000',
+    'line-width': _zoomWidth,
+    'line-opacity': 0.9,
+    'line-dasharray': [2, 1],
+    'line-join': 'round',
+    'line-cap': 'round',
+  },
+  'fill': {
+    'fill-color': '#088f8f',
+    'fill-opacity': 0.5,
+    'fill-outline-color': '#000000',
+    'fill-translate': [1, 1],
+    'fill-antialias': true,
+  },
+  'fill-extrusion': {
+    'fill-extrusion-color': '#aaaaaa',
+    'fill-extrusion-height': ['get', 'height'],
+    'fill-extrusion-base': ['get', 'min_height'],
+    'fill-extrusion-opacity': 0.6,
+    'fill-extrusion-translate': [0, 0],
+  },
+  'raster': {
+    'raster-opacity': 0.7,
+    'raster-brightness-min': 0.1,
+    'raster-brightness-max': 0.9,
+    'raster-saturation': 0.2,
+    'raster-contrast': 0.1,
+    'raster-fade-duration': 300,
+  },
+  'hillshade': {
+    'hillshade-illumination-direction': 335,
+    'hillshade-exaggeration': 0.5,
+    'hillshade-shadow-color': '#000000',
+    'hillshade-highlight-color': '#ffffff',
+    'hillshade-accent-color': '#000000',
+  },
+  'heatmap': {
+    'heatmap-weight': ['get', 'mag'],
+    'heatmap-intensity': _zoomWidth,
+    'heatmap-radius': 20,
+    'heatmap-opacity': 0.8,
+  },
+};
+
+Map<String, String> _legacyEncode(Map<String, dynamic> properties) {
+  return properties
+      .map((key, value) => MapEntry<String, String>(key, jsonEncode(value)));
+}
+
+int _measure(Object Function() encode) {
+  const codec = StandardMessageCodec();
+  final stopwatch = Stopwatch()..start();
+  for (var i = 0; i < _iterations; i++) {
+    codec.encodeMessage(encode());
+  }
+  stopwatch.stop();
+  return stopwatch.elapsedMicroseconds;
+}
+
+void main() {
+  const codec = StandardMessageCodec();
+
+  for (final entry in _layerProperties.entries) {
+    test('${entry.key} layer properties', () {
+      final properties = entry.value;
+      final legacyBytes =
+          codec.encodeMessage(_legacyEncode(properties))!.lengthInBytes;
+      final typedBytes =
+          codec.encodeMessage(encodeLayerProperties(properties))!.lengthInBytes;
+
+      final legacyMicros = _measure(() => _legacyEncode(properties));
+      final typedMicros = _measure(() => encodeLayerProperties(properties));
+
+      // ignore: avoid_print
+      print('${entry.key}: '
+          'json ${legacyMicros / _iterations}us/$legacyBytes bytes, '
+          'typed ${typedMicros / _iterations}us/$typedBytes bytes');
+
+      final decoded = codec.decodeMessage(
+          codec.encodeMessage(encodeLayerProperties(properties))) as Map;
+      expect(decoded.keys, unorderedEquals(properties.keys));
+    });
+  }
+}
@@ -1,8 +1,10 @@
 library maplibre_gl_platform_interface;
 
 import 'dart:async';
+import 'dart:collection';
 import 'dart:convert';
 import 'dart:io';
+import 'dart:isolate';
 import 'dart:math';
 import 'package:flutter/foundation.dart';
 import 'package:flutter/gestures.dart';
@@ -22,3 +24,14 @@ part 'src/ui.dart';
 part 'src/maplibre_gl_platform_interface.dart';
 part 'src/source_properties.dart';
 part 'src/location_engine_properties.dart';
+part 'src/style_operation.dart';
+part 'src/layer_property_encoding.dart';
+part 'src/layer_property_spec.dart';
+part 'src/expression_compiler.dart';
+part 'src/cluster_index.dart';
+part 'src/motion_interpolator.dart';
+part 'src/offline_tile_planner.dart';
+part 'src/offline_tile_revalidator.dart';
+part 'src/map_performance_stats.dart';
+part 'src/ambient_cache.dart';
+part 'src/route_prefetch_planner.dart';
@@ -0,0 +1,54 @@
+part of '../maplibre_gl_platform_interface.dart';
+
+/// The occupancy of the database of MapLibre and the storage of the device.
+///
+/// The database holds the ambient cache and the offline regions. MapLibre
+/// evicts the least recently used ambient tiles once they exceed
+/// [maximumAmbientCacheSize], tiles of offline regions are never evicted.
+@immutable
+class AmbientCacheStatistics {
+  const AmbientCacheStatistics({
+    required this.databaseSize,
+    required this.maximumAmbientCacheSize,
+    required this.freeSpace,
+    required this.totalSpace,
+  });
+
+  factory AmbientCacheStatistics.fromMap(Map<Object?, Object?> map) =>
+      AmbientCacheStatistics(
+        databaseSize: map['databaseSize'] as int,
+        maximumAmbientCacheSize: map['maximumAmbientCacheSize'] as int,
+        freeSpace: map['freeSpace'] as int,
+        totalSpace: map['totalSpace'] as int,
+      );
+
+  /// The default maximum size of the ambient cache of MapLibre.
+  static const defaultMaximumAmbientCacheSize = 50 * 1024 * 1024;
+
+  /// The size of the database file in bytes.
+  final int databaseSize;
+
+  /// The size the ambient cache is limited to, as last set with
+  /// `setMaximumAmbientCacheSize` or the default of MapLibre.
+  final int maximumAmbientCacheSize;
+
+  /// The free and total bytes of the storage of the database.
+  final int freeSpace;
+  final int totalSpace;
+
+  /// A maximum ambient cache size for the storage of the device: [fraction]
+  /// of the storage that is free or used by the database, within [minimum]
+  /// and [maximum]. Devices with large storage keep more tiles, while the
+  /// cache never takes the last free space of small ones.
+  int recommendedSize({
+    double fraction = 0.02,
+    int minimum = defaultMaximumAmbientCacheSize,
+    int maximum = 2 * 1024 * 1024 * 1024,
+  }) =>
+      ((freeSpace + databaseSize) * fraction).round().clamp(minimum, maximum);
+
+  @override
+  String toString() => 'AmbientCacheStatistics, databaseSize = $databaseSize, '
+      'maximumAmbientCacheSize = $maximumAmbientCacheSize, '
+      'freeSpace = $freeSpace, totalSpace = $totalSpace';
+}
@@ -87,6 +87,63 @@ class CameraPosition {
       'CameraPosition(bearing: $bearing, target: $target, tilt: $tilt, zoom: $zoom)';
 }
 
+/// The smallest camera changes for which camera move events are delivered.
+///
+/// Changes of all components below their tolerance are not reported until the
+/// camera becomes idle.
+@immutable
+class CameraMoveTolerance {
+  const CameraMoveTolerance({
+    this.target = 1e-7,
+    this.zoom = 1e-4,
+    this.bearing = 1e-3,
+    this.tilt = 1e-3,
+  });
+
+  /// The tolerance of the latitude and longitude of the target in degrees.
+  final double target;
+
+  /// The tolerance of the zoom level.
+  final double zoom;
+
+  /// The tolerance of the bearing in degrees.
+  final double bearing;
+
+  /// The tolerance of the tilt in degrees.
+  final double tilt;
+
+  dynamic toMap() => <String, dynamic>{
+        'target': target,
+        'zoom': zoom,
+        'bearing': bearing,
+        'tilt': tilt,
+      };
+
+  static CameraMoveTolerance? fromMap(dynamic json) {
+    if (json == null) {
+      return null;
+    }
+    return CameraMoveTolerance(
+      target: json['target'],
+      zoom: json['zoom'],
+      bearing: json['bearing'],
+      tilt: json['tilt'],
+    );
+  }
+
+  @override
+  bool operator ==(Object other) =>
+      identical(this, other) ||
+      other is CameraMoveTolerance &&
+          target == other.target &&
+          zoom == other.zoom &&
+          bearing == other.bearing &&
+          tilt == other.tilt;
+
+  @override
+  int get hashCode => Object.hash(target, zoom, bearing, tilt);
+}
+
 /// Defines a camera move, supporting absolute moves as well as moves relative
 /// the current position.
 class CameraUpdate {
@@ -0,0 +1,594 @@
+part of '../maplibre_gl_platform_interface.dart';
+
+/// Maps the properties of a single point to the properties that are
+/// aggregated into its cluster, see [ClusterIndex.map].
+typedef ClusterPropertiesMapper = Map<String, dynamic> Function(
+    Map<String, dynamic> properties);
+
+/// Merges [properties] of a point or cluster into the [accumulated]
+/// properties of a cluster, see [ClusterIndex.reduce].
+typedef ClusterPropertiesReducer = void Function(
+    Map<String, dynamic> accumulated, Map<String, dynamic> properties);
+
+/// A hierarchical point clustering index in pure Dart.
+///
+/// This implements the same greedy algorithm as supercluster, which is used
+/// by MapLibre GL JS and MapLibre Native for clustered geojson sources: the
+/// points are projected to web mercator, indexed in a static KD-tree and
+/// clustered zoom by zoom from [maxZoom] down to [minZoom], each level
+/// reusing the clusters of the level above. Queries for a zoom level only
+/// walk the tree of that level, so they are independent of the number of
+/// points outside of the requested bounds.
+///
+/// The output uses the same geojson conventions as clustered map sources.
+/// Clusters are `Point` features with the properties `cluster`,
+/// `cluster_id`, `point_count` and `point_count_abbreviated`, points are
+/// returned as they were passed to [load].
+///
+/// Use it to cluster without a map, e.g. in tests or in a background
+/// isolate, or to answer cluster queries without a platform round trip.
+///
+/// Example:
+/// ```dart
+/// final index = ClusterIndex(radius: 60, maxZoom: 14)..load(features);
+/// final clusters = index.getClusters([-180, -85, 180, 85], 2);
+/// ```
+class ClusterIndex {
+  /// Minimum zoom level at which clusters are generated.
+  final int minZoom;
+
+  /// Maximum zoom level at which clusters are generated.
+  final int maxZoom;
+
+  /// Minimum number of points to form a cluster.
+  final int minPoints;
+
+  /// Cluster radius in pixels, see [GeojsonSourceProperties.clusterRadius].
+  final double radius;
+
+  /// Tile extent, the [radius] is calculated relative to it.
+  final double extent;
+
+  /// Size of the KD-tree leaf node, affects performance only.
+  final int nodeSize;
+
+  /// Extracts the properties of a point that are aggregated into clusters.
+  /// Only used if [reduce] is set.
+  final ClusterPropertiesMapper? map;
+
+  /// Aggregates the mapped properties of points into clusters, comparable to
+  /// [GeojsonSourceProperties.clusterProperties].
+  final ClusterPropertiesReducer? reduce;
+
+  ClusterIndex({
+    this.minZoom = 0,
+    this.maxZoom = 16,
+    this.minPoints = 2,
+    this.radius = 40,
+    this.extent = 512,
+    this.nodeSize = 64,
+    this.map,
+    this.reduce,
+  })  : assert(minZoom >= 0 && minZoom <= maxZoom),
+        assert(maxZoom < 32, "cluster ids encode the zoom with 5 bits");
+
+  int get _stride => reduce != null ? 7 : 6;
+
+  final _trees = <int, _KDBush>{};
+  final _clusterProperties = <Map<String, dynamic>>[];
+  var _points = const <Map<String, dynamic>>[];
+
+  /// The points passed to the last call of [load].
+  List<Map<String, dynamic>> get points => _points;
+
+  /// Builds the index from geojson `Point` [points], replacing the previous
+  /// content. Features without point geometry are ignored.
+  void load(List<Map<String, dynamic>> points) {
+    _points = points;
+    _trees.clear();
+    _clusterProperties.clear();
+
+    final stride = _stride;
+    final data = <double>[];
+    for (var i = 0; i < points.length; i++) {
+      final geometry = points[i]['geometry'];
+      if (geometry is! Map || geometry['type'] != 'Point') continue;
+      final coordinates = geometry['coordinates'] as List;
+      data
+        ..add(_lngX((coordinates[0] as num).toDouble()))
+        ..add(_latY((coordinates[1] as num).toDouble()))
+        // the last zoom the point was processed at
+        ..add(double.infinity)
+        // index of the source feature in the original input array
+        ..add(i.toDouble())
+        // parent cluster id
+        ..add(-1)
+        // number of points in a cluster
+        ..add(1);
+      if (reduce != null) {
+        // index of the cluster properties, none for single points
+        data.add(-1);
+      }
+    }
+
+    var tree = _trees[maxZoom + 1] = _createTree(data, stride);
+    // cluster points on max zoom, then cluster the results on previous zoom,
+    // etc.; results in a cluster hierarchy across zoom levels
+    for (var z = maxZoom; z >= minZoom; z--) {
+      tree = _trees[z] = _createTree(_cluster(tree, z), stride);
+    }
+  }
+
+  /// Returns the clusters and points in [bbox] (`[west, south, east, north]`
+  /// in degrees) at the integer [zoom].
+  List<Map<String, dynamic>> getClusters(List<double> bbox, int zoom) {
+    var minLng = ((bbox[0] + 180) % 360 + 360) % 360 - 180;
+    final minLat = max(-90.0, min(90.0, bbox[1]));
+    var maxLng =
+        bbox[2] == 180 ? 180.0 : ((bbox[2] + 180) % 360 + 360) % 360 - 180;
+    final maxLat = max(-90.0, min(90.0, bbox[3]));
+
+    if (bbox[2] - bbox[0] >= 360) {
+      minLng = -180;
+      maxLng = 180;
+    } else if (minLng > maxLng) {
+      // the bounds cross the antimeridian
+      return [
+        ...getClusters([minLng, minLat, 180, maxLat], zoom),
+        ...getClusters([-180, minLat, maxLng, maxLat], zoom),
+      ];
+    }
+
+    final tree = _trees[_limitZoom(zoom)];
+    if (tree == null) return [];
+    final ids = tree.range(
+        _lngX(minLng), _latY(maxLat), _lngX(maxLng), _latY(minLat));
+    final data = tree.data;
+    final stride = _stride;
+    return [
+      for (final id in ids) _toFeature(data, stride * id),
+    ];
+  }
+
+  /// Returns the direct children (clusters or points) of the cluster with
+  /// [clusterId] on the next zoom level.
+  ///
+  /// Throws an [ArgumentError] if there is no such cluster.
+  List<Map<String, dynamic>> getChildren(int clusterId) {
+    final originId = _originId(clusterId);
+    final originZoom = _originZoom(clusterId);
+    final tree = _trees[originZoom];
+    final stride = _stride;
+    if (tree == null || originId < 0 || originId * stride >= tree.data.length) {
+      throw ArgumentError.value(
+          clusterId, 'clusterId', 'No cluster with the specified id');
+    }
+
+    final data = tree.data;
+    final r = radius / (extent * pow(2, originZoom - 1));
+    final x = data[originId * stride];
+    final y = data[originId * stride + 1];
+    final children = <Map<String, dynamic>>[];
+    for (final id in tree.within(x, y, r)) {
+      final k = id * stride;
+      if (data[k + 4] == clusterId) {
+        children.add(_toFeature(data, k));
+      }
+    }
+
+    if (children.isEmpty) {
+      throw ArgumentError.value(
+          clusterId, 'clusterId', 'No cluster with the specified id');
+    }
+    return children;
+  }
+
+  /// Returns up to [limit] points of the cluster with [clusterId], skipping
+  /// the first [offset] points. Use it to page through large clusters.
+  List<Map<String, dynamic>> getLeaves(int clusterId,
+      {int limit = 10, int offset = 0}) {
+    final leaves = <Map<String, dynamic>>[];
+    if (limit > 0) {
+      _appendLeaves(leaves, clusterId, limit, offset, 0);
+    }
+    return leaves;
+  }
+
+  /// Returns the zoom at which the cluster with [clusterId] splits into
+  /// multiple children, e.g. to zoom the camera in on a tapped cluster.
+  int getClusterExpansionZoom(int clusterId) {
+    var expansionZoom = _originZoom(clusterId) - 1;
+    while (expansionZoom <= maxZoom) {
+      final children = getChildren(clusterId);
+      expansionZoom++;
+      if (children.length != 1) break;
+      final properties = children.first['properties'] as Map;
+      if (properties['cluster'] != true) break;
+      clusterId = properties['cluster_id'];
+    }
+    return expansionZoom;
+  }
+
+  int _appendLeaves(List<Map<String, dynamic>> result, int clusterId,
+      int limit, int offset, int skipped) {
+    for (final child in getChildren(clusterId)) {
+      final properties = child['properties'];
+      if (properties is Map && properties['cluster'] == true) {
+        final int pointCount = properties['point_count'];
+        if (skipped + pointCount <= offset) {
+          // skip the whole cluster
+          skipped += pointCount;
+        } else {
+          skipped = _appendLeaves(
+              result, properties['cluster_id'], limit, offset, skipped);
+        }
+      } else if (skipped < offset) {
+        skipped++;
+      } else {
+        result.add(child);
+      }
+      if (result.length == limit) break;
+    }
+    return skipped;
+  }
+
+  _KDBush _createTree(List<double> data, int stride) {
+    final tree = _KDBush(data.length ~/ stride, nodeSize, data);
+    for (var i = 0; i < data.length; i += stride) {
+      tree.add(data[i], data[i + 1]);
+    }
+    tree.finish();
+    return tree;
+  }
+
+  List<double> _cluster(_KDBush tree, int zoom) {
+    final stride = _stride;
+    final r = radius / (extent * pow(2, zoom));
+    final data = tree.data;
+    final nextData = <double>[];
+
+    // loop through each point
+    for (var i = 0; i < data.length; i += stride) {
+      // if we've already visited the point at this zoom level, skip it
+      if (data[i + 2] <= zoom) continue;
+      data[i + 2] = zoom.toDouble();
+
+      // find all nearby points
+      final x = data[i];
+      final y = data[i + 1];
+      final neighborIds = tree.within(x, y, r);
+
+      final numPointsOrigin = data[i + 5];
+      var numPoints = numPointsOrigin;
+
+      // count the number of points in a potential cluster
+      for (final neighborId in neighborIds) {
+        final k = neighborId * stride;
+        // filter out neighbors that are already processed
+        if (data[k + 2] > zoom) numPoints += data[k + 5];
+      }
+
+      // if there were neighbors to merge, and there are enough points to
+      // form a cluster
+      if (numPoints > numPointsOrigin && numPoints >= minPoints) {
+        var wx = x * numPointsOrigin;
+        var wy = y * numPointsOrigin;
+
+        Map<String, dynamic>? clusterProperties;
+        var clusterPropertiesIndex = -1;
+
+        // encode both zoom and point index on which the cluster originated,
+        // offset by the total length of the features
+        final id = ((i ~/ stride) << 5) + (zoom + 1) + _points.length;
+
+        for (final neighborId in neighborIds) {
+          final k = neighborId * stride;
+
+          if (data[k + 2] <= zoom) continue;
+          // save the zoom (so it doesn't get processed twice)
+          data[k + 2] = zoom.toDouble();
+
+          final numPoints2 = data[k + 5];
+          // accumulate coordinates for calculating weighted center
+          wx += data[k] * numPoints2;
+          wy += data[k + 1] * numPoints2;
+
+          data[k + 4] = id.toDouble();
+
+          if (reduce != null) {
+            if (clusterProperties == null) {
+              clusterProperties = _mapProperties(data, i, true);
+              clusterPropertiesIndex = _clusterProperties.length;
+              _clusterProperties.add(clusterProperties);
+            }
+            reduce!(clusterProperties, _mapProperties(data, k, false));
+          }
+        }
+
+        data[i + 4] = id.toDouble();
+        nextData
+          ..add(wx / numPoints)
+          ..add(wy / numPoints)
+          ..add(double.infinity)
+          ..add(id.toDouble())
+          ..add(-1)
+          ..add(numPoints);
+        if (reduce != null) {
+          nextData.add(clusterPropertiesIndex.toDouble());
+        }
+      } else {
+        // left points as unclustered
+        for (var j = 0; j < stride; j++) {
+          nextData.add(data[i + j]);
+        }
+
+        if (numPoints > 1) {
+          for (final neighborId in neighborIds) {
+            final k = neighborId * stride;
+            if (data[k + 2] <= zoom) continue;
+            data[k + 2] = zoom.toDouble();
+            for (var j = 0; j < stride; j++) {
+              nextData.add(data[k + j]);
+            }
+          }
+        }
+      }
+    }
+
+    return nextData;
+  }
+
+  Map<String, dynamic> _mapProperties(List<double> data, int i, bool clone) {
+    if (data[i + 5] > 1) {
+      final properties = _clusterProperties[data[i + 6].toInt()];
+      return clone ? {...properties} : properties;
+    }
+    final original = (_points[data[i + 3].toInt()]['properties'] as Map?)
+            ?.cast<String, dynamic>() ??
+        <String, dynamic>{};
+    final mapped = map != null ? map!(original) : original;
+    return clone && identical(mapped, original) ? {...mapped} : mapped;
+  }
+
+  Map<String, dynamic> _toFeature(List<double> data, int k) {
+    if (data[k + 5] <= 1) {
+      return _points[data[k + 3].toInt()];
+    }
+
+    final count = data[k + 5].toInt();
+    final clusterId = data[k + 3].toInt();
+    final propertiesIndex = reduce != null ? data[k + 6].toInt() : -1;
+    return {
+      'type': 'Feature',
+      'id': clusterId,
+      'properties': {
+        if (propertiesIndex >= 0) ..._clusterProperties[propertiesIndex],
+        'cluster': true,
+        'cluster_id': clusterId,
+        'point_count': count,
+        'point_count_abbreviated': count >= 10000
+            ? '${(count / 1000).round()}k'
+            : count >= 1000
+                ? '${(count / 100).round() / 10}k'
+                : count,
+      },
+      'geometry': {
+        'type': 'Point',
+        'coordinates': [_xLng(data[k]), _yLat(data[k + 1])],
+      },
+    };
+  }
+
+  int _limitZoom(int zoom) => max(minZoom, min(zoom, maxZoom + 1));
+
+  int _originId(int clusterId) => (clusterId - _points.length) >> 5;
+
+  int _originZoom(int clusterId) => (clusterId - _points.length) % 32;
+
+  static double _lngX(double lng) => lng / 360 + 0.5;
+
+  static double _latY(double lat) {
+    final sinLat = sin(lat * pi / 180);
+    final y = 0.5 - 0.25 * log((1 + sinLat) / (1 - sinLat)) / pi;
+    return y < 0
+        ? 0
+        : y > 1
+            ? 1
+            : y;
+  }
+
+  static double _xLng(double x) => (x - 0.5) * 360;
+
+  static double _yLat(double y) {
+    final y2 = (180 - y * 360) * pi / 180;
+    return 360 * atan(exp(y2)) / pi - 90;
+  }
+}
+
+/// A static KD-tree over 2D points, sorted in place once all points are
+/// added. [data] is the flat point data of the cluster level the tree was
+/// built from.
+class _KDBush {
+  final int nodeSize;
+  final List<double> data;
+  final List<int> _ids;
+  final Float64List _coords;
+  var _pos = 0;
+
+  _KDBush(int numItems, this.nodeSize, this.data)
+      : _ids = List<int>.filled(numItems, 0),
+        _coords = Float64List(numItems * 2);
+
+  void add(double x, double y) {
+    final index = _pos >> 1;
+    _ids[index] = index;
+    _coords[_pos++] = x;
+    _coords[_pos++] = y;
+  }
+
+  void finish() {
+    _sort(0, _ids.length - 1, 0);
+  }
+
+  /// Returns the ids of the points inside the bounding box.
+  List<int> range(double minX, double minY, double maxX, double maxY) {
+    final stack = [0, _ids.length - 1, 0];
+    final result = <int>[];
+
+    while (stack.isNotEmpty) {
+      final axis = stack.removeLast();
+      final right = stack.removeLast();
+      final left = stack.removeLast();
+
+      // search linearly in small nodes
+      if (right - left <= nodeSize) {
+        for (var i = left; i <= right; i++) {
+          final x = _coords[2 * i];
+          final y = _coords[2 * i + 1];
+          if (x >= minX && x <= maxX && y >= minY && y <= maxY) {
+            result.add(_ids[i]);
+          }
+        }
+        continue;
+      }
+
+      final m = (left + right) >> 1;
+      final x = _coords[2 * m];
+      final y = _coords[2 * m + 1];
+      if (x >= minX && x <= maxX && y >= minY && y <= maxY) {
+        result.add(_ids[m]);
+      }
+
+      if (axis == 0 ? minX <= x : minY <= y) {
+        stack
+          ..add(left)
+          ..add(m - 1)
+          ..add(1 - axis);
+      }
+      if (axis == 0 ? maxX >= x : maxY >= y) {
+        stack
+          ..add(m + 1)
+          ..add(right)
+          ..add(1 - axis);
+      }
+    }
+    return result;
+  }
+
+  /// Returns the ids of the points within radius [r] of ([qx], [qy]).
+  List<int> within(double qx, double qy, double r) {
+    final stack = [0, _ids.length - 1, 0];
+    final result = <int>[];
+    final r2 = r * r;
+
+    while (stack.isNotEmpty) {
+      final axis = stack.removeLast();
+      final right = stack.removeLast();
+      final left = stack.removeLast();
+
+      if (right - left <= nodeSize) {
+        for (var i = left; i <= right; i++) {
+          if (_sqDist(_coords[2 * i], _coords[2 * i + 1], qx, qy) <= r2) {
+            result.add(_ids[i]);
+          }
+        }
+        continue;
+      }
+
+      final m = (left + right) >> 1;
+      final x = _coords[2 * m];
+      final y = _coords[2 * m + 1];
+      if (_sqDist(x, y, qx, qy) <= r2) result.add(_ids[m]);
+
+      if (axis == 0 ? qx - r <= x : qy - r <= y) {
+        stack
+          ..add(left)
+          ..add(m - 1)
+          ..add(1 - axis);
+      }
+      if (axis == 0 ? qx + r >= x : qy + r >= y) {
+        stack
+          ..add(m + 1)
+          ..add(right)
+          ..add(1 - axis);
+      }
+    }
+    return result;
+  }
+
+  void _sort(int left, int right, int axis) {
+    if (right - left <= nodeSize) return;
+
+    final m = (left + right) >> 1;
+    // sort ids and coords around the middle index so that the halves lie
+    // either left/right or top/bottom correspondingly (taking turns)
+    _select(m, left, right, axis);
+    _sort(left, m - 1, 1 - axis);
+    _sort(m + 1, right, 1 - axis);
+  }
+
+  /// Floyd-Rivest selection: rearranges the items so that the k-th smallest
+  /// coordinate on [axis] is at index [k].
+  void _select(int k, int left, int right, int axis) {
+    while (right > left) {
+      if (right - left > 600) {
+        final n = right - left + 1;
+        final m = k - left + 1;
+        final z = log(n);
+        final s = 0.5 * exp(2 * z / 3);
+        final sd = 0.5 * sqrt(z * s * (n - s) / n) * (m - n / 2 < 0 ? -1 : 1);
+        final newLeft = max(left, (k - m * s / n + sd).floor());
+        final newRight = min(right, (k + (n - m) * s / n + sd).floor());
+        _select(k, newLeft, newRight, axis);
+      }
+
+      final t = _coords[2 * k + axis];
+      var i = left;
+      var j = right;
+
+      _swap(left, k);
+      if (_coords[2 * right + axis] > t) _swap(left, right);
+
+      while (i < j) {
+        _swap(i, j);
+        i++;
+        j--;
+        while (_coords[2 * i + axis] < t) {
+          i++;
+        }
+        while (_coords[2 * j + axis] > t) {
+          j--;
+        }
+      }
+
+      if (_coords[2 * left + axis] == t) {
+        _swap(left, j);
+      } else {
+        j++;
+        _swap(j, right);
+      }
+
+      if (j <= k) left = j + 1;
+      if (k <= j) right = j - 1;
+    }
+  }
+
+  void _swap(int i, int j) {
+    final id = _ids[i];
+    _ids[i] = _ids[j];
+    _ids[j] = id;
+
+    final x = _coords[2 * i];
+    final y = _coords[2 * i + 1];
+    _coords[2 * i] = _coords[2 * j];
+    _coords[2 * i + 1] = _coords[2 * j + 1];
+    _coords[2 * j] = x;
+    _coords[2 * j + 1] = y;
+  }
+
+  static double _sqDist(double ax, double ay, double bx, double by) {
+    final dx = ax - bx;
+    final dy = ay - by;
+    return dx * dx + dy * dy;
+  }
+}
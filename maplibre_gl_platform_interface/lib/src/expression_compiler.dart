@@ -0,0 +1,890 @@
+part of '../maplibre_gl_platform_interface.dart';
+
+/// Style specification metadata of a single layer property, generated from
+/// `scripts/input/style.json` into `layer_property_spec.dart`.
+@immutable
+class _LayerPropertySpec {
+  const _LayerPropertySpec({
+    required this.type,
+    this.arrayValueType,
+    this.arrayLength,
+    this.values,
+    this.minimum,
+    this.maximum,
+    required this.supportsExpression,
+    this.parameters = const {},
+    required this.isInterpolated,
+  });
+
+  final String type;
+  final String? arrayValueType;
+  final int? arrayLength;
+  final Set<String>? values;
+  final num? minimum;
+  final num? maximum;
+  final bool supportsExpression;
+  final Set<String> parameters;
+  final bool isInterpolated;
+}
+
+/// A layer property value that does not match the style specification.
+@immutable
+class ExpressionValidationError {
+  const ExpressionValidationError(this.property, this.path, this.message);
+
+  /// Name of the layer property, e.g. `circle-radius`.
+  final String property;
+
+  /// Indices leading from the property value to the offending sub
+  /// expression, empty if the property value itself is invalid.
+  final List<int> path;
+
+  final String message;
+
+  @override
+  String toString() => path.isEmpty
+      ? 'ExpressionValidationError($property: $message)'
+      : 'ExpressionValidationError($property$path: $message)';
+}
+
+/// Thrown by [ExpressionCompiler.compileLayerProperties] if at least one
+/// property is invalid.
+class ExpressionValidationException implements Exception {
+  const ExpressionValidationException(this.errors);
+
+  final List<ExpressionValidationError> errors;
+
+  @override
+  String toString() => 'ExpressionValidationException($errors)';
+}
+
+/// Validates layer property values against the style specification and
+/// folds constant sub expressions before they are sent to the platform.
+///
+/// The renderer evaluates expressions per feature and frame. Parts that do not
+/// depend on the feature, the zoom level or any other runtime input are
+/// evaluated once in Dart instead: arithmetic on literals is computed, `case`
+/// and `match` branches that can never be taken are dropped, and `step` or
+/// `interpolate` over a constant input or over identical outputs is replaced
+/// by its result.
+///
+/// Using the compiler is optional, values that are not expressions are passed
+/// through unchanged.
+class ExpressionCompiler {
+  const ExpressionCompiler();
+
+  /// Validates [properties] of a layer of [layerType] (e.g. `fill-extrusion`)
+  /// and returns them with all expressions folded.
+  ///
+  /// Throws an [ExpressionValidationException] if any property is invalid.
+  Map<String, dynamic> compileLayerProperties(
+      String layerType, Map<String, dynamic> properties) {
+    final errors = validateLayerProperties(layerType, properties);
+    if (errors.isNotEmpty) {
+      throw ExpressionValidationException(errors);
+    }
+    return properties.map((key, value) => MapEntry(key, fold(value)));
+  }
+
+  /// Returns a simplified expression that evaluates to the same result as
+  /// [expression] for every feature and zoom level.
+  dynamic fold(dynamic expression) {
+    if (!_isExpression(expression)) {
+      return expression;
+    }
+    final result = _evaluate(expression, const _Scope.unknown());
+    return result is _Value ? result.value : result;
+  }
+
+  /// Checks [properties] of a layer of [layerType] against the style
+  /// specification, returns an empty list if all of them are valid.
+  List<ExpressionValidationError> validateLayerProperties(
+      String layerType, Map<String, dynamic> properties) {
+    final specs = _layerPropertySpecs[layerType];
+    if (specs == null) {
+      throw ArgumentError.value(layerType, 'layerType', 'Unknown layer type');
+    }
+
+    final errors = <ExpressionValidationError>[];
+    for (final entry in properties.entries) {
+      final spec = specs[entry.key];
+      if (spec == null) {
+        errors.add(ExpressionValidationError(
+            entry.key, const [], 'Unknown property of $layerType layers'));
+      } else if (entry.value != null) {
+        _validateProperty(entry.key, spec, entry.value, errors);
+      }
+    }
+    return errors;
+  }
+
+  /// Evaluates [expression] for a single feature, used to verify folding.
+  ///
+  /// Only the operators which [fold] is able to compute are supported, an
+  /// [UnsupportedError] is thrown for all others.
+  @visibleForTesting
+  dynamic evaluate(
+    dynamic expression, {
+    num? zoom,
+    Map<String, dynamic> properties = const {},
+    Map<String, dynamic> featureState = const {},
+    Object? id,
+    String? geometryType,
+  }) {
+    if (!_isExpression(expression)) {
+      return expression;
+    }
+    final result = _evaluate(
+        expression,
+        _Scope(
+          zoom: zoom,
+          properties: properties,
+          featureState: featureState,
+          id: id,
+          geometryType: geometryType,
+        ));
+    if (result is! _Value) {
+      throw UnsupportedError('Cannot evaluate $result');
+    }
+    return result.value;
+  }
+
+  void _validateProperty(String property, _LayerPropertySpec spec,
+      dynamic value, List<ExpressionValidationError> errors) {
+    if (!_isExpression(value)) {
+      _validateConstant(property, spec, value, errors);
+      return;
+    }
+
+    final errorCount = errors.length;
+    _validateExpression(property, spec, value as List, const [], errors);
+    if (errors.length != errorCount) {
+      return;
+    }
+
+    final folded = _evaluate(value, const _Scope.unknown());
+    if (folded is _Value) {
+      _validateConstant(property, spec, folded.value, errors);
+    } else if (!spec.supportsExpression) {
+      errors.add(ExpressionValidationError(
+          property, const [], 'Property does not support expressions'));
+    }
+  }
+
+  void _validateConstant(String property, _LayerPropertySpec spec,
+      dynamic value, List<ExpressionValidationError> errors) {
+    void fail(String message) =>
+        errors.add(ExpressionValidationError(property, const [], message));
+
+    switch (spec.type) {
+      case 'number':
+        if (value is! num) {
+          fail('Expected a number but found $value');
+        } else if (spec.minimum != null && value < spec.minimum!) {
+          fail('$value is smaller than the minimum ${spec.minimum}');
+        } else if (spec.maximum != null && value > spec.maximum!) {
+          fail('$value is larger than the maximum ${spec.maximum}');
+        }
+      case 'boolean':
+        if (value is! bool) {
+          fail('Expected a boolean but found $value');
+        }
+      case 'enum':
+        if (value is! String || !spec.values!.contains(value)) {
+          fail('Expected one of ${spec.values} but found $value');
+        }
+      case 'array':
+        if (value is! List) {
+          fail('Expected an array but found $value');
+        } else if (spec.arrayLength != null &&
+            value.length != spec.arrayLength) {
+          fail('Expected an array of length ${spec.arrayLength}');
+        } else if (!value.every((item) => switch (spec.arrayValueType) {
+              'number' => item is num,
+              'enum' => spec.values!.contains(item),
+              _ => item is String,
+            })) {
+          fail('Expected an array of ${spec.arrayValueType} but found $value');
+        }
+      default:
+        if (value is! String) {
+          fail('Expected a ${spec.type} but found $value');
+        }
+    }
+  }
+
+  void _validateExpression(
+      String property,
+      _LayerPropertySpec spec,
+      List expression,
+      List<int> path,
+      List<ExpressionValidationError> errors) {
+    void fail(String message) =>
+        errors.add(ExpressionValidationError(property, path, message));
+
+    final operator = expression.isEmpty ? null : expression.first;
+    if (operator is! String) {
+      fail('Array values must be wrapped in a "literal" expression');
+      return;
+    }
+    if (!_expressionOperators.contains(operator)) {
+      fail('Unknown expression operator "$operator"');
+      return;
+    }
+
+    final parameter = _runtimeParameters[operator];
+    if (parameter != null && !spec.parameters.contains(parameter)) {
+      fail('"$operator" can not be used with $property');
+    }
+
+    final argumentCount = expression.length - 1;
+    final arityError = switch (operator) {
+      'literal' when argumentCount != 1 => 'Expected exactly one argument',
+      'case' when argumentCount < 3 || argumentCount.isEven =>
+        'Expected pairs of condition and output followed by a fallback',
+      'match' when argumentCount < 4 || argumentCount.isOdd =>
+        'Expected an input, pairs of label and output and a fallback',
+      'step' when argumentCount < 2 || argumentCount.isOdd =>
+        'Expected an input, an output and pairs of stop and output',
+      'interpolate' ||
+      'interpolate-hcl' ||
+      'interpolate-lab' when argumentCount < 4 || argumentCount.isOdd =>
+        'Expected an interpolation type, an input and pairs of stop and output',
+      _ => null,
+    };
+    if (arityError != null) {
+      fail(arityError);
+      return;
+    }
+
+    for (var i = 1; i < expression.length; i++) {
+      final argument = expression[i];
+      final isLiteralArgument = switch (operator) {
+        'literal' => true,
+        'match' => i > 1 && i.isEven && i < expression.length - 1,
+        'interpolate' || 'interpolate-hcl' || 'interpolate-lab' => i == 1,
+        _ => false,
+      };
+      if (argument is List && !isLiteralArgument) {
+        _validateExpression(property, spec, argument, [...path, i], errors);
+      }
+    }
+  }
+
+  static bool _isExpression(dynamic value) =>
+      value is List &&
+      value.isNotEmpty &&
+      _expressionOperators.contains(value.first);
+
+  /// Evaluates [node] as far as the inputs known to [scope] allow. Returns a
+  /// [_Value] if the result is constant, otherwise the remaining expression.
+  Object? _evaluate(dynamic node, _Scope scope) {
+    if (node is List) {
+      if (!_isExpression(node)) {
+        return node;
+      }
+      return _evaluateExpression(node.first as String, node.sublist(1), scope);
+    } else if (node is Map) {
+      return node;
+    }
+    return _Value(node);
+  }
+
+  Object? _evaluateExpression(String operator, List args, _Scope scope) {
+    switch (operator) {
+      case 'literal':
+        return _Value(args.first);
+      case 'let':
+        return _evaluateLet(args, scope);
+      case 'var':
+        return scope.bindings[args.first] ?? [operator, ...args];
+      case 'case':
+        return _evaluateCase(args, scope);
+      case 'match':
+        return _evaluateMatch(args, scope);
+      case 'coalesce':
+        return _evaluateCoalesce(args, scope);
+      case 'step':
+        return _evaluateStep(args, scope);
+      case 'interpolate':
+      case 'interpolate-hcl':
+      case 'interpolate-lab':
+        return _evaluateInterpolate(operator, args, scope);
+      case 'all':
+      case 'any':
+        return _evaluateLogical(operator, args, scope);
+      case 'pi':
+        return const _Value(pi);
+      case 'e':
+        return const _Value(e);
+      case 'ln2':
+        return const _Value(ln2);
+    }
+
+    final evaluated = [for (final arg in args) _evaluate(arg, scope)];
+    if (_runtimeParameters.containsKey(operator)) {
+      final value = scope.lookup(operator, evaluated);
+      if (value != null) {
+        return value;
+      }
+    } else if (evaluated.every((arg) => arg is _Value)) {
+      final value = _apply(
+          operator, [for (final arg in evaluated) (arg as _Value).value]);
+      if (value != null) {
+        return value;
+      }
+    }
+    return [operator, for (final arg in evaluated) _emit(arg)];
+  }
+
+  Object? _evaluateLet(List args, _Scope scope) {
+    final bindings = Map.of(scope.bindings);
+    final residual = <dynamic>['let'];
+    for (var i = 0; i + 1 < args.length; i += 2) {
+      final value = _evaluate(args[i + 1], scope);
+      if (value is _Value) {
+        bindings[args[i] as String] = value;
+      } else {
+        // shadows a constant of an enclosing let
+        bindings.remove(args[i]);
+      }
+      residual
+        ..add(args[i])
+        ..add(_emit(value));
+    }
+    final body = _evaluate(args.last, scope.withBindings(bindings));
+    if (body is _Value) {
+      return body;
+    }
+    return residual..add(body);
+  }
+
+  Object? _evaluateCase(List args, _Scope scope) {
+    final residual = <dynamic>['case'];
+    final outputs = <Object?>[];
+    for (var i = 0; i + 1 < args.length; i += 2) {
+      final condition = _evaluate(args[i], scope);
+      if (condition is _Value && condition.value == false) {
+        continue;
+      }
+      final output = _evaluate(args[i + 1], scope);
+      if (condition is _Value && condition.value == true) {
+        if (outputs.isEmpty) {
+          return output;
+        }
+        // every later branch is unreachable, the output becomes the fallback
+        outputs.add(output);
+        return _sameConstant(outputs) ?? (residual..add(_emit(output)));
+      }
+      outputs.add(output);
+      residual
+        ..add(_emit(condition))
+        ..add(_emit(output));
+    }
+    final fallback = _evaluate(args.last, scope);
+    if (outputs.isEmpty) {
+      return fallback;
+    }
+    outputs.add(fallback);
+    return _sameConstant(outputs) ?? (residual..add(_emit(fallback)));
+  }
+
+  Object? _evaluateMatch(List args, _Scope scope) {
+    final input = _evaluate(args.first, scope);
+    if (input is _Value) {
+      for (var i = 1; i + 1 < args.length; i += 2) {
+        final label = args[i];
+        final matches = label is List
+            ? label.any((item) => item == input.value)
+            : label == input.value;
+        if (matches) {
+          return _evaluate(args[i + 1], scope);
+        }
+      }
+      return _evaluate(args.last, scope);
+    }
+
+    final residual = <dynamic>['match', _emit(input)];
+    final outputs = <Object?>[];
+    for (var i = 1; i + 1 < args.length; i += 2) {
+      final output = _evaluate(args[i + 1], scope);
+      outputs.add(output);
+      residual
+        ..add(args[i])
+        ..add(_emit(output));
+    }
+    final fallback = _evaluate(args.last, scope);
+    outputs.add(fallback);
+    return _sameConstant(outputs) ?? (residual..add(_emit(fallback)));
+  }
+
+  Object? _evaluateCoalesce(List args, _Scope scope) {
+    final residual = <dynamic>['coalesce'];
+    for (final arg in args) {
+      final value = _evaluate(arg, scope);
+      if (value is _Value) {
+        if (value.value == null) {
+          continue;
+        }
+        if (residual.length == 1) {
+          return value;
+        }
+        // later arguments are never reached
+        return residual..add(_emit(value));
+      }
+      residual.add(value);
+    }
+    return residual.length == 1 ? const _Value(null) : residual;
+  }
+
+  Object? _evaluateStep(List args, _Scope scope) {
+    final input = _evaluate(args.first, scope);
+    final stops = [
+      for (var i = 2; i < args.length; i += 2) _evaluate(args[i], scope)
+    ];
+    if (input is _Value &&
+        input.value is num &&
+        stops.every((stop) => stop is _Value && stop.value is num)) {
+      var output = args[1];
+      for (var i = 0; i < stops.length; i++) {
+        if ((input.value as num) < ((stops[i] as _Value).value as num)) {
+          break;
+        }
+        output = args[2 * i + 3];
+      }
+      return _evaluate(output, scope);
+    }
+
+    final outputs = [
+      for (var i = 1; i < args.length; i += 2) _evaluate(args[i], scope)
+    ];
+    return _sameConstant(outputs) ??
+        [
+          'step',
+          _emit(input),
+          _emit(outputs.first),
+          for (var i = 0; i < stops.length; i++) ...[
+            _emit(stops[i]),
+            _emit(outputs[i + 1]),
+          ],
+        ];
+  }
+
+  Object? _evaluateInterpolate(String operator, List args, _Scope scope) {
+    final type = args.first;
+    final input = _evaluate(args[1], scope);
+    final stops = [
+      for (var i = 2; i < args.length; i += 2) _evaluate(args[i], scope)
+    ];
+    final outputs = [
+      for (var i = 3; i < args.length; i += 2) _evaluate(args[i], scope)
+    ];
+
+    final same = _sameConstant(outputs);
+    if (same != null) {
+      return same;
+    }
+
+    if (input is _Value &&
+        input.value is num &&
+        stops.every((stop) => stop is _Value && stop.value is num)) {
+      final x = input.value as num;
+      final stopValues = [
+        for (final stop in stops) (stop as _Value).value as num,
+      ];
+      if (x <= stopValues.first) {
+        return outputs.first;
+      }
+      if (x >= stopValues.last) {
+        return outputs.last;
+      }
+      final index = stopValues.lastIndexWhere((stop) => stop <= x);
+      final lower = outputs[index];
+      final upper = outputs[index + 1];
+      final t = _interpolationFactor(
+          type, x, stopValues[index], stopValues[index + 1]);
+      if (operator == 'interpolate' &&
+          t != null &&
+          lower is _Value &&
+          upper is _Value) {
+        final value = _interpolateValue(lower.value, upper.value, t);
+        if (value != null) {
+          return _Value(value);
+        }
+      }
+    }
+
+    return [
+      operator,
+      type,
+      _emit(input),
+      for (var i = 0; i < stops.length; i++) ...[
+        _emit(stops[i]),
+        _emit(outputs[i]),
+      ],
+    ];
+  }
+
+  Object? _evaluateLogical(String operator, List args, _Scope scope) {
+    // `all` is decided by the first false argument, `any` by the first true
+    final decisive = operator == 'any';
+    final residual = <dynamic>[operator];
+    for (final arg in args) {
+      final value = _evaluate(arg, scope);
+      if (value is _Value && value.value is bool) {
+        if (value.value == decisive) {
+          return _Value(decisive);
+        }
+        continue;
+      }
+      residual.add(_emit(value));
+    }
+    return residual.length == 1 ? _Value(!decisive) : residual;
+  }
+
+  static double? _interpolationFactor(
+      dynamic type, num x, num lower, num upper) {
+    if (type is! List || type.isEmpty) {
+      return null;
+    }
+    final range = upper - lower;
+    final progress = x - lower;
+    if (range == 0) {
+      return 0;
+    }
+    switch (type.first) {
+      case 'linear':
+        return progress / range;
+      case 'exponential':
+        final base = type.length > 1 ? type[1] : null;
+        if (base is! num) {
+          return null;
+        }
+        if (base == 1) {
+          return progress / range;
+        }
+        return (pow(base, progress) - 1) / (pow(base, range) - 1);
+      default:
+        return null;
+    }
+  }
+
+  static Object? _interpolateValue(Object? lower, Object? upper, double t) {
+    if (lower is num && upper is num) {
+      return lower + (upper - lower) * t;
+    }
+    if (lower is List &&
+        upper is List &&
+        lower.length == upper.length &&
+        lower.every((item) => item is num) &&
+        upper.every((item) => item is num)) {
+      return [
+        for (var i = 0; i < lower.length; i++)
+          (lower[i] as num) + ((upper[i] as num) - (lower[i] as num)) * t
+      ];
+    }
+    return null;
+  }
+
+  /// Returns the common value if all [results] are the same constant.
+  static _Value? _sameConstant(List<Object?> results) {
+    final first = results.first;
+    if (first is! _Value) {
+      return null;
+    }
+    for (final result in results.skip(1)) {
+      if (result is! _Value || !_deepEquals(result.value, first.value)) {
+        return null;
+      }
+    }
+    return first;
+  }
+
+  static _Value? _apply(String operator, List<Object?> args) {
+    num number(int i) => args[i] as num;
+    final numeric = args.every((arg) => arg is num);
+    final unary = args.length == 1;
+
+    switch (operator) {
+      case '+' when numeric:
+        return _number(args.fold<num>(0, (sum, arg) => sum + (arg as num)));
+      case '*' when numeric:
+        return _number(
+            args.fold<num>(1, (product, arg) => product * (arg as num)));
+      case '-' when numeric && args.length == 1:
+        return _number(-number(0));
+      case '-' when numeric && args.length == 2:
+        return _number(number(0) - number(1));
+      case '/' when numeric && args.length == 2:
+        return _number(number(0) / number(1));
+      case '%' when numeric && args.length == 2:
+        return _number(number(0).remainder(number(1)));
+      case '^' when numeric && args.length == 2:
+        return _number(pow(number(0), number(1)));
+      case 'min' when numeric && args.isNotEmpty:
+        return _number(args.cast<num>().reduce(min));
+      case 'max' when numeric && args.isNotEmpty:
+        return _number(args.cast<num>().reduce(max));
+      case 'sqrt' when numeric && unary:
+        return _number(sqrt(number(0)));
+      case 'ln' when numeric && unary:
+        return _number(log(number(0)));
+      case 'log10' when numeric && unary:
+        return _number(log(number(0)) / ln10);
+      case 'log2' when numeric && unary:
+        return _number(log(number(0)) / ln2);
+      case 'sin' when numeric && unary:
+        return _number(sin(number(0)));
+      case 'cos' when numeric && unary:
+        return _number(cos(number(0)));
+      case 'tan' when numeric && unary:
+        return _number(tan(number(0)));
+      case 'asin' when numeric && unary:
+        return _number(asin(number(0)));
+      case 'acos' when numeric && unary:
+        return _number(acos(number(0)));
+      case 'atan' when numeric && unary:
+        return _number(atan(number(0)));
+      case 'abs' when numeric && unary:
+        return _number(number(0).abs());
+      case 'ceil' when numeric && unary:
+        return _number(number(0).ceil());
+      case 'floor' when numeric && unary:
+        return _number(number(0).floor());
+      case 'round' when numeric && unary:
+        // like the style specification, halfway values round away from zero
+        return _number(number(0).round());
+      case '==' when args.length == 2:
+        return _Value(_deepEquals(args[0], args[1]));
+      case '!=' when args.length == 2:
+        return _Value(!_deepEquals(args[0], args[1]));
+      case '<' || '<=' || '>' || '>=' when args.length == 2:
+        final a = args[0];
+        final b = args[1];
+        final int comparison;
+        if (a is num && b is num) {
+          comparison = a.compareTo(b);
+        } else if (a is String && b is String) {
+          comparison = a.compareTo(b);
+        } else {
+          return null;
+        }
+        return _Value(switch (operator) {
+          '<' => comparison < 0,
+          '<=' => comparison <= 0,
+          '>' => comparison > 0,
+          _ => comparison >= 0,
+        });
+      case '!' when unary && args.single is bool:
+        return _Value(!(args.single as bool));
+      case 'concat':
+        return _Value(args.map(_toStringValue).join());
+      case 'upcase' when unary && args.single is String:
+        return _Value((args.single as String).toUpperCase());
+      case 'downcase' when unary && args.single is String:
+        return _Value((args.single as String).toLowerCase());
+      case 'length' when unary:
+        final value = args.single;
+        if (value is String) {
+          return _Value(value.length);
+        } else if (value is List) {
+          return _Value(value.length);
+        }
+        return null;
+      case 'in' when args.length == 2:
+        final needle = args[0];
+        final haystack = args[1];
+        if (haystack is String && needle is String) {
+          return _Value(haystack.contains(needle));
+        } else if (haystack is List) {
+          return _Value(haystack.any((item) => _deepEquals(item, needle)));
+        }
+        return null;
+      case 'at' when args.length == 2:
+        final index = args[0];
+        final array = args[1];
+        if (index is int &&
+            array is List &&
+            index >= 0 &&
+            index < array.length) {
+          return _Value(array[index]);
+        }
+        return null;
+      case 'to-string' when unary:
+        final value = args.single;
+        if (value is String || value is num || value is bool || value == null) {
+          return _Value(_toStringValue(value));
+        }
+        return null;
+      case 'to-boolean' when unary:
+        final value = args.single;
+        return _Value(!(value == null ||
+            value == false ||
+            value == '' ||
+            value == 0 ||
+            (value is double && value.isNaN)));
+      case 'to-number':
+        for (final value in args) {
+          if (value is num) {
+            return _Value(value);
+          } else if (value is bool) {
+            return _Value(value ? 1 : 0);
+          } else if (value == null) {
+            return const _Value(0);
+          } else if (value is String) {
+            final parsed = num.tryParse(value);
+            if (parsed != null) {
+              return _Value(parsed);
+            }
+          }
+        }
+        return null;
+      case 'number' when unary && args.single is num:
+      case 'string' when unary && args.single is String:
+      case 'boolean' when unary && args.single is bool:
+        return _Value(args.single);
+      default:
+        return null;
+    }
+  }
+
+  /// Wraps finite numbers, anything else can not be sent as JSON.
+  static _Value? _number(num value) => value.isFinite ? _Value(value) : null;
+
+  static String _toStringValue(Object? value) {
+    if (value == null) {
+      return '';
+    } else if (value is double && value == value.truncateToDouble()) {
+      return value.toInt().toString();
+    } else if (value is String || value is num || value is bool) {
+      return value.toString();
+    }
+    return jsonEncode(value);
+  }
+
+  static bool _deepEquals(Object? a, Object? b) {
+    if (a is List && b is List) {
+      if (a.length != b.length) {
+        return false;
+      }
+      for (var i = 0; i < a.length; i++) {
+        if (!_deepEquals(a[i], b[i])) {
+          return false;
+        }
+      }
+      return true;
+    }
+    if (a is Map && b is Map) {
+      return a.length == b.length &&
+          a.keys.every(
+              (key) => b.containsKey(key) && _deepEquals(a[key], b[key]));
+    }
+    return a == b;
+  }
+
+  /// Turns an evaluation result back into an expression argument.
+  static dynamic _emit(Object? result) {
+    if (result is _Value) {
+      final value = result.value;
+      return value is List || value is Map ? ['literal', value] : value;
+    }
+    return result;
+  }
+}
+
+/// Operators that read runtime inputs, mapped to the expression parameter of
+/// the style specification that has to be supported by a property to use it.
+const _runtimeParameters = {
+  'zoom': 'zoom',
+  'get': 'feature',
+  'has': 'feature',
+  'properties': 'feature',
+  'geometry-type': 'feature',
+  'id': 'feature',
+  'accumulated': 'feature',
+  'feature-state': 'feature-state',
+  'heatmap-density': 'heatmap-density',
+  'line-progress': 'line-progress',
+};
+
+/// A constant result of an evaluation.
+@immutable
+class _Value {
+  const _Value(this.value);
+
+  final Object? value;
+}
+
+/// The runtime inputs available while evaluating an expression. When folding
+/// none of them are known.
+class _Scope {
+  const _Scope({
+    this.zoom,
+    this.properties = const {},
+    this.featureState = const {},
+    this.id,
+    this.geometryType,
+  })  : isFeatureKnown = true,
+        bindings = const {};
+
+  const _Scope.unknown()
+      : zoom = null,
+        properties = const {},
+        featureState = const {},
+        id = null,
+        geometryType = null,
+        isFeatureKnown = false,
+        bindings = const {};
+
+  const _Scope._withBindings(_Scope scope, this.bindings)
+      : zoom = scope.zoom,
+        properties = scope.properties,
+        featureState = scope.featureState,
+        id = scope.id,
+        geometryType = scope.geometryType,
+        isFeatureKnown = scope.isFeatureKnown;
+
+  final num? zoom;
+  final Map<String, dynamic> properties;
+  final Map<String, dynamic> featureState;
+  final Object? id;
+  final String? geometryType;
+  final bool isFeatureKnown;
+
+  /// Constant values of the variables bound by enclosing `let` expressions.
+  final Map<String, _Value> bindings;
+
+  _Scope withBindings(Map<String, _Value> bindings) =>
+      _Scope._withBindings(this, bindings);
+
+  /// Resolves a runtime input operator, returns null if it is not known.
+  _Value? lookup(String operator, List<Object?> args) {
+    if (operator == 'zoom') {
+      return zoom == null ? null : _Value(zoom);
+    }
+    if (!isFeatureKnown || !args.every((arg) => arg is _Value)) {
+      return null;
+    }
+    final values = [for (final arg in args) (arg as _Value).value];
+    switch (operator) {
+      case 'get' when values.length == 1:
+        return _Value(properties[values.first]);
+      case 'get' when values.length == 2 && values[1] is Map:
+        return _Value((values[1] as Map)[values.first]);
+      case 'has' when values.length == 1:
+        return _Value(properties.containsKey(values.first));
+      case 'has' when values.length == 2 && values[1] is Map:
+        return _Value((values[1] as Map).containsKey(values.first));
+      case 'properties':
+        return _Value(properties);
+      case 'feature-state' when values.length == 1:
+        return _Value(featureState[values.first]);
+      case 'id':
+        return _Value(id);
+      case 'geometry-type':
+        return _Value(geometryType);
+      default:
+        return null;
+    }
+  }
+}
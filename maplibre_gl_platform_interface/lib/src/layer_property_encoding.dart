@@ -0,0 +1,27 @@
+part of '../maplibre_gl_platform_interface.dart';
+
+/// Encodes layer properties for the method channel.
+///
+/// Literal values are passed in their native message codec representation so
+/// that the platform converters can use them without parsing JSON: numbers,
+/// booleans and strings (including colors) are sent as they are, lists of
+/// numbers are packed into a [Float64List]. Any other list or map is an
+/// expression and is sent as a nested structure which the platform converts
+/// into its expression type. Properties with a `null` value are omitted.
+Map<String, Object> encodeLayerProperties(Map<String, dynamic> properties) {
+  final encoded = <String, Object>{};
+  for (final entry in properties.entries) {
+    final value = _encodeLayerPropertyValue(entry.value);
+    if (value != null) {
+      encoded[entry.key] = value;
+    }
+  }
+  return encoded;
+}
+
+Object? _encodeLayerPropertyValue(dynamic value) {
+  if (value is List && value.isNotEmpty && value.every((e) => e is num)) {
+    return Float64List.fromList([for (final e in value) (e as num).toDouble()]);
+  }
+  return value;
+}
@@ -0,0 +1,1415 @@
+// This file is generated by
+// ./scripts/lib/generate.dart
+
+part of '../maplibre_gl_platform_interface.dart';
+
+const _expressionOperators = <String>{
+  "let",
+  "var",
+  "literal",
+  "array",
+  "at",
+  "in",
+  "case",
+  "match",
+  "coalesce",
+  "step",
+  "interpolate",
+  "interpolate-hcl",
+  "interpolate-lab",
+  "ln2",
+  "pi",
+  "e",
+  "typeof",
+  "string",
+  "number",
+  "boolean",
+  "object",
+  "collator",
+  "format",
+  "image",
+  "number-format",
+  "to-string",
+  "to-number",
+  "to-boolean",
+  "to-rgba",
+  "to-color",
+  "rgb",
+  "rgba",
+  "get",
+  "has",
+  "length",
+  "properties",
+  "feature-state",
+  "geometry-type",
+  "id",
+  "zoom",
+  "heatmap-density",
+  "line-progress",
+  "accumulated",
+  "+",
+  "*",
+  "-",
+  "/",
+  "%",
+  "^",
+  "sqrt",
+  "log10",
+  "ln",
+  "log2",
+  "sin",
+  "cos",
+  "tan",
+  "asin",
+  "acos",
+  "atan",
+  "min",
+  "max",
+  "round",
+  "abs",
+  "ceil",
+  "floor",
+  "==",
+  "!=",
+  ">",
+  "<",
+  ">=",
+  "<=",
+  "all",
+  "any",
+  "!",
+  "is-supported-script",
+  "upcase",
+  "downcase",
+  "concat",
+  "resolved-locale",
+};
+
+const _layerPropertySpecs = <String, Map<String, _LayerPropertySpec>>{
+  "symbol": {
+    "icon-opacity": _LayerPropertySpec(
+      type: "number",
+      minimum: 0,
+      maximum: 1,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+        "feature-state",
+      },
+      isInterpolated: true,
+    ),
+    "icon-color": _LayerPropertySpec(
+      type: "color",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+        "feature-state",
+      },
+      isInterpolated: true,
+    ),
+    "icon-halo-color": _LayerPropertySpec(
+      type: "color",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+        "feature-state",
+      },
+      isInterpolated: true,
+    ),
+    "icon-halo-width": _LayerPropertySpec(
+      type: "number",
+      minimum: 0,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+        "feature-state",
+      },
+      isInterpolated: true,
+    ),
+    "icon-halo-blur": _LayerPropertySpec(
+      type: "number",
+      minimum: 0,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+        "feature-state",
+      },
+      isInterpolated: true,
+    ),
+    "icon-translate": _LayerPropertySpec(
+      type: "array",
+      arrayValueType: "number",
+      arrayLength: 2,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: true,
+    ),
+    "icon-translate-anchor": _LayerPropertySpec(
+      type: "enum",
+      values: {
+        "map",
+        "viewport",
+      },
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: false,
+    ),
+    "text-opacity": _LayerPropertySpec(
+      type: "number",
+      minimum: 0,
+      maximum: 1,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+        "feature-state",
+      },
+      isInterpolated: true,
+    ),
+    "text-color": _LayerPropertySpec(
+      type: "color",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+        "feature-state",
+      },
+      isInterpolated: true,
+    ),
+    "text-halo-color": _LayerPropertySpec(
+      type: "color",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+        "feature-state",
+      },
+      isInterpolated: true,
+    ),
+    "text-halo-width": _LayerPropertySpec(
+      type: "number",
+      minimum: 0,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+        "feature-state",
+      },
+      isInterpolated: true,
+    ),
+    "text-halo-blur": _LayerPropertySpec(
+      type: "number",
+      minimum: 0,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+        "feature-state",
+      },
+      isInterpolated: true,
+    ),
+    "text-translate": _LayerPropertySpec(
+      type: "array",
+      arrayValueType: "number",
+      arrayLength: 2,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: true,
+    ),
+    "text-translate-anchor": _LayerPropertySpec(
+      type: "enum",
+      values: {
+        "map",
+        "viewport",
+      },
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: false,
+    ),
+    "symbol-placement": _LayerPropertySpec(
+      type: "enum",
+      values: {
+        "point",
+        "line",
+        "line-center",
+      },
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: false,
+    ),
+    "symbol-spacing": _LayerPropertySpec(
+      type: "number",
+      minimum: 1,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: true,
+    ),
+    "symbol-avoid-edges": _LayerPropertySpec(
+      type: "boolean",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: false,
+    ),
+    "symbol-sort-key": _LayerPropertySpec(
+      type: "number",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+      },
+      isInterpolated: false,
+    ),
+    "symbol-z-order": _LayerPropertySpec(
+      type: "enum",
+      values: {
+        "auto",
+        "viewport-y",
+        "source",
+      },
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: false,
+    ),
+    "icon-allow-overlap": _LayerPropertySpec(
+      type: "boolean",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: false,
+    ),
+    "icon-ignore-placement": _LayerPropertySpec(
+      type: "boolean",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: false,
+    ),
+    "icon-optional": _LayerPropertySpec(
+      type: "boolean",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: false,
+    ),
+    "icon-rotation-alignment": _LayerPropertySpec(
+      type: "enum",
+      values: {
+        "map",
+        "viewport",
+        "auto",
+      },
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: false,
+    ),
+    "icon-size": _LayerPropertySpec(
+      type: "number",
+      minimum: 0,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+      },
+      isInterpolated: true,
+    ),
+    "icon-text-fit": _LayerPropertySpec(
+      type: "enum",
+      values: {
+        "none",
+        "width",
+        "height",
+        "both",
+      },
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: false,
+    ),
+    "icon-text-fit-padding": _LayerPropertySpec(
+      type: "array",
+      arrayValueType: "number",
+      arrayLength: 4,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: true,
+    ),
+    "icon-image": _LayerPropertySpec(
+      type: "resolvedImage",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+      },
+      isInterpolated: false,
+    ),
+    "icon-rotate": _LayerPropertySpec(
+      type: "number",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+      },
+      isInterpolated: true,
+    ),
+    "icon-padding": _LayerPropertySpec(
+      type: "number",
+      minimum: 0,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: true,
+    ),
+    "icon-keep-upright": _LayerPropertySpec(
+      type: "boolean",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: false,
+    ),
+    "icon-offset": _LayerPropertySpec(
+      type: "array",
+      arrayValueType: "number",
+      arrayLength: 2,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+      },
+      isInterpolated: true,
+    ),
+    "icon-anchor": _LayerPropertySpec(
+      type: "enum",
+      values: {
+        "center",
+        "left",
+        "right",
+        "top",
+        "bottom",
+        "top-left",
+        "top-right",
+        "bottom-left",
+        "bottom-right",
+      },
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+      },
+      isInterpolated: false,
+    ),
+    "icon-pitch-alignment": _LayerPropertySpec(
+      type: "enum",
+      values: {
+        "map",
+        "viewport",
+        "auto",
+      },
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: false,
+    ),
+    "text-pitch-alignment": _LayerPropertySpec(
+      type: "enum",
+      values: {
+        "map",
+        "viewport",
+        "auto",
+      },
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: false,
+    ),
+    "text-rotation-alignment": _LayerPropertySpec(
+      type: "enum",
+      values: {
+        "map",
+        "viewport",
+        "auto",
+      },
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: false,
+    ),
+    "text-field": _LayerPropertySpec(
+      type: "formatted",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+      },
+      isInterpolated: false,
+    ),
+    "text-font": _LayerPropertySpec(
+      type: "array",
+      arrayValueType: "string",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+      },
+      isInterpolated: false,
+    ),
+    "text-size": _LayerPropertySpec(
+      type: "number",
+      minimum: 0,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+      },
+      isInterpolated: true,
+    ),
+    "text-max-width": _LayerPropertySpec(
+      type: "number",
+      minimum: 0,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+      },
+      isInterpolated: true,
+    ),
+    "text-line-height": _LayerPropertySpec(
+      type: "number",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: true,
+    ),
+    "text-letter-spacing": _LayerPropertySpec(
+      type: "number",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+      },
+      isInterpolated: true,
+    ),
+    "text-justify": _LayerPropertySpec(
+      type: "enum",
+      values: {
+        "auto",
+        "left",
+        "center",
+        "right",
+      },
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+      },
+      isInterpolated: false,
+    ),
+    "text-radial-offset": _LayerPropertySpec(
+      type: "number",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+      },
+      isInterpolated: true,
+    ),
+    "text-variable-anchor": _LayerPropertySpec(
+      type: "array",
+      arrayValueType: "enum",
+      values: {
+        "center",
+        "left",
+        "right",
+        "top",
+        "bottom",
+        "top-left",
+        "top-right",
+        "bottom-left",
+        "bottom-right",
+      },
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: false,
+    ),
+    "text-anchor": _LayerPropertySpec(
+      type: "enum",
+      values: {
+        "center",
+        "left",
+        "right",
+        "top",
+        "bottom",
+        "top-left",
+        "top-right",
+        "bottom-left",
+        "bottom-right",
+      },
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+      },
+      isInterpolated: false,
+    ),
+    "text-max-angle": _LayerPropertySpec(
+      type: "number",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: true,
+    ),
+    "text-writing-mode": _LayerPropertySpec(
+      type: "array",
+      arrayValueType: "enum",
+      values: {
+        "horizontal",
+        "vertical",
+      },
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: false,
+    ),
+    "text-rotate": _LayerPropertySpec(
+      type: "number",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+      },
+      isInterpolated: true,
+    ),
+    "text-padding": _LayerPropertySpec(
+      type: "number",
+      minimum: 0,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: true,
+    ),
+    "text-keep-upright": _LayerPropertySpec(
+      type: "boolean",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: false,
+    ),
+    "text-transform": _LayerPropertySpec(
+      type: "enum",
+      values: {
+        "none",
+        "uppercase",
+        "lowercase",
+      },
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+      },
+      isInterpolated: false,
+    ),
+    "text-offset": _LayerPropertySpec(
+      type: "array",
+      arrayValueType: "number",
+      arrayLength: 2,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+      },
+      isInterpolated: true,
+    ),
+    "text-allow-overlap": _LayerPropertySpec(
+      type: "boolean",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: false,
+    ),
+    "text-ignore-placement": _LayerPropertySpec(
+      type: "boolean",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: false,
+    ),
+    "text-optional": _LayerPropertySpec(
+      type: "boolean",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: false,
+    ),
+    "visibility": _LayerPropertySpec(
+      type: "enum",
+      values: {
+        "visible",
+        "none",
+      },
+      supportsExpression: false,
+      isInterpolated: false,
+    ),
+  },
+  "circle": {
+    "circle-radius": _LayerPropertySpec(
+      type: "number",
+      minimum: 0,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+        "feature-state",
+      },
+      isInterpolated: true,
+    ),
+    "circle-color": _LayerPropertySpec(
+      type: "color",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+        "feature-state",
+      },
+      isInterpolated: true,
+    ),
+    "circle-blur": _LayerPropertySpec(
+      type: "number",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+        "feature-state",
+      },
+      isInterpolated: true,
+    ),
+    "circle-opacity": _LayerPropertySpec(
+      type: "number",
+      minimum: 0,
+      maximum: 1,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+        "feature-state",
+      },
+      isInterpolated: true,
+    ),
+    "circle-translate": _LayerPropertySpec(
+      type: "array",
+      arrayValueType: "number",
+      arrayLength: 2,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: true,
+    ),
+    "circle-translate-anchor": _LayerPropertySpec(
+      type: "enum",
+      values: {
+        "map",
+        "viewport",
+      },
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: false,
+    ),
+    "circle-pitch-scale": _LayerPropertySpec(
+      type: "enum",
+      values: {
+        "map",
+        "viewport",
+      },
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: false,
+    ),
+    "circle-pitch-alignment": _LayerPropertySpec(
+      type: "enum",
+      values: {
+        "map",
+        "viewport",
+      },
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: false,
+    ),
+    "circle-stroke-width": _LayerPropertySpec(
+      type: "number",
+      minimum: 0,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+        "feature-state",
+      },
+      isInterpolated: true,
+    ),
+    "circle-stroke-color": _LayerPropertySpec(
+      type: "color",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+        "feature-state",
+      },
+      isInterpolated: true,
+    ),
+    "circle-stroke-opacity": _LayerPropertySpec(
+      type: "number",
+      minimum: 0,
+      maximum: 1,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+        "feature-state",
+      },
+      isInterpolated: true,
+    ),
+    "circle-sort-key": _LayerPropertySpec(
+      type: "number",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+      },
+      isInterpolated: false,
+    ),
+    "visibility": _LayerPropertySpec(
+      type: "enum",
+      values: {
+        "visible",
+        "none",
+      },
+      supportsExpression: false,
+      isInterpolated: false,
+    ),
+  },
+  "line": {
+    "line-opacity": _LayerPropertySpec(
+      type: "number",
+      minimum: 0,
+      maximum: 1,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+        "feature-state",
+      },
+      isInterpolated: true,
+    ),
+    "line-color": _LayerPropertySpec(
+      type: "color",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+        "feature-state",
+      },
+      isInterpolated: true,
+    ),
+    "line-translate": _LayerPropertySpec(
+      type: "array",
+      arrayValueType: "number",
+      arrayLength: 2,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: true,
+    ),
+    "line-translate-anchor": _LayerPropertySpec(
+      type: "enum",
+      values: {
+        "map",
+        "viewport",
+      },
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: false,
+    ),
+    "line-width": _LayerPropertySpec(
+      type: "number",
+      minimum: 0,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+        "feature-state",
+      },
+      isInterpolated: true,
+    ),
+    "line-gap-width": _LayerPropertySpec(
+      type: "number",
+      minimum: 0,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+        "feature-state",
+      },
+      isInterpolated: true,
+    ),
+    "line-offset": _LayerPropertySpec(
+      type: "number",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+        "feature-state",
+      },
+      isInterpolated: true,
+    ),
+    "line-blur": _LayerPropertySpec(
+      type: "number",
+      minimum: 0,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+        "feature-state",
+      },
+      isInterpolated: true,
+    ),
+    "line-dasharray": _LayerPropertySpec(
+      type: "array",
+      arrayValueType: "number",
+      minimum: 0,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: false,
+    ),
+    "line-pattern": _LayerPropertySpec(
+      type: "resolvedImage",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+      },
+      isInterpolated: false,
+    ),
+    "line-gradient": _LayerPropertySpec(
+      type: "color",
+      supportsExpression: true,
+      parameters: {
+        "line-progress",
+      },
+      isInterpolated: true,
+    ),
+    "line-cap": _LayerPropertySpec(
+      type: "enum",
+      values: {
+        "butt",
+        "round",
+        "square",
+      },
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: false,
+    ),
+    "line-join": _LayerPropertySpec(
+      type: "enum",
+      values: {
+        "bevel",
+        "round",
+        "miter",
+      },
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+      },
+      isInterpolated: false,
+    ),
+    "line-miter-limit": _LayerPropertySpec(
+      type: "number",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: true,
+    ),
+    "line-round-limit": _LayerPropertySpec(
+      type: "number",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: true,
+    ),
+    "line-sort-key": _LayerPropertySpec(
+      type: "number",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+      },
+      isInterpolated: false,
+    ),
+    "visibility": _LayerPropertySpec(
+      type: "enum",
+      values: {
+        "visible",
+        "none",
+      },
+      supportsExpression: false,
+      isInterpolated: false,
+    ),
+  },
+  "fill": {
+    "fill-antialias": _LayerPropertySpec(
+      type: "boolean",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: false,
+    ),
+    "fill-opacity": _LayerPropertySpec(
+      type: "number",
+      minimum: 0,
+      maximum: 1,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+        "feature-state",
+      },
+      isInterpolated: true,
+    ),
+    "fill-color": _LayerPropertySpec(
+      type: "color",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+        "feature-state",
+      },
+      isInterpolated: true,
+    ),
+    "fill-outline-color": _LayerPropertySpec(
+      type: "color",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+        "feature-state",
+      },
+      isInterpolated: true,
+    ),
+    "fill-translate": _LayerPropertySpec(
+      type: "array",
+      arrayValueType: "number",
+      arrayLength: 2,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: true,
+    ),
+    "fill-translate-anchor": _LayerPropertySpec(
+      type: "enum",
+      values: {
+        "map",
+        "viewport",
+      },
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: false,
+    ),
+    "fill-pattern": _LayerPropertySpec(
+      type: "resolvedImage",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+      },
+      isInterpolated: false,
+    ),
+    "fill-sort-key": _LayerPropertySpec(
+      type: "number",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+      },
+      isInterpolated: false,
+    ),
+    "visibility": _LayerPropertySpec(
+      type: "enum",
+      values: {
+        "visible",
+        "none",
+      },
+      supportsExpression: false,
+      isInterpolated: false,
+    ),
+  },
+  "fill-extrusion": {
+    "fill-extrusion-opacity": _LayerPropertySpec(
+      type: "number",
+      minimum: 0,
+      maximum: 1,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: true,
+    ),
+    "fill-extrusion-color": _LayerPropertySpec(
+      type: "color",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+        "feature-state",
+      },
+      isInterpolated: true,
+    ),
+    "fill-extrusion-translate": _LayerPropertySpec(
+      type: "array",
+      arrayValueType: "number",
+      arrayLength: 2,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: true,
+    ),
+    "fill-extrusion-translate-anchor": _LayerPropertySpec(
+      type: "enum",
+      values: {
+        "map",
+        "viewport",
+      },
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: false,
+    ),
+    "fill-extrusion-pattern": _LayerPropertySpec(
+      type: "resolvedImage",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+      },
+      isInterpolated: false,
+    ),
+    "fill-extrusion-height": _LayerPropertySpec(
+      type: "number",
+      minimum: 0,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+        "feature-state",
+      },
+      isInterpolated: true,
+    ),
+    "fill-extrusion-base": _LayerPropertySpec(
+      type: "number",
+      minimum: 0,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+        "feature-state",
+      },
+      isInterpolated: true,
+    ),
+    "fill-extrusion-vertical-gradient": _LayerPropertySpec(
+      type: "boolean",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: false,
+    ),
+    "visibility": _LayerPropertySpec(
+      type: "enum",
+      values: {
+        "visible",
+        "none",
+      },
+      supportsExpression: false,
+      isInterpolated: false,
+    ),
+  },
+  "raster": {
+    "raster-opacity": _LayerPropertySpec(
+      type: "number",
+      minimum: 0,
+      maximum: 1,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: true,
+    ),
+    "raster-hue-rotate": _LayerPropertySpec(
+      type: "number",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: true,
+    ),
+    "raster-brightness-min": _LayerPropertySpec(
+      type: "number",
+      minimum: 0,
+      maximum: 1,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: true,
+    ),
+    "raster-brightness-max": _LayerPropertySpec(
+      type: "number",
+      minimum: 0,
+      maximum: 1,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: true,
+    ),
+    "raster-saturation": _LayerPropertySpec(
+      type: "number",
+      minimum: -1,
+      maximum: 1,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: true,
+    ),
+    "raster-contrast": _LayerPropertySpec(
+      type: "number",
+      minimum: -1,
+      maximum: 1,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: true,
+    ),
+    "raster-resampling": _LayerPropertySpec(
+      type: "enum",
+      values: {
+        "linear",
+        "nearest",
+      },
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: false,
+    ),
+    "raster-fade-duration": _LayerPropertySpec(
+      type: "number",
+      minimum: 0,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: true,
+    ),
+    "visibility": _LayerPropertySpec(
+      type: "enum",
+      values: {
+        "visible",
+        "none",
+      },
+      supportsExpression: false,
+      isInterpolated: false,
+    ),
+  },
+  "hillshade": {
+    "hillshade-illumination-direction": _LayerPropertySpec(
+      type: "number",
+      minimum: 0,
+      maximum: 359,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: true,
+    ),
+    "hillshade-illumination-anchor": _LayerPropertySpec(
+      type: "enum",
+      values: {
+        "map",
+        "viewport",
+      },
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: false,
+    ),
+    "hillshade-exaggeration": _LayerPropertySpec(
+      type: "number",
+      minimum: 0,
+      maximum: 1,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: true,
+    ),
+    "hillshade-shadow-color": _LayerPropertySpec(
+      type: "color",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: true,
+    ),
+    "hillshade-highlight-color": _LayerPropertySpec(
+      type: "color",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: true,
+    ),
+    "hillshade-accent-color": _LayerPropertySpec(
+      type: "color",
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: true,
+    ),
+    "visibility": _LayerPropertySpec(
+      type: "enum",
+      values: {
+        "visible",
+        "none",
+      },
+      supportsExpression: false,
+      isInterpolated: false,
+    ),
+  },
+  "heatmap": {
+    "heatmap-radius": _LayerPropertySpec(
+      type: "number",
+      minimum: 1,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+        "feature-state",
+      },
+      isInterpolated: true,
+    ),
+    "heatmap-weight": _LayerPropertySpec(
+      type: "number",
+      minimum: 0,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+        "feature",
+        "feature-state",
+      },
+      isInterpolated: true,
+    ),
+    "heatmap-intensity": _LayerPropertySpec(
+      type: "number",
+      minimum: 0,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: true,
+    ),
+    "heatmap-color": _LayerPropertySpec(
+      type: "color",
+      supportsExpression: true,
+      parameters: {
+        "heatmap-density",
+      },
+      isInterpolated: true,
+    ),
+    "heatmap-opacity": _LayerPropertySpec(
+      type: "number",
+      minimum: 0,
+      maximum: 1,
+      supportsExpression: true,
+      parameters: {
+        "zoom",
+      },
+      isInterpolated: true,
+    ),
+    "visibility": _LayerPropertySpec(
+      type: "enum",
+      values: {
+        "visible",
+        "none",
+      },
+      supportsExpression: false,
+      isInterpolated: false,
+    ),
+  },
+};
@@ -0,0 +1,139 @@
+part of '../maplibre_gl_platform_interface.dart';
+
+/// The tile requests of a source, see [MapPerformanceStats.sources].
+///
+/// Requests are attributed to a source by their url template, the url with
+/// the tile coordinates replaced by `{z}/{x}/{y}`, e.g.
+/// `https://tiles.example.com/{z}/{x}/{y}.pbf`.
+@immutable
+class TileSourceStatistics {
+  const TileSourceStatistics({
+    required this.requests,
+    required this.failures,
+    required this.networkResponses,
+    required this.ambientCacheHits,
+    required this.httpCacheHits,
+    required this.bytes,
+    required this.latencies,
+  });
+
+  factory TileSourceStatistics.fromMap(Map<Object?, Object?> map) =>
+      TileSourceStatistics(
+        requests: map['requests'] as int,
+        failures: map['failures'] as int,
+        networkResponses: map['networkResponses'] as int,
+        ambientCacheHits: map['ambientCacheHits'] as int,
+        httpCacheHits: map['httpCacheHits'] as int,
+        bytes: map['bytes'] as int,
+        latencies: [
+          for (final latency in map['latencies'] as List)
+            Duration(milliseconds: latency as int),
+        ]..sort(),
+      );
+
+  final int requests;
+  final int failures;
+
+  /// The requests answered with a tile by the server.
+  final int networkResponses;
+
+  /// The requests for tiles in the ambient cache of MapLibre, which the
+  /// server confirmed with `304 Not Modified`. Tiles in the ambient cache
+  /// that did not expire yet are loaded without a request and not counted.
+  final int ambientCacheHits;
+
+  /// The requests answered by the HTTP disk cache of the
+  /// `NetworkConfiguration`.
+  final int httpCacheHits;
+
+  /// The bytes of the response bodies.
+  final int bytes;
+
+  /// The time until the response headers arrived of the most recent
+  /// requests, sorted.
+  final List<Duration> latencies;
+
+  double get cacheHitRate =>
+      requests == 0 ? 0 : (ambientCacheHits + httpCacheHits) / requests;
+
+  /// The latency that [percentile] percent of the requests did not exceed,
+  /// or null without requests.
+  Duration? latencyPercentile(double percentile) =>
+      _percentile(latencies, percentile);
+
+  @override
+  String toString() =>
+      'TileSourceStatistics, requests = $requests, failures = $failures, '
+      'networkResponses = $networkResponses, '
+      'ambientCacheHits = $ambientCacheHits, httpCacheHits = $httpCacheHits, '
+      'bytes = $bytes, p50 = ${latencyPercentile(50)}, '
+      'p90 = ${latencyPercentile(90)}, p99 = ${latencyPercentile(99)}';
+}
+
+/// The tile loading of a map, to find out whether the network, the caches
+/// or rendering make it slow.
+@immutable
+class MapPerformanceStats {
+  const MapPerformanceStats({
+    required this.sources,
+    required this.timesToIdle,
+  });
+
+  /// The tile requests per source. The HTTP client is shared, so these
+  /// include the requests of all maps and offline downloads.
+  final Map<String, TileSourceStatistics> sources;
+
+  /// The times from the end of a camera move until the map was idle, i.e.
+  /// all tiles of the new viewport were loaded and rendered, sorted.
+  final List<Duration> timesToIdle;
+
+  Duration? timeToIdlePercentile(double percentile) =>
+      _percentile(timesToIdle, percentile);
+
+  @override
+  String toString() => 'MapPerformanceStats, sources = $sources, '
+      'timeToIdle p50 = ${timeToIdlePercentile(50)}, '
+      'p90 = ${timeToIdlePercentile(90)}';
+}
+
+/// Measures the time from the end of each camera move until the map is
+/// idle, keeping the most recent [capacity] measurements.
+class TimeToIdleRecorder {
+  TimeToIdleRecorder({this.capacity = 256, Duration Function()? clock})
+      : _clock = clock ?? _stopwatchClock();
+
+  final int capacity;
+  final Duration Function() _clock;
+  final _times = Queue<Duration>();
+  Duration? _cameraIdleAt;
+
+  static Duration Function() _stopwatchClock() {
+    final stopwatch = Stopwatch()..start();
+    return () => stopwatch.elapsed;
+  }
+
+  /// The camera stopped moving, the map starts loading the new viewport.
+  void cameraIdle() => _cameraIdleAt = _clock();
+
+  /// The map finished loading and rendering. Idle events without a camera
+  /// move before, e.g. after a style change, are not measured.
+  void mapIdle() {
+    final cameraIdleAt = _cameraIdleAt;
+    if (cameraIdleAt == null) return;
+    _cameraIdleAt = null;
+    _times.addLast(_clock() - cameraIdleAt);
+    if (_times.length > capacity) _times.removeFirst();
+  }
+
+  /// The measured times, sorted.
+  List<Duration> get times => _times.toList()..sort();
+
+  void reset() => _times.clear();
+}
+
+/// The nearest-rank [percentile] of [sorted].
+Duration? _percentile(List<Duration> sorted, double percentile) {
+  if (sorted.isEmpty) return null;
+  final rank = (percentile / 100 * sorted.length).ceil();
+  return sorted[(rank - 1).clamp(0, sorted.length - 1)];
+}
@@ -5,6 +5,11 @@ part of '../maplibre_gl_platform_interface.dart';
 /// The default instance of [MapLibrePlatform] to use.
 typedef OnPlatformViewCreatedCallback = void Function(int);
 
+/// Prefix of the feature properties that hold the feature state on platforms
+/// without native feature state support, see
+/// [MapLibrePlatform.setFeatureState].
+const featureStatePropertyPrefix = 'feature-state:';
+
 abstract class MapLibrePlatform {
   static MapLibreMethodChannel? _instance;
 
@@ -23,6 +28,8 @@ abstract class MapLibrePlatform {
 
   final onFeatureDraggedPlatform = ArgumentCallbacks<Map<String, dynamic>>();
 
+  final onFeatureHoverPlatform = ArgumentCallbacks<Map<String, dynamic>>();
+
   final onCameraMoveStartedPlatform = ArgumentCallbacks<void>();
 
   final onCameraMovePlatform = ArgumentCallbacks<CameraPosition>();
@@ -75,6 +82,7 @@ abstract class MapLibrePlatform {
       String sourceId, String? sourceLayerId, List<Object>? filter);
   Future invalidateAmbientCache();
   Future clearAmbientCache();
+  Future<void> setPrefetchZoomDelta(int delta);
   Future<LatLng?> requestMyLocationLatLng();
 
   Future<LatLngBounds> getVisibleRegion();
@@ -127,8 +135,50 @@ abstract class MapLibrePlatform {
   Future<void> setFeatureForGeoJsonSource(
       String sourceId, Map<String, dynamic> geojsonFeature);
 
+  /// Merges [state] into the state of the feature [featureId] of [sourceId].
+  ///
+  /// On web this uses the renderer's feature state, which paint properties
+  /// read with `["feature-state", key]`. Android and iOS have no feature state
+  /// support, there the state is stored in the feature properties of geojson
+  /// sources under [featureStatePropertyPrefix] followed by the key.
+  Future<void> setFeatureState(
+      String sourceId, String featureId, Map<String, dynamic> state,
+      {String? sourceLayer});
+
+  /// Removes the [key] of the state of [featureId], all keys of the feature
+  /// if [key] is null or the state of all features of [sourceId] if
+  /// [featureId] is null as well.
+  Future<void> removeFeatureState(String sourceId,
+      {String? featureId, String? key, String? sourceLayer});
+
+  /// Returns the zoom at which the cluster with [clusterId] of the clustered
+  /// geojson source [sourceId] expands into multiple children.
+  Future<int> getClusterExpansionZoom(String sourceId, int clusterId);
+
+  /// Returns the direct children of the cluster with [clusterId] as geojson
+  /// features.
+  Future<List> getClusterChildren(String sourceId, int clusterId);
+
+  /// Returns up to [limit] points of the cluster with [clusterId] as geojson
+  /// features, skipping the first [offset] points.
+  Future<List> getClusterLeaves(String sourceId, int clusterId,
+      {int limit = 10, int offset = 0});
+
   Future<void> removeSource(String sourceId);
 
+  /// Adds an empty geojson source [sourceId] of moving points, which are
+  /// extrapolated from their last fix with a [MotionInterpolator] once per
+  /// display frame on the platform side. Points are set with
+  /// [updateMotionSource], the source is removed with [removeSource].
+  Future<void> addMotionSource(String sourceId,
+      {Duration maxExtrapolation = const Duration(seconds: 5),
+      Duration blendDuration = const Duration(seconds: 1)});
+
+  /// Sets the fixes of [points] and removes the points with [removeIds] from
+  /// the motion source [sourceId].
+  Future<void> updateMotionSource(String sourceId, List<MovingPoint> points,
+      {List<Object> removeIds = const []});
+
   Future<void> addSymbolLayer(
       String sourceId, String layerId, Map<String, dynamic> properties,
       {String? belowLayerId,
@@ -202,6 +252,15 @@ abstract class MapLibrePlatform {
 
   Future<void> setLayerVisibility(String layerId, bool visible);
 
+  /// Applies a list of style operations in order with a single platform call.
+  ///
+  /// Every operation is a map with a `type` key (e.g. `addLayer`,
+  /// `setLayerProperties`) and the same arguments as the corresponding single
+  /// call. Failing operations do not abort the transaction, they are reported
+  /// in the returned list instead.
+  Future<List<StyleOperationError>> applyStyleTransaction(
+      List<Map<String, dynamic>> operations);
+
   @mustCallSuper
   void dispose() {
     // clear all callbacks to avoid cyclic refs
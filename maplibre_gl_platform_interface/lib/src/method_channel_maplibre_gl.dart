@@ -4,6 +4,12 @@ class MapLibreMethodChannel extends MapLibrePlatform {
   late MethodChannel _channel;
   static bool useHybridComposition = false;
 
+  /// Geojson sources with at least this many features are encoded to JSON
+  /// in a background isolate instead of on the UI isolate, which would drop
+  /// frames for large sources. Set to 0 to always encode in the background,
+  /// or to null to never do so.
+  static int? geoJsonEncodingIsolateThreshold = 5000;
+
   Future<dynamic> _handleMethodCall(MethodCall call) async {
     switch (call.method) {
       case 'infoWindow#onTap':
@@ -333,6 +339,13 @@ class MapLibreMethodChannel extends MapLibrePlatform {
     }
   }
 
+  @override
+  Future<void> setPrefetchZoomDelta(int delta) async {
+    await _channel.invokeMethod('map#setPrefetchZoomDelta', <String, dynamic>{
+      'delta': delta,
+    });
+  }
+
   @override
   Future<LatLng> requestMyLocationLatLng() async {
     try {
@@ -462,6 +475,41 @@ class MapLibreMethodChannel extends MapLibrePlatform {
     }
   }
 
+  @override
+  Future<void> addMotionSource(String sourceId,
+      {Duration maxExtrapolation = const Duration(seconds: 5),
+      Duration blendDuration = const Duration(seconds: 1)}) async {
+    await _channel.invokeMethod('motionSource#add', <String, dynamic>{
+      'sourceId': sourceId,
+      'maxExtrapolation': maxExtrapolation.inMilliseconds,
+      'blendDuration': blendDuration.inMilliseconds,
+    });
+  }
+
+  /// Sends the fixes as one [Float64List] of latitude, longitude, track,
+  /// speed and timestamp per point, next to the ids and properties.
+  @override
+  Future<void> updateMotionSource(String sourceId, List<MovingPoint> points,
+      {List<Object> removeIds = const []}) async {
+    final fixes = Float64List(points.length * 5);
+    for (var i = 0; i < points.length; i++) {
+      final point = points[i];
+      fixes
+        ..[i * 5] = point.position.latitude
+        ..[i * 5 + 1] = point.position.longitude
+        ..[i * 5 + 2] = point.track
+        ..[i * 5 + 3] = point.speed
+        ..[i * 5 + 4] = point.timestamp.millisecondsSinceEpoch.toDouble();
+    }
+    await _channel.invokeMethod('motionSource#update', <String, dynamic>{
+      'sourceId': sourceId,
+      'ids': [for (final point in points) point.id],
+      'fixes': fixes,
+      'properties': [for (final point in points) point.properties],
+      'removeIds': removeIds,
+    });
+  }
+
   @override
   Future<void> addLayer(String imageLayerId, String imageSourceId,
       double? minzoom, double? maxzoom) async {
@@ -560,7 +608,7 @@ class MapLibreMethodChannel extends MapLibrePlatform {
       {String? promoteId}) async {
     await _channel.invokeMethod('source#addGeoJson', <String, dynamic>{
       'sourceId': sourceId,
-      'geojson': jsonEncode(geojson),
+      'geojson': await _encodeGeoJson(geojson),
     });
   }
 
@@ -569,10 +617,29 @@ class MapLibreMethodChannel extends MapLibrePlatform {
       String sourceId, Map<String, dynamic> geojson) async {
     await _channel.invokeMethod('source#setGeoJson', <String, dynamic>{
       'sourceId': sourceId,
-      'geojson': jsonEncode(geojson),
+      'geojson': await _encodeGeoJson(geojson),
     });
   }
 
+  /// Encodes [geojson] to a JSON string, or for sources above the
+  /// [geoJsonEncodingIsolateThreshold] to UTF-8 encoded JSON in a background
+  /// isolate. The bytes are transferred back without copying and sent to the
+  /// platform as is.
+  static Future<Object> _encodeGeoJson(Map<String, dynamic> geojson) async {
+    final threshold = geoJsonEncodingIsolateThreshold;
+    final List? features = geojson['features'];
+    if (threshold == null ||
+        features == null ||
+        features.length < threshold) {
+      return jsonEncode(geojson);
+    }
+    final bytes = await Isolate.run(
+        () => TransferableTypedData.fromList(
+            [utf8.encode(jsonEncode(geojson))]),
+        debugName: 'geojson encoding');
+    return bytes.materialize().asUint8List();
+  }
+
   @override
   Future setCameraBounds({
     required double west,
@@ -612,8 +679,7 @@ class MapLibreMethodChannel extends MapLibrePlatform {
       'maxzoom': maxzoom,
       'filter': jsonEncode(filter),
       'enableInteraction': enableInteraction,
-      'properties': properties
-          .map((key, value) => MapEntry<String, String>(key, jsonEncode(value)))
+      'properties': encodeLayerProperties(properties)
     });
   }
 
@@ -635,8 +701,7 @@ class MapLibreMethodChannel extends MapLibrePlatform {
       'maxzoom': maxzoom,
       'filter': jsonEncode(filter),
       'enableInteraction': enableInteraction,
-      'properties': properties
-          .map((key, value) => MapEntry<String, String>(key, jsonEncode(value)))
+      'properties': encodeLayerProperties(properties)
     });
   }
 
@@ -645,8 +710,7 @@ class MapLibreMethodChannel extends MapLibrePlatform {
       String layerId, Map<String, dynamic> properties) async {
     await _channel.invokeMethod('layer#setProperties', <String, dynamic>{
       'layerId': layerId,
-      'properties': properties
-          .map((key, value) => MapEntry<String, String>(key, jsonEncode(value)))
+      'properties': encodeLayerProperties(properties)
     });
   }
 
@@ -668,8 +732,7 @@ class MapLibreMethodChannel extends MapLibrePlatform {
       'maxzoom': maxzoom,
       'filter': jsonEncode(filter),
       'enableInteraction': enableInteraction,
-      'properties': properties
-          .map((key, value) => MapEntry<String, String>(key, jsonEncode(value)))
+      'properties': encodeLayerProperties(properties)
     });
   }
 
@@ -691,8 +754,7 @@ class MapLibreMethodChannel extends MapLibrePlatform {
       'maxzoom': maxzoom,
       'filter': jsonEncode(filter),
       'enableInteraction': enableInteraction,
-      'properties': properties
-          .map((key, value) => MapEntry<String, String>(key, jsonEncode(value)))
+      'properties': encodeLayerProperties(properties)
     });
   }
 
@@ -714,8 +776,7 @@ class MapLibreMethodChannel extends MapLibrePlatform {
       'maxzoom': maxzoom,
       'filter': jsonEncode(filter),
       'enableInteraction': enableInteraction,
-      'properties': properties
-          .map((key, value) => MapEntry<String, String>(key, jsonEncode(value)))
+      'properties': encodeLayerProperties(properties)
     });
   }
 
@@ -746,8 +807,7 @@ class MapLibreMethodChannel extends MapLibrePlatform {
       'belowLayerId': belowLayerId,
       'minzoom': minzoom,
       'maxzoom': maxzoom,
-      'properties': properties
-          .map((key, value) => MapEntry<String, String>(key, jsonEncode(value)))
+      'properties': encodeLayerProperties(properties)
     });
   }
 
@@ -764,8 +824,7 @@ class MapLibreMethodChannel extends MapLibrePlatform {
       'belowLayerId': belowLayerId,
       'minzoom': minzoom,
       'maxzoom': maxzoom,
-      'properties': properties
-          .map((key, value) => MapEntry<String, String>(key, jsonEncode(value)))
+      'properties': encodeLayerProperties(properties)
     });
   }
 
@@ -782,8 +841,7 @@ class MapLibreMethodChannel extends MapLibrePlatform {
       'belowLayerId': belowLayerId,
       'minzoom': minzoom,
       'maxzoom': maxzoom,
-      'properties': properties
-          .map((key, value) => MapEntry<String, String>(key, jsonEncode(value)))
+      'properties': encodeLayerProperties(properties)
     });
   }
 
@@ -796,6 +854,82 @@ class MapLibreMethodChannel extends MapLibrePlatform {
     });
   }
 
+  @override
+  Future<void> setFeatureState(
+      String sourceId, String featureId, Map<String, dynamic> state,
+      {String? sourceLayer}) async {
+    try {
+      await _channel.invokeMethod('featureState#set', <String, dynamic>{
+        'sourceId': sourceId,
+        'sourceLayer': sourceLayer,
+        'featureId': featureId,
+        'state': state,
+      });
+    } on PlatformException catch (e) {
+      return Future.error(e);
+    }
+  }
+
+  @override
+  Future<void> removeFeatureState(String sourceId,
+      {String? featureId, String? key, String? sourceLayer}) async {
+    try {
+      await _channel.invokeMethod('featureState#remove', <String, dynamic>{
+        'sourceId': sourceId,
+        'sourceLayer': sourceLayer,
+        'featureId': featureId,
+        'key': key,
+      });
+    } on PlatformException catch (e) {
+      return Future.error(e);
+    }
+  }
+
+  @override
+  Future<int> getClusterExpansionZoom(String sourceId, int clusterId) async {
+    try {
+      final int zoom = await _channel.invokeMethod(
+          'source#getClusterExpansionZoom', <String, dynamic>{
+        'sourceId': sourceId,
+        'clusterId': clusterId,
+      });
+      return zoom;
+    } on PlatformException catch (e) {
+      return Future.error(e);
+    }
+  }
+
+  @override
+  Future<List> getClusterChildren(String sourceId, int clusterId) async {
+    try {
+      final Map<dynamic, dynamic> reply = await _channel
+          .invokeMethod('source#getClusterChildren', <String, dynamic>{
+        'sourceId': sourceId,
+        'clusterId': clusterId,
+      });
+      return reply['features'].map((feature) => jsonDecode(feature)).toList();
+    } on PlatformException catch (e) {
+      return Future.error(e);
+    }
+  }
+
+  @override
+  Future<List> getClusterLeaves(String sourceId, int clusterId,
+      {int limit = 10, int offset = 0}) async {
+    try {
+      final Map<dynamic, dynamic> reply = await _channel
+          .invokeMethod('source#getClusterLeaves', <String, dynamic>{
+        'sourceId': sourceId,
+        'clusterId': clusterId,
+        'limit': limit,
+        'offset': offset,
+      });
+      return reply['features'].map((feature) => jsonDecode(feature)).toList();
+    } on PlatformException catch (e) {
+      return Future.error(e);
+    }
+  }
+
   @override
   Future<void> setLayerVisibility(String layerId, bool visible) async {
     await _channel.invokeMethod('layer#setVisibility', <String, dynamic>{
@@ -804,6 +938,43 @@ class MapLibreMethodChannel extends MapLibrePlatform {
     });
   }
 
+  @override
+  Future<List<StyleOperationError>> applyStyleTransaction(
+      List<Map<String, dynamic>> operations) async {
+    try {
+      final Map<dynamic, dynamic> reply = await _channel
+          .invokeMethod('style#applyTransaction', <String, dynamic>{
+        'operations': [
+          for (final operation in operations) _encodeStyleOperation(operation)
+        ],
+      });
+      return [
+        for (final error in reply['errors'] as List)
+          StyleOperationError.fromMap(error)
+      ];
+    } on PlatformException catch (e) {
+      return Future.error(e);
+    }
+  }
+
+  /// Encodes a style operation the same way the corresponding single method
+  /// call would, so the native side can reuse its existing converters.
+  Map<String, dynamic> _encodeStyleOperation(Map<String, dynamic> operation) {
+    final type = operation['type'];
+    return operation.map((key, value) {
+      switch (key) {
+        case 'properties' when type != 'addSource':
+          return MapEntry(
+              key, encodeLayerProperties(value as Map<String, dynamic>));
+        case 'geojson':
+        case 'filter':
+          return MapEntry(key, jsonEncode(value));
+        default:
+          return MapEntry(key, value);
+      }
+    });
+  }
+
   @override
   void forceResizeWebMap() {}
 
@@ -0,0 +1,222 @@
+part of '../maplibre_gl_platform_interface.dart';
+
+/// A position fix of a moving point of a motion source, see
+/// [MapLibrePlatform.addMotionSource].
+@immutable
+class MovingPoint {
+  const MovingPoint({
+    required this.id,
+    required this.position,
+    this.track = 0,
+    this.speed = 0,
+    required this.timestamp,
+    this.properties = const {},
+  });
+
+  /// The id of the feature, a fix replaces the previous fix with the same id.
+  final Object id;
+
+  /// The position at [timestamp].
+  final LatLng position;
+
+  /// The direction of travel in degrees clockwise from north.
+  final double track;
+
+  /// The ground speed in meters per second.
+  final double speed;
+
+  /// The time of the fix. Positions are extrapolated from this time with the
+  /// clock of the device, so it should not be ahead of that clock.
+  final DateTime timestamp;
+
+  /// The properties of the geojson feature. The [id] is added as the `id`
+  /// property.
+  final Map<String, dynamic> properties;
+}
+
+/// Extrapolates the positions of moving points from their last fix by dead
+/// reckoning.
+///
+/// Each point moves along the great circle of its track at its speed, for at
+/// most [maxExtrapolation] after its fix, so that points of a stalled feed
+/// stop instead of drifting away. When a new fix does not match the
+/// extrapolated position, the difference is blended out over
+/// [blendDuration] instead of jumping to the fix.
+///
+/// The state of all points is kept in a single [Float64List], so computing
+/// the positions of a frame allocates nothing. The Android and iOS motion
+/// sources implement the same algorithm natively and run it once per
+/// display frame, on web the plugin runs this class.
+///
+/// Times are milliseconds since the epoch.
+class MotionInterpolator {
+  MotionInterpolator({
+    this.maxExtrapolation = const Duration(seconds: 5),
+    this.blendDuration = const Duration(seconds: 1),
+  });
+
+  /// The longest time a point is moved after its last fix.
+  final Duration maxExtrapolation;
+
+  /// The time over which the error of a new fix is corrected.
+  final Duration blendDuration;
+
+  static const _earthRadius = 6371008.8;
+
+  // latitude, longitude, track, speed, fix time, latitude and longitude
+  // error of the fix and the start of its correction
+  static const _stride = 8;
+
+  final _ids = <Object>[];
+  final _indexById = <Object, int>{};
+  var _state = Float64List(_stride * 16);
+  final _scratch = Float64List(4);
+
+  /// The number of points.
+  int get length => _ids.length;
+
+  /// The ids of the points in the order of [positionsAt].
+  List<Object> get ids => UnmodifiableListView(_ids);
+
+  bool contains(Object id) => _indexById.containsKey(id);
+
+  /// Sets the latest fix of a point at [now], adding the point if it is new.
+  void update(MovingPoint point, int now) {
+    var index = _indexById[point.id];
+    var errorLatitude = 0.0;
+    var errorLongitude = 0.0;
+    if (index != null) {
+      _positionAt(index, now, _scratch, 0);
+      _setFix(index, point);
+      _positionAt(index, now, _scratch, 2);
+      errorLatitude = _scratch[0] - _scratch[2];
+      errorLongitude = _wrap(_scratch[1] - _scratch[3]);
+    } else {
+      index = _ids.length;
+      _ids.add(point.id);
+      _indexById[point.id] = index;
+      if (_state.length < _ids.length * _stride) {
+        _state = Float64List(_state.length * 2)..setAll(0, _state);
+      }
+      _setFix(index, point);
+    }
+    final offset = index * _stride;
+    _state
+      ..[offset + 5] = errorLatitude
+      ..[offset + 6] = errorLongitude
+      ..[offset + 7] = now.toDouble();
+  }
+
+  void _setFix(int index, MovingPoint point) {
+    final offset = index * _stride;
+    _state
+      ..[offset] = point.position.latitude
+      ..[offset + 1] = point.position.longitude
+      ..[offset + 2] = point.track
+      ..[offset + 3] = point.speed
+      ..[offset + 4] = point.timestamp.millisecondsSinceEpoch.toDouble()
+      ..[offset + 5] = 0
+      ..[offset + 6] = 0;
+  }
+
+  /// Removes the point [id]. The last point takes its place in [ids].
+  bool remove(Object id) {
+    final index = _indexById.remove(id);
+    if (index == null) return false;
+    final last = _ids.length - 1;
+    final lastId = _ids.removeLast();
+    if (index != last) {
+      _ids[index] = lastId;
+      _indexById[lastId] = index;
+      _state.setRange(
+          index * _stride, (index + 1) * _stride, _state, last * _stride);
+    }
+    return true;
+  }
+
+  void clear() {
+    _ids.clear();
+    _indexById.clear();
+  }
+
+  /// The position of the point [id] at [now], null if there is no such
+  /// point.
+  LatLng? positionOf(Object id, int now) {
+    final index = _indexById[id];
+    if (index == null) return null;
+    _positionAt(index, now, _scratch, 0);
+    return LatLng(_scratch[0], _scratch[1]);
+  }
+
+  /// Writes the positions of all points at [now] as latitude and longitude
+  /// pairs in the order of [ids] to [out], which is reused if it is large
+  /// enough.
+  Float64List positionsAt(int now, [Float64List? out]) {
+    final positions = out != null && out.length >= _ids.length * 2
+        ? out
+        : Float64List(_state.length ~/ _stride * 2);
+    for (var i = 0; i < _ids.length; i++) {
+      _positionAt(i, now, positions, i * 2);
+    }
+    return positions;
+  }
+
+  /// Whether any point moves at [now], i.e. is extrapolated or has an error
+  /// being corrected. If not, the positions do not need to be updated.
+  bool isMovingAt(int now) {
+    for (var i = 0; i < _ids.length; i++) {
+      final offset = i * _stride;
+      if (_state[offset + 3] > 0 &&
+          now - _state[offset + 4] < maxExtrapolation.inMilliseconds) {
+        return true;
+      }
+      if ((_state[offset + 5] != 0 || _state[offset + 6] != 0) &&
+          _blendAt(offset, now) > 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// The remaining fraction of the fix error at [now].
+  double _blendAt(int offset, int now) {
+    final duration = blendDuration.inMilliseconds;
+    if (duration <= 0) return 0;
+    final elapsed = now - _state[offset + 7];
+    return elapsed >= duration ? 0 : 1 - max(elapsed, 0) / duration;
+  }
+
+  /// Moves the fix of the point at [index] along its great circle by the
+  /// distance travelled until [now], see
+  /// http://www.movable-type.co.uk/scripts/latlong.html, adds the remaining
+  /// error of the fix and writes the position to [out] at [outOffset].
+  void _positionAt(int index, int now, Float64List out, int outOffset) {
+    final offset = index * _stride;
+    var latitude = _state[offset];
+    var longitude = _state[offset + 1];
+    final seconds = (now - _state[offset + 4])
+            .clamp(0, maxExtrapolation.inMilliseconds) /
+        1000;
+    final distance = _state[offset + 3] * seconds / _earthRadius;
+    if (distance > 0) {
+      final track = _state[offset + 2] * pi / 180;
+      final latitude1 = latitude * pi / 180;
+      final latitude2 = asin(sin(latitude1) * cos(distance) +
+          cos(latitude1) * sin(distance) * cos(track));
+      final deltaLongitude = atan2(
+          sin(track) * sin(distance) * cos(latitude1),
+          cos(distance) - sin(latitude1) * sin(latitude2));
+      latitude = latitude2 * 180 / pi;
+      longitude += deltaLongitude * 180 / pi;
+    }
+    final blend = _blendAt(offset, now);
+    out
+      ..[outOffset] = latitude + _state[offset + 5] * blend
+      ..[outOffset + 1] = _wrap(longitude + _state[offset + 6] * blend);
+  }
+
+  static double _wrap(double longitude) =>
+      longitude > 180 || longitude < -180
+          ? (longitude + 540) % 360 - 180
+          : longitude;
+}
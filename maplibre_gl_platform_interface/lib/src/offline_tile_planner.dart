@@ -0,0 +1,637 @@
+part of '../maplibre_gl_platform_interface.dart';
+
+/// Returns the size in bytes of the tile [zoom]/[x]/[y], or null if it could
+/// not be measured, e.g. with a HEAD request to the tile url.
+typedef TileSizeProbe = Future<int?> Function(int zoom, int x, int y);
+
+/// Plans offline region downloads before they start: counts the tiles a
+/// region needs per zoom level, estimates their size and splits large
+/// regions into chunks that can be downloaded in parallel.
+///
+/// The tiles are counted like MapLibre covers an offline region: a tile is
+/// downloaded if it intersects the region, at the zoom levels of
+/// [zoomLevels]. The counts are per tiled source of the style, a style with
+/// several sources downloads the tiles of each of them.
+///
+/// The pixel ratio of a region selects the resolution of raster tiles and of
+/// the sprite, not which tiles are downloaded, so the counts hold for any
+/// pixel ratio. Measure tile sizes at the pixel ratio of the download.
+@immutable
+class OfflineTilePlanner {
+  const OfflineTilePlanner({
+    this.tileSize = 512,
+    this.isRaster = false,
+    this.sourceMinZoom = 0,
+    this.sourceMaxZoom = 22,
+  });
+
+  /// The tile size of the source in pixels.
+  final int tileSize;
+
+  /// Whether the source is a raster source, whose zoom levels are rounded
+  /// instead of floored.
+  final bool isRaster;
+
+  /// The zoom levels of the tiles of the source, regions never download
+  /// tiles beyond them.
+  final int sourceMinZoom;
+  final int sourceMaxZoom;
+
+  /// The first and last tile zoom level downloaded for a region from
+  /// [minZoom] to [maxZoom], or null if the region downloads no tiles of
+  /// the source. [maxZoom] may be infinite.
+  (int, int)? zoomLevels(double minZoom, double maxZoom) {
+    final shift = log(512 / tileSize) / ln2;
+    int covering(double zoom) =>
+        isRaster ? (zoom + shift).round() : (zoom + shift).floor();
+    final first = max(covering(minZoom), sourceMinZoom);
+    final last = maxZoom.isFinite
+        ? min(covering(maxZoom), sourceMaxZoom)
+        : sourceMaxZoom;
+    return first <= last ? (first, last) : null;
+  }
+
+  /// Counts the tiles of a region of [bounds], which may cross the
+  /// antimeridian.
+  OfflineTilePlan planBounds(
+      LatLngBounds bounds, double minZoom, double maxZoom) {
+    return _plan(_BoundsCover.fromBounds(bounds), minZoom, maxZoom);
+  }
+
+  /// Counts the tiles of a region of a polygon. The first ring is the
+  /// outline, the others are holes. The rings must not cross the
+  /// antimeridian.
+  OfflineTilePlan planPolygon(
+      List<List<LatLng>> rings, double minZoom, double maxZoom) {
+    return planPolygons([rings], minZoom, maxZoom);
+  }
+
+  /// Counts the tiles of a region of several polygons, e.g. of a multi
+  /// polygon or of [corridorPolygons]. Tiles covered by more than one
+  /// polygon are counted once.
+  OfflineTilePlan planPolygons(
+      List<List<List<LatLng>>> polygons, double minZoom, double maxZoom) {
+    return _plan(_PolygonCover(polygons), minZoom, maxZoom);
+  }
+
+  /// The polygons covering a corridor of [width] meters along [path]: a
+  /// quadrilateral along each segment and a polygon around each point of the
+  /// path, for the joins and the round ends. The path must not cross the
+  /// antimeridian.
+  ///
+  /// The polygons are ordered along the path, so consecutive polygons cover
+  /// neighboring parts of the corridor.
+  static List<List<List<LatLng>>> corridorPolygons(
+    List<LatLng> path,
+    double width, {
+    int joinVertices = 8,
+  }) {
+    const degreesPerMeter = 180 / (pi * 6371008.8);
+    final halfWidth = width / 2;
+    // circumscribes the circle of the join
+    final joinRadius = halfWidth / cos(pi / joinVertices);
+
+    LatLng offset(LatLng point, double east, double north) => LatLng(
+          point.latitude + north * degreesPerMeter,
+          point.longitude +
+              east * degreesPerMeter / cos(point.latitude * pi / 180),
+        );
+
+    List<List<LatLng>> join(LatLng point) => [
+          [
+            for (var i = 0; i < joinVertices; i++)
+              offset(point, joinRadius * cos(2 * pi * i / joinVertices),
+                  joinRadius * sin(2 * pi * i / joinVertices)),
+          ],
+        ];
+
+    final polygons = <List<List<LatLng>>>[];
+    for (var i = 0; i < path.length; i++) {
+      polygons.add(join(path[i]));
+      if (i + 1 == path.length) break;
+      final from = path[i];
+      final to = path[i + 1];
+      final latitude = (from.latitude + to.latitude) / 2;
+      final east = (to.longitude - from.longitude) * cos(latitude * pi / 180);
+      final north = to.latitude - from.latitude;
+      final length = sqrt(east * east + north * north);
+      if (length == 0) continue;
+      final normalEast = -north / length * halfWidth;
+      final normalNorth = east / length * halfWidth;
+      polygons.add([
+        [
+          offset(from, normalEast, normalNorth),
+          offset(to, normalEast, normalNorth),
+          offset(to, -normalEast, -normalNorth),
+          offset(from, -normalEast, -normalNorth),
+        ],
+      ]);
+    }
+    return polygons;
+  }
+
+  /// Splits [path] into consecutive paths of [segmentLength] meters, the
+  /// last one may be shorter, e.g. to download a long corridor in parts in
+  /// the order of the route. Each path starts at the end of the previous one.
+  /// Paths without length, e.g. of identical points, are returned as is.
+  static List<List<LatLng>> splitPath(
+      List<LatLng> path, double segmentLength) {
+    assert(segmentLength > 0);
+    if (path.length < 2) return [path];
+    const metersPerDegree = pi * 6371008.8 / 180;
+    final parts = <List<LatLng>>[];
+    var part = [path.first];
+    var length = 0.0;
+    for (var i = 1; i < path.length; i++) {
+      var from = path[i - 1];
+      final to = path[i];
+      final latitude = (from.latitude + to.latitude) / 2;
+      final east = (to.longitude - from.longitude) * cos(latitude * pi / 180);
+      final north = to.latitude - from.latitude;
+      var distance = sqrt(east * east + north * north) * metersPerDegree;
+      while (length + distance > segmentLength) {
+        final t = (segmentLength - length) / distance;
+        final split = LatLng(
+          from.latitude + (to.latitude - from.latitude) * t,
+          from.longitude + (to.longitude - from.longitude) * t,
+        );
+        parts.add(part..add(split));
+        part = [split];
+        from = split;
+        distance -= segmentLength - length;
+        length = 0;
+      }
+      length += distance;
+      part.add(to);
+    }
+    if (length > 0) parts.add(part);
+    return parts.isEmpty ? [path] : parts;
+  }
+
+  OfflineTilePlan _plan(_TileCover cover, double minZoom, double maxZoom) {
+    final zooms = zoomLevels(minZoom, maxZoom);
+    final tileCounts = SplayTreeMap<int, int>();
+    if (zooms != null) {
+      for (var zoom = zooms.$1; zoom <= zooms.$2; zoom++) {
+        tileCounts[zoom] = cover.count(zoom);
+      }
+    }
+    return OfflineTilePlan._(UnmodifiableMapView(tileCounts), cover);
+  }
+
+  /// Splits [bounds] into chunks of at most [maxTilesPerChunk] tiles, e.g.
+  /// to stay below the offline tile count limit or to download them in
+  /// parallel.
+  ///
+  /// Chunks are split in half along their longer side, at a tile boundary of
+  /// the lowest zoom level near the middle. Chunks share no tiles at the zoom
+  /// levels of which they are split on a tile boundary, so the overlap of
+  /// their tiles is limited to a few tiles of the lowest zoom levels. A chunk
+  /// that can't be split on a tile boundary is returned as is, even if it has
+  /// more tiles.
+  List<LatLngBounds> splitBounds(
+    LatLngBounds bounds,
+    double minZoom,
+    double maxZoom, {
+    required int maxTilesPerChunk,
+  }) {
+    assert(maxTilesPerChunk > 0);
+    final zooms = zoomLevels(minZoom, maxZoom);
+    if (zooms == null) return [bounds];
+    final (firstZoom, lastZoom) = zooms;
+    final chunks = <LatLngBounds>[];
+
+    void split(_BoundsCover chunk) {
+      var tileCount = 0;
+      for (var zoom = firstZoom; zoom <= lastZoom; zoom++) {
+        tileCount += chunk.count(zoom);
+      }
+      final isWide = chunk.east - chunk.west >= chunk.south - chunk.north;
+      final at = tileCount <= maxTilesPerChunk
+          ? null
+          : isWide
+              ? _splitPosition(chunk.west, chunk.east, firstZoom, lastZoom)
+              : _splitPosition(chunk.north, chunk.south, firstZoom, lastZoom);
+      if (at == null) {
+        chunks.add(chunk.toBounds());
+      } else if (isWide) {
+        split(_BoundsCover(chunk.west, chunk.north, at, chunk.south));
+        split(_BoundsCover(at, chunk.north, chunk.east, chunk.south));
+      } else {
+        split(_BoundsCover(chunk.west, chunk.north, chunk.east, at));
+        split(_BoundsCover(chunk.west, at, chunk.east, chunk.south));
+      }
+    }
+
+    split(_BoundsCover.fromBounds(bounds));
+    // unchanged instead of converted to world coordinates and back
+    return chunks.length == 1 ? [bounds] : chunks;
+  }
+
+  /// The tile boundary between [low] and [high] of the lowest zoom level that
+  /// is in the middle half of them, or else the boundary closest to the
+  /// middle at [lastZoom].
+  static double? _splitPosition(
+      double low, double high, int firstZoom, int lastZoom) {
+    final middle = (low + high) / 2;
+    final slack = (high - low) / 4;
+    for (var zoom = firstZoom; zoom <= lastZoom; zoom++) {
+      final tiles = pow(2, zoom).toDouble();
+      final boundary = (middle * tiles).roundToDouble() / tiles;
+      if ((boundary - middle).abs() <= slack &&
+          boundary > low &&
+          boundary < high) {
+        return boundary;
+      }
+    }
+    final tiles = pow(2, lastZoom).toDouble();
+    final boundary = (middle * tiles).roundToDouble() / tiles;
+    return boundary > low && boundary < high ? boundary : null;
+  }
+}
+
+/// The tiles of an offline region per zoom level, see [OfflineTilePlanner].
+@immutable
+class OfflineTilePlan {
+  const OfflineTilePlan._(this.tileCounts, this._cover);
+
+  /// The number of tiles per zoom level, in ascending order of zoom.
+  final Map<int, int> tileCounts;
+  final _TileCover _cover;
+
+  int get tileCount => tileCounts.values.fold(0, (sum, count) => sum + count);
+
+  /// The estimated size of the tiles in bytes.
+  int estimateBytes(OfflineTileSizeModel model) {
+    var bytes = 0;
+    tileCounts.forEach(
+        (zoom, count) => bytes += count * model.bytesPerTile(zoom));
+    return bytes;
+  }
+
+  /// The tiles and bytes this plan saves compared to [other], e.g. a region
+  /// of a geometry compared to the region of its bounding box.
+  OfflineTileSavings savingsComparedTo(OfflineTilePlan other,
+      [OfflineTileSizeModel model = const OfflineTileSizeModel()]) {
+    return OfflineTileSavings(
+      tiles: other.tileCount - tileCount,
+      bytes: other.estimateBytes(model) - estimateBytes(model),
+      fraction: other.tileCount > 0 ? 1 - tileCount / other.tileCount : 0,
+    );
+  }
+
+  /// The tiles of all zoom levels, as zoom, x and y.
+  Iterable<(int, int, int)> tiles() sync* {
+    for (final zoom in tileCounts.keys) {
+      for (final (x, y) in _cover.tilesAt(zoom)) {
+        yield (zoom, x, y);
+      }
+    }
+  }
+
+  /// Picks [count] tiles of [zoom] at random, e.g. to measure their size,
+  /// as x and y coordinates. Tiles may be picked more than once.
+  List<(int, int)> sampleTiles(int zoom, int count, [Random? random]) {
+    final tileCount = tileCounts[zoom] ?? 0;
+    if (tileCount == 0) return const [];
+    random ??= Random();
+    return [
+      for (var i = 0; i < count; i++)
+        _cover.tileAt(zoom, random.nextInt(min(tileCount, 1 << 31))),
+    ];
+  }
+}
+
+/// The tiles and bytes one offline region saves compared to another, see
+/// [OfflineTilePlan.savingsComparedTo].
+@immutable
+class OfflineTileSavings {
+  const OfflineTileSavings({
+    required this.tiles,
+    required this.bytes,
+    required this.fraction,
+  });
+
+  final int tiles;
+
+  /// The estimated bytes saved.
+  final int bytes;
+
+  /// The saved fraction of the tiles of the other region.
+  final double fraction;
+
+  /// The download time saved at a throughput of [tilesPerSecond], e.g. of
+  /// the offline download queue.
+  Duration timeAt(double tilesPerSecond) => Duration(
+      microseconds: (tiles / tilesPerSecond * Duration.microsecondsPerSecond)
+          .round());
+
+  @override
+  String toString() => 'OfflineTileSavings, tiles = $tiles, bytes = $bytes, '
+      'fraction = $fraction';
+}
+
+/// The average size of a tile per zoom level, to estimate the size of an
+/// offline region with [OfflineTilePlan.estimateBytes].
+@immutable
+class OfflineTileSizeModel {
+  const OfflineTileSizeModel({
+    this.averageTileBytes = const {},
+    this.defaultTileBytes = 30000,
+  });
+
+  /// The average tile size in bytes per zoom level.
+  final Map<int, int> averageTileBytes;
+
+  /// The tile size of zoom levels without an average, if there is no average
+  /// of any zoom level.
+  final int defaultTileBytes;
+
+  /// The average tile size of [zoom], or else of the closest zoom level with
+  /// an average.
+  int bytesPerTile(int zoom) {
+    final bytes = averageTileBytes[zoom];
+    if (bytes != null) return bytes;
+    int? closest;
+    for (final other in averageTileBytes.keys) {
+      if (closest == null ||
+          (other - zoom).abs() < (closest - zoom).abs() ||
+          ((other - zoom).abs() == (closest - zoom).abs() && other > closest)) {
+        closest = other;
+      }
+    }
+    return closest == null ? defaultTileBytes : averageTileBytes[closest]!;
+  }
+
+  /// Measures the average tile size of each zoom level of [plan] with
+  /// [samplesPerZoom] tiles picked at random.
+  ///
+  /// Zoom levels of which no tile could be measured use the average of the
+  /// closest zoom level.
+  static Future<OfflineTileSizeModel> probe(
+    OfflineTilePlan plan,
+    TileSizeProbe tileSize, {
+    int samplesPerZoom = 5,
+    int defaultTileBytes = 30000,
+    Random? random,
+  }) async {
+    final averages = <int, int>{};
+    for (final zoom in plan.tileCounts.keys) {
+      final sizes = await Future.wait([
+        for (final (x, y) in plan.sampleTiles(zoom, samplesPerZoom, random))
+          tileSize(zoom, x, y),
+      ]);
+      final measured = sizes.whereType<int>();
+      if (measured.isNotEmpty) {
+        averages[zoom] =
+            measured.reduce((sum, size) => sum + size) ~/ measured.length;
+      }
+    }
+    return OfflineTileSizeModel(
+      averageTileBytes: averages,
+      defaultTileBytes: defaultTileBytes,
+    );
+  }
+}
+
+/// Snaps [value] to the closest integer if it only differs by a rounding
+/// error, e.g. after converting tile boundaries to degrees and back.
+double _snapTileCoordinate(double value) {
+  final rounded = value.roundToDouble();
+  return (value - rounded).abs() < 1e-6 ? rounded : value;
+}
+
+/// The x coordinate of [longitude] in the Web Mercator world, from 0 to 1.
+double _worldX(double longitude) => (longitude + 180) / 360;
+
+/// The y coordinate of [latitude] in the Web Mercator world, from 0 at the
+/// north to 1 at the south.
+double _worldY(double latitude) {
+  const maxLatitude = 85.051128779806604;
+  final radians = latitude.clamp(-maxLatitude, maxLatitude) * pi / 180;
+  return (1 - log(tan(radians) + 1 / cos(radians)) / pi) / 2;
+}
+
+abstract class _TileCover {
+  int count(int zoom);
+
+  /// The tile with [index] in row-major order of the tiles at [zoom].
+  (int, int) tileAt(int zoom, int index);
+
+  Iterable<(int, int)> tilesAt(int zoom);
+}
+
+/// The tiles of a rectangle in world coordinates. [east] is larger than 1 if
+/// the rectangle crosses the antimeridian.
+class _BoundsCover implements _TileCover {
+  _BoundsCover(this.west, this.north, this.east, this.south);
+
+  factory _BoundsCover.fromBounds(LatLngBounds bounds) {
+    final west = _worldX(bounds.southwest.longitude);
+    var east = _worldX(bounds.northeast.longitude);
+    if (east < west) east += 1;
+    return _BoundsCover(west, _worldY(bounds.northeast.latitude), east,
+        _worldY(bounds.southwest.latitude));
+  }
+
+  final double west;
+  final double north;
+  final double east;
+  final double south;
+
+  /// The first tile and the number of tiles along [from] to [to] in world
+  /// coordinates, the tiles intersecting it at [tiles] per axis.
+  static (int, int) _range(double from, double to, int tiles) {
+    final first =
+        min(_snapTileCoordinate(from * tiles).floor(), tiles - 1);
+    final end = max(first + 1, _snapTileCoordinate(to * tiles).ceil());
+    return (first, min(end - first, tiles));
+  }
+
+  @override
+  int count(int zoom) {
+    final tiles = 1 << zoom;
+    return _range(west, east, tiles).$2 * _range(north, south, tiles).$2;
+  }
+
+  @override
+  (int, int) tileAt(int zoom, int index) {
+    final tiles = 1 << zoom;
+    final (firstX, columns) = _range(west, east, tiles);
+    final (firstY, _) = _range(north, south, tiles);
+    return ((firstX + index % columns) % tiles, firstY + index ~/ columns);
+  }
+
+  @override
+  Iterable<(int, int)> tilesAt(int zoom) sync* {
+    final tiles = 1 << zoom;
+    final (firstX, columns) = _range(west, east, tiles);
+    final (firstY, rows) = _range(north, south, tiles);
+    for (var y = firstY; y < firstY + rows; y++) {
+      for (var x = firstX; x < firstX + columns; x++) {
+        yield (x % tiles, y);
+      }
+    }
+  }
+
+  LatLngBounds toBounds() {
+    double latitude(double y) => atan(_sinh(pi * (1 - 2 * y))) * 180 / pi;
+    return LatLngBounds(
+      southwest: LatLng(latitude(south), west * 360 - 180),
+      northeast: LatLng(latitude(north), east * 360 - 180),
+    );
+  }
+
+  static double _sinh(double x) => (exp(x) - exp(-x)) / 2;
+}
+
+/// The tiles of a polygon with holes.
+///
+/// Each row of tiles is covered by the tiles that the edges of the polygon
+/// cross in that row, and by the tiles between them whose centers are
+/// inside the polygon, by the even-odd rule. The tiles are kept as runs per
+/// row, so the cost grows with the perimeter and the height of the polygon
+/// in tiles instead of its area.
+class _PolygonCover implements _TileCover {
+  _PolygonCover(List<List<List<LatLng>>> polygons)
+      : _polygons = [
+          for (final rings in polygons)
+            [
+              for (final ring in rings)
+                [
+                  for (final point in ring)
+                    Point(_worldX(point.longitude), _worldY(point.latitude)),
+                ],
+            ],
+        ];
+
+  /// The rings of each polygon in world coordinates.
+  final List<List<List<Point<double>>>> _polygons;
+  int? _rowsZoom;
+  SplayTreeMap<int, List<int>>? _rows;
+
+  @override
+  int count(int zoom) {
+    var count = 0;
+    for (final runs in _rowsAt(zoom).values) {
+      for (var i = 0; i < runs.length; i += 2) {
+        count += runs[i + 1] - runs[i];
+      }
+    }
+    return count;
+  }
+
+  @override
+  (int, int) tileAt(int zoom, int index) {
+    for (final MapEntry(key: row, value: runs) in _rowsAt(zoom).entries) {
+      for (var i = 0; i < runs.length; i += 2) {
+        final length = runs[i + 1] - runs[i];
+        if (index < length) return (runs[i] + index, row);
+        index -= length;
+      }
+    }
+    throw RangeError.index(index, this, 'index');
+  }
+
+  @override
+  Iterable<(int, int)> tilesAt(int zoom) sync* {
+    for (final MapEntry(key: row, value: runs) in _rowsAt(zoom).entries) {
+      for (var i = 0; i < runs.length; i += 2) {
+        for (var x = runs[i]; x < runs[i + 1]; x++) {
+          yield (x, row);
+        }
+      }
+    }
+  }
+
+  /// The runs of tiles of each row at [zoom], as the first and the end x of
+  /// each run.
+  SplayTreeMap<int, List<int>> _rowsAt(int zoom) {
+    if (_rowsZoom == zoom) return _rows!;
+    final tiles = 1 << zoom;
+    final runs = <int, List<int>>{};
+    final crossings = <int, List<double>>{};
+
+    void addRun(int row, int first, int end) {
+      first = max(first, 0);
+      end = min(end, tiles);
+      if (first < end) (runs[row] ??= []).addAll([first, end]);
+    }
+
+    // the tiles an edge crosses from [a] to [b] within a row. An edge along
+    // a tile boundary is skipped, the tiles inside of it are filled.
+    void addEdgeRun(int row, double a, double b) {
+      final from = _snapTileCoordinate(min(a, b));
+      final to = _snapTileCoordinate(max(a, b));
+      if (from == to && from == from.roundToDouble()) return;
+      final first = from.floor();
+      addRun(row, first, max(first + 1, to.ceil()));
+    }
+
+    for (final rings in _polygons) {
+      for (final ring in rings) {
+        for (var i = 0; i < ring.length; i++) {
+          final x0 = ring[i].x * tiles;
+          final y0 = ring[i].y * tiles;
+          final x1 = ring[(i + 1) % ring.length].x * tiles;
+          final y1 = ring[(i + 1) % ring.length].y * tiles;
+          final top = min(y0, y1);
+          final bottom = max(y0, y1);
+          final firstRow = max(_snapTileCoordinate(top).floor(), 0);
+          if (y0 == y1) {
+            // horizontal edges on a row boundary are left to the other edges
+            if (_snapTileCoordinate(y0) != firstRow && firstRow < tiles) {
+              addEdgeRun(firstRow, x0, x1);
+            }
+            continue;
+          }
+          final lastRow =
+              min(_snapTileCoordinate(bottom).ceil() - 1, tiles - 1);
+          for (var row = firstRow; row <= lastRow; row++) {
+            // the part of the edge within the row
+            final xa = x0 + (x1 - x0) * (max(top, row) - y0) / (y1 - y0);
+            final xb = x0 + (x1 - x0) * (min(bottom, row + 1) - y0) / (y1 - y0);
+            addEdgeRun(row, xa, xb);
+            final center = row + 0.5;
+            if (center >= top && center < bottom) {
+              (crossings[row] ??= [])
+                  .add(x0 + (x1 - x0) * (center - y0) / (y1 - y0));
+            }
+          }
+        }
+      }
+
+      // the polygons are filled separately, their union is covered
+      crossings.forEach((row, xs) {
+        xs.sort();
+        for (var i = 0; i + 1 < xs.length; i += 2) {
+          // the tiles whose centers are between the crossings
+          addRun(row, (xs[i] - 0.5).ceil(), (xs[i + 1] - 0.5).floor() + 1);
+        }
+      });
+      crossings.clear();
+    }
+
+    final rows = SplayTreeMap<int, List<int>>();
+    runs.forEach((row, unmerged) => rows[row] = _merge(unmerged));
+    _rowsZoom = zoom;
+    return _rows = rows;
+  }
+
+  /// Merges overlapping and adjacent runs, given as first and end x.
+  static List<int> _merge(List<int> runs) {
+    final order = List.generate(runs.length ~/ 2, (i) => i)
+      ..sort((a, b) => runs[a * 2].compareTo(runs[b * 2]));
+    final merged = <int>[];
+    for (final i in order) {
+      final first = runs[i * 2];
+      final end = runs[i * 2 + 1];
+      if (merged.isNotEmpty && first <= merged.last) {
+        merged.last = max(merged.last, end);
+      } else {
+        merged.addAll([first, end]);
+      }
+    }
+    return merged;
+  }
+}
@@ -0,0 +1,184 @@
+part of '../maplibre_gl_platform_interface.dart';
+
+/// The validators of a stored tile, from the `ETag` and `Last-Modified`
+/// headers of the response it was stored from.
+@immutable
+class TileValidator {
+  const TileValidator({this.etag, this.lastModified, required this.size});
+
+  factory TileValidator.fromJson(Map<String, dynamic> json) => TileValidator(
+        etag: json['etag'],
+        lastModified: json['lastModified'],
+        size: json['size'],
+      );
+
+  final String? etag;
+  final String? lastModified;
+
+  /// The size of the stored tile in bytes.
+  final int size;
+
+  Map<String, dynamic> toJson() => {
+        if (etag != null) 'etag': etag,
+        if (lastModified != null) 'lastModified': lastModified,
+        'size': size,
+      };
+}
+
+/// The result of [OfflineTileRevalidator.revalidate] and of
+/// `OfflineDownloadQueue.refreshWithStatistics`.
+@immutable
+class OfflineRefreshStatistics {
+  const OfflineRefreshStatistics({
+    required this.unchanged,
+    required this.changed,
+    required this.failed,
+    required this.downloadedBytes,
+    required this.savedBytes,
+  });
+
+  /// The number of tiles the server reported as not modified.
+  final int unchanged;
+
+  /// The number of tiles downloaded because they changed or had no
+  /// validators.
+  final int changed;
+
+  /// The number of tiles whose request failed.
+  final int failed;
+
+  final int downloadedBytes;
+
+  /// The bytes of the unchanged tiles, which a full download would have
+  /// fetched again. Estimated for a refresh of an offline region.
+  final int savedBytes;
+
+  int get requests => unchanged + changed + failed;
+
+  @override
+  String toString() => 'OfflineRefreshStatistics, unchanged = $unchanged, '
+      'changed = $changed, failed = $failed, '
+      'downloadedBytes = $downloadedBytes, savedBytes = $savedBytes';
+}
+
+/// Finds the changed tiles of an offline region with conditional requests,
+/// instead of downloading all of its tiles again.
+///
+/// Each tile is requested with the `If-None-Match` and `If-Modified-Since`
+/// headers of its [TileValidator], so the server only sends the tiles that
+/// changed. At most [maxConcurrentRequests] requests run at the same time.
+///
+/// The validators are recorded by the app when it stores the tiles, e.g. in
+/// its own tile store, and the changed tiles are passed to `onChanged` of
+/// [revalidate] to write them to that store. Tiles without a validator are
+/// downloaded in full. The database of MapLibre does not expose the
+/// validators of its tiles, refresh MapLibre offline regions with
+/// `OfflineDownloadQueue.refreshWithStatistics` instead, which revalidates
+/// them natively.
+///
+/// Example:
+/// ```dart
+/// final revalidator = OfflineTileRevalidator(
+///     urlTemplate: 'https://tiles.example.com/{z}/{x}/{y}.pbf');
+/// final statistics = await revalidator.revalidate(
+///     plan.tiles(), tileStore.validators,
+///     onChanged: tileStore.write);
+/// ```
+class OfflineTileRevalidator {
+  OfflineTileRevalidator({
+    required this.urlTemplate,
+    this.headers = const {},
+    this.maxConcurrentRequests = 8,
+    HttpClient? client,
+  })  : assert(maxConcurrentRequests > 0),
+        _client = client ?? HttpClient();
+
+  /// The url of the tiles, with `{z}`, `{x}` and `{y}` placeholders.
+  final String urlTemplate;
+
+  /// Headers added to each request, e.g. for authorization.
+  final Map<String, String> headers;
+
+  final int maxConcurrentRequests;
+  final HttpClient _client;
+
+  String urlOf(int zoom, int x, int y) => urlTemplate
+      .replaceAll('{z}', '$zoom')
+      .replaceAll('{x}', '$x')
+      .replaceAll('{y}', '$y');
+
+  /// Requests [tiles], given as zoom, x and y, conditionally on their
+  /// [validators] by url. The validators of changed tiles are replaced.
+  Future<OfflineRefreshStatistics> revalidate(
+    Iterable<(int, int, int)> tiles,
+    Map<String, TileValidator> validators, {
+    void Function(int zoom, int x, int y, Uint8List data)? onChanged,
+  }) async {
+    var unchanged = 0;
+    var changed = 0;
+    var failed = 0;
+    var downloadedBytes = 0;
+    var savedBytes = 0;
+
+    Future<void> revalidateTile(int zoom, int x, int y) async {
+      final url = urlOf(zoom, x, y);
+      final validator = validators[url];
+      try {
+        final request = await _client.getUrl(Uri.parse(url));
+        headers.forEach(request.headers.set);
+        if (validator?.etag != null) {
+          request.headers.set(HttpHeaders.ifNoneMatchHeader, validator!.etag!);
+        }
+        if (validator?.lastModified != null) {
+          request.headers.set(
+              HttpHeaders.ifModifiedSinceHeader, validator!.lastModified!);
+        }
+        final response = await request.close();
+        if (response.statusCode == HttpStatus.notModified &&
+            validator != null) {
+          await response.drain<void>();
+          unchanged++;
+          savedBytes += validator.size;
+        } else if (response.statusCode == HttpStatus.ok) {
+          final data = await consolidateHttpClientResponseBytes(response);
+          changed++;
+          downloadedBytes += data.length;
+          validators[url] = TileValidator(
+            etag: response.headers.value(HttpHeaders.etagHeader),
+            lastModified:
+                response.headers.value(HttpHeaders.lastModifiedHeader),
+            size: data.length,
+          );
+          onChanged?.call(zoom, x, y, data);
+        } else {
+          await response.drain<void>();
+          failed++;
+        }
+      } on Exception {
+        failed++;
+      }
+    }
+
+    // the workers share the iterator, each takes the next tile when done
+    final iterator = tiles.iterator;
+    Future<void> worker() async {
+      while (iterator.moveNext()) {
+        final (zoom, x, y) = iterator.current;
+        await revalidateTile(zoom, x, y);
+      }
+    }
+
+    await Future.wait([
+      for (var i = 0; i < maxConcurrentRequests; i++) worker(),
+    ]);
+    return OfflineRefreshStatistics(
+      unchanged: unchanged,
+      changed: changed,
+      failed: failed,
+      downloadedBytes: downloadedBytes,
+      savedBytes: savedBytes,
+    );
+  }
+
+  void close() => _client.close();
+}
@@ -0,0 +1,387 @@
+part of '../maplibre_gl_platform_interface.dart';
+
+/// A position matched to a route, see [RoutePrefetchPlanner.locate].
+@immutable
+class RoutePosition {
+  const RoutePosition({
+    required this.point,
+    required this.distanceAlong,
+    required this.offset,
+  });
+
+  /// The closest point of the route.
+  final LatLng point;
+
+  /// The distance from the start of the route to [point] in meters.
+  final double distanceAlong;
+
+  /// The distance of the located position from [point] in meters.
+  final double offset;
+
+  @override
+  String toString() => 'RoutePosition, point = $point, '
+      'distanceAlong = $distanceAlong, offset = $offset';
+}
+
+/// The tiles the camera needs along a part of a route, see
+/// [RoutePrefetchPlanner.plan].
+@immutable
+class RoutePrefetchPlan {
+  const RoutePrefetchPlan({
+    required this.path,
+    required this.fromDistance,
+    required this.toDistance,
+    required this.width,
+    required this.minZoom,
+    required this.maxZoom,
+    required this.tiles,
+  });
+
+  /// The part of the route from [fromDistance] to [toDistance] meters.
+  final List<LatLng> path;
+  final double fromDistance;
+  final double toDistance;
+
+  /// The width in meters of the corridor along [path] that the viewport
+  /// shows.
+  final double width;
+
+  /// The zoom levels the viewport loads tiles of, lower at the far end of a
+  /// tilted viewport.
+  final double minZoom;
+  final double maxZoom;
+
+  /// The tiles of the corridor.
+  final OfflineTilePlan tiles;
+
+  @override
+  String toString() => 'RoutePrefetchPlan, fromDistance = $fromDistance, '
+      'toDistance = $toDistance, width = $width, minZoom = $minZoom, '
+      'maxZoom = $maxZoom, tiles = ${tiles.tileCount}';
+}
+
+/// Predicts the tiles the camera of a navigation will need along a known
+/// route.
+///
+/// The position of the user is matched to the route, and the part of the
+/// route the user covers at the current speed within a time horizon is
+/// planned as a corridor as wide as the viewport at the current zoom and
+/// tilt. A tilted viewport shows the route further ahead and wider at its
+/// top, where the map loads tiles of lower zoom levels, so tilt widens the
+/// corridor, extends it ahead and adds lower zoom levels.
+///
+/// The viewport is assumed to be centered on the user and, if
+/// [rotatesWithBearing], to rotate with the direction of travel like a
+/// tracking camera. Otherwise the corridor is as wide as the longer side of
+/// the viewport, for any direction of the route.
+///
+/// Distances are in meters, computed on a local equirectangular projection,
+/// which is exact enough for the segments of a route.
+class RoutePrefetchPlanner {
+  RoutePrefetchPlanner(
+    List<LatLng> route, {
+    this.viewportWidth = 400,
+    this.viewportHeight = 800,
+    this.rotatesWithBearing = true,
+    this.maxOffRouteDistance = 200,
+    this.minSpeed = 5,
+    this.tilePlanner = const OfflineTilePlanner(),
+  })  : assert(route.length >= 2),
+        route = List.unmodifiable(route),
+        _distances = _cumulativeDistances(route);
+
+  final List<LatLng> route;
+
+  /// The size of the viewport in logical pixels.
+  final double viewportWidth;
+  final double viewportHeight;
+
+  final bool rotatesWithBearing;
+
+  /// Positions further from the route are not matched to it.
+  final double maxOffRouteDistance;
+
+  /// The speed in meters per second assumed at lower speeds, e.g. at a
+  /// traffic light, so the tiles right ahead are planned anyway.
+  final double minSpeed;
+
+  /// Counts the tiles of the source, see [OfflineTilePlanner].
+  final OfflineTilePlanner tilePlanner;
+
+  /// The distance from the start of the route to each of its points.
+  final List<double> _distances;
+
+  static const _earthRadius = 6371008.8;
+  static const _metersPerDegree = pi * _earthRadius / 180;
+
+  /// The vertical field of view of MapLibre.
+  static const _fieldOfView = 0.6435011087932844;
+
+  /// The length of the route in meters.
+  double get length => _distances.last;
+
+  static List<double> _cumulativeDistances(List<LatLng> route) {
+    final distances = [0.0];
+    for (var i = 1; i < route.length; i++) {
+      distances.add(distances.last + _distance(route[i - 1], route[i]));
+    }
+    return distances;
+  }
+
+  /// The east and north meters from [from] to [to].
+  static (double, double) _offset(LatLng from, LatLng to) {
+    final latitude = (from.latitude + to.latitude) / 2;
+    return (
+      (to.longitude - from.longitude) *
+          cos(latitude * pi / 180) *
+          _metersPerDegree,
+      (to.latitude - from.latitude) * _metersPerDegree,
+    );
+  }
+
+  static double _distance(LatLng from, LatLng to) {
+    final (east, north) = _offset(from, to);
+    return sqrt(east * east + north * north);
+  }
+
+  /// The difference of two bearings in degrees, from 0 to 180.
+  static double _bearingDifference(double a, double b) {
+    final difference = (a - b).abs() % 360;
+    return difference > 180 ? 360 - difference : difference;
+  }
+
+  /// Matches [position] to the closest point of the route.
+  ///
+  /// Routes may pass the same place more than once, e.g. out and back on
+  /// the same road. Points where the route runs in the direction of
+  /// [bearing], within 90 degrees, and points from [notBefore] meters on,
+  /// e.g. the distance of the previous match, are preferred over closer
+  /// points. Returns null if the position is more than
+  /// [maxOffRouteDistance] away from the route.
+  RoutePosition? locate(
+    LatLng position, {
+    double? bearing,
+    double notBefore = 0,
+  }) {
+    RoutePosition? best;
+    var bestScore = double.infinity;
+    for (var i = 1; i < route.length; i++) {
+      final from = route[i - 1];
+      final length = _distances[i] - _distances[i - 1];
+      final (east, north) = _offset(from, route[i]);
+      final (pointEast, pointNorth) = _offset(from, position);
+      final t = length > 0
+          ? ((pointEast * east + pointNorth * north) / (length * length))
+              .clamp(0.0, 1.0)
+          : 0.0;
+      final offsetEast = pointEast - east * t;
+      final offsetNorth = pointNorth - north * t;
+      final offset = sqrt(offsetEast * offsetEast + offsetNorth * offsetNorth);
+      if (offset > maxOffRouteDistance) continue;
+      final distanceAlong = _distances[i - 1] + length * t;
+      // a mismatch weighs more than any offset of a candidate
+      var score = offset;
+      if (bearing != null &&
+          length > 0 &&
+          _bearingDifference(atan2(east, north) * 180 / pi, bearing) > 90) {
+        score += 2 * maxOffRouteDistance;
+      }
+      if (distanceAlong < notBefore - maxOffRouteDistance) {
+        score += 4 * maxOffRouteDistance;
+      }
+      if (score < bestScore) {
+        bestScore = score;
+        best = RoutePosition(
+          point: _pointAt(i, distanceAlong),
+          distanceAlong: distanceAlong,
+          offset: offset,
+        );
+      }
+    }
+    return best;
+  }
+
+  /// The point [distance] meters along the segment that ends at point [i].
+  LatLng _pointAt(int i, double distance) {
+    final from = route[i - 1];
+    final to = route[i];
+    final length = _distances[i] - _distances[i - 1];
+    final t = length > 0 ? (distance - _distances[i - 1]) / length : 0.0;
+    return LatLng(
+      from.latitude + (to.latitude - from.latitude) * t,
+      from.longitude + (to.longitude - from.longitude) * t,
+    );
+  }
+
+  /// The part of the route from [from] to [to] meters, clamped to the
+  /// route.
+  List<LatLng> pathBetween(double from, double to) {
+    from = from.clamp(0.0, length);
+    to = to.clamp(from, length);
+    var i = 1;
+    while (i < route.length - 1 && _distances[i] <= from) {
+      i++;
+    }
+    final path = [_pointAt(i, from)];
+    while (i < route.length - 1 && _distances[i] < to) {
+      path.add(route[i]);
+      i++;
+    }
+    path.add(_pointAt(i, to));
+    return path;
+  }
+
+  /// The meters per logical pixel at the center of the viewport.
+  static double metersPerPixel(double zoom, double latitude) =>
+      2 * pi * _earthRadius * cos(latitude * pi / 180) / (512 * pow(2, zoom));
+
+  /// The ground distance in pixels at the scale of the center from the
+  /// center to the top edge of the viewport, and the scale of the top edge
+  /// relative to the center, for [tilt] in degrees.
+  (double, double) _topEdge(double tilt) {
+    const halfFov = _fieldOfView / 2;
+    // keeps the top edge below the horizon
+    final pitch = min(tilt * pi / 180, pi / 2 - halfFov - 0.05);
+    final cameraToCenter = viewportHeight / 2 / tan(halfFov);
+    final height = cameraToCenter * cos(pitch);
+    final distance =
+        height * tan(pitch + halfFov) - cameraToCenter * sin(pitch);
+    final scale = cos(pitch) * cos(halfFov) / cos(pitch + halfFov);
+    return (distance, scale);
+  }
+
+  /// The width in meters of the corridor the viewport shows along the route
+  /// at [zoom] and [tilt].
+  double corridorWidth(double zoom, double tilt, double latitude) {
+    final (_, scale) = _topEdge(tilt);
+    final pixels = rotatesWithBearing
+        ? viewportWidth * scale
+        : max(viewportWidth, viewportHeight) * scale;
+    return pixels * metersPerPixel(zoom, latitude);
+  }
+
+  /// The meters the viewport shows ahead of the user at [zoom] and [tilt].
+  double viewAhead(double zoom, double tilt, double latitude) {
+    final (distance, scale) = _topEdge(tilt);
+    final pixels = rotatesWithBearing
+        ? distance
+        : max(distance, viewportWidth / 2 * scale);
+    return pixels * metersPerPixel(zoom, latitude);
+  }
+
+  /// The zoom levels of the tiles the viewport loads at [zoom] and [tilt].
+  (double, double) zoomRange(double zoom, double tilt) {
+    final (_, scale) = _topEdge(tilt);
+    return (max(zoom - log(scale) / ln2, 0), zoom);
+  }
+
+  /// Plans the tiles the camera needs from [position], as matched by
+  /// [locate], until [horizon] at [speed] meters per second, as seen at
+  /// [zoom] and [tilt].
+  ///
+  /// Only the route after [prefetchedUntil] meters is planned, so a plan
+  /// continues the previous one, and at most [maxLength] meters of it, e.g.
+  /// to prefetch the route in parts. Returns null if nothing is left to
+  /// plan.
+  RoutePrefetchPlan? plan({
+    required RoutePosition position,
+    required double speed,
+    required Duration horizon,
+    required double zoom,
+    double tilt = 0,
+    double prefetchedUntil = 0,
+    double maxLength = double.infinity,
+  }) {
+    final latitude = position.point.latitude;
+    final ahead = max(speed, minSpeed) *
+            horizon.inMilliseconds /
+            Duration.millisecondsPerSecond +
+        viewAhead(zoom, tilt, latitude);
+    final from = max(position.distanceAlong, prefetchedUntil);
+    final to =
+        min(min(position.distanceAlong + ahead, length), from + maxLength);
+    if (to <= from) return null;
+    final path = pathBetween(from, to);
+    final width = corridorWidth(zoom, tilt, latitude);
+    final (minZoom, maxZoom) = zoomRange(zoom, tilt);
+    return RoutePrefetchPlan(
+      path: path,
+      fromDistance: from,
+      toDistance: to,
+      width: width,
+      minZoom: minZoom,
+      maxZoom: maxZoom,
+      tiles: tilePlanner.planPolygons(
+          OfflineTilePlanner.corridorPolygons(path, width), minZoom, maxZoom),
+    );
+  }
+}
+
+/// Paces prefetches by the measured bandwidth, so they leave enough of it to
+/// the tiles the map loads itself.
+///
+/// The bandwidth is an exponential moving average of the measured
+/// throughput. Prefetches may use [maxBandwidthShare] of it, and at most
+/// [maxBytesPerSecond], e.g. on metered connections: after a prefetch of
+/// some bytes, the next one waits until the average rate is within that
+/// budget.
+class PrefetchPacer {
+  PrefetchPacer({
+    this.maxBandwidthShare = 0.5,
+    this.maxBytesPerSecond,
+    this.smoothing = 0.3,
+    this.maxDelay = const Duration(seconds: 30),
+  }) : assert(maxBandwidthShare > 0 && maxBandwidthShare <= 1);
+
+  final double maxBandwidthShare;
+  final double? maxBytesPerSecond;
+
+  /// The weight of a new measurement in the average, from 0 to 1.
+  final double smoothing;
+
+  /// The longest wait between prefetches, even on a slow connection.
+  final Duration maxDelay;
+
+  double? _bandwidth;
+
+  /// The average throughput in bytes per second, null until measured.
+  double? get bandwidth => _bandwidth;
+
+  /// The bytes per second prefetches may use, null if unlimited.
+  double? get budget {
+    final share = _bandwidth == null ? null : _bandwidth! * maxBandwidthShare;
+    if (share == null) return maxBytesPerSecond;
+    return maxBytesPerSecond == null ? share : min(share, maxBytesPerSecond!);
+  }
+
+  /// Adds a measurement of the throughput in bytes per second.
+  void addThroughput(double bytesPerSecond) {
+    final bandwidth = _bandwidth;
+    _bandwidth = bandwidth == null
+        ? bytesPerSecond
+        : bandwidth + (bytesPerSecond - bandwidth) * smoothing;
+  }
+
+  /// The time to wait after a prefetch of [bytes] that took [elapsed].
+  Duration delayAfter(int bytes, Duration elapsed) {
+    final budget = this.budget;
+    if (budget == null || budget <= 0) return Duration.zero;
+    final delay = Duration(
+            microseconds:
+                (bytes / budget * Duration.microsecondsPerSecond).round()) -
+        elapsed;
+    if (delay <= Duration.zero) return Duration.zero;
+    return delay < maxDelay ? delay : maxDelay;
+  }
+
+  /// Whether [bytes] can be downloaded within [time] at the budget, e.g.
+  /// before the camera reaches the tiles. Always true until measured.
+  bool canDownloadWithin(int bytes, Duration time) {
+    final budget = this.budget;
+    if (budget == null) return true;
+    return bytes <=
+        budget * time.inMicroseconds / Duration.microsecondsPerSecond;
+  }
+
+  void reset() => _bandwidth = null;
+}
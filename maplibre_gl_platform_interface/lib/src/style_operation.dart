@@ -0,0 +1,35 @@
+part of '../maplibre_gl_platform_interface.dart';
+
+/// Describes a single operation of a style transaction that could not be
+/// applied on the platform side.
+///
+/// The remaining operations of the transaction are still applied, so a
+/// transaction may partially succeed.
+@immutable
+class StyleOperationError {
+  const StyleOperationError({
+    required this.index,
+    required this.code,
+    this.message,
+  });
+
+  /// Position of the failed operation within the transaction.
+  final int index;
+
+  /// Platform specific error code, e.g. `layerNotFound`.
+  final String code;
+
+  /// Human readable description of the failure.
+  final String? message;
+
+  static StyleOperationError fromMap(Map<dynamic, dynamic> map) {
+    return StyleOperationError(
+      index: map['index'] as int,
+      code: map['code'].toString(),
+      message: map['message']?.toString(),
+    );
+  }
+
+  @override
+  String toString() => 'StyleOperationError($index, $code, $message)';
+}
@@ -0,0 +1,39 @@
+import 'package:flutter_test/flutter_test.dart';
+import 'package:maplibre_gl_platform_interface/maplibre_gl_platform_interface.dart';
+
+const megabyte = 1024 * 1024;
+const gigabyte = 1024 * megabyte;
+
+AmbientCacheStatistics statistics({required int freeSpace, int database = 0}) =>
+    AmbientCacheStatistics.fromMap({
+      'databaseSize': database,
+      'maximumAmbientCacheSize':
+          AmbientCacheStatistics.defaultMaximumAmbientCacheSize,
+      'freeSpace': freeSpace,
+      'totalSpace': 256 * gigabyte,
+    });
+
+void main() {
+  group(AmbientCacheStatistics, () {
+    test('recommends a fraction of the free and cache storage', () {
+      expect(
+          statistics(freeSpace: 20 * gigabyte, database: 5 * gigabyte)
+              .recommendedSize(),
+          (25 * gigabyte * 0.02).round());
+    });
+
+    test('keeps the default on small storage', () {
+      expect(statistics(freeSpace: gigabyte).recommendedSize(),
+          AmbientCacheStatistics.defaultMaximumAmbientCacheSize);
+    });
+
+    test('limits the size on large storage', () {
+      expect(statistics(freeSpace: 200 * gigabyte).recommendedSize(),
+          2 * gigabyte);
+      expect(
+          statistics(freeSpace: 200 * gigabyte)
+              .recommendedSize(fraction: 0.001, maximum: gigabyte),
+          (200 * gigabyte * 0.001).round());
+    });
+  });
+}
@@ -0,0 +1,122 @@
+import 'dart:math';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:maplibre_gl_platform_interface/maplibre_gl_platform_interface.dart';
+
+const world = [-180.0, -85.0, 180.0, 85.0];
+
+Map<String, dynamic> point(double lng, double lat, int id) => {
+      'type': 'Feature',
+      'id': id,
+      'properties': {'id': id, 'value': 1},
+      'geometry': {
+        'type': 'Point',
+        'coordinates': [lng, lat],
+      },
+    };
+
+/// Deterministic points spread over a few dense groups.
+List<Map<String, dynamic>> samplePoints(int count) {
+  final random = Random(42);
+  const centers = [
+    [13.4, 52.5],
+    [-74.0, 40.7],
+    [139.7, 35.7],
+    [179.4, -16.5],
+  ];
+  return [
+    for (var i = 0; i < count; i++)
+      point(
+        centers[i % centers.length][0] + random.nextDouble() - 0.5,
+        centers[i % centers.length][1] + random.nextDouble() - 0.5,
+        i,
+      ),
+  ];
+}
+
+int pointCount(Map<String, dynamic> feature) =>
+    feature['properties']['cluster'] == true
+        ? feature['properties']['point_count']
+        : 1;
+
+void main() {
+  group(ClusterIndex, () {
+    final points = samplePoints(1000);
+    final index = ClusterIndex()..load(points);
+
+    test('keeps every point on every zoom level', () {
+      for (var zoom = 0; zoom <= 17; zoom++) {
+        final features = index.getClusters(world, zoom);
+        expect(features.map(pointCount).fold(0, (a, b) => a + b), 1000,
+            reason: 'zoom $zoom');
+      }
+    });
+
+    test('clusters dense points on low zoom levels only', () {
+      expect(index.getClusters(world, 0), hasLength(4));
+      expect(index.getClusters(world, 17), hasLength(1000));
+    });
+
+    test('returns the points of a cluster as leaves', () {
+      final cluster = index.getClusters(world, 0).first;
+      final int clusterId = cluster['properties']['cluster_id'];
+      final int count = cluster['properties']['point_count'];
+
+      final leaves = index.getLeaves(clusterId, limit: count);
+      expect(leaves, hasLength(count));
+      expect(leaves.every((leaf) => points.contains(leaf)), isTrue);
+
+      final paged = [
+        for (var offset = 0; offset < count; offset += 100)
+          ...index.getLeaves(clusterId, limit: 100, offset: offset),
+      ];
+      expect(paged.map((leaf) => leaf['id']).toSet(),
+          leaves.map((leaf) => leaf['id']).toSet());
+    });
+
+    test('splits a cluster at its expansion zoom', () {
+      final cluster = index.getClusters(world, 0).first;
+      final int clusterId = cluster['properties']['cluster_id'];
+      final zoom = index.getClusterExpansionZoom(clusterId);
+      expect(zoom, greaterThan(0));
+      expect(
+          index.getClusters(world, zoom).any(
+              (feature) => feature['properties']['cluster_id'] == clusterId),
+          isFalse);
+    });
+
+    test('rejects unknown cluster ids', () {
+      expect(() => index.getChildren(-1), throwsArgumentError);
+      expect(() => index.getChildren(points.length + 12345 * 32),
+          throwsArgumentError);
+    });
+
+    test('queries bounds crossing the antimeridian', () {
+      final features = index.getClusters([170, -30, -170, 0], 17);
+      expect(features, isNotEmpty);
+      expect(features, hasLength(250));
+    });
+
+    test('aggregates cluster properties', () {
+      final index = ClusterIndex(
+        map: (properties) => {'sum': properties['value']},
+        reduce: (accumulated, properties) =>
+            accumulated['sum'] += properties['sum'],
+      )..load(points);
+      for (final feature in index.getClusters(world, 2)) {
+        final properties = feature['properties'];
+        if (properties['cluster'] == true) {
+          expect(properties['sum'], properties['point_count']);
+        }
+      }
+    });
+
+    test('abbreviates large point counts', () {
+      final index = ClusterIndex()
+        ..load([for (var i = 0; i < 12000; i++) point(0, 0, i)]);
+      final cluster = index.getClusters(world, 0).single;
+      expect(cluster['properties']['point_count'], 12000);
+      expect(cluster['properties']['point_count_abbreviated'], '12k');
+    });
+  });
+}
@@ -0,0 +1,387 @@
+import 'package:flutter_test/flutter_test.dart';
+import 'package:maplibre_gl_platform_interface/maplibre_gl_platform_interface.dart';
+
+const compiler = ExpressionCompiler();
+
+const contexts = [
+  (zoom: 3, properties: <String, dynamic>{'type': 'park', 'height': 10}),
+  (zoom: 10.5, properties: <String, dynamic>{'type': 'school', 'height': 42}),
+  (zoom: 18, properties: <String, dynamic>{'height': 0}),
+];
+
+/// Folds [expression] and verifies that the result evaluates to the same
+/// value as the original for all [contexts].
+dynamic expectSameResults(dynamic expression) {
+  final folded = compiler.fold(expression);
+  for (final context in contexts) {
+    expect(
+      compiler.evaluate(folded,
+          zoom: context.zoom, properties: context.properties),
+      compiler.evaluate(expression,
+          zoom: context.zoom, properties: context.properties),
+      reason: '$expression folded to $folded with $context',
+    );
+  }
+  return folded;
+}
+
+void main() {
+  group(ExpressionCompiler, () {
+    group('fold', () {
+      test('leaves literal values untouched', () {
+        expect(compiler.fold(5), 5);
+        expect(compiler.fold('#ff0000'), '#ff0000');
+        expect(compiler.fold([0, 1]), [0, 1]);
+        expect(compiler.fold(['Open Sans Regular']), ['Open Sans Regular']);
+      });
+
+      test('computes arithmetic on constants', () {
+        expect(
+            expectSameResults([
+              '*',
+              2,
+              ['+', 1, 2]
+            ]),
+            6);
+        expect(
+            expectSameResults([
+              '-',
+              ['^', 2, 3]
+            ]),
+            -8);
+      });
+
+      test('does not fold results that are not finite', () {
+        expect(compiler.fold(['/', 1, 0]), ['/', 1, 0]);
+        expect(compiler.fold(['ln', -1]), ['ln', -1]);
+      });
+
+      test('keeps feature dependent parts', () {
+        expect(
+            expectSameResults([
+              '*',
+              ['get', 'height'],
+              ['/', 10, 2]
+            ]),
+            [
+              '*',
+              ['get', 'height'],
+              5
+            ]);
+      });
+
+      test('selects the branch of a case with constant conditions', () {
+        expect(
+            expectSameResults([
+              'case',
+              ['==', 1, 2],
+              'a',
+              ['<', 1, 2],
+              'b',
+              'c'
+            ]),
+            'b');
+        expect(
+            expectSameResults([
+              'case',
+              false,
+              'a',
+              [
+                '==',
+                ['get', 'type'],
+                'park'
+              ],
+              'b',
+              true,
+              'c',
+              ['get', 'type'],
+              'd'
+            ]),
+            [
+              'case',
+              [
+                '==',
+                ['get', 'type'],
+                'park'
+              ],
+              'b',
+              'c'
+            ]);
+      });
+
+      test('selects the output of a match on a constant input', () {
+        expect(
+            expectSameResults([
+              'match',
+              ['concat', 'sch', 'ool'],
+              'park',
+              1,
+              ['school', 'university'],
+              2,
+              0
+            ]),
+            2);
+      });
+
+      test('collapses a match whose outputs are all equal', () {
+        expect(
+            expectSameResults([
+              'match',
+              ['get', 'type'],
+              'park',
+              ['+', 1, 1],
+              'school',
+              2,
+              ['*', 1, 2]
+            ]),
+            2);
+      });
+
+      test('folds the outputs of a feature dependent match', () {
+        expect(
+            expectSameResults([
+              'match',
+              ['get', 'type'],
+              'park',
+              ['+', 1, 1],
+              0
+            ]),
+            [
+              'match',
+              ['get', 'type'],
+              'park',
+              2,
+              0
+            ]);
+      });
+
+      test('interpolates over a constant input', () {
+        expect(
+            expectSameResults([
+              'interpolate',
+              ['linear'],
+              ['+', 5, 5],
+              0,
+              0,
+              20,
+              100
+            ]),
+            50);
+        expect(
+            expectSameResults([
+              'interpolate',
+              ['exponential', 2],
+              1,
+              0,
+              0,
+              2,
+              30
+            ]),
+            10);
+      });
+
+      test('collapses an interpolate over identical outputs', () {
+        expect(
+            expectSameResults([
+              'interpolate',
+              ['linear'],
+              ['zoom'],
+              5,
+              ['*', 2, 2],
+              15,
+              4
+            ]),
+            4);
+      });
+
+      test('keeps zoom interpolations', () {
+        final expression = [
+          'interpolate',
+          ['linear'],
+          ['zoom'],
+          5,
+          ['*', 1, 2],
+          15,
+          ['get', 'height']
+        ];
+        expect(expectSameResults(expression), [
+          'interpolate',
+          ['linear'],
+          ['zoom'],
+          5,
+          2,
+          15,
+          ['get', 'height']
+        ]);
+      });
+
+      test('selects the output of a step', () {
+        expect(expectSameResults(['step', 7, 'a', 5, 'b', 10, 'c']), 'b');
+        expect(
+            expectSameResults([
+              'step',
+              ['zoom'],
+              ['get', 'type'],
+              12,
+              'x'
+            ]),
+            [
+              'step',
+              ['zoom'],
+              ['get', 'type'],
+              12,
+              'x'
+            ]);
+      });
+
+      test('short circuits all and any', () {
+        expect(
+            expectSameResults([
+              'all',
+              ['has', 'type'],
+              ['==', 1, 2]
+            ]),
+            false);
+        expect(
+            expectSameResults([
+              'any',
+              false,
+              ['has', 'type']
+            ]),
+            [
+              'any',
+              ['has', 'type']
+            ]);
+      });
+
+      test('drops null arguments of coalesce', () {
+        expect(
+            expectSameResults([
+              'coalesce',
+              ['literal', null],
+              ['get', 'type'],
+              'none',
+              'unreachable'
+            ]),
+            [
+              'coalesce',
+              ['get', 'type'],
+              'none'
+            ]);
+      });
+
+      test('substitutes constant let bindings', () {
+        expect(
+            expectSameResults([
+              'let',
+              'size',
+              ['*', 2, 3],
+              [
+                '+',
+                ['var', 'size'],
+                1
+              ]
+            ]),
+            7);
+      });
+
+      test('wraps folded arrays in literal when nested', () {
+        expect(
+            compiler.fold([
+              'case',
+              ['has', 'type'],
+              [
+                'literal',
+                [0, 1]
+              ],
+              [
+                'literal',
+                [1, 0]
+              ]
+            ]),
+            [
+              'case',
+              ['has', 'type'],
+              [
+                'literal',
+                [0, 1]
+              ],
+              [
+                'literal',
+                [1, 0]
+              ]
+            ]);
+      });
+    });
+
+    group('validateLayerProperties', () {
+      test('accepts valid properties', () {
+        expect(
+            compiler.validateLayerProperties('circle', {
+              'circle-radius': [
+                'interpolate',
+                ['linear'],
+                ['zoom'],
+                5,
+                1,
+                15,
+                ['get', 'size']
+              ],
+              'circle-color': '#ff0000',
+              'circle-translate': [0, 1],
+              'visibility': 'visible',
+            }),
+            isEmpty);
+      });
+
+      test('reports unknown properties and operators', () {
+        final errors = compiler.validateLayerProperties('line', {
+          'circle-radius': 5,
+          'line-width': [
+            '+',
+            1,
+            ['unknown', 2]
+          ],
+        });
+        expect(errors.map((error) => error.property),
+            ['circle-radius', 'line-width']);
+        expect(errors.last.path, [2]);
+      });
+
+      test('reports constants outside of the specification', () {
+        final errors = compiler.validateLayerProperties('line', {
+          'line-opacity': ['+', 1, 1],
+          'line-join': 'sharp',
+          'line-translate': [1, 2, 3],
+        });
+        expect(errors, hasLength(3));
+      });
+
+      test('reports inputs not supported by a property', () {
+        final errors = compiler.validateLayerProperties('line', {
+          'line-translate-anchor': ['get', 'anchor'],
+          'visibility': [
+            'case',
+            ['has', 'hidden'],
+            'none',
+            'visible'
+          ],
+        });
+        expect(errors.map((error) => error.property),
+            ['line-translate-anchor', 'visibility']);
+      });
+
+      test('compileLayerProperties throws for invalid properties', () {
+        expect(
+            () => compiler
+                .compileLayerProperties('fill', {'fill-opacity': 'opaque'}),
+            throwsA(isA<ExpressionValidationException>()));
+        expect(
+            compiler.compileLayerProperties('fill', {
+              'fill-opacity': ['/', 1, 2]
+            }),
+            {'fill-opacity': 0.5});
+      });
+    });
+  });
+}
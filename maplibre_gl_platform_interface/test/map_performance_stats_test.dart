@@ -0,0 +1,90 @@
+import 'package:flutter_test/flutter_test.dart';
+import 'package:maplibre_gl_platform_interface/maplibre_gl_platform_interface.dart';
+
+void main() {
+  group(TileSourceStatistics, () {
+    final statistics = TileSourceStatistics.fromMap({
+      'requests': 10,
+      'failures': 1,
+      'networkResponses': 5,
+      'ambientCacheHits': 3,
+      'httpCacheHits': 1,
+      'bytes': 12345,
+      'latencies': [90, 10, 80, 20, 70, 30, 60, 40, 50, 100],
+    });
+
+    test('reads the statistics sent by the platform', () {
+      expect(statistics.requests, 10);
+      expect(statistics.bytes, 12345);
+      expect(statistics.cacheHitRate, 0.4);
+      expect(statistics.latencies.first, const Duration(milliseconds: 10));
+    });
+
+    test('computes nearest rank latency percentiles', () {
+      expect(statistics.latencyPercentile(50),
+          const Duration(milliseconds: 50));
+      expect(statistics.latencyPercentile(90),
+          const Duration(milliseconds: 90));
+      expect(statistics.latencyPercentile(99),
+          const Duration(milliseconds: 100));
+      expect(statistics.latencyPercentile(0),
+          const Duration(milliseconds: 10));
+    });
+
+    test('has no percentiles without requests', () {
+      final empty = TileSourceStatistics.fromMap({
+        'requests': 0,
+        'failures': 0,
+        'networkResponses': 0,
+        'ambientCacheHits': 0,
+        'httpCacheHits': 0,
+        'bytes': 0,
+        'latencies': [],
+      });
+      expect(empty.latencyPercentile(50), isNull);
+      expect(empty.cacheHitRate, 0);
+    });
+  });
+
+  group(TimeToIdleRecorder, () {
+    var now = Duration.zero;
+    late TimeToIdleRecorder recorder;
+
+    setUp(() {
+      now = Duration.zero;
+      recorder = TimeToIdleRecorder(capacity: 3, clock: () => now);
+    });
+
+    test('measures from the camera idle to the map idle', () {
+      recorder.cameraIdle();
+      now += const Duration(milliseconds: 300);
+      recorder.mapIdle();
+      expect(recorder.times, [const Duration(milliseconds: 300)]);
+    });
+
+    test('ignores map idles without a camera move', () {
+      recorder.mapIdle();
+      recorder.cameraIdle();
+      now += const Duration(milliseconds: 100);
+      recorder.mapIdle();
+      now += const Duration(milliseconds: 100);
+      recorder.mapIdle();
+      expect(recorder.times, [const Duration(milliseconds: 100)]);
+    });
+
+    test('keeps the most recent times and resets', () {
+      for (final milliseconds in [400, 100, 300, 200]) {
+        recorder.cameraIdle();
+        now += Duration(milliseconds: milliseconds);
+        recorder.mapIdle();
+      }
+      expect(recorder.times, [
+        const Duration(milliseconds: 100),
+        const Duration(milliseconds: 200),
+        const Duration(milliseconds: 300),
+      ]);
+      recorder.reset();
+      expect(recorder.times, isEmpty);
+    });
+  });
+}
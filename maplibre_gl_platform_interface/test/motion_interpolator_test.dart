@@ -0,0 +1,133 @@
+import 'dart:math';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:maplibre_gl_platform_interface/maplibre_gl_platform_interface.dart';
+
+const start = 1700000000000;
+
+/// Degrees of a great circle arc of [meters].
+double degrees(double meters) => meters / 6371008.8 * 180 / pi;
+
+MovingPoint fix(Object id, double latitude, double longitude,
+        {double track = 0, double speed = 0, int time = start}) =>
+    MovingPoint(
+      id: id,
+      position: LatLng(latitude, longitude),
+      track: track,
+      speed: speed,
+      timestamp: DateTime.fromMillisecondsSinceEpoch(time),
+    );
+
+Matcher closeToLatLng(double latitude, double longitude) => isA<LatLng>()
+    .having((p) => p.latitude, 'latitude', closeTo(latitude, 1e-9))
+    .having((p) => p.longitude, 'longitude', closeTo(longitude, 1e-9));
+
+void main() {
+  group(MotionInterpolator, () {
+    test('keeps a stationary point at its fix', () {
+      final interpolator = MotionInterpolator()
+        ..update(fix('a', 52.5, 13.4), start);
+      expect(interpolator.positionOf('a', start + 3000),
+          closeToLatLng(52.5, 13.4));
+      expect(interpolator.isMovingAt(start), isFalse);
+    });
+
+    test('moves a point along its track', () {
+      final interpolator = MotionInterpolator()
+        ..update(fix('east', 0, 0, track: 90, speed: 100), start)
+        ..update(fix('north', 10, 20, track: 0, speed: 100), start);
+
+      expect(interpolator.positionOf('east', start + 2000),
+          closeToLatLng(0, degrees(200)));
+      expect(interpolator.positionOf('north', start + 2000),
+          closeToLatLng(10 + degrees(200), 20));
+      expect(interpolator.isMovingAt(start + 2000), isTrue);
+    });
+
+    test('extrapolates from the time of the fix', () {
+      final interpolator = MotionInterpolator()
+        ..update(fix('a', 0, 0, track: 90, speed: 100, time: start - 1000),
+            start);
+      expect(interpolator.positionOf('a', start),
+          closeToLatLng(0, degrees(100)));
+    });
+
+    test('does not move a point before the time of its fix', () {
+      final interpolator = MotionInterpolator()
+        ..update(fix('a', 0, 0, track: 90, speed: 100, time: start + 1000),
+            start);
+      expect(interpolator.positionOf('a', start), closeToLatLng(0, 0));
+    });
+
+    test('stops a point after the maximum extrapolation', () {
+      final interpolator = MotionInterpolator(
+          maxExtrapolation: const Duration(seconds: 3))
+        ..update(fix('a', 0, 0, track: 90, speed: 100), start);
+
+      expect(interpolator.positionOf('a', start + 10000),
+          closeToLatLng(0, degrees(300)));
+      expect(interpolator.isMovingAt(start + 2999), isTrue);
+      expect(interpolator.isMovingAt(start + 3000), isFalse);
+    });
+
+    test('blends out the error of a new fix', () {
+      final interpolator = MotionInterpolator(
+          blendDuration: const Duration(milliseconds: 1000))
+        ..update(fix('a', 0, 0, track: 90, speed: 100), start);
+      final shown = interpolator.positionOf('a', start + 1000)!;
+
+      // the new fix is 50 m behind the extrapolated position
+      interpolator.update(
+          fix('a', 0, degrees(50), track: 90, speed: 100, time: start + 1000),
+          start + 1000);
+      expect(interpolator.positionOf('a', start + 1000),
+          closeToLatLng(shown.latitude, shown.longitude));
+      expect(interpolator.positionOf('a', start + 1500),
+          closeToLatLng(0, degrees(50 + 50 + 25)));
+      expect(interpolator.positionOf('a', start + 2000),
+          closeToLatLng(0, degrees(50 + 100)));
+      expect(interpolator.isMovingAt(start + 2000), isTrue);
+    });
+
+    test('blends the error of a stationary point', () {
+      final interpolator = MotionInterpolator()
+        ..update(fix('a', 0, 0), start)
+        ..update(fix('a', 0, 0.001), start);
+
+      expect(interpolator.positionOf('a', start), closeToLatLng(0, 0));
+      expect(interpolator.isMovingAt(start + 500), isTrue);
+      expect(interpolator.positionOf('a', start + 1000),
+          closeToLatLng(0, 0.001));
+      expect(interpolator.isMovingAt(start + 1000), isFalse);
+    });
+
+    test('wraps points crossing the antimeridian', () {
+      final interpolator = MotionInterpolator()
+        ..update(
+            fix('a', 0, 180 - degrees(100), track: 90, speed: 100), start);
+      expect(interpolator.positionOf('a', start + 2000),
+          closeToLatLng(0, -180 + degrees(100)));
+    });
+
+    test('writes all positions in the order of the ids', () {
+      final interpolator = MotionInterpolator();
+      for (var i = 0; i < 40; i++) {
+        interpolator.update(fix(i, i.toDouble(), -i.toDouble()), start);
+      }
+      interpolator
+        ..remove(3)
+        ..remove(39)
+        ..remove(100);
+
+      final positions = interpolator.positionsAt(start);
+      expect(interpolator.length, 38);
+      expect(interpolator.ids, isNot(contains(3)));
+      for (var i = 0; i < interpolator.length; i++) {
+        final id = interpolator.ids[i] as int;
+        expect(positions[i * 2], id.toDouble());
+        expect(positions[i * 2 + 1], -id.toDouble());
+      }
+      expect(interpolator.positionsAt(start, positions), same(positions));
+    });
+  });
+}
@@ -0,0 +1,286 @@
+import 'dart:math';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:maplibre_gl_platform_interface/maplibre_gl_platform_interface.dart';
+
+/// The latitude of the Web Mercator world coordinate [y], from 0 at the north
+/// to 1 at the south.
+double latitude(double y) {
+  final x = pi * (1 - 2 * y);
+  return atan((exp(x) - exp(-x)) / 2) * 180 / pi;
+}
+
+/// The longitude of the Web Mercator world coordinate [x].
+double longitude(double x) => x * 360 - 180;
+
+LatLngBounds worldBounds(
+        double west, double north, double east, double south) =>
+    LatLngBounds(
+      southwest: LatLng(latitude(south), longitude(west)),
+      northeast: LatLng(latitude(north), longitude(east)),
+    );
+
+List<LatLng> rectangle(LatLngBounds bounds) => [
+      bounds.southwest,
+      LatLng(bounds.southwest.latitude, bounds.northeast.longitude),
+      bounds.northeast,
+      LatLng(bounds.northeast.latitude, bounds.southwest.longitude),
+    ];
+
+void main() {
+  const planner = OfflineTilePlanner();
+
+  group('zoomLevels', () {
+    test('floors the zoom levels of vector sources', () {
+      expect(planner.zoomLevels(0.5, 10.7), (0, 10));
+    });
+
+    test('rounds and shifts the zoom levels of 256 pixel raster sources', () {
+      const raster = OfflineTilePlanner(tileSize: 256, isRaster: true);
+      expect(raster.zoomLevels(0.5, 10.7), (2, 12));
+    });
+
+    test('limits the zoom levels to the source', () {
+      const source = OfflineTilePlanner(sourceMaxZoom: 14);
+      expect(source.zoomLevels(2, double.infinity), (2, 14));
+      expect(source.zoomLevels(15, 16), isNull);
+    });
+  });
+
+  group('planBounds', () {
+    test('counts the tiles intersecting the bounds per zoom', () {
+      final plan = planner.planBounds(
+        LatLngBounds(
+          southwest: const LatLng(-80, -170),
+          northeast: const LatLng(80, 170),
+        ),
+        0,
+        2,
+      );
+      expect(plan.tileCounts, {0: 1, 1: 4, 2: 16});
+      expect(plan.tileCount, 21);
+    });
+
+    test('does not count tiles that only touch the bounds', () {
+      final plan = planner.planBounds(worldBounds(0.5, 0.25, 0.75, 0.5), 2, 3);
+      expect(plan.tileCounts, {2: 1, 3: 4});
+    });
+
+    test('counts bounds crossing the antimeridian', () {
+      final plan = planner.planBounds(
+        LatLngBounds(
+          southwest: const LatLng(-10, 170),
+          northeast: const LatLng(10, -170),
+        ),
+        0,
+        3,
+      );
+      expect(plan.tileCounts, {0: 1, 1: 4, 2: 4, 3: 4});
+    });
+  });
+
+  group('planPolygon', () {
+    test('counts a rectangle like its bounds', () {
+      final bounds = LatLngBounds(
+        southwest: const LatLng(47.1, 5.3),
+        northeast: const LatLng(54.9, 15.1),
+      );
+      expect(planner.planPolygon([rectangle(bounds)], 0, 10).tileCounts,
+          planner.planBounds(bounds, 0, 10).tileCounts);
+    });
+
+    test('counts the tiles crossed by a diagonal once', () {
+      final triangle = [
+        LatLng(latitude(0.25), longitude(0.25)),
+        LatLng(latitude(0.5), longitude(0.25)),
+        LatLng(latitude(0.5), longitude(0.5)),
+      ];
+      // 4 x 4 tiles at zoom 4, the diagonal crosses 4 of them
+      expect(planner.planPolygon([triangle], 4, 4).tileCounts, {4: 10});
+    });
+
+    test('leaves out the tiles inside of holes', () {
+      final outline = rectangle(worldBounds(0.25, 0.25, 0.5, 0.5));
+      final hole = rectangle(worldBounds(0.3125, 0.3125, 0.4375, 0.4375));
+      expect(planner.planPolygon([outline, hole], 4, 5).tileCounts,
+          {4: 16 - 4, 5: 64 - 16});
+    });
+
+    test('samples tiles of the polygon', () {
+      final outline = rectangle(worldBounds(0.25, 0.25, 0.5, 0.5));
+      final hole = rectangle(worldBounds(0.3125, 0.3125, 0.4375, 0.4375));
+      final plan = planner.planPolygon([outline, hole], 4, 4);
+      final samples = plan.sampleTiles(4, 50, Random(1));
+      expect(samples, hasLength(50));
+      for (final (x, y) in samples) {
+        expect(x, inInclusiveRange(4, 7));
+        expect(y, inInclusiveRange(4, 7));
+        expect((x == 5 || x == 6) && (y == 5 || y == 6), isFalse);
+      }
+    });
+  });
+
+  group('planPolygons', () {
+    test('counts the tiles covered by several polygons once', () {
+      final square = rectangle(worldBounds(0.25, 0.25, 0.5, 0.5));
+      expect(
+          planner.planPolygons([
+            [square],
+            [square],
+          ], 3, 6).tileCounts,
+          planner.planPolygon([square], 3, 6).tileCounts);
+    });
+  });
+
+  group('corridorPolygons', () {
+    test('buffers each segment and joins', () {
+      const halfWidth = 1000 * 180 / (pi * 6371008.8);
+      final polygons = OfflineTilePlanner.corridorPolygons(
+          const [LatLng(0, 0), LatLng(0, 1), LatLng(1, 1)], 2000);
+      // a join around each point and a quadrilateral along each segment
+      expect(polygons.map((rings) => rings.first.length), [8, 4, 8, 4, 8]);
+      final segment = polygons[1].first;
+      expect(segment[0].latitude, closeTo(halfWidth, 1e-9));
+      expect(segment[1].latitude, closeTo(halfWidth, 1e-9));
+      expect(segment[1].longitude, closeTo(1, 1e-9));
+      expect(segment[2].latitude, closeTo(-halfWidth, 1e-9));
+    });
+
+    test('covers a fraction of the tiles of the bounding box', () {
+      const path = [LatLng(0, 0), LatLng(5, 5)];
+      final corridor = planner.planPolygons(
+          OfflineTilePlanner.corridorPolygons(path, 1000), 12, 12);
+      final boundingBox = planner.planBounds(
+          LatLngBounds(southwest: path.first, northeast: path.last), 12, 12);
+      final savings = corridor.savingsComparedTo(
+          boundingBox, const OfflineTileSizeModel(defaultTileBytes: 10));
+      expect(savings.tiles, boundingBox.tileCount - corridor.tileCount);
+      expect(savings.bytes, savings.tiles * 10);
+      expect(savings.fraction, greaterThan(0.9));
+      expect(savings.timeAt(100),
+          Duration(milliseconds: savings.tiles * 10));
+    });
+  });
+
+  group('splitPath', () {
+    const metersPerDegree = pi * 6371008.8 / 180;
+
+    test('splits a path into parts of the segment length', () {
+      final parts = OfflineTilePlanner.splitPath(
+          const [LatLng(0, 0), LatLng(0, 0.5), LatLng(0, 1)], 40000);
+      expect(parts, hasLength(3));
+      expect(parts[0], hasLength(2));
+      expect(parts[0].last.longitude, closeTo(40000 / metersPerDegree, 1e-9));
+      // the point of the path is kept in the part it falls into
+      expect(parts[1].map((p) => p.longitude), [
+        parts[0].last.longitude,
+        0.5,
+        closeTo(80000 / metersPerDegree, 1e-9),
+      ]);
+      expect(parts[2].first, parts[1].last);
+      expect(parts[2].last, const LatLng(0, 1));
+    });
+
+    test('returns short paths as is', () {
+      const path = [LatLng(0, 0), LatLng(0.1, 0.1)];
+      expect(OfflineTilePlanner.splitPath(path, 100000), [path]);
+    });
+
+    test('returns paths of identical points as is', () {
+      const path = [LatLng(0.1, 0.1), LatLng(0.1, 0.1), LatLng(0.1, 0.1)];
+      expect(OfflineTilePlanner.splitPath(path, 1000), [path]);
+    });
+  });
+
+  group('splitBounds', () {
+    final bounds = LatLngBounds(
+      southwest: const LatLng(45.2, 5.1),
+      northeast: const LatLng(55.3, 15.4),
+    );
+
+    test('returns small bounds as is', () {
+      expect(planner.splitBounds(bounds, 0, 4, maxTilesPerChunk: 100),
+          [bounds]);
+    });
+
+    test('splits into chunks of at most the maximum tiles', () {
+      final chunks =
+          planner.splitBounds(bounds, 0, 12, maxTilesPerChunk: 2000);
+      expect(chunks.length, greaterThan(1));
+      for (final chunk in chunks) {
+        expect(planner.planBounds(chunk, 0, 12).tileCount,
+            lessThanOrEqualTo(2000));
+      }
+      // split on tile boundaries, the chunks share no tiles of the last zoom
+      expect(
+          chunks
+              .map((chunk) => planner.planBounds(chunk, 12, 12).tileCount)
+              .reduce((a, b) => a + b),
+          planner.planBounds(bounds, 12, 12).tileCount);
+    });
+
+    test('splits bounds crossing the antimeridian', () {
+      final crossing = LatLngBounds(
+        southwest: const LatLng(-5, 175),
+        northeast: const LatLng(5, -175),
+      );
+      final chunks =
+          planner.splitBounds(crossing, 0, 10, maxTilesPerChunk: 500);
+      expect(
+          chunks
+              .map((chunk) => planner.planBounds(chunk, 10, 10).tileCount)
+              .reduce((a, b) => a + b),
+          planner.planBounds(crossing, 10, 10).tileCount);
+    });
+  });
+
+  group(OfflineTileSizeModel, () {
+    test('uses the average of the closest zoom level', () {
+      const model = OfflineTileSizeModel(
+          averageTileBytes: {2: 10, 6: 50}, defaultTileBytes: 1);
+      expect(model.bytesPerTile(2), 10);
+      expect(model.bytesPerTile(0), 10);
+      expect(model.bytesPerTile(4), 50);
+      expect(model.bytesPerTile(9), 50);
+      expect(const OfflineTileSizeModel(defaultTileBytes: 7).bytesPerTile(3),
+          7);
+    });
+
+    test('estimates the bytes of a plan', () {
+      final plan = planner.planBounds(
+        LatLngBounds(
+          southwest: const LatLng(-80, -170),
+          northeast: const LatLng(80, 170),
+        ),
+        0,
+        2,
+      );
+      const model = OfflineTileSizeModel(averageTileBytes: {0: 100, 1: 10});
+      expect(plan.estimateBytes(model), 100 + 4 * 10 + 16 * 10);
+    });
+
+    test('probes the tile sizes of each zoom level', () async {
+      final plan = planner.planBounds(
+        LatLngBounds(
+          southwest: const LatLng(45.2, 5.1),
+          northeast: const LatLng(55.3, 15.4),
+        ),
+        2,
+        5,
+      );
+      final probed = <int>[];
+      final model = await OfflineTileSizeModel.probe(
+        plan,
+        (zoom, x, y) async {
+          probed.add(zoom);
+          return zoom == 3 ? null : zoom * 1000;
+        },
+        samplesPerZoom: 3,
+        random: Random(1),
+      );
+      expect(probed, [2, 2, 2, 3, 3, 3, 4, 4, 4, 5, 5, 5]);
+      expect(model.averageTileBytes, {2: 2000, 4: 4000, 5: 5000});
+      expect(model.bytesPerTile(3), 4000);
+    });
+  });
+}
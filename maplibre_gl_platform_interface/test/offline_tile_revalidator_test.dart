@@ -0,0 +1,140 @@
+import 'dart:io';
+import 'dart:math';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:maplibre_gl_platform_interface/maplibre_gl_platform_interface.dart';
+
+/// A tile server serving a version of each tile, with the version as ETag.
+class TileServer {
+  TileServer._(this._server) {
+    _server.listen(_handle);
+  }
+
+  static Future<TileServer> start() async =>
+      TileServer._(await HttpServer.bind(InternetAddress.loopbackIPv4, 0));
+
+  final HttpServer _server;
+  final versions = <String, int>{};
+  var requests = 0;
+  var _active = 0;
+  var maxActive = 0;
+
+  String get urlTemplate =>
+      'http://${_server.address.host}:${_server.port}/{z}/{x}/{y}';
+
+  Future<void> _handle(HttpRequest request) async {
+    requests++;
+    maxActive = max(maxActive, ++_active);
+    await Future<void>.delayed(const Duration(milliseconds: 5));
+    final path = request.uri.path;
+    if (path.startsWith('/0/')) {
+      request.response.statusCode = HttpStatus.internalServerError;
+    } else {
+      final etag = '"${versions[path] ?? 0}"';
+      if (request.headers.value(HttpHeaders.ifNoneMatchHeader) == etag) {
+        request.response.statusCode = HttpStatus.notModified;
+      } else {
+        request.response
+          ..headers.set(HttpHeaders.etagHeader, etag)
+          ..write('tile $path $etag');
+      }
+    }
+    await request.response.close();
+    _active--;
+  }
+
+  Future<void> close() => _server.close(force: true);
+}
+
+void main() {
+  late TileServer server;
+  late OfflineTileRevalidator revalidator;
+  final tiles = [
+    for (var x = 0; x < 4; x++)
+      for (var y = 0; y < 4; y++) (2, x, y),
+  ];
+
+  setUp(() async {
+    server = await TileServer.start();
+    revalidator = OfflineTileRevalidator(
+      urlTemplate: server.urlTemplate,
+      maxConcurrentRequests: 3,
+    );
+  });
+
+  tearDown(() async {
+    revalidator.close();
+    await server.close();
+  });
+
+  test('downloads tiles without validators', () async {
+    final validators = <String, TileValidator>{};
+    final changed = <(int, int, int)>[];
+    final statistics = await revalidator.revalidate(tiles, validators,
+        onChanged: (zoom, x, y, data) => changed.add((zoom, x, y)));
+    expect(statistics.changed, 16);
+    expect(statistics.unchanged, 0);
+    expect(statistics.savedBytes, 0);
+    expect(changed, unorderedEquals(tiles));
+    expect(validators, hasLength(16));
+    expect(validators[revalidator.urlOf(2, 1, 3)]!.etag, '"0"');
+    expect(statistics.downloadedBytes,
+        validators.values.fold(0, (sum, v) => sum + v.size));
+  });
+
+  test('only downloads changed tiles', () async {
+    final validators = <String, TileValidator>{};
+    final first = await revalidator.revalidate(tiles, validators);
+    server.versions['/2/1/3'] = 1;
+    server.versions['/2/3/0'] = 1;
+
+    final changed = <(int, int, int)>[];
+    final statistics = await revalidator.revalidate(tiles, validators,
+        onChanged: (zoom, x, y, data) => changed.add((zoom, x, y)));
+    expect(statistics.changed, 2);
+    expect(statistics.unchanged, 14);
+    expect(changed, unorderedEquals([(2, 1, 3), (2, 3, 0)]));
+    expect(validators[revalidator.urlOf(2, 1, 3)]!.etag, '"1"');
+    expect(statistics.savedBytes + statistics.downloadedBytes,
+        first.downloadedBytes);
+  });
+
+  test('keeps the validators of failed tiles', () async {
+    final validators = {
+      revalidator.urlOf(0, 0, 0): const TileValidator(etag: '"0"', size: 3),
+    };
+    final statistics = await revalidator.revalidate([(0, 0, 0)], validators);
+    expect(statistics.failed, 1);
+    expect(statistics.requests, 1);
+    expect(validators[revalidator.urlOf(0, 0, 0)]!.size, 3);
+  });
+
+  test('limits the concurrent requests', () async {
+    await revalidator.revalidate(tiles, {});
+    expect(server.requests, 16);
+    expect(server.maxActive, lessThanOrEqualTo(3));
+  });
+
+  test('revalidates the tiles of a plan', () async {
+    final plan = const OfflineTilePlanner().planBounds(
+      LatLngBounds(
+        southwest: const LatLng(-10, -10),
+        northeast: const LatLng(10, 10),
+      ),
+      1,
+      2,
+    );
+    expect(plan.tiles(), hasLength(plan.tileCount));
+    final statistics = await revalidator.revalidate(plan.tiles(), {});
+    expect(statistics.changed, plan.tileCount);
+  });
+
+  test('serializes validators', () {
+    const validator = TileValidator(
+        etag: '"a"', lastModified: 'Wed, 21 Oct 2015 07:28:00 GMT', size: 9);
+    final copy = TileValidator.fromJson(validator.toJson());
+    expect(copy.etag, validator.etag);
+    expect(copy.lastModified, validator.lastModified);
+    expect(copy.size, validator.size);
+  });
+}
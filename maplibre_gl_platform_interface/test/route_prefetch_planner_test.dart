@@ -0,0 +1,212 @@
+import 'dart:math';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:maplibre_gl_platform_interface/maplibre_gl_platform_interface.dart';
+
+/// The meters of a degree along the equator.
+const metersPerDegree = pi * 6371008.8 / 180;
+
+void main() {
+  // 0.2 degrees east along the equator
+  final straight = RoutePrefetchPlanner(const [
+    LatLng(0, 0),
+    LatLng(0, 0.1),
+    LatLng(0, 0.2),
+  ]);
+
+  group('locate', () {
+    test('matches a position to the closest point of the route', () {
+      final position = straight.locate(const LatLng(0.001, 0.05))!;
+      expect(position.distanceAlong, closeTo(0.05 * metersPerDegree, 0.01));
+      expect(position.offset, closeTo(0.001 * metersPerDegree, 0.01));
+      expect(position.point.latitude, 0);
+      expect(position.point.longitude, closeTo(0.05, 1e-9));
+    });
+
+    test('does not match positions off the route', () {
+      expect(straight.locate(const LatLng(0.01, 0.05)), isNull);
+    });
+
+    group('on a route out and back', () {
+      final outAndBack = RoutePrefetchPlanner(const [
+        LatLng(0, 0),
+        LatLng(0, 0.1),
+        LatLng(0, 0),
+      ]);
+      const position = LatLng(0, 0.03);
+
+      test('prefers the direction of the bearing', () {
+        expect(outAndBack.locate(position, bearing: 90)!.distanceAlong,
+            closeTo(0.03 * metersPerDegree, 0.01));
+        expect(outAndBack.locate(position, bearing: 270)!.distanceAlong,
+            closeTo(0.17 * metersPerDegree, 0.01));
+      });
+
+      test('prefers points after the previous match', () {
+        expect(
+            outAndBack
+                .locate(position, notBefore: 0.15 * metersPerDegree)!
+                .distanceAlong,
+            closeTo(0.17 * metersPerDegree, 0.01));
+      });
+    });
+  });
+
+  test('pathBetween cuts the route at the distances', () {
+    final path =
+        straight.pathBetween(0.05 * metersPerDegree, 0.15 * metersPerDegree);
+    expect(path, hasLength(3));
+    expect(path.first.longitude, closeTo(0.05, 1e-9));
+    expect(path[1], const LatLng(0, 0.1));
+    expect(path.last.longitude, closeTo(0.15, 1e-9));
+    final whole = straight.pathBetween(-1, double.infinity);
+    expect(whole, hasLength(3));
+    expect(whole.first, const LatLng(0, 0));
+    expect(whole.last.longitude, closeTo(0.2, 1e-9));
+  });
+
+  group('viewport', () {
+    test('is as wide as the viewport without tilt', () {
+      final metersPerPixel = RoutePrefetchPlanner.metersPerPixel(14, 0);
+      expect(metersPerPixel, closeTo(4.77, 0.01));
+      expect(straight.corridorWidth(14, 0, 0),
+          closeTo(400 * metersPerPixel, 1e-6));
+      expect(
+          straight.viewAhead(14, 0, 0), closeTo(400 * metersPerPixel, 1e-6));
+      final (minZoom, maxZoom) = straight.zoomRange(14, 0);
+      expect(minZoom, closeTo(14, 1e-9));
+      expect(maxZoom, 14);
+    });
+
+    test('shows more and lower zoom levels when tilted', () {
+      expect(straight.corridorWidth(14, 60, 0),
+          greaterThan(2 * straight.corridorWidth(14, 0, 0)));
+      expect(straight.viewAhead(14, 60, 0),
+          greaterThan(4 * straight.viewAhead(14, 0, 0)));
+      final (minZoom, maxZoom) = straight.zoomRange(14, 60);
+      expect(minZoom, closeTo(12.76, 0.01));
+      expect(maxZoom, 14);
+    });
+
+    test('keeps the top edge below the horizon', () {
+      expect(straight.viewAhead(14, 85, 0).isFinite, isTrue);
+    });
+
+    test('fits any direction unless it rotates with the bearing', () {
+      final northUp = RoutePrefetchPlanner(straight.route,
+          rotatesWithBearing: false);
+      expect(northUp.corridorWidth(14, 0, 0),
+          closeTo(2 * straight.corridorWidth(14, 0, 0), 1e-6));
+    });
+  });
+
+  group('plan', () {
+    final start = straight.locate(const LatLng(0, 0.01))!;
+    final viewAhead = straight.viewAhead(14, 0, 0);
+
+    test('covers the route within the horizon and the viewport', () {
+      final plan = straight.plan(
+        position: start,
+        speed: 20,
+        horizon: const Duration(minutes: 1),
+        zoom: 14,
+      )!;
+      expect(plan.fromDistance, start.distanceAlong);
+      expect(plan.toDistance,
+          closeTo(start.distanceAlong + 1200 + viewAhead, 1e-6));
+      expect(plan.width, straight.corridorWidth(14, 0, 0));
+      expect(plan.tiles.tileCounts.keys, [14]);
+      expect(plan.tiles.tileCount, greaterThan(0));
+    });
+
+    test('assumes the minimum speed when standing', () {
+      final plan = straight.plan(
+        position: start,
+        speed: 0,
+        horizon: const Duration(minutes: 1),
+        zoom: 14,
+      )!;
+      expect(plan.toDistance,
+          closeTo(start.distanceAlong + 300 + viewAhead, 1e-6));
+    });
+
+    test('continues after the prefetched distance', () {
+      final plan = straight.plan(
+        position: start,
+        speed: 20,
+        horizon: const Duration(minutes: 1),
+        zoom: 14,
+        prefetchedUntil: start.distanceAlong + 1000,
+        maxLength: 500,
+      )!;
+      expect(plan.fromDistance, start.distanceAlong + 1000);
+      expect(plan.toDistance, closeTo(start.distanceAlong + 1500, 1e-6));
+      expect(
+        straight.plan(
+          position: start,
+          speed: 20,
+          horizon: const Duration(minutes: 1),
+          zoom: 14,
+          prefetchedUntil: start.distanceAlong + 5000,
+        ),
+        isNull,
+      );
+    });
+
+    test('ends at the end of the route', () {
+      final plan = straight.plan(
+        position: start,
+        speed: 30,
+        horizon: const Duration(hours: 1),
+        zoom: 14,
+      )!;
+      expect(plan.toDistance, straight.length);
+      expect(plan.path.last.longitude, closeTo(0.2, 1e-9));
+    });
+  });
+
+  group('PrefetchPacer', () {
+    test('averages the throughput', () {
+      final pacer = PrefetchPacer(smoothing: 0.5);
+      expect(pacer.bandwidth, isNull);
+      pacer.addThroughput(1000);
+      expect(pacer.bandwidth, 1000);
+      pacer.addThroughput(2000);
+      expect(pacer.bandwidth, 1500);
+      pacer.reset();
+      expect(pacer.bandwidth, isNull);
+    });
+
+    test('limits the budget to a share of the bandwidth', () {
+      final pacer = PrefetchPacer(maxBytesPerSecond: 400);
+      expect(pacer.budget, 400);
+      pacer.addThroughput(600);
+      expect(pacer.budget, 300);
+      pacer.addThroughput(2000);
+      expect(pacer.budget, 400);
+      expect(PrefetchPacer().budget, isNull);
+    });
+
+    test('delays prefetches to stay within the budget', () {
+      final pacer = PrefetchPacer()..addThroughput(1000);
+      expect(pacer.delayAfter(1000, const Duration(milliseconds: 500)),
+          const Duration(milliseconds: 1500));
+      expect(pacer.delayAfter(1000, const Duration(seconds: 3)),
+          Duration.zero);
+      expect(pacer.delayAfter(1000000, Duration.zero),
+          const Duration(seconds: 30));
+      expect(PrefetchPacer().delayAfter(1000000, Duration.zero),
+          Duration.zero);
+    });
+
+    test('tells whether bytes can be downloaded in time', () {
+      final pacer = PrefetchPacer();
+      expect(pacer.canDownloadWithin(1000000, Duration.zero), isTrue);
+      pacer.addThroughput(1000);
+      expect(pacer.canDownloadWithin(1000, const Duration(seconds: 2)),
+          isTrue);
+      expect(pacer.canDownloadWithin(1001, const Duration(seconds: 2)),
+          isFalse);
+    });
+  });
+}
@@ -0,0 +1,107 @@
+// Compares the previous per-feature conversion of geojson sources, which
+// created a Feature and Geometry wrapper and called jsify for the properties
+// of every feature, with the single pass of FeatureCollection.fromGeoJson,
+// and measures the main thread time of packing a source for the
+// GeoJsonWorker.
+//
+// Run with:
+//   flutter test --platform chrome benchmark/geojson_conversion_benchmark.dart
+//
+// The package is built on package:js and dart:html, so it can only be
+// compiled with dart2js for now.
+@TestOn('browser')
+library;
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:js/js_util.dart';
+// ignore: implementation_imports
+import 'package:maplibre_gl_web/src/geo/geojson.dart';
+// ignore: implementation_imports
+import 'package:maplibre_gl_web/src/geojson_worker.dart';
+
+const _featureCount = 30000;
+const _iterations = 5;
+
+Map<String, dynamic> _geojson() => {
+      'type': 'FeatureCollection',
+      'features': [
+        for (var i = 0; i < _featureCount; i++)
+          {
+            'type': 'Feature',
+            'id': '$i',
+            'properties': {
+              'id': '$i',
+              'name': 'feature $i',
+              'iconSize': 1.5,
+              'iconOffset': [0, -8],
+              'textColor': '#333333',
+              'zIndex': i % 10,
+            },
+            'geometry': {
+              'type': 'Point',
+              'coordinates': [(i % 360) - 180.0, (i % 170) - 85.0],
+            },
+          }
+      ],
+    };
+
+FeatureCollection _perFeature(Map<String, dynamic> geojson) {
+  return FeatureCollection(features: [
+    for (final f in geojson['features'])
+      Feature(
+          geometry: Geometry(
+              type: f['geometry']['type'],
+              coordinates: jsify(f['geometry']['coordinates'])),
+          properties: f['properties'],
+          id: f['properties']?['id'] ?? f['id'])
+  ]);
+}
+
+int _measure(String name, Object? Function() convert) {
+  convert(); // warm up
+  final stopwatch = Stopwatch()..start();
+  for (var i = 0; i < _iterations; i++) {
+    convert();
+  }
+  final micros = stopwatch.elapsedMicroseconds ~/ _iterations;
+  // ignore: avoid_print
+  print('$name: ${(micros / 1000).toStringAsFixed(1)} ms '
+      'for $_featureCount features');
+  return micros;
+}
+
+void main() {
+  final geojson = _geojson();
+
+  test('FeatureCollection.fromGeoJson', () {
+    final perFeature = _measure('per feature', () => _perFeature(geojson));
+    final singlePass = _measure(
+        'single pass', () => FeatureCollection.fromGeoJson(geojson));
+    // ignore: avoid_print
+    print('speedup: ${(perFeature / singlePass).toStringAsFixed(2)}x');
+
+    final collection = FeatureCollection.fromGeoJson(geojson);
+    final feature = Feature.fromJsObject(collection.jsObject.features[42]);
+    expect(feature.id, '42');
+    expect(feature.properties['name'], 'feature 42');
+  });
+
+  test('GeoJsonWorker', () async {
+    final singlePass = _measure(
+        'single pass', () => FeatureCollection.fromGeoJson(geojson));
+    final pack =
+        _measure('pack', () => PackedGeoJson.pack(geojson['features']));
+    // ignore: avoid_print
+    print('main thread time saved: '
+        '${((singlePass - pack) / 1000).toStringAsFixed(1)} ms');
+
+    final worker = GeoJsonWorker.start()!;
+    final stopwatch = Stopwatch()..start();
+    final packed = PackedGeoJson.pack(geojson['features'])!;
+    final url = await worker.prepare('source', packed);
+    // ignore: avoid_print
+    print('worker round trip: ${stopwatch.elapsedMilliseconds} ms');
+    expect(url, startsWith('blob:'));
+    worker.dispose();
+  });
+}
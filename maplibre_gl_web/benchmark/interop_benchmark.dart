@@ -0,0 +1,132 @@
+// Measures the typed dart:js_interop layer used on the hot paths of the
+// plugin: reading map mouse events and the camera, and sending geojson
+// source diffs. The library under test does not depend on package:js or
+// dart:html, so the same benchmark compiles with dart2js and dart2wasm.
+//
+// Compare the JS and wasm builds with:
+//   flutter test --platform chrome benchmark/interop_benchmark.dart
+//   flutter test --platform chrome --wasm benchmark/interop_benchmark.dart
+//
+// maplibre-gl-js is not loaded, the map and the source are stubbed with plain
+// JS objects, so only the cost of crossing the interop boundary is measured.
+@TestOn('browser')
+library;
+
+import 'dart:js_interop';
+import 'dart:js_interop_unsafe';
+import 'dart:math';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:maplibre_gl_platform_interface/maplibre_gl_platform_interface.dart';
+// ignore: implementation_imports
+import 'package:maplibre_gl_web/src/interop/typed_interop.dart';
+
+const _eventCount = 100000;
+const _featureCount = 1000;
+const _iterations = 5;
+
+final _backend = const bool.fromEnvironment('dart.tool.dart2wasm')
+    ? 'wasm'
+    : 'js';
+
+int _measure(String name, int count, void Function() run) {
+  run(); // warm up
+  final stopwatch = Stopwatch()..start();
+  for (var i = 0; i < _iterations; i++) {
+    run();
+  }
+  final micros = stopwatch.elapsedMicroseconds ~/ _iterations;
+  // ignore: avoid_print
+  print('[$_backend] $name: ${(micros / 1000).toStringAsFixed(2)} ms '
+      'for $count operations');
+  return micros;
+}
+
+JSObject _object(Map<String, Object?> properties) =>
+    properties.jsify() as JSObject;
+
+void main() {
+  test('mouse event throughput', () {
+    final events = [
+      for (var i = 0; i < 100; i++)
+        _object({
+          'type': 'mousemove',
+          'point': {'x': i * 1.5, 'y': i * 2.5},
+          'lngLat': {'lng': i * 0.1, 'lat': i * 0.05},
+        }) as MapMouseEventJs,
+    ];
+    var checksum = 0.0;
+    _measure('read events', _eventCount, () {
+      for (var i = 0; i < _eventCount; i++) {
+        final event = events[i % events.length];
+        final point = Point<double>(event.point.x, event.point.y);
+        final latLng = LatLng(event.lngLat.lat, event.lngLat.lng);
+        checksum += point.x + latLng.longitude;
+      }
+    });
+    expect(checksum, greaterThan(0));
+  });
+
+  test('camera reads', () {
+    final map = _object({});
+    final center = _object({'lng': 13.4, 'lat': 52.5});
+    map
+      ..setProperty('getCenter'.toJS, (() => center).toJS)
+      ..setProperty('getZoom'.toJS, (() => 12.5.toJS).toJS)
+      ..setProperty('getBearing'.toJS, (() => 30.0.toJS).toJS)
+      ..setProperty('getPitch'.toJS, (() => 45.0.toJS).toJS);
+    final typedMap = map as MapJs;
+    var checksum = 0.0;
+    _measure('read camera', _eventCount, () {
+      for (var i = 0; i < _eventCount; i++) {
+        final center = typedMap.getCenter();
+        checksum += center.lat +
+            center.lng +
+            typedMap.getZoom() +
+            typedMap.getBearing() +
+            typedMap.getPitch();
+      }
+    });
+    expect(checksum, greaterThan(0));
+  });
+
+  test('geojson source updates', () {
+    final source = _object({});
+    var updates = 0;
+    var added = 0;
+    source
+      ..setProperty(
+          'updateData'.toJS,
+          ((GeoJsonSourceDiffJs diff) {
+            updates++;
+            added += diff.getProperty<JSArray>('add'.toJS).length;
+            return source;
+          }).toJS)
+      ..setProperty('setData'.toJS, ((JSAny data) => source).toJS);
+    final typedSource = source as GeoJsonSourceJs;
+    expect(typedSource.supportsUpdateData, isTrue);
+
+    final features = [
+      for (var i = 0; i < _featureCount; i++)
+        _object({
+          'type': 'Feature',
+          'id': i,
+          'properties': {'id': i},
+          'geometry': {
+            'type': 'Point',
+            'coordinates': [i * 0.01, i * 0.02],
+          },
+        }) as FeatureJs,
+    ];
+    _measure('single feature diffs', _featureCount, () {
+      for (final feature in features) {
+        typedSource.updateData(GeoJsonSourceDiffJs(add: [feature].toJS));
+      }
+    });
+    _measure('one diff', _featureCount, () {
+      typedSource.updateData(GeoJsonSourceDiffJs(add: features.toJS));
+    });
+    expect(updates, greaterThan(0));
+    expect(added, greaterThan(0));
+  });
+}
@@ -1,6 +1,7 @@
 library maplibre_gl_web;
 
 import 'dart:async';
+import 'dart:convert';
 
 // FIXED HERE: https://github.com/dart-lang/linter/pull/1985
 // ignore_for_file: avoid_web_libraries_in_flutter
@@ -8,8 +9,11 @@ import 'dart:html' as html hide Event;
 
 // ignore: unused_import
 import 'dart:js';
+import 'dart:js_interop';
+import 'dart:js_interop_unsafe';
 import 'dart:js_util';
 import 'dart:math';
+import 'dart:typed_data';
 import 'dart:ui' as ui;
 import 'dart:ui_web' as ui_web;
 import 'package:flutter/services.dart';
@@ -25,6 +29,8 @@ import 'package:maplibre_gl_web/src/geo/point.dart' as geo_point;
 import 'package:maplibre_gl_web/src/geo/geojson.dart';
 import 'package:maplibre_gl_web/src/geo/lng_lat.dart';
 import 'package:maplibre_gl_web/src/geo/lng_lat_bounds.dart';
+import 'package:maplibre_gl_web/src/geojson_worker.dart';
+import 'package:maplibre_gl_web/src/interop/typed_interop.dart';
 import 'package:maplibre_gl_web/src/layer_tools.dart';
 import 'package:maplibre_gl_web/src/style/sources/geojson_source.dart';
 import 'package:maplibre_gl_web/src/ui/camera.dart';
@@ -41,3 +47,11 @@ part 'src/maplibre_map_plugin.dart';
 part 'src/options_sink.dart';
 
 part 'src/maplibre_web_gl_platform.dart';
+
+part 'src/geojson_source_data.dart';
+
+part 'src/hit_test_cache.dart';
+
+part 'src/camera_stream.dart';
+
+part 'src/motion_source.dart';
@@ -0,0 +1,118 @@
+part of '../maplibre_gl_web.dart';
+
+/// Reads the camera of the map into a [Float64List] as latitude, longitude,
+/// bearing, tilt and zoom in a single call into JS.
+const _readCameraSource = '''
+var center = map.getCenter();
+out[0] = center.lat;
+out[1] = center.lng;
+out[2] = map.getBearing();
+out[3] = map.getPitch();
+out[4] = map.getZoom();
+''';
+
+/// Delivers the camera of a moving map at most once per animation frame.
+///
+/// maplibre-gl-js fires several `move` events per frame during gestures and
+/// animations. Instead of reading the camera across the interop boundary and
+/// building a [CameraPosition] for each of them, the camera is read once per
+/// frame into a reused snapshot and only emitted if it changed by more than
+/// the [CameraMoveTolerance].
+class _CameraStream {
+  final MapJs _map;
+  final CameraMoveTolerance _tolerance;
+  final void Function(CameraPosition camera) _onCameraMove;
+
+  /// The camera read in the current frame, shared with JS, and the last
+  /// emitted camera.
+  final _snapshotJs = JSFloat64Array.withLength(5);
+  late final _snapshot = _snapshotJs.toDart;
+  final _emitted = Float64List(5);
+  var _hasEmitted = false;
+
+  /// The compiled [_readCameraSource], null if the page does not allow to
+  /// compile scripts, e.g. because of its content security policy.
+  final JSFunction? _readCamera;
+
+  int? _frame;
+
+  _CameraStream(MapLibreMap map, this._tolerance, this._onCameraMove)
+      : _map = asMapJs(map.jsObject),
+        _readCamera = _compileReadCamera();
+
+  static JSFunction? _compileReadCamera() {
+    try {
+      return globalContext
+          .getProperty<JSFunction>('Function'.toJS)
+          .callAsConstructor<JSFunction>(
+              'map'.toJS, 'out'.toJS, _readCameraSource.toJS);
+    } catch (_) {
+      return null;
+    }
+  }
+
+  /// Requests the delivery of the camera in the next animation frame.
+  void schedule() {
+    _frame ??= html.window.requestAnimationFrame(_onFrame);
+  }
+
+  /// Delivers a scheduled camera immediately, e.g. before the map becomes
+  /// idle.
+  void flush() {
+    final frame = _frame;
+    if (frame == null) return;
+    html.window.cancelAnimationFrame(frame);
+    _onFrame(0);
+  }
+
+  /// Cancels a scheduled delivery.
+  void cancel() {
+    final frame = _frame;
+    if (frame != null) html.window.cancelAnimationFrame(frame);
+    _frame = null;
+  }
+
+  /// Reads the current camera of the map.
+  CameraPosition read() {
+    _read();
+    return _toCameraPosition();
+  }
+
+  void _onFrame(num _) {
+    _frame = null;
+    _read();
+    if (_hasEmitted && !_hasChanged()) return;
+    _emitted.setAll(0, _snapshot);
+    _hasEmitted = true;
+    _onCameraMove(_toCameraPosition());
+  }
+
+  void _read() {
+    final readCamera = _readCamera;
+    if (readCamera != null) {
+      readCamera.callAsFunction(null, _map, _snapshotJs);
+      return;
+    }
+    final center = _map.getCenter();
+    _snapshot
+      ..[0] = center.lat
+      ..[1] = center.lng
+      ..[2] = _map.getBearing()
+      ..[3] = _map.getPitch()
+      ..[4] = _map.getZoom();
+  }
+
+  bool _hasChanged() =>
+      (_snapshot[0] - _emitted[0]).abs() > _tolerance.target ||
+      (_snapshot[1] - _emitted[1]).abs() > _tolerance.target ||
+      (_snapshot[2] - _emitted[2]).abs() > _tolerance.bearing ||
+      (_snapshot[3] - _emitted[3]).abs() > _tolerance.tilt ||
+      (_snapshot[4] - _emitted[4]).abs() > _tolerance.zoom;
+
+  CameraPosition _toCameraPosition() => CameraPosition(
+        target: LatLng(_snapshot[0], _snapshot[1]),
+        bearing: _snapshot[2],
+        tilt: _snapshot[3],
+        zoom: _snapshot[4],
+      );
+}
@@ -17,10 +17,44 @@ class FeatureCollection extends JsObjectWrapper<FeatureCollectionJsImpl> {
     ));
   }
 
+  /// Converts a geojson feature collection to JS in a single pass, without
+  /// creating a [Feature] wrapper or converting the properties of each
+  /// feature separately. Properties are only converted back to Dart when
+  /// [Feature.properties] is read.
+  ///
+  /// The id of a feature is replaced by its `id` property if it has one.
+  factory FeatureCollection.fromGeoJson(Map<String, dynamic> geojson) {
+    final FeatureCollectionJsImpl jsObject = jsify({
+      'type': 'FeatureCollection',
+      'features': geojson['features'] ?? const [],
+    });
+    for (final feature in jsObject.features) {
+      _promotePropertyId(feature);
+    }
+    return FeatureCollection.fromJsObject(jsObject);
+  }
+
   /// Creates a new FeatureCollection from a [jsObject].
   FeatureCollection.fromJsObject(super.jsObject) : super.fromJsObject();
 }
 
+/// The data of a geojson source for maplibre-gl-js: a [FeatureCollection]
+/// converted with [FeatureCollection.fromGeoJson], or the JS object of any
+/// other geojson, like a single feature or a bare geometry, unchanged.
+Object geoJsonSourceData(Map<String, dynamic> geojson) =>
+    geojson['type'] == 'FeatureCollection'
+        ? FeatureCollection.fromGeoJson(geojson)
+        : jsify(geojson);
+
+void _promotePropertyId(FeatureJsImpl feature) {
+  final properties = feature.properties;
+  if (properties == null) return;
+  final id = getProperty(properties, 'id');
+  if (id != null) {
+    feature.id = id;
+  }
+}
+
 class Feature extends JsObjectWrapper<FeatureJsImpl> {
   dynamic get id => jsObject.id;
 
@@ -36,6 +70,13 @@ class Feature extends JsObjectWrapper<FeatureJsImpl> {
 
   String get source => jsObject.source;
 
+  /// The id of the style layer of a rendered feature, null for features that
+  /// were not queried from the map.
+  String? get layerId {
+    final layer = getProperty<Object?>(jsObject, 'layer');
+    return layer != null ? getProperty(layer, 'id') : null;
+  }
+
   factory Feature({
     dynamic id,
     required Geometry geometry,
@@ -65,6 +106,14 @@ class Feature extends JsObjectWrapper<FeatureJsImpl> {
         source: source ?? this.source,
       ));
 
+  /// Converts a geojson feature to JS in a single pass, see
+  /// [FeatureCollection.fromGeoJson].
+  factory Feature.fromGeoJson(Map<String, dynamic> geojson) {
+    final FeatureJsImpl jsObject = jsify(geojson);
+    _promotePropertyId(jsObject);
+    return Feature.fromJsObject(jsObject);
+  }
+
   /// Creates a new Feature from a [jsObject].
   Feature.fromJsObject(super.jsObject) : super.fromJsObject();
 }
@@ -0,0 +1,104 @@
+part of '../maplibre_gl_web.dart';
+
+/// Mirrors the data of a geojson source added by the plugin, so that a
+/// single feature can be replaced without reading the data back from
+/// maplibre-gl-js.
+class _GeoJsonSourceData {
+  /// The JS feature collection last passed to the source, null if the source
+  /// was prepared by the [GeoJsonWorker].
+  final FeatureCollection? collection;
+
+  /// The geojson features of a source prepared by the [GeoJsonWorker].
+  final List? geojsonFeatures;
+
+  /// The JS object of a source that is not a feature collection, e.g. a
+  /// single feature or a bare geometry, which is passed to maplibre-gl-js
+  /// unchanged and has no features to replace.
+  final Object? passThrough;
+
+  /// The index into the features by feature id.
+  final _indexById = <dynamic, int>{};
+
+  /// Whether every feature has a unique id. maplibre-gl-js can only apply
+  /// `updateData` diffs to such sources.
+  var updatable = true;
+
+  _GeoJsonSourceData(FeatureCollection this.collection)
+      : geojsonFeatures = null,
+        passThrough = null {
+    _reindex();
+  }
+
+  _GeoJsonSourceData.fromGeoJson(Map<String, dynamic> geojson)
+      : collection = null,
+        geojsonFeatures = List.of(geojson['features'] ?? const []),
+        passThrough = geojson['type'] == 'FeatureCollection'
+            ? null
+            : geoJsonSourceData(geojson) {
+    _reindex();
+  }
+
+  _GeoJsonSourceData.passThrough(Object this.passThrough)
+      : collection = null,
+        geojsonFeatures = [];
+
+  /// The features of either backing, JS features or geojson maps.
+  List get _features => collection?.jsObject.features ?? geojsonFeatures!;
+
+  dynamic _idOf(dynamic feature) => collection != null
+      ? getProperty(feature, 'id')
+      : feature['properties']?['id'] ?? feature['id'];
+
+  void _reindex() {
+    _indexById.clear();
+    updatable = true;
+    final features = _features;
+    for (var i = 0; i < features.length; i++) {
+      _index(_idOf(features[i]), i);
+    }
+  }
+
+  void _index(dynamic id, int i) {
+    if (id == null || _indexById.containsKey(id)) {
+      updatable = false;
+    }
+    if (id != null) {
+      _indexById.putIfAbsent(id, () => i);
+    }
+  }
+
+  /// Replaces the feature with the id of [feature]. [geojsonFeature] is the
+  /// geojson the feature was created from. Returns false if there is no such
+  /// feature.
+  bool replace(Feature feature, Map<String, dynamic> geojsonFeature) {
+    final index = _indexById[feature.id];
+    if (index == null) return false;
+    if (collection != null) {
+      collection!.jsObject.features[index] = feature.jsObject;
+    } else {
+      geojsonFeatures![index] = geojsonFeature;
+    }
+    return true;
+  }
+
+  /// Replaces the features with the ids of [add], appends the others and
+  /// removes the features with an id in [remove]. [geojsonAdd] are the
+  /// geojson features [add] was created from.
+  void update(List<Feature> add, List geojsonAdd, Set remove) {
+    final features = _features;
+    if (remove.isNotEmpty) {
+      features.removeWhere((feature) => remove.contains(_idOf(feature)));
+      _reindex();
+    }
+    for (var i = 0; i < add.length; i++) {
+      final feature = collection != null ? add[i].jsObject : geojsonAdd[i];
+      final index = _indexById[add[i].id];
+      if (index != null) {
+        features[index] = feature;
+      } else {
+        _index(add[i].id, features.length);
+        features.add(feature);
+      }
+    }
+  }
+}
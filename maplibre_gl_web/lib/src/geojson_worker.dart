@@ -0,0 +1,230 @@
+// ignore_for_file: avoid_web_libraries_in_flutter
+import 'dart:async';
+import 'dart:convert';
+import 'dart:html' as html;
+import 'dart:typed_data';
+
+/// The script of the worker. It rebuilds the feature collection from the
+/// packed buffers, serializes it and returns a blob URL, which maplibre-gl-js
+/// loads and parses in its own worker.
+const _workerSource = r'''
+onmessage = function (event) {
+  var message = event.data;
+  var structure = new Int32Array(message.structure);
+  var coordinates = new Float64Array(message.coordinates);
+  var entries = JSON.parse(message.properties);
+  var s = 0;
+  var c = 0;
+  function point() {
+    var p = [coordinates[c], coordinates[c + 1]];
+    c += 2;
+    return p;
+  }
+  function line() {
+    var n = structure[s++];
+    var l = new Array(n);
+    for (var i = 0; i < n; i++) l[i] = point();
+    return l;
+  }
+  function lines() {
+    var n = structure[s++];
+    var l = new Array(n);
+    for (var i = 0; i < n; i++) l[i] = line();
+    return l;
+  }
+  var features = new Array(entries.length);
+  for (var i = 0; i < entries.length; i++) {
+    var geometry;
+    switch (structure[s++]) {
+      case 0: geometry = { type: 'Point', coordinates: point() }; break;
+      case 1: geometry = { type: 'MultiPoint', coordinates: line() }; break;
+      case 2: geometry = { type: 'LineString', coordinates: line() }; break;
+      case 3: geometry = { type: 'MultiLineString', coordinates: lines() }; break;
+      case 4: geometry = { type: 'Polygon', coordinates: lines() }; break;
+      case 5:
+        var n = structure[s++];
+        var polygons = new Array(n);
+        for (var j = 0; j < n; j++) polygons[j] = lines();
+        geometry = { type: 'MultiPolygon', coordinates: polygons };
+        break;
+      default: geometry = null;
+    }
+    var properties = entries[i][1] || {};
+    var feature = { type: 'Feature', geometry: geometry, properties: properties };
+    var id = properties.id != null ? properties.id : entries[i][0];
+    if (id != null) feature.id = id;
+    features[i] = feature;
+  }
+  var json = JSON.stringify({ type: 'FeatureCollection', features: features });
+  var blob = new Blob([json], { type: 'application/json' });
+  postMessage({ id: message.id, url: URL.createObjectURL(blob) });
+};
+''';
+
+const _geometryTypes = {
+  'Point': 0,
+  'MultiPoint': 1,
+  'LineString': 2,
+  'MultiLineString': 3,
+  'Polygon': 4,
+  'MultiPolygon': 5,
+};
+
+/// A geojson feature collection packed into flat buffers that can be
+/// transferred to a worker without copying.
+class PackedGeoJson {
+  /// The geometry type of each feature followed by its part, ring and point
+  /// counts.
+  final Int32List structure;
+
+  /// The longitude and latitude of all points of all features.
+  final Float64List coordinates;
+
+  /// The id and properties of each feature as a JSON array of
+  /// `[id, properties]` pairs.
+  final String properties;
+
+  PackedGeoJson._(this.structure, this.coordinates, this.properties);
+
+  /// Packs the [features] of a feature collection, or returns null if a
+  /// feature has a geometry that can not be packed, e.g. a
+  /// `GeometryCollection`.
+  static PackedGeoJson? pack(List features) {
+    final structure = <int>[];
+    final coordinates = <double>[];
+    final entries = <List>[];
+
+    void point(List position) {
+      coordinates
+        ..add((position[0] as num).toDouble())
+        ..add((position[1] as num).toDouble());
+    }
+
+    void line(List positions) {
+      structure.add(positions.length);
+      positions.cast<List>().forEach(point);
+    }
+
+    void lines(List parts) {
+      structure.add(parts.length);
+      parts.cast<List>().forEach(line);
+    }
+
+    for (final feature in features) {
+      final geometry = feature['geometry'];
+      if (geometry == null) {
+        structure.add(-1);
+      } else {
+        final type = _geometryTypes[geometry['type']];
+        final List? geometryCoordinates = geometry['coordinates'];
+        if (type == null || geometryCoordinates == null) return null;
+        structure.add(type);
+        switch (type) {
+          case 0:
+            point(geometryCoordinates);
+          case 1:
+          case 2:
+            line(geometryCoordinates);
+          case 3:
+          case 4:
+            lines(geometryCoordinates);
+          case 5:
+            structure.add(geometryCoordinates.length);
+            geometryCoordinates.cast<List>().forEach(lines);
+        }
+      }
+      entries.add([feature['id'], feature['properties']]);
+    }
+
+    return PackedGeoJson._(Int32List.fromList(structure),
+        Float64List.fromList(coordinates), jsonEncode(entries));
+  }
+}
+
+/// Prepares large geojson sources in a dedicated web worker.
+///
+/// maplibre-gl-js structured clones the data passed to `setData` to its own
+/// worker, after the plugin converted it to JS on the main thread. For large
+/// sources both passes block the page. With this worker the main thread only
+/// packs the geometries into typed arrays, which are transferred without
+/// copying. The worker builds the geojson and hands back a blob URL, which
+/// maplibre-gl-js fetches and parses off the main thread.
+class GeoJsonWorker {
+  final html.Worker _worker;
+  final String _scriptUrl;
+  final _pending = <int, Completer<String?>>{};
+  final _latestRequestBySource = <String, int>{};
+  final _urlBySource = <String, String>{};
+  var _nextRequestId = 0;
+
+  GeoJsonWorker._(this._worker, this._scriptUrl) {
+    _worker.onMessage.listen(_onMessage);
+  }
+
+  /// Starts a worker, or returns null if web workers are not supported.
+  static GeoJsonWorker? start() {
+    if (!html.Worker.supported) return null;
+    final scriptUrl = html.Url.createObjectUrlFromBlob(
+        html.Blob([_workerSource], 'application/javascript'));
+    return GeoJsonWorker._(html.Worker(scriptUrl), scriptUrl);
+  }
+
+  /// Whether a call to [prepare] for [sourceId] has not completed yet.
+  bool isPending(String sourceId) {
+    final requestId = _latestRequestBySource[sourceId];
+    return requestId != null && _pending.containsKey(requestId);
+  }
+
+  /// Builds the geojson of the [packed] features in the worker and returns a
+  /// blob URL to it. Returns null if [prepare] has been called for the same
+  /// source again before the worker finished, in which case only the latest
+  /// result should be used.
+  ///
+  /// The buffers of [packed] are transferred to the worker and can not be
+  /// used afterwards. The URL of the previous result of the source is
+  /// revoked.
+  Future<String?> prepare(String sourceId, PackedGeoJson packed) {
+    final requestId = _nextRequestId++;
+    final completer = Completer<String?>();
+    _pending[requestId] = completer;
+    _latestRequestBySource[sourceId] = requestId;
+    _worker.postMessage({
+      'id': requestId,
+      'structure': packed.structure.buffer,
+      'coordinates': packed.coordinates.buffer,
+      'properties': packed.properties,
+    }, [
+      packed.structure.buffer,
+      packed.coordinates.buffer
+    ]);
+
+    return completer.future.then((url) {
+      if (url == null) return null;
+      if (_latestRequestBySource[sourceId] != requestId) {
+        html.Url.revokeObjectUrl(url);
+        return null;
+      }
+      final previous = _urlBySource[sourceId];
+      if (previous != null) html.Url.revokeObjectUrl(previous);
+      _urlBySource[sourceId] = url;
+      return url;
+    });
+  }
+
+  void _onMessage(html.MessageEvent event) {
+    final data = event.data;
+    _pending.remove(data['id'])?.complete(data['url']);
+  }
+
+  /// Stops the worker and revokes all blob URLs.
+  void dispose() {
+    _worker.terminate();
+    html.Url.revokeObjectUrl(_scriptUrl);
+    _urlBySource.values.forEach(html.Url.revokeObjectUrl);
+    _urlBySource.clear();
+    for (final completer in _pending.values) {
+      completer.complete(null);
+    }
+    _pending.clear();
+  }
+}
@@ -0,0 +1,48 @@
+part of '../maplibre_gl_web.dart';
+
+/// Memoizes the rendered features of the interactive layers at the pointer
+/// position, so that the mousedown, click and hover handlers of one pointer
+/// position share a single `queryRenderedFeatures` call.
+///
+/// The result is valid until the map renders the next frame or the
+/// interactive layers change.
+class _HitTestCache {
+  final MapJs _map;
+
+  /// The interactive layers as a JS query options object, rebuilt when the
+  /// layers change instead of on every query.
+  JSObject? _options;
+  var _isEmpty = true;
+
+  double? _x;
+  double? _y;
+  List<FeatureJs>? _features;
+
+  _HitTestCache(MapLibreMap map) : _map = asMapJs(map.jsObject);
+
+  /// Drops the cached result, called when the map renders a frame.
+  void invalidate() {
+    _features = null;
+  }
+
+  /// Replaces the queried layers with [layerIds].
+  void setLayers(Iterable<String> layerIds) {
+    _isEmpty = layerIds.isEmpty;
+    _options = {'layers': layerIds.toList()}.jsify() as JSObject;
+    invalidate();
+  }
+
+  /// Returns the rendered features of the interactive layers at ([x], [y]).
+  List<FeatureJs> query(double x, double y) {
+    if (_isEmpty) return const [];
+    final cached = _features;
+    if (cached != null && _x == x && _y == y) return cached;
+
+    final features =
+        _map.queryRenderedFeatures([x.toJS, y.toJS].toJS, _options).toDart;
+    _x = x;
+    _y = y;
+    _features = features;
+    return features;
+  }
+}
@@ -0,0 +1,108 @@
+/// Typed `dart:js_interop` bindings for the hot paths of the plugin: camera
+/// reads, map events, rendered feature queries and geojson source updates.
+///
+/// Unlike the `package:js` wrappers in this directory, the extension types
+/// below are erased at compile time, so calls have no wrapper allocation and
+/// no dynamic dispatch, and this library compiles with dart2wasm. The map,
+/// sources and features of the `package:js` wrappers can be viewed as these
+/// types with [asMapJs], [asGeoJsonSourceJs] and [asFeatureJs].
+library maplibre.interop.typed;
+
+import 'dart:js_interop';
+import 'dart:js_interop_unsafe';
+
+/// Views the JS object of a `package:js` wrapper as a typed interop value.
+/// Both interop layers share the same JS objects, so this is a free cast.
+MapJs asMapJs(Object jsObject) => jsObject as MapJs;
+
+GeoJsonSourceJs asGeoJsonSourceJs(Object jsObject) =>
+    jsObject as GeoJsonSourceJs;
+
+FeatureJs asFeatureJs(Object jsObject) => jsObject as FeatureJs;
+
+/// A `maplibregl.Map`.
+extension type MapJs._(JSObject _) implements JSObject {
+  external LngLatJs getCenter();
+
+  external double getZoom();
+
+  external double getBearing();
+
+  external double getPitch();
+
+  external JSAny? getSource(String id);
+
+  /// Adds a [listener] for the map wide event [type], e.g. `move` or
+  /// `mousemove`.
+  external MapJs on(String type, JSFunction listener);
+
+  external MapJs off(String type, JSFunction listener);
+
+  external JSArray<FeatureJs> queryRenderedFeatures(
+      JSArray<JSNumber> point, JSObject? options);
+}
+
+/// A `maplibregl.LngLat`.
+extension type LngLatJs._(JSObject _) implements JSObject {
+  external double get lng;
+
+  external double get lat;
+}
+
+/// A `maplibregl.Point`.
+extension type PointJs._(JSObject _) implements JSObject {
+  external double get x;
+
+  external double get y;
+}
+
+/// A `MapMouseEvent` or `MapTouchEvent`.
+extension type MapMouseEventJs._(JSObject _) implements JSObject {
+  external String get type;
+
+  external PointJs get point;
+
+  external LngLatJs get lngLat;
+
+  external void preventDefault();
+}
+
+/// A geojson feature, either passed to a source or returned by
+/// [MapJs.queryRenderedFeatures].
+extension type FeatureJs._(JSObject _) implements JSObject {
+  external JSAny? get id;
+
+  external JSObject? get properties;
+
+  /// The style layer of a rendered feature.
+  external StyleLayerRefJs? get layer;
+
+  /// Reads the property [name] without converting the other properties.
+  JSAny? property(String name) => properties?.getProperty(name.toJS);
+}
+
+/// The style layer a rendered feature was queried from.
+extension type StyleLayerRefJs._(JSObject _) implements JSObject {
+  external String get id;
+}
+
+/// A `maplibregl.GeoJSONSource`.
+extension type GeoJsonSourceJs._(JSObject _) implements JSObject {
+  /// Sets a feature collection object or the URL of a geojson document.
+  external GeoJsonSourceJs setData(JSAny data);
+
+  /// Applies a diff to the data of the source. Requires maplibre-gl-js 3.3 or
+  /// newer and unique feature ids.
+  external GeoJsonSourceJs updateData(GeoJsonSourceDiffJs diff);
+
+  /// Whether [updateData] is supported by the loaded maplibre-gl-js version.
+  bool get supportsUpdateData => has('updateData');
+}
+
+/// A `GeoJSONSourceDiff`.
+extension type GeoJsonSourceDiffJs._(JSObject _) implements JSObject {
+  external factory GeoJsonSourceDiffJs({
+    JSArray<FeatureJs>? add,
+    JSArray<JSAny?>? remove,
+  });
+}
@@ -10,9 +10,29 @@ class MapLibreMapController extends MapLibrePlatform
   LatLng? _dragOrigin;
   LatLng? _dragPrevious;
   bool _dragEnabled = true;
-  final _addedFeaturesByLayer = <String, FeatureCollection>{};
+  final _addedFeaturesByLayer = <String, _GeoJsonSourceData>{};
+
+  /// Whether the map is scrolled out of view or hidden. Geojson data set in
+  /// the meantime is only kept in [_addedFeaturesByLayer] and the sources are
+  /// listed in [_staleSources] until the map becomes visible again.
+  var _isSuspended = false;
+  final _staleSources = <String>{};
+  html.IntersectionObserver? _intersectionObserver;
+
+  /// Prepares geojson sources with at least [_geoJsonWorkerThreshold]
+  /// features off the main thread, null if disabled.
+  GeoJsonWorker? _geoJsonWorker;
+  int _geoJsonWorkerThreshold = 0;
 
   final _interactiveFeatureLayerIds = <String>{};
+  late _HitTestCache _hitTestCache;
+  late _CameraStream _cameraStream;
+  final _motionSources = <String, _MotionSource>{};
+
+  /// The latest mousemove event, hit tested once per animation frame.
+  MapMouseEventJs? _pendingHoverEvent;
+  dynamic _hoveredFeatureId;
+  String? _hoveredLayerId;
 
   bool _trackCameraPosition = false;
   GeolocateControl? _geolocateControl;
@@ -37,6 +57,10 @@ class MapLibreMapController extends MapLibrePlatform
   @override
   void dispose() {
     super.dispose();
+    _geoJsonWorker?.dispose();
+    _cameraStream.cancel();
+    _cancelMotionSources();
+    _intersectionObserver?.disconnect();
     _map.remove();
   }
 
@@ -71,25 +95,92 @@ class MapLibreMapController extends MapLibrePlatform
           attributionControl: false, //avoid duplicate control
         ),
       );
+      _hitTestCache = _HitTestCache(_map);
+      _cameraStream = _CameraStream(
+          _map,
+          CameraMoveTolerance.fromMap(
+                  _creationParams['webCameraMoveTolerance']) ??
+              const CameraMoveTolerance(),
+          onCameraMovePlatform);
       _map.on('style.load', _onStyleLoaded);
-      _map.on('click', _onMapClick);
       // long click not available in web, so it is mapped to double click
       _map.on('dblclick', _onMapLongClick);
       _map.on('movestart', _onCameraMoveStarted);
-      _map.on('move', _onCameraMove);
       _map.on('moveend', _onCameraIdle);
       _map.on('resize', (_) => _onMapResize());
       _map.on('styleimagemissing', _loadFromAssets);
+
+      // events fired up to several times per frame are bound with the typed
+      // interop layer, which does not wrap each event
+      final map = asMapJs(_map.jsObject);
+      map
+        ..on('render', ((JSAny? _) => _hitTestCache.invalidate()).toJS)
+        ..on('move', ((JSAny? _) => _cameraStream.schedule()).toJS)
+        ..on('click', _onMapClick.toJS)
+        // the interactive layers are hit tested with one query for all
+        // layers instead of delegated per layer listeners
+        ..on('mousemove', _onMouseMove.toJS)
+        ..on('mouseout',
+            ((MapMouseEventJs e) => _setHoveredFeature(null, e)).toJS);
       if (_dragEnabled) {
-        _map.on('mouseup', _onMouseUp);
-        _map.on('mousemove', _onMouseMove);
+        map
+          ..on('mousedown', _onMouseDown.toJS)
+          ..on('mouseup', _onMouseUp.toJS);
       }
 
       _initResizeObserver();
+      _initIntersectionObserver();
+
+      final int? geoJsonWorkerThreshold =
+          _creationParams['webGeoJsonWorkerThreshold'];
+      if (geoJsonWorkerThreshold != null) {
+        _geoJsonWorkerThreshold = geoJsonWorkerThreshold;
+        _geoJsonWorker = GeoJsonWorker.start();
+      }
     }
     Convert.interpretMapLibreMapOptions(_creationParams['options'], this);
   }
 
+  void _initIntersectionObserver() {
+    _intersectionObserver = html.IntersectionObserver((entries, observer) {
+      final html.IntersectionObserverEntry entry = entries.last;
+      final isSuspended = !(entry.isIntersecting ?? true);
+      if (isSuspended == _isSuspended) return;
+      _isSuspended = isSuspended;
+      if (!isSuspended) {
+        _flushStaleSources();
+        for (final motionSource in _motionSources.values) {
+          motionSource.schedule();
+        }
+      }
+    });
+    _intersectionObserver!.observe(_mapElement);
+  }
+
+  /// Sets the data of all sources changed while the map was suspended, once
+  /// per source with the latest data.
+  Future<void> _flushStaleSources() async {
+    final sourceIds = _staleSources.toList();
+    _staleSources.clear();
+    for (final sourceId in sourceIds) {
+      final source = _map.getSource(sourceId) as GeoJsonSource?;
+      final data = _addedFeaturesByLayer[sourceId];
+      if (source == null || data == null) continue;
+      if (data.passThrough != null) {
+        source.setGeoJsonData(data.passThrough!);
+      } else if (data.collection != null) {
+        source.setData(data.collection!);
+      } else if (_isPreparedInWorker(data.geojsonFeatures)) {
+        await _setDataInWorker(sourceId, data);
+      } else {
+        final collection =
+            FeatureCollection.fromGeoJson({'features': data.geojsonFeatures});
+        _addedFeaturesByLayer[sourceId] = _GeoJsonSourceData(collection);
+        source.setData(collection);
+      }
+    }
+  }
+
   void _initResizeObserver() {
     final resizeObserver = html.ResizeObserver((entries, observer) {
       // The resize observer might be called a lot of times when the user resizes the browser window with the mouse for example.
@@ -109,24 +200,29 @@ class MapLibreMapController extends MapLibrePlatform
     await addImage(imagePath, bytes.buffer.asUint8List());
   }
 
-  _onMouseDown(Event e) {
-    final isDraggable = e.features[0].properties['draggable'];
-    if (isDraggable != null && isDraggable) {
+  static Point<double> _pointOf(MapMouseEventJs e) =>
+      Point<double>(e.point.x, e.point.y);
+
+  static LatLng _latLngOf(MapMouseEventJs e) =>
+      LatLng(e.lngLat.lat, e.lngLat.lng);
+
+  void _onMouseDown(MapMouseEventJs e) {
+    final features = _hitTestCache.query(e.point.x, e.point.y);
+    if (features.isEmpty) return;
+    final isDraggable = features.first.property('draggable')?.dartify();
+    if (isDraggable == true) {
       // Prevent the default map drag behavior.
       e.preventDefault();
-      _draggedFeatureId = e.features[0].id;
+      _draggedFeatureId = features.first.id?.dartify();
       _map.getCanvas().style.cursor = 'grabbing';
-      final coords = e.lngLat;
-      _dragOrigin = LatLng(coords.lat as double, coords.lng as double);
+      _dragOrigin = _latLngOf(e);
 
       if (_draggedFeatureId != null) {
-        final current =
-            LatLng(e.lngLat.lat.toDouble(), e.lngLat.lng.toDouble());
         final payload = {
           'id': _draggedFeatureId,
-          'point': Point<double>(e.point.x.toDouble(), e.point.y.toDouble()),
+          'point': _pointOf(e),
           'origin': _dragOrigin,
-          'current': current,
+          'current': _dragOrigin,
           'delta': const LatLng(0, 0),
           'eventType': 'start'
         };
@@ -135,12 +231,12 @@ class MapLibreMapController extends MapLibrePlatform
     }
   }
 
-  _onMouseUp(Event e) {
+  void _onMouseUp(MapMouseEventJs e) {
     if (_draggedFeatureId != null) {
-      final current = LatLng(e.lngLat.lat.toDouble(), e.lngLat.lng.toDouble());
+      final current = _latLngOf(e);
       final payload = {
         'id': _draggedFeatureId,
-        'point': Point<double>(e.point.x.toDouble(), e.point.y.toDouble()),
+        'point': _pointOf(e),
         'origin': _dragOrigin,
         'current': current,
         'delta': current - (_dragPrevious ?? _dragOrigin!),
@@ -154,12 +250,12 @@ class MapLibreMapController extends MapLibrePlatform
     _map.getCanvas().style.cursor = '';
   }
 
-  _onMouseMove(Event e) {
+  void _onMouseMove(MapMouseEventJs e) {
     if (_draggedFeatureId != null) {
-      final current = LatLng(e.lngLat.lat.toDouble(), e.lngLat.lng.toDouble());
+      final current = _latLngOf(e);
       final payload = {
         'id': _draggedFeatureId,
-        'point': Point<double>(e.point.x.toDouble(), e.point.y.toDouble()),
+        'point': _pointOf(e),
         'origin': _dragOrigin,
         'current': current,
         'delta': current - (_dragPrevious ?? _dragOrigin!),
@@ -167,9 +263,41 @@ class MapLibreMapController extends MapLibrePlatform
       };
       _dragPrevious = current;
       onFeatureDraggedPlatform(payload);
+    } else if (_interactiveFeatureLayerIds.isNotEmpty) {
+      _scheduleHover(e);
     }
   }
 
+  /// Hit tests the latest mousemove event once per animation frame.
+  void _scheduleHover(MapMouseEventJs e) {
+    final isScheduled = _pendingHoverEvent != null;
+    _pendingHoverEvent = e;
+    if (isScheduled) return;
+    html.window.requestAnimationFrame((_) {
+      final event = _pendingHoverEvent;
+      _pendingHoverEvent = null;
+      if (event == null || _draggedFeatureId != null) return;
+      final features = _hitTestCache.query(event.point.x, event.point.y);
+      final feature = features.isEmpty ? null : features.first;
+      _setHoveredFeature(feature, event);
+    });
+  }
+
+  void _setHoveredFeature(FeatureJs? feature, MapMouseEventJs e) {
+    final id = feature?.id?.dartify();
+    final layerId = feature?.layer?.id;
+    if (id == _hoveredFeatureId && layerId == _hoveredLayerId) return;
+    _hoveredFeatureId = id;
+    _hoveredLayerId = layerId;
+    _map.getCanvas().style.cursor = feature != null ? 'pointer' : '';
+    onFeatureHoverPlatform({
+      'id': id,
+      'layerId': layerId,
+      'point': _pointOf(e),
+      'latLng': _latLngOf(e),
+    });
+  }
+
   @override
   Future<CameraPosition?> updateMapOptions(
       Map<String, dynamic> optionsUpdate) async {
@@ -359,6 +487,11 @@ class MapLibreMapController extends MapLibrePlatform
     print('Offline storage not available in web');
   }
 
+  @override
+  Future<void> setPrefetchZoomDelta(int delta) async {
+    print('Prefetch zoom delta not available in web');
+  }
+
   @override
   Future<LatLng?> requestMyLocationLatLng() async {
     return _myLastLocation;
@@ -398,18 +531,50 @@ class MapLibreMapController extends MapLibrePlatform
 
   @override
   Future<void> removeSource(String sourceId) async {
+    _staleSources.remove(sourceId);
+    _motionSources.remove(sourceId)?.cancel();
     _map.removeSource(sourceId);
   }
 
+  @override
+  Future<void> addMotionSource(String sourceId,
+      {Duration maxExtrapolation = const Duration(seconds: 5),
+      Duration blendDuration = const Duration(seconds: 1)}) async {
+    _map.addSource(sourceId, {
+      "type": 'geojson',
+      "data": {"type": "FeatureCollection", "features": []},
+      "promoteId": 'id',
+    });
+    final source = _map.getSource(sourceId) as GeoJsonSource;
+    _motionSources[sourceId] = _MotionSource(
+        asGeoJsonSourceJs(source.jsObject),
+        MotionInterpolator(
+            maxExtrapolation: maxExtrapolation, blendDuration: blendDuration),
+        () => _isSuspended);
+  }
+
+  @override
+  Future<void> updateMotionSource(String sourceId, List<MovingPoint> points,
+      {List<Object> removeIds = const []}) async {
+    final motionSource = _motionSources[sourceId];
+    if (motionSource == null) {
+      throw PlatformException(
+          code: 'SOURCE_NOT_FOUND',
+          message: 'No motion source found with id $sourceId');
+    }
+    motionSource.update(points, removeIds);
+  }
+
+  void _cancelMotionSources() {
+    for (final motionSource in _motionSources.values) {
+      motionSource.cancel();
+    }
+    _motionSources.clear();
+  }
+
   CameraPosition? _getCameraPosition() {
     if (_trackCameraPosition) {
-      final center = _map.getCenter();
-      return CameraPosition(
-        bearing: _map.getBearing() as double,
-        target: LatLng(center.lat as double, center.lng as double),
-        tilt: _map.getPitch() as double,
-        zoom: _map.getZoom() as double,
-      );
+      return _cameraStream.read();
     }
     return null;
   }
@@ -422,6 +587,8 @@ class MapLibreMapController extends MapLibrePlatform
       });
       return;
     }
+    // the sources of the previous style are gone
+    _cancelMotionSources();
     _onMapResize();
     onMapStyleLoadedPlatform(null);
   }
@@ -438,13 +605,13 @@ class MapLibreMapController extends MapLibrePlatform
     });
   }
 
-  void _onMapClick(Event e) {
-    final features = _map.queryRenderedFeatures([e.point.x, e.point.y],
-        {"layers": _interactiveFeatureLayerIds.toList()});
+  void _onMapClick(MapMouseEventJs e) {
+    final features = _hitTestCache.query(e.point.x, e.point.y);
     final payload = {
-      'point': Point<double>(e.point.x.toDouble(), e.point.y.toDouble()),
-      'latLng': LatLng(e.lngLat.lat.toDouble(), e.lngLat.lng.toDouble()),
-      if (features.isNotEmpty) "id": features.first.id,
+      'point': _pointOf(e),
+      'latLng': _latLngOf(e),
+      if (features.isNotEmpty) "id": features.first.id?.dartify(),
+      if (features.isNotEmpty) "layerId": features.first.layer?.id,
     };
     if (features.isNotEmpty) {
       onFeatureTappedPlatform(payload);
@@ -464,26 +631,9 @@ class MapLibreMapController extends MapLibrePlatform
     onCameraMoveStartedPlatform(null);
   }
 
-  void _onCameraMove(_) {
-    final center = _map.getCenter();
-    final camera = CameraPosition(
-      bearing: _map.getBearing() as double,
-      target: LatLng(center.lat as double, center.lng as double),
-      tilt: _map.getPitch() as double,
-      zoom: _map.getZoom() as double,
-    );
-    onCameraMovePlatform(camera);
-  }
-
   void _onCameraIdle(_) {
-    final center = _map.getCenter();
-    final camera = CameraPosition(
-      bearing: _map.getBearing() as double,
-      target: LatLng(center.lat as double, center.lng as double),
-      tilt: _map.getPitch() as double,
-      zoom: _map.getZoom() as double,
-    );
-    onCameraIdlePlatform(camera);
+    _cameraStream.flush();
+    onCameraIdlePlatform(_cameraStream.read());
   }
 
   void _onCameraTrackingChanged(bool isTracking) {
@@ -697,14 +847,8 @@ class MapLibreMapController extends MapLibrePlatform
 
   @override
   void setStyleString(String? styleString) {
-    //remove old mouseenter callbacks to avoid multicalling
-    for (final layerId in _interactiveFeatureLayerIds) {
-      _map.off('mouseenter', layerId, _onMouseEnterFeature);
-      _map.off('mousemouve', layerId, _onMouseEnterFeature);
-      _map.off('mouseleave', layerId, _onMouseLeaveFeature);
-      if (_dragEnabled) _map.off('mousedown', layerId, _onMouseDown);
-    }
     _interactiveFeatureLayerIds.clear();
+    _hitTestCache.setLayers(_interactiveFeatureLayerIds);
 
     _map.setStyle(styleString, {'diff': false});
   }
@@ -750,7 +894,9 @@ class MapLibreMapController extends MapLibrePlatform
 
   @override
   Future<void> removeLayer(String imageLayerId) async {
-    _interactiveFeatureLayerIds.remove(imageLayerId);
+    if (_interactiveFeatureLayerIds.remove(imageLayerId)) {
+      _hitTestCache.setLayers(_interactiveFeatureLayerIds);
+    }
     _map.removeLayer(imageLayerId);
   }
 
@@ -762,36 +908,95 @@ class MapLibreMapController extends MapLibrePlatform
   @override
   Future<void> addGeoJsonSource(String sourceId, Map<String, dynamic> geojson,
       {String? promoteId}) async {
-    final data = _makeFeatureCollection(geojson);
-    _addedFeaturesByLayer[sourceId] = data;
+    if (_isSuspended) {
+      // the data is converted and set once the map becomes visible
+      _addedFeaturesByLayer[sourceId] =
+          _GeoJsonSourceData.fromGeoJson(geojson);
+      _staleSources.add(sourceId);
+      _map.addSource(sourceId, {
+        "type": 'geojson',
+        "data": {"type": "FeatureCollection", "features": []},
+        if (promoteId != null) "promoteId": promoteId
+      });
+      return;
+    }
+
+    if (_isPreparedInWorker(geojson['features'])) {
+      final data = _GeoJsonSourceData.fromGeoJson(geojson);
+      _addedFeaturesByLayer[sourceId] = data;
+      _map.addSource(sourceId, {
+        "type": 'geojson',
+        "data": {"type": "FeatureCollection", "features": []},
+        if (promoteId != null) "promoteId": promoteId
+      });
+      await _setDataInWorker(sourceId, data);
+      return;
+    }
+
+    // the geojson is converted to JS once and shared with maplibre-gl-js
+    final data = geoJsonSourceData(geojson);
+    _addedFeaturesByLayer[sourceId] = data is FeatureCollection
+        ? _GeoJsonSourceData(data)
+        : _GeoJsonSourceData.passThrough(data);
     _map.addSource(sourceId, {
       "type": 'geojson',
-      "data": geojson, // pass the raw string here to avoid errors
+      "data": data is FeatureCollection ? data.jsObject : data,
       if (promoteId != null) "promoteId": promoteId
     });
   }
 
-  Feature _makeFeature(Map<String, dynamic> geojsonFeature) {
-    return Feature(
-        geometry: Geometry(
-            type: geojsonFeature["geometry"]["type"],
-            coordinates: geojsonFeature["geometry"]["coordinates"]),
-        properties: geojsonFeature["properties"],
-        id: geojsonFeature["properties"]?["id"] ?? geojsonFeature["id"]);
-  }
-
-  FeatureCollection _makeFeatureCollection(Map<String, dynamic> geojson) {
-    return FeatureCollection(
-        features: [for (final f in geojson["features"] ?? []) _makeFeature(f)]);
-  }
-
   @override
   Future<void> setGeoJsonSource(
       String sourceId, Map<String, dynamic> geojson) async {
+    if (_isSuspended) {
+      _addedFeaturesByLayer[sourceId] =
+          _GeoJsonSourceData.fromGeoJson(geojson);
+      _staleSources.add(sourceId);
+      return;
+    }
+
+    if (_isPreparedInWorker(geojson['features'])) {
+      final data = _GeoJsonSourceData.fromGeoJson(geojson);
+      _addedFeaturesByLayer[sourceId] = data;
+      await _setDataInWorker(sourceId, data);
+      return;
+    }
+
     final source = _map.getSource(sourceId) as GeoJsonSource;
-    final data = _makeFeatureCollection(geojson);
-    _addedFeaturesByLayer[sourceId] = data;
-    source.setData(data);
+    final data = geoJsonSourceData(geojson);
+    if (data is FeatureCollection) {
+      _addedFeaturesByLayer[sourceId] = _GeoJsonSourceData(data);
+      source.setData(data);
+    } else {
+      _addedFeaturesByLayer[sourceId] = _GeoJsonSourceData.passThrough(data);
+      source.setGeoJsonData(data);
+    }
+  }
+
+  bool _isPreparedInWorker(List? features) {
+    return _geoJsonWorker != null &&
+        features != null &&
+        features.length >= _geoJsonWorkerThreshold;
+  }
+
+  /// Sets the features of [data] to the source once the [_geoJsonWorker]
+  /// prepared them, unless the source has been changed in the meantime.
+  Future<void> _setDataInWorker(
+      String sourceId, _GeoJsonSourceData data) async {
+    final packed = PackedGeoJson.pack(data.geojsonFeatures!);
+    final url = packed != null
+        ? await _geoJsonWorker!.prepare(sourceId, packed)
+        : null;
+    final source = _map.getSource(sourceId) as GeoJsonSource?;
+    if (source == null || !identical(_addedFeaturesByLayer[sourceId], data)) {
+      return;
+    }
+    if (url != null) {
+      source.setDataUrl(url);
+    } else if (packed == null) {
+      source.setData(FeatureCollection.fromGeoJson(
+          {'features': data.geojsonFeatures}));
+    }
   }
 
   @override
@@ -987,26 +1192,10 @@ class MapLibreMapController extends MapLibrePlatform
 
     if (enableInteraction) {
       _interactiveFeatureLayerIds.add(layerId);
-      if (layerType == "fill") {
-        _map.on('mousemove', layerId, _onMouseEnterFeature);
-      } else {
-        _map.on('mouseenter', layerId, _onMouseEnterFeature);
-      }
-      _map.on('mouseleave', layerId, _onMouseLeaveFeature);
-      if (_dragEnabled) _map.on('mousedown', layerId, _onMouseDown);
+      _hitTestCache.setLayers(_interactiveFeatureLayerIds);
     }
   }
 
-  void _onMouseEnterFeature(_) {
-    if (_draggedFeatureId == null) {
-      _map.getCanvas().style.cursor = 'pointer';
-    }
-  }
-
-  void _onMouseLeaveFeature(_) {
-    _map.getCanvas().style.cursor = '';
-  }
-
   @override
   void setGestures(
       {required bool rotateGesturesEnabled,
@@ -1107,19 +1296,126 @@ class MapLibreMapController extends MapLibrePlatform
     final data = _addedFeaturesByLayer[sourceId];
 
     if (source != null && data != null) {
-      final feature = _makeFeature(geojsonFeature);
-      final features = data.features.toList();
-      final index = features.indexWhere((f) => f.id == feature.id);
-      if (index >= 0) {
-        features[index] = feature;
-        final newData = FeatureCollection(features: features);
-        _addedFeaturesByLayer[sourceId] = newData;
-
-        source.setData(newData);
+      final feature = Feature.fromGeoJson(geojsonFeature);
+      if (!data.replace(feature, geojsonFeature)) return;
+      if (_isSuspended) {
+        _staleSources.add(sourceId);
+        return;
+      }
+
+      // a diff would be overwritten by a pending result of the worker
+      final isPending = data.collection == null &&
+          (_geoJsonWorker?.isPending(sourceId) ?? false);
+      if (data.updatable && source.supportsUpdateData && !isPending) {
+        // only the changed feature is sent to the worker
+        source.updateData(add: [feature]);
+      } else if (data.collection != null) {
+        source.setData(data.collection!);
+      } else {
+        await _setDataInWorker(sourceId, data);
       }
     }
   }
 
+  /// Applies a diff to the geojson source [sourceId], with `updateData` if
+  /// maplibre-gl-js supports it for the source and by setting the whole data
+  /// otherwise.
+  Future<void> _updateGeoJsonSource(
+      String sourceId, List geojsonAdd, List removeIds) async {
+    final source = _map.getSource(sourceId) as GeoJsonSource?;
+    final data = _addedFeaturesByLayer[sourceId];
+    if (source == null || data == null) {
+      throw PlatformException(
+          code: 'SOURCE_NOT_FOUND',
+          message: 'No geojson source found with id $sourceId');
+    }
+    final add = [
+      for (final feature in geojsonAdd) Feature.fromGeoJson(feature),
+    ];
+    data.update(add, geojsonAdd, removeIds.toSet());
+    if (_isSuspended) {
+      _staleSources.add(sourceId);
+      return;
+    }
+
+    final isPending = data.collection == null &&
+        (_geoJsonWorker?.isPending(sourceId) ?? false);
+    if (data.updatable && source.supportsUpdateData && !isPending) {
+      source.updateData(add: add, remove: removeIds);
+    } else if (data.collection != null) {
+      source.setData(data.collection!);
+    } else {
+      await _setDataInWorker(sourceId, data);
+    }
+  }
+
+  @override
+  Future<void> setFeatureState(
+      String sourceId, String featureId, Map<String, dynamic> state,
+      {String? sourceLayer}) async {
+    _map.setFeatureState(
+        jsify({
+          'source': sourceId,
+          if (sourceLayer != null) 'sourceLayer': sourceLayer,
+          'id': featureId,
+        }),
+        jsify(state));
+  }
+
+  @override
+  Future<void> removeFeatureState(String sourceId,
+      {String? featureId, String? key, String? sourceLayer}) async {
+    _map.removeFeatureState(
+        jsify({
+          'source': sourceId,
+          if (sourceLayer != null) 'sourceLayer': sourceLayer,
+          if (featureId != null) 'id': featureId,
+        }),
+        key);
+  }
+
+  @override
+  Future<int> getClusterExpansionZoom(String sourceId, int clusterId) async {
+    final num zoom = await promiseToFuture(callMethod(
+        _geoJsonSourceJs(sourceId), 'getClusterExpansionZoom', [clusterId]));
+    return zoom.toInt();
+  }
+
+  @override
+  Future<List> getClusterChildren(String sourceId, int clusterId) async {
+    final features = await promiseToFuture(callMethod(
+        _geoJsonSourceJs(sourceId), 'getClusterChildren', [clusterId]));
+    return _featuresFromJs(features);
+  }
+
+  @override
+  Future<List> getClusterLeaves(String sourceId, int clusterId,
+      {int limit = 10, int offset = 0}) async {
+    final features = await promiseToFuture(callMethod(
+        _geoJsonSourceJs(sourceId),
+        'getClusterLeaves',
+        [clusterId, limit, offset]));
+    return _featuresFromJs(features);
+  }
+
+  Object _geoJsonSourceJs(String sourceId) {
+    final source = _map.jsObject.getSource(sourceId);
+    if (source == null) {
+      throw PlatformException(
+          code: 'SOURCE_NOT_FOUND',
+          message: 'No geojson source found with id $sourceId');
+    }
+    return source;
+  }
+
+  /// Converts geojson features returned by maplibre-gl-js to the same json
+  /// structure the method channel returns.
+  List _featuresFromJs(Object? features) {
+    final String json = callMethod(
+        getProperty(globalThis, 'JSON'), 'stringify', [features]);
+    return jsonDecode(json);
+  }
+
   @override
   void resizeWebMap() {
     _onMapResize();
@@ -1135,6 +1431,62 @@ class MapLibreMapController extends MapLibrePlatform
     _map.setLayoutProperty(layerId, 'visibility', visible ? 'visible' : 'none');
   }
 
+  @override
+  Future<List<StyleOperationError>> applyStyleTransaction(
+      List<Map<String, dynamic>> operations) async {
+    final errors = <StyleOperationError>[];
+    for (var i = 0; i < operations.length; i++) {
+      try {
+        await _applyStyleOperation(operations[i]);
+      } catch (e) {
+        errors.add(StyleOperationError(
+          index: i,
+          code: 'styleOperationError',
+          message: e.toString(),
+        ));
+      }
+    }
+    return errors;
+  }
+
+  Future<void> _applyStyleOperation(Map<String, dynamic> operation) async {
+    switch (operation['type']) {
+      case 'addSource':
+        _map.addSource(operation['sourceId'], operation['properties']);
+      case 'addGeoJsonSource':
+        await addGeoJsonSource(operation['sourceId'], operation['geojson'],
+            promoteId: operation['promoteId']);
+      case 'setGeoJsonSource':
+        await setGeoJsonSource(operation['sourceId'], operation['geojson']);
+      case 'updateGeoJsonSource':
+        await _updateGeoJsonSource(operation['sourceId'],
+            operation['geojson']['features'], operation['removeIds']);
+      case 'addLayer':
+        await _addLayer(operation['sourceId'], operation['layerId'],
+            operation['properties'], operation['layerType'],
+            belowLayerId: operation['belowLayerId'],
+            sourceLayer: operation['sourceLayer'],
+            minzoom: operation['minzoom'],
+            maxzoom: operation['maxzoom'],
+            filter: operation['filter'],
+            enableInteraction: operation['enableInteraction'] ?? false);
+      case 'setLayerProperties':
+        await setLayerProperties(
+            operation['layerId'], operation['properties']);
+      case 'setFilter':
+        await setFilter(operation['layerId'], operation['filter']);
+      case 'setLayerVisibility':
+        await setLayerVisibility(operation['layerId'], operation['visible']);
+      case 'removeLayer':
+        await removeLayer(operation['layerId']);
+      case 'removeSource':
+        await removeSource(operation['sourceId']);
+      default:
+        throw UnimplementedError(
+            'Unknown style operation ${operation['type']}');
+    }
+  }
+
   @override
   Future getFilter(String layerId) async {
     return _map.getFilter(layerId);
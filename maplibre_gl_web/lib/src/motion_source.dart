@@ -0,0 +1,89 @@
+part of '../maplibre_gl_web.dart';
+
+/// A geojson source of moving points, see [MapLibrePlatform.addMotionSource].
+///
+/// The features are converted to JS once per update. In between, the
+/// positions are extrapolated with a [MotionInterpolator] once per animation
+/// frame, written into the coordinates of the JS features in place and set
+/// on the source, while any point moves and the map is visible.
+class _MotionSource {
+  final GeoJsonSourceJs _source;
+  final MotionInterpolator _interpolator;
+  final bool Function() _isSuspended;
+
+  final _featuresById = <Object, JSObject>{};
+
+  /// The coordinates of the features in the order of the ids of the
+  /// interpolator.
+  final _coordinates = <JSObject>[];
+  final _collection = JSObject()
+    ..setProperty('type'.toJS, 'FeatureCollection'.toJS);
+  Float64List? _positions;
+  int? _frame;
+
+  _MotionSource(this._source, this._interpolator, this._isSuspended);
+
+  void update(List<MovingPoint> points, List<Object> removeIds) {
+    final now = DateTime.now().millisecondsSinceEpoch;
+    for (final id in removeIds) {
+      _interpolator.remove(id);
+      _featuresById.remove(id);
+    }
+    for (final point in points) {
+      _interpolator.update(point, now);
+      _featuresById[point.id] = {
+        'type': 'Feature',
+        'id': point.id,
+        'properties': {...point.properties, 'id': point.id},
+        'geometry': {
+          'type': 'Point',
+          'coordinates': [point.position.longitude, point.position.latitude],
+        },
+      }.jsify() as JSObject;
+    }
+
+    final features = [
+      for (final id in _interpolator.ids) _featuresById[id]!,
+    ];
+    _coordinates
+      ..clear()
+      ..addAll(features.map((feature) => feature
+          .getProperty<JSObject>('geometry'.toJS)
+          .getProperty<JSObject>('coordinates'.toJS)));
+    _collection.setProperty('features'.toJS, features.toJS);
+    _render(now);
+    schedule();
+  }
+
+  /// Requests the positions of the next animation frame, e.g. once the map
+  /// becomes visible again.
+  void schedule() {
+    _frame ??= html.window.requestAnimationFrame(_onFrame);
+  }
+
+  void cancel() {
+    final frame = _frame;
+    if (frame != null) html.window.cancelAnimationFrame(frame);
+    _frame = null;
+  }
+
+  void _onFrame(num _) {
+    _frame = null;
+    // resumed with [schedule] once the map is visible again
+    if (_isSuspended()) return;
+    final now = DateTime.now().millisecondsSinceEpoch;
+    _render(now);
+    if (_interpolator.isMovingAt(now)) schedule();
+  }
+
+  void _render(int now) {
+    final positions = _interpolator.positionsAt(now, _positions);
+    _positions = positions;
+    for (var i = 0; i < _coordinates.length; i++) {
+      _coordinates[i]
+        ..setProperty(0.toJS, positions[i * 2 + 1].toJS)
+        ..setProperty(1.toJS, positions[i * 2].toJS);
+    }
+    _source.setData(_collection);
+  }
+}
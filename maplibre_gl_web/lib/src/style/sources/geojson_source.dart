@@ -1,5 +1,8 @@
+import 'dart:js_interop';
+
 import 'package:maplibre_gl_web/src/geo/geojson.dart';
 import 'package:maplibre_gl_web/src/interop/style/sources/geojson_source_interop.dart';
+import 'package:maplibre_gl_web/src/interop/typed_interop.dart';
 import 'package:maplibre_gl_web/src/style/sources/source.dart';
 
 class GeoJsonSource extends Source<GeoJsonSourceJsImpl> {
@@ -19,6 +22,40 @@ class GeoJsonSource extends Source<GeoJsonSourceJsImpl> {
   GeoJsonSource setData(FeatureCollection featureCollection) =>
       GeoJsonSource.fromJsObject(jsObject.setData(featureCollection.jsObject));
 
+  /// Sets the data of the source to the JS object of a geojson other than a
+  /// feature collection, see [geoJsonSourceData].
+  GeoJsonSource setGeoJsonData(Object data) {
+    asGeoJsonSourceJs(jsObject).setData(data as JSAny);
+    return this;
+  }
+
+  /// Sets the data of the source to the geojson at [url], which
+  /// maplibre-gl-js loads and parses in its worker.
+  GeoJsonSource setDataUrl(String url) {
+    asGeoJsonSourceJs(jsObject).setData(url.toJS);
+    return this;
+  }
+
+  /// Whether [updateData] is supported by the loaded maplibre-gl-js version.
+  bool get supportsUpdateData =>
+      asGeoJsonSourceJs(jsObject).supportsUpdateData;
+
+  /// Incrementally updates the data of the source: [add] inserts features or
+  /// replaces the features with the same id, [remove] removes the features
+  /// with the given ids. Only the diff is sent to the worker of
+  /// maplibre-gl-js, which updates its index instead of rebuilding it.
+  GeoJsonSource updateData({List<Feature>? add, List<dynamic>? remove}) {
+    asGeoJsonSourceJs(jsObject).updateData(GeoJsonSourceDiffJs(
+      add: add != null
+          ? [for (final feature in add) asFeatureJs(feature.jsObject)].toJS
+          : null,
+      remove: remove != null
+          ? [for (final id in remove) id.jsify()].toJS
+          : null,
+    ));
+    return this;
+  }
+
   /// Creates a new GeoJsonSource from a [jsObject].
   GeoJsonSource.fromJsObject(super.jsObject) : super.fromJsObject();
 
@@ -0,0 +1,60 @@
+// Run with:
+//   flutter test --platform chrome test/geojson_source_data_test.dart
+@TestOn('browser')
+library;
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:js/js_util.dart';
+// ignore: implementation_imports
+import 'package:maplibre_gl_web/src/geo/geojson.dart';
+
+void main() {
+  group('geoJsonSourceData', () {
+    test('converts feature collections and promotes property ids', () {
+      final data = geoJsonSourceData({
+        'type': 'FeatureCollection',
+        'features': [
+          {
+            'type': 'Feature',
+            'properties': {'id': 'a'},
+            'geometry': {
+              'type': 'Point',
+              'coordinates': [1, 2],
+            },
+          },
+        ],
+      });
+      expect(data, isA<FeatureCollection>());
+      final features = (data as FeatureCollection).features;
+      expect(features, hasLength(1));
+      expect(features.single.id, 'a');
+    });
+
+    test('passes a single feature through unchanged', () {
+      final feature = {
+        'type': 'Feature',
+        'properties': {'name': 'a'},
+        'geometry': {
+          'type': 'LineString',
+          'coordinates': [
+            [1, 2],
+            [3, 4],
+          ],
+        },
+      };
+      final data = geoJsonSourceData(feature);
+      expect(data, isNot(isA<FeatureCollection>()));
+      expect(dartify(data), feature);
+    });
+
+    test('passes a bare geometry through unchanged', () {
+      final point = {
+        'type': 'Point',
+        'coordinates': [1, 2],
+      };
+      final data = geoJsonSourceData(point);
+      expect(data, isNot(isA<FeatureCollection>()));
+      expect(dartify(data), point);
+    });
+  });
+}
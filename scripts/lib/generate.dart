@@ -40,6 +40,10 @@ main() async {
           "typeCamel": ReCase(type).camelCase,
           "paint_properties": buildStyleProperties(styleJson, "paint_$type"),
           "layout_properties": buildStyleProperties(styleJson, "layout_$type"),
+          "properties": [
+            ...buildStyleProperties(styleJson, "paint_$type"),
+            ...buildStyleProperties(styleJson, "layout_$type"),
+          ],
         },
     ],
     "sourceTypes": [
@@ -66,6 +70,7 @@ main() async {
     "maplibre_gl/lib/src/layer_properties.dart",
     "maplibre_gl_web/lib/src/layer_tools.dart",
     "maplibre_gl_platform_interface/lib/src/source_properties.dart",
+    "maplibre_gl_platform_interface/lib/src/layer_property_spec.dart",
   ];
 
   for (final template in templates) {
@@ -107,9 +112,25 @@ Map<String, dynamic> buildStyleProperty(
   final nestedTypeDart = dartTypeMappingTable[value["value"]] ??
       dartTypeMappingTable[value["value"]?["type"]];
   final camelCase = ReCase(key).camelCase;
+  final Map<String, dynamic>? enumValues = value["values"];
+  final Map<String, dynamic>? expression = value["expression"];
 
   return <String, dynamic>{
     'value': key,
+    'specType': value["type"],
+    'hasEnumValues': enumValues != null,
+    'enumValues': enumValues?.keys.toList() ?? [],
+    'hasMinimum': value["minimum"] != null,
+    'minimum': value["minimum"],
+    'hasMaximum': value["maximum"] != null,
+    'maximum': value["maximum"],
+    'hasArrayValueType': value["value"] is String,
+    'arrayValueType': value["value"] is String ? value["value"] : null,
+    'hasArrayLength': value["length"] != null,
+    'arrayLength': value["length"],
+    'supportsExpression': expression != null,
+    'expressionParameters': expression?["parameters"] ?? [],
+    'isInterpolated': expression?["interpolated"] == true,
     'isFloatArrayProperty': typeDart == "List" && nestedTypeDart == "double",
     'isVisibilityProperty': key == "visibility",
     'requiresLiteral': key == "icon-image",